@@ -25,9 +25,10 @@ import time
 import requests
 import cv2
 import os
-from datetime import datetime
+from datetime import datetime, timedelta
 import json
 import threading
+import struct
 
 # ----------------------------------------------------------------------
 # MACROs
@@ -52,6 +53,12 @@ PUMP_DIR =      "/home/pi/data/pump"
 
 DELAY_SECONDS = 20.00
 timer = None
+commands = None        # CommandClient, created once the port is open
+
+# Last sample handed to the server; survives Pi reboots so the Giga can
+# backfill exactly what was missed
+TLM_STATE_FILE = "/home/pi/data/telemetry_state.json"
+RESEND_MIN_INTERVAL = 5.0      # seconds between RESEND requests
 
 # ----------------------------------------------------------------------
 # ensure save directory exists
@@ -76,6 +83,280 @@ if not os.path.exists(BLOWERS_DIR):
 if not os.path.exists(PUMP_DIR):
     os.makedirs(PUMP_DIR)
 
+# ----------------------------------------------------------------------
+# Telemetry frames from the Giga (see include/logic/telemetry.h)
+#   0x00 | COBS( ver | type | seq(2) | payload | crc16(2) ) | 0x00
+# Anything between zero bytes that does not decode to a valid frame is
+# debug text from the Giga and is only printed.
+#
+# Sensor readings arrive in TLM_SAMPLES batches with 32-bit sample numbers.
+# Samples are accepted strictly in order; each batch is answered with
+# TLM_ACK(next expected), and a gap is answered with TLM_RESEND.
+# The Giga never holds more than GIGA_BACKLOG unacknowledged samples, so a
+# batch ending further than that below next_seq comes from a restarted
+# Giga, even if its boot_id matches.
+# ----------------------------------------------------------------------
+TLM_VERSION      = 2
+TLM_DOOR         = 0x02
+TLM_ACTUATOR     = 0x03
+TLM_CAMERA_DELAY = 0x04
+TLM_SAMPLES      = 0x05
+TLM_RESPONSE     = 0x06
+TLM_ACK          = 0x81
+TLM_RESEND       = 0x82
+TLM_NONE         = -32768
+GIGA_BACKLOG     = 360     # TELEMETRY_BACKLOG in include/config.h
+
+# Commands (see include/logic/command_channel.h); replies are TLM_RESPONSE
+CMD_GET_SNAPSHOT = 0x90    # -> snapshot
+CMD_GET_HISTORY  = 0x91    # window, metric, series, max_points -> count, int16[count]
+CMD_GET_CONFIG   = 0x92    # field, index -> float
+CMD_SET_CONFIG   = 0xA0    # field, index, float -> float
+CMD_TRIGGER      = 0xA1    # actuator (TLM_ACT_*)
+CMD_STATUS = {0: "ok", 1: "bad request", 2: "out of range", 3: "busy",
+              4: "unknown command", 5: "queue full"}
+
+# SettingField indices for CMD_GET_CONFIG / CMD_SET_CONFIG
+SETTING_TEMP_LOW, SETTING_TEMP_HIGH, SETTING_HUM_LOW, SETTING_BLOWER_SEC, \
+    SETTING_PUMP_SEC, SETTING_ACTIVATION_MIN, SETTING_CAMERA_DELAY_SEC, \
+    SETTING_SEND_INTERVAL_MIN = range(8)
+
+TLM_SNAPSHOT     = struct.Struct("<I3h3hhhBBBBI")
+
+TLM_SAMPLES_HDR  = struct.Struct("<IIIB")    # boot_id, now_ms, first_seq, count
+TLM_SAMPLE       = struct.Struct("<I7hB")    # t_ms, temp[3], hum[3], o2, fill
+
+TLM_DOOR_LOADING = 2
+TLM_ACT_PUMP     = 0
+TLM_ACT_BLOWER   = 1
+
+
+def cobs_decode(data):
+    out = bytearray()
+    i = 0
+    while i < len(data):
+        code = data[i]
+        if code == 0 or i + code > len(data):
+            return None
+        out += data[i + 1:i + code]
+        i += code
+        if code < 0xFF and i < len(data):
+            out.append(0)
+    return bytes(out)
+
+
+def crc16_ccitt(data):
+    crc = 0xFFFF
+    for b in data:
+        crc ^= b << 8
+        for _ in range(8):
+            crc = ((crc << 1) ^ 0x1021) & 0xFFFF if crc & 0x8000 else (crc << 1) & 0xFFFF
+    return crc
+
+
+def parse_frame(chunk):
+    """Return (type, seq, payload) for a valid frame, else None."""
+    raw = cobs_decode(chunk)
+    if raw is None or len(raw) < 6:
+        return None
+    if struct.unpack_from("<H", raw, len(raw) - 2)[0] != crc16_ccitt(raw[:-2]):
+        return None
+    if raw[0] != TLM_VERSION:
+        print(f"Unsupported telemetry version {raw[0]}")
+        return None
+    seq = struct.unpack_from("<H", raw, 2)[0]
+    return raw[1], seq, raw[4:-2]
+
+
+def fixed(value, scale):
+    return None if value == TLM_NONE else value / scale
+
+
+def cobs_encode(data):
+    out = bytearray()
+    block = bytearray()
+    for b in data:
+        if b == 0:
+            out.append(len(block) + 1)
+            out += block
+            block = bytearray()
+        else:
+            block.append(b)
+            if len(block) == 0xFE:
+                out.append(0xFF)
+                out += block
+                block = bytearray()
+    out.append(len(block) + 1)
+    out += block
+    return bytes(out)
+
+
+tx_seq = 0
+tx_lock = threading.Lock()
+
+def send_frame(ser, msg_type, payload):
+    """Frame, COBS-encode and write one message to the Giga (thread-safe)."""
+    global tx_seq
+    with tx_lock:
+        raw = bytes([TLM_VERSION, msg_type]) + struct.pack("<H", tx_seq) + payload
+        raw += struct.pack("<H", crc16_ccitt(raw))
+        tx_seq = (tx_seq + 1) & 0xFFFF
+        ser.write(b"\x00" + cobs_encode(raw) + b"\x00")
+
+
+class CommandClient:
+    """Request/response calls to the Giga. The main loop owns the serial
+    reader and hands TLM_RESPONSE payloads to on_response(); call() may be
+    used from any other thread (e.g. fleet tooling)."""
+
+    def __init__(self, ser):
+        self.ser = ser
+        self.lock = threading.Lock()
+        self.next_id = 1
+        self.pending = {}
+
+    def call(self, cmd, args=b"", timeout=2.0):
+        """Send one command; returns (status, data) or None on timeout."""
+        with self.lock:
+            req_id = self.next_id
+            self.next_id = (self.next_id + 1) & 0xFFFF or 1
+            slot = self.pending[req_id] = {"event": threading.Event(), "reply": None}
+            send_frame(self.ser, cmd, struct.pack("<H", req_id) + args)
+        if not slot["event"].wait(timeout):
+            with self.lock:
+                self.pending.pop(req_id, None)
+            return None
+        return slot["reply"]
+
+    def on_response(self, payload):
+        if len(payload) < 4:
+            return
+        req_id, cmd, status = struct.unpack_from("<HBB", payload)
+        with self.lock:
+            slot = self.pending.pop(req_id, None)
+        if slot is None:
+            print(f"Unexpected response to command {cmd:#x} ({CMD_STATUS.get(status, status)})")
+            return
+        slot["reply"] = (status, payload[4:])
+        slot["event"].set()
+
+    def snapshot(self):
+        reply = self.call(CMD_GET_SNAPSHOT)
+        if reply is None or reply[0] != 0:
+            return None
+        v = TLM_SNAPSHOT.unpack(reply[1])
+        return {
+            "uptime_ms": v[0],
+            "sensor": [{"temp": fixed(v[1 + i], 10), "hum": fixed(v[4 + i], 10)} for i in range(3)],
+            "o2": fixed(v[7], 100),
+            "board_temp": fixed(v[8], 10),
+            "fill": v[9],
+            "switches": v[10],
+            "pump": bool(v[11]),
+            "blower_state": v[12],
+            "samples": v[13],
+        }
+
+    def history(self, window, metric, series=0, max_points=100):
+        reply = self.call(CMD_GET_HISTORY, bytes([window, metric, series, max_points]))
+        if reply is None or reply[0] != 0:
+            return None
+        count = reply[1][0]
+        return list(struct.unpack_from(f"<{count}h", reply[1], 1))
+
+    def get_config(self, field, index=0):
+        reply = self.call(CMD_GET_CONFIG, bytes([field, index]))
+        return struct.unpack("<f", reply[1])[0] if reply and reply[0] == 0 else None
+
+    def set_config(self, field, value, index=0):
+        """Returns the CommandStatus code (0 = applied), or None on timeout."""
+        reply = self.call(CMD_SET_CONFIG, bytes([field, index]) + struct.pack("<f", value))
+        return None if reply is None else reply[0]
+
+    def trigger(self, actuator):
+        reply = self.call(CMD_TRIGGER, bytes([actuator]))
+        return None if reply is None else reply[0]
+
+
+def load_tlm_state():
+    try:
+        with open(TLM_STATE_FILE) as f:
+            state = json.load(f)
+        return {"boot_id": int(state["boot_id"]), "next_seq": int(state["next_seq"])}
+    except (IOError, ValueError, KeyError):
+        return {"boot_id": None, "next_seq": 0}
+
+
+def save_tlm_state(state):
+    tmp = TLM_STATE_FILE + ".tmp"
+    with open(tmp, "w") as f:
+        json.dump(state, f)
+    os.replace(tmp, TLM_STATE_FILE)      # atomic, survives power loss
+
+
+def handle_samples(ser, payload, state, last_resend):
+    """Store/forward new samples from one TLM_SAMPLES frame, then ACK.
+    Returns the time of the last RESEND request."""
+    if len(payload) < TLM_SAMPLES_HDR.size:
+        return last_resend
+    boot_id, giga_now, first_seq, count = TLM_SAMPLES_HDR.unpack_from(payload)
+    if len(payload) != TLM_SAMPLES_HDR.size + count * TLM_SAMPLE.size:
+        print(f"Bad sample batch length {len(payload)}")
+        return last_resend
+
+    if boot_id != state["boot_id"]:
+        print(f"Giga restarted (boot {boot_id:08x}); sample numbering reset")
+        state["boot_id"] = boot_id
+        state["next_seq"] = 0
+    elif first_seq + count + GIGA_BACKLOG < state["next_seq"]:
+        print(f"Giga restarted (samples {first_seq}.. after {state['next_seq'] - 1}); "
+              "sample numbering reset")
+        state["next_seq"] = 0
+
+    if first_seq > state["next_seq"]:
+        # Gap: ask for everything from the first missing sample
+        if time.time() - last_resend >= RESEND_MIN_INTERVAL:
+            print(f"Missing samples {state['next_seq']}..{first_seq - 1}, requesting resend")
+            send_frame(ser, TLM_RESEND, struct.pack("<III", boot_id, state["next_seq"], 0xFFFFFFFF))
+            last_resend = time.time()
+        return last_resend
+
+    received = datetime.utcnow()
+    for i in range(count):
+        seq = first_seq + i
+        if seq < state["next_seq"]:
+            continue                     # already have it
+        v = TLM_SAMPLE.unpack_from(payload, TLM_SAMPLES_HDR.size + i * TLM_SAMPLE.size)
+        # Sample time from the Giga's uptime clock, relative to this frame
+        taken = received - timedelta(milliseconds=(giga_now - v[0]) & 0xFFFFFFFF)
+        # create JSON payload for Lambda
+        # sensor[0] IS ON TOP
+        reading = {
+            "deviceId": DEVICE_ID,
+            "timestamp": taken.isoformat() + "Z",
+            "seq": seq,
+            "sensor": [
+                {"temp": fixed(v[1], 10), "hum": fixed(v[4], 10)},
+                {"temp": fixed(v[2], 10), "hum": fixed(v[5], 10)},
+                {"temp": fixed(v[3], 10), "hum": fixed(v[6], 10)}
+            ],
+            "o2": fixed(v[7], 100),
+            "fill": v[8]
+        }
+        print(f"Data #{seq}: {reading['sensor']}, o2={reading['o2']}, fill={reading['fill']}")
+
+        # store payload
+        store_data(reading,"Readings")
+
+        # send to server
+        send_to_server(reading,"Readings")
+
+        state["next_seq"] = seq + 1
+
+    save_tlm_state(state)
+    send_frame(ser, TLM_ACK, struct.pack("<II", boot_id, state["next_seq"]))
+    return last_resend
+
 
 # ----------------------------------------------------------------------
 # Function: Initialize serial port for interfacing with Arduino Giga Wifi
@@ -277,122 +558,97 @@ def main():
     print("Init: time set to 5 seconds")
     # clear serial buffer
     ser.reset_input_buffer()
+    rx_buf = b""
+    last_seq = None
+    tlm_state = load_tlm_state()
+    global commands
+    commands = CommandClient(ser)
+    last_resend = 0.0
+    if tlm_state["boot_id"] is not None:
+        # Catch up on anything sampled while this script was down
+        send_frame(ser, TLM_RESEND, struct.pack("<III", tlm_state["boot_id"],
+                                                  tlm_state["next_seq"], 0xFFFFFFFF))
     try:
         while True:
             # line = input("Enter What you would like to do, Ctrl+C to quit: ")
             
             if ser.in_waiting > 0: # wait for serial buffer to be filled
-                line = ser.readline().decode('utf-8').strip()
-                print(f"\n\nRecieved: {line}\n")
-
-                if line.startswith("Data:"):
-                    data_str = line[5:]
-                    print(f"--Data--\nRemaining String: {data_str}")
-
-                    try:
-                        data = [float(x) for x in data_str.split(',')]
-                        if len(data) == 8:
-                            # create JSON payload for Lambda
-                            payload = {
-                                "deviceId": DEVICE_ID,
-                                "timestamp": datetime.utcnow().isoformat() + "Z",
-                                "sensor": [
-                                    {"temp": data[0], "hum": data[1]},
-                                    {"temp": data[2], "hum": data[3]},
-                                    {"temp": data[4], "hum": data[5]}
-                                ],
-                                "o2": data[6],
-                                "fill": data[7]
-                            }
-                            print(f"Data: {data[0]}, {data[1]}, {data[2]}, {data[3]}, {data[4]}, {data[5]}, {data[6]}, {data[7]}")
-                            
-                            # sensor[0] IS ON TOP
-                            # sensor[0]temp, sensor[0]hum, sensor[1]temp, sensor[1]hum, sensor[2]temp, sensor[2]hum, o2, fill
-                            # Data:1,2,3,4,5,6,7,8
-                            
-                            # store payload
-                            store_data(payload,"Readings")
-                            
-                            # send to server
-                            send_to_server(payload,"Readings")
-                            
-                        else:
-                            print("Error: Expected 8 floats")
-
-                    except ValueError:
-                        print("Error: Invalid float format")
-                    
-                elif line.startswith("Loaded"):
-                    payload = {
-                                "deviceId": DEVICE_ID,
-                                "timestamp": datetime.utcnow().isoformat() + "Z",
-                                "loaded": [
-                                    {"Status": True}
-                                ]
-                            }
-                            
-                    # store payload
-                    store_data(payload,"Loaded")
-                    
-                    # send to server
-                    send_to_server(payload,"Loaded")
-                    
-                    # start 3 min timer for picture
-                    handle_door_open()
-                        
-                elif line.startswith("Unloaded"):
+                rx_buf += ser.read(ser.in_waiting)
+                if len(rx_buf) > 4096 and b"\x00" not in rx_buf:
+                    rx_buf = rx_buf[-256:]     # only debug text; don't grow forever
+
+            # every zero byte ends a frame (or a run of debug text)
+            while b"\x00" in rx_buf:
+                chunk, _, rx_buf = rx_buf.partition(b"\x00")
+                if not chunk:
+                    continue
+
+                frame = parse_frame(chunk)
+                if frame is None:
+                    text = chunk.decode('utf-8', errors='replace').strip()
+                    if text:
+                        print(f"[giga] {text}")
+                    continue
+
+                msg_type, seq, payload = frame
+                if last_seq is not None and seq != (last_seq + 1) & 0xFFFF:
+                    print(f"Warning: {(seq - last_seq - 1) & 0xFFFF} frame(s) lost")
+                last_seq = seq
+
+                if msg_type == TLM_SAMPLES:
+                    last_resend = handle_samples(ser, payload, tlm_state, last_resend)
+
+                elif msg_type == TLM_RESPONSE:
+                    commands.on_response(payload)
+
+                elif msg_type == TLM_DOOR and len(payload) == 2:
+                    loaded = payload[1] == 1
+                    kind = "Loaded" if loaded else "Unloaded"
                     payload = {
                                 "deviceId": DEVICE_ID,
                                 "timestamp": datetime.utcnow().isoformat() + "Z",
-                                "unloaded": [
+                                kind.lower(): [
                                     {"Status": True}
                                 ]
                             }
-                            
+
                     # store payload
-                    store_data(payload,"Unloaded")
-                    
+                    store_data(payload,kind)
+
                     # send to server
-                    send_to_server(payload,"Unloaded")
-                    
+                    send_to_server(payload,kind)
+
                     # start 3 min timer for picture
                     handle_door_open()
-                    
-                elif line.startswith("Delay:"):
-                    delay = float(line[6:])
+
+                elif msg_type == TLM_CAMERA_DELAY and len(payload) == 2:
+                    delay = float(struct.unpack("<H", payload)[0])
                     print(f"Camera delay changed to {delay} seconds")
-                    
-                elif line.startswith("Blower:"):
-                    print("Blowers Activated!")
-                    payload = {
-                                "deviceId": DEVICE_ID,
-                                "timestamp": datetime.utcnow().isoformat() + "Z",
-                                "blower": [
-                                    {"Status": True}
-                                ]
-                            }
-                    # store payload
-                    store_data(payload,"Blowers")        
-                    
-                    # send payload
-                    send_to_server(payload,"Blowers")
-                    
-                elif line.startswith("Pump:"):
-                    print("Pump Activated!")
+
+                elif msg_type == TLM_ACTUATOR and len(payload) == 1:
+                    if payload[0] == TLM_ACT_BLOWER:
+                        print("Blowers Activated!")
+                        kind, key = "Blowers", "blower"
+                    else:
+                        print("Pump Activated!")
+                        kind, key = "Pump", "pump"
                     payload = {
                                 "deviceId": DEVICE_ID,
                                 "timestamp": datetime.utcnow().isoformat() + "Z",
-                                "pump": [
+                                key: [
                                     {"Status": True}
                                 ]
                             }
-                    
+
                     # store payload
-                    store_data(payload,"Pump")        
-                    
+                    store_data(payload,kind)
+
                     # send payload
-                    send_to_server(payload,"Pump")
-                    
+                    send_to_server(payload,kind)
+
+                else:
+                    print(f"Unknown frame type {msg_type} ({len(payload)} bytes)")
+
             time.sleep(0.005)     # avoid overloading
 
     except KeyboardInterrupt:
@@ -4,22 +4,22 @@
  * @date   May 10, 2025
  * @brief  Header file for the GVSU logo image used in the UI.
  *
- * This file declares the GVSU logo image for use with LVGL.
- * It provides an external declaration for the image symbol,
- * allowing it to be used in the UI components.
+ * The logo is stored palette + PackBits compressed (see packed_image.h and
+ * tools/pack_image.py). Use packed_image_decode(&GVSU_Logo_packed) to get
+ * an LVGL image descriptor; the first call decodes it into SDRAM.
  ******************************************************************************/
 
 #ifndef GVSU_LOGO_H
 #define GVSU_LOGO_H
 
+#include "packed_image.h"
+
 #ifdef __cplusplus
 extern "C" {
 #endif
 
-#include "lvgl.h"
-
-// External declaration for LVGL to find the image symbol
-LV_IMG_DECLARE(GVSU_Logo);
+// Compressed logo (400x304 RGB565)
+extern const packed_image_t GVSU_Logo_packed;
 
 #ifdef __cplusplus
 }
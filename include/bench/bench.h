@@ -0,0 +1,46 @@
+/******************************************************************************
+ * @file    bench.h
+ * @author  Thomas Zoldowski
+ * @date    October 18, 2026
+ * @brief   Microbenchmarks of the firmware's hot paths.
+ *
+ * Each case runs a warm-up pass and BENCH_REPS timed repetitions; the
+ * fastest repetition is reported, since anything slower only measured
+ * interrupts, other threads or cache misses from elsewhere. Results are
+ * one line per case, on DebugSerial on the board and stdout on a host:
+ *
+ *   BENCH: fill_filter iters=20000 ns/op=38.4 cycles/op=18.4
+ *
+ * cycles/op is only printed on the board (DWT CYCCNT, cycle_counter.h);
+ * host builds time with a nanosecond clock. tools/bench_compare.py checks
+ * the lines against tools/bench_baseline.json.
+ *
+ *   Host:  pio run -e bench && .pio/build/bench/program
+ *   Board: pio run -e giga_r1_m7_bench -t upload, results at the end of boot
+ *
+ * Cases that draw widgets (format_warnings, add_warning) only exist on
+ * the board; the host has no LVGL.
+ ******************************************************************************/
+#ifndef BENCH_BENCH_H
+#define BENCH_BENCH_H
+
+#include <cstdint>
+#include "hal.h"
+
+#define BENCH_REPS   5
+
+/**
+ * @brief Run every case whose name contains @p filter (nullptr = all).
+ * @param between Called between repetitions, e.g. a watchdog check-in; may be nullptr.
+ * @return Number of cases run.
+ */
+int bench_run(const char *filter, void (*between)());
+
+#if HAL_SIM
+#include <cstdio>
+
+/** Where host runs print results (stdout by default). */
+void bench_set_output(FILE *f);
+#endif
+
+#endif // BENCH_BENCH_H
@@ -17,6 +17,12 @@
 
 // ======= SIMULATION MODE =======
 #define SIMULATION_MODE    0   // Set to 1 to enable fake sensor data; 0 = real sensors
+// (display only; the native env runs the real logic on a simulated batch, see src/sim/main_sim.cpp)
+
+// ======= BENCHMARKS (see bench/bench.h) =======
+#ifndef BENCH_ON_BOOT
+#define BENCH_ON_BOOT      0   // 1 = run the microbenchmarks at the end of setup() (env:giga_r1_m7_bench)
+#endif
 
 // Sensor thresholds (adjust as needed)
 #define TEMP_GOOD_MIN     15.0
@@ -28,9 +34,16 @@
 
 // Sensor polling interval (milliseconds)
 #define SENSOR_UPDATE_INTERVAL_MS 1000
+#define SENSOR_SNAPSHOT_SLOTS     4      // Published readings kept (power of two, see snapshot_ring.h)
 
 // Inactivity timeout (milliseconds)
-#define INACTIVITY_TIMEOUT_MS 2400000  // 20 sec
+#define INACTIVITY_TIMEOUT_MS 2400000  // 40 min, then back to Home
+
+// Display power stages (milliseconds without touch)
+#define DISPLAY_DIM_TIMEOUT_MS    120000   // 2 min  -> dim backlight
+#define DISPLAY_OFF_TIMEOUT_MS    600000   // 10 min -> backlight off, rendering suspended
+#define DISPLAY_BRIGHTNESS_FULL   100      // percent
+#define DISPLAY_BRIGHTNESS_DIM    20       // percent
 
 // ========== I2C MUX AND SENSOR ARRAY ==========
 #define I2C_MUX_ADDR        0x70  // TCA9548A default I2C address
@@ -60,4 +73,96 @@
 #define SENSOR_UPDATE_INTERVAL_MS   1000
 #define SCREEN_REFRESH_INTERVAL_MS  500
 
+// ========== IDLE / RENDER-ON-DEMAND ==========
+#define TOUCH_IRQ_PIN          PI_1   // GT911 INT line on the GIGA Display Shield
+#define IDLE_MAX_SLEEP_MS      250    // Longest single idle park (watchdog is 2 s)
+#define TOUCH_POLL_ACTIVE_MS   30     // Touch read period while the panel is in use
+#define TOUCH_POLL_IDLE_MS     200    // Fallback touch poll once idle (IRQ wakes sooner)
+#define TOUCH_IDLE_AFTER_MS    2000   // No touch for this long -> slow touch polling
+
+// ========== SERIAL TX BUFFERING ==========
+#define SERIAL_TX_TLM_BUF      4096   // Telemetry frames (never displaced by debug)
+#define SERIAL_TX_DBG_BUF      4096   // Debug text (oldest lines dropped when full)
+#define SERIAL_TX_CHUNK        256    // Bytes handed to Serial.write() per call
+
+// ========== TELEMETRY BATCHING (see telemetry.h) ==========
+#define TELEMETRY_BACKLOG          360     // Samples kept until the Pi ACKs them
+#define TELEMETRY_BATCH_SAMPLES    6       // Send a batch once this many samples wait...
+#define TELEMETRY_BATCH_MAX_AGE_MS 60000   // ...or the oldest waiting one is this old
+#define TELEMETRY_BATCH_MAX        11      // Samples per TLM_SAMPLES frame (payload limit)
+#define TELEMETRY_ACK_TIMEOUT_MS   30000   // Resend unacknowledged samples after this
+#define TELEMETRY_FRAMES_PER_POLL  2       // Frames queued per loop() pass during backfill
+
+// ========== WI-FI UPLOADER (see network_manager.h) ==========
+#ifndef NET_UPLOAD_ENABLED
+#define NET_UPLOAD_ENABLED     0       // 1 = the GIGA uploads readings over its own Wi-Fi
+#endif
+#define NET_TRANSPORT_HTTP     0
+#define NET_TRANSPORT_MQTT     1
+#ifndef NET_TRANSPORT
+#define NET_TRANSPORT          NET_TRANSPORT_MQTT
+#endif
+#define NET_UPLOAD_INTERVAL_MS 60000   // Readings queued for upload this often
+#define NET_QUEUE_LEN          16      // Readings held in RAM (new ones dropped when full)
+#define NET_BODY_MAX           384     // HTTP: JSON body buffer
+#define NET_LINE_MAX           128     // Longest response line kept (rest skipped)
+#define NET_CONNECT_TIMEOUT_MS 10000   // TCP connect + TLS handshake
+#define NET_RESPONSE_TIMEOUT_MS 5000   // HTTP response, or MQTT CONNACK/PUBACK wait
+#define NET_IDLE_CLOSE_MS      90000   // HTTP: close the kept-alive connection after this idle
+#define NET_RETRY_MIN_MS       2000    // Backoff after a failed upload...
+#define NET_RETRY_MAX_MS       60000   // ...doubling up to this
+#define NET_MQTT_KEEPALIVE_S   60      // MQTT keep-alive (PINGREQ at half of it when idle)
+#define NET_MQTT_BATCH         8       // Readings per PUBLISH (several wait after an outage)
+#define NET_MQTT_INFLIGHT      4       // PUBLISHes awaiting PUBACK at once
+#define NET_MQTT_PAYLOAD_MAX   1536    // Batch payload buffer
+#define NET_SPOOL_MAX_RECORDS  10080   // LittleFS spool: a week of readings (~315 KB)
+
+// ========== DUAL CORE (see core_link.h) ==========
+#ifndef CORE_SPLIT
+#define CORE_SPLIT             0       // 1 = sensors and actuators run on the M4 (split envs)
+#endif
+#define CORE_LINK_STALE_MS     3000    // M4 counted as stopped after this without a publish
+#define CORE_M4_SWITCH_MS      250     // M4: limit switch poll period
+#define CORE_M4_PUBLISH_MS     250     // M4: snapshot refresh even when nothing else ran
+
+// ========== FIELD TRACE (see logic/trace.h) ==========
+#ifndef TRACE_ENABLED
+#define TRACE_ENABLED          (!CORE_SPLIT)   // the M4 sees the raw data but has no filesystem
+#endif
+#define TRACE_SINK_FS          0x01    // rotating files on LittleFS
+#define TRACE_SINK_PI          0x02    // TLM_TRACE frames to the Pi
+#ifndef TRACE_SINKS
+#define TRACE_SINKS            TRACE_SINK_FS
+#endif
+#define TRACE_RING_BYTES       4096    // RAM between flushes (power of two)
+#define TRACE_FLUSH_BYTES      2048    // Flush once this much waits...
+#define TRACE_FLUSH_MS         60000   // ...or this long after the last flush
+#define TRACE_FILE_BYTES       1048576 // Per file; two files alternate (8 h or more each at a pass per second)
+#define TRACE_STATE_PASSES     600     // Sensor passes between TRACE_STATE sync points
+
+// ========== THREADS AND WATCHDOG (see supervisor.h) ==========
+// Priorities: actuator control > supervisor > acquisition > UI (loop()).
+#define WATCHDOG_TIMEOUT_MS      2000   // Reset if the supervisor stops kicking
+#define SUPERVISOR_PERIOD_MS     250    // Check-ins are verified this often
+#define ACTUATOR_CHECK_MS        1000   // Control thread: schedule re-checked at least this often
+#define ACTUATOR_LATE_WARN_MS    10     // Pulse off its set length by more than this is logged as a warning
+#define LIMIT_SWITCH_INTERVAL_MS 250    // Acquisition thread: limit switch poll period
+#define CONTROL_MAX_SILENCE_MS   1500   // Longest gap between check-ins before a reset...
+#define ACQ_MAX_SILENCE_MS       2000   // ...a sensor pass can block on I2C timeouts
+#define UI_MAX_SILENCE_MS        2000   // ...a full-screen redraw plus an idle park
+
+// ========== LOGGING (see log.h) ==========
+// Calls above a module's level are compiled out entirely.
+#define LOG_LEVEL_DEFAULT      LOG_LEVEL_INFO
+#define LOG_LEVEL_MAIN         LOG_LEVEL_INFO
+#define LOG_LEVEL_UI           LOG_LEVEL_WARN    // screen/nav chatter
+#define LOG_LEVEL_SENSOR       LOG_LEVEL_INFO
+#define LOG_LEVEL_ACTUATOR     LOG_LEVEL_INFO
+#define LOG_LEVEL_STORAGE      LOG_LEVEL_INFO
+#define LOG_LEVEL_DISPLAY      LOG_LEVEL_INFO
+#define LOG_LEVEL_NETWORK      LOG_LEVEL_INFO
+#define LOG_LEVEL_CORE         LOG_LEVEL_INFO
+#define LOG_LEVEL_SUPERVISOR   LOG_LEVEL_INFO
+#define LOG_RING_RECORDS       64     // Records kept for log_dump()
+
 #endif /* CONFIG_H_ */
@@ -0,0 +1,58 @@
+/******************************************************************************
+ * @file    cycle_counter.h
+ * @author  Thomas Zoldowski
+ * @date    October 18, 2026
+ * @brief   CPU cycle counter for timing short code paths.
+ *
+ * On the GIGA's Cortex-M7 and M4 this is the DWT cycle counter (CYCCNT),
+ * which counts core clocks with no overhead beyond the register read. It
+ * wraps after 2^32 cycles (~8.9 s at 480 MHz), so only time paths that are
+ * much shorter than that. Elsewhere (host builds) a nanosecond clock
+ * stands in and cycles_to_ns() is the identity.
+ *
+ *   uint32_t c0 = cycle_count();
+ *   work();
+ *   uint32_t spent = cycle_count() - c0;
+ ******************************************************************************/
+#ifndef CYCLE_COUNTER_H
+#define CYCLE_COUNTER_H
+
+#include <cstdint>
+
+#if defined(__arm__)
+#include <mbed.h>
+
+/** Enable the counter. Harmless to call more than once. */
+static inline void cycle_counter_init() {
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+#if defined(CORE_CM7)
+    DWT->LAR = 0xC5ACCE55;              // M7: unlock the DWT registers
+#endif
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+}
+
+static inline uint32_t cycle_count() {
+    return DWT->CYCCNT;
+}
+
+static inline uint32_t cycles_to_ns(uint32_t cycles) {
+    return (uint32_t)((uint64_t)cycles * 1000000000ULL / SystemCoreClock);
+}
+
+#else
+#include <chrono>
+
+static inline void cycle_counter_init() {
+}
+
+static inline uint32_t cycle_count() {
+    using namespace std::chrono;
+    return (uint32_t)duration_cast<nanoseconds>(steady_clock::now().time_since_epoch()).count();
+}
+
+static inline uint32_t cycles_to_ns(uint32_t cycles) {
+    return cycles;
+}
+#endif
+
+#endif // CYCLE_COUNTER_H
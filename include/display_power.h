@@ -0,0 +1,42 @@
+/******************************************************************************
+ * @file    display_power.h
+ * @author  Thomas Zoldowski
+ * @date    October 18, 2026
+ * @brief   Staged inactivity handling for the GIGA Display Shield.
+ *
+ * After DISPLAY_DIM_TIMEOUT_MS without input the backlight is dimmed, after
+ * DISPLAY_OFF_TIMEOUT_MS it is switched off and LVGL invalidation/rendering
+ * is suspended. Any touch wakes the panel again. Sensor and actuator work in
+ * loop() is not affected.
+ ******************************************************************************/
+
+#ifndef DISPLAY_POWER_H
+#define DISPLAY_POWER_H
+
+#include <stdint.h>
+
+enum DisplayPowerState {
+    DISPLAY_AWAKE,
+    DISPLAY_DIMMED,
+    DISPLAY_OFF
+};
+
+/** Start the backlight driver at full brightness. Call after Display.begin(). */
+void display_power_init();
+
+/** Step the dim/off stages. Call every loop() pass. */
+void display_power_update(uint32_t now, uint32_t last_input_ms);
+
+/**
+ * Restore full brightness and rendering.
+ * @return true if the panel was off (the waking touch should be swallowed).
+ */
+bool display_power_wake();
+
+/** Current stage. */
+DisplayPowerState display_power_state();
+
+/** False while the panel is off; screen refreshes can be skipped. */
+bool display_power_is_rendering();
+
+#endif /* DISPLAY_POWER_H */
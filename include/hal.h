@@ -0,0 +1,114 @@
+/******************************************************************************
+ * @file    hal.h
+ * @author  Thomas Zoldowski
+ * @date    October 18, 2026
+ * @brief   Hardware abstraction for the sensing, control and storage logic.
+ *
+ * sensor_manager, actuator_manager and settings_storage reach the board
+ * only through these calls, so the same sources build for:
+ *
+ *   the GIGA      hal_giga.cpp: Wire, Arduino GPIO, Mbed timers, LittleFS
+ *                 mounted at /user
+ *   a Linux host  HAL_SIM=1 (env:native), src/sim/: a virtual clock, GPIO
+ *                 array and I2C bus with simulated devices (sim/sim_bus.h)
+ *
+ * On the host time only moves when the logic waits (hal_delay_ms(), bus
+ * transfers) or the simulation advances it, so hours of operation run in
+ * milliseconds and every run is repeatable.
+ ******************************************************************************/
+#ifndef HAL_H
+#define HAL_H
+
+#include <cstddef>
+#include <cstdint>
+
+#ifndef HAL_SIM
+#define HAL_SIM 0
+#endif
+
+#if HAL_SIM
+#define HAL_D(n) (n)                     // digital pin n
+#else
+#include <Arduino.h>
+#include <mbed.h>
+#define HAL_D(n) D##n
+#endif
+
+// ========== I2C ==========
+// Results of hal_i2c_write(), as Wire.endTransmission() returns them
+#define HAL_I2C_OK         0
+#define HAL_I2C_ADDR_NACK  2
+#define HAL_I2C_DATA_NACK  3
+#define HAL_I2C_TIMEOUT    5
+
+/** Start the bus. */
+void hal_i2c_begin();
+
+/**
+ * Write len bytes to a 7-bit address (len 0 only probes it). With
+ * stop = false the bus is held for a repeated-start read.
+ * @return HAL_I2C_OK or one of the error codes above.
+ */
+uint8_t hal_i2c_write(uint8_t addr, const uint8_t *data, size_t len, bool stop = true);
+
+/** Read up to len bytes. @return Bytes received (0 if nothing answered). */
+size_t hal_i2c_read(uint8_t addr, uint8_t *data, size_t len);
+
+/** True if something acknowledges the address. */
+static inline bool hal_i2c_probe(uint8_t addr) {
+    return hal_i2c_write(addr, nullptr, 0) == HAL_I2C_OK;
+}
+
+// ========== GPIO ==========
+enum HalPinMode : uint8_t { HAL_INPUT, HAL_OUTPUT };
+
+void hal_pin_mode(uint8_t pin, HalPinMode mode);
+void hal_pin_write(uint8_t pin, bool high);   // ISR-safe
+bool hal_pin_read(uint8_t pin);
+
+// ========== CLOCK ==========
+uint32_t hal_millis();                  // since boot
+uint64_t hal_micros();                  // since boot; ISR-safe
+uint32_t hal_epoch();                   // wall clock, seconds since 1970
+void     hal_delay_ms(uint32_t ms);     // blocks the calling thread
+
+/** 32 random bits: the STM32H7's RNG on the board, the run's seed on the host. */
+uint32_t hal_random32();
+
+// One-shot timer; the callback runs in interrupt context on the board
+#if HAL_SIM
+typedef struct HalTimeout {
+    void      (*fn)(void *);
+    void       *arg;
+    uint64_t    due_us;
+    bool        armed;
+    HalTimeout *next;                   // pending list, sim/hal_sim.cpp
+} HalTimeout;
+#else
+typedef mbed::Timeout HalTimeout;
+#endif
+
+/** Call fn(arg) once, ms from now; re-arming replaces a pending call. ISR-safe. */
+void hal_timeout_start(HalTimeout &t, void (*fn)(void *), void *arg, uint32_t ms);
+
+/** Cancel a pending call. */
+void hal_timeout_stop(HalTimeout &t);
+
+// Interrupts masked between enter and exit (calls nest); keep it to a few
+// hundred cycles. ISR-safe. A host has no interrupts, so both do nothing.
+void hal_critical_enter();
+void hal_critical_exit();
+
+// ========== FILESYSTEM ==========
+// Paths are absolute on the board's LittleFS ("/user/config.bin").
+
+/** @return True if the file exists and exactly len bytes were read. */
+bool hal_fs_read(const char *path, void *buf, size_t len);
+
+/** Create or replace the file. @return True if all len bytes were written. */
+bool hal_fs_write(const char *path, const void *buf, size_t len);
+
+/** Add to the end of the file, creating it. @return True if all len bytes were written. */
+bool hal_fs_append(const char *path, const void *buf, size_t len);
+
+#endif // HAL_H
@@ -0,0 +1,79 @@
+/******************************************************************************
+ * @file    json_writer.h
+ * @author  Thomas Zoldowski
+ * @date    October 18, 2026
+ * @brief   Streaming JSON encoder into a caller-supplied buffer.
+ *
+ * Values are encoded straight into the buffer, with commas and nesting
+ * tracked by the writer, and nothing is ever allocated. When the buffer fills
+ * the optional flush callback receives the bytes so far (e.g. to write them
+ * to a socket) and encoding continues from the start of the buffer. Without
+ * a callback, output that does not fit marks the writer as failed.
+ *
+ * Floats are printed in fixed point by the writer itself rather than through
+ * printf (newlib's float formatting allocates). NaN and infinity, which this
+ * firmware uses for "sensor missing", are written as null.
+ *
+ *   JsonWriter w;
+ *   json_init(w, buf, sizeof(buf));
+ *   json_begin_object(w);
+ *   json_key(w, "temp"); json_float(w, tempF, 1);
+ *   json_end_object(w);
+ *   if (json_finish(w)) send(buf, json_length(w));
+ ******************************************************************************/
+#ifndef JSON_WRITER_H
+#define JSON_WRITER_H
+
+#include <cstdint>
+#include <cstddef>
+
+#define JSON_MAX_DEPTH      16   // nested objects/arrays
+#define JSON_MAX_DECIMALS   6
+
+// Receives a full buffer; return false to abort encoding
+typedef bool (*JsonFlushFn)(void *ctx, const char *data, size_t len);
+
+typedef struct {
+    char       *buf;
+    size_t      size;
+    size_t      len;        // bytes in buf not yet flushed
+    size_t      total;      // bytes produced since json_init()
+    JsonFlushFn flush;
+    void       *ctx;
+    uint16_t    has_items;  // bit d: container at depth d already has an element
+    uint8_t     depth;
+    bool        after_key;  // next value belongs to the key just written
+    bool        failed;     // overflow, flush error or nesting error
+} JsonWriter;
+
+/** Start a document in buf. flush may be nullptr (output must then fit). */
+void json_init(JsonWriter &w, char *buf, size_t size,
+               JsonFlushFn flush = nullptr, void *ctx = nullptr);
+
+void json_begin_object(JsonWriter &w);
+void json_end_object(JsonWriter &w);
+void json_begin_array(JsonWriter &w);
+void json_end_array(JsonWriter &w);
+
+/** Member name inside an object; the next call writes its value. */
+void json_key(JsonWriter &w, const char *key);
+
+void json_string(JsonWriter &w, const char *s);      // nullptr -> null
+void json_int(JsonWriter &w, int32_t v);
+void json_uint(JsonWriter &w, uint32_t v);
+void json_bool(JsonWriter &w, bool v);
+void json_null(JsonWriter &w);
+
+/** Fixed-point number with the given decimals; NaN, infinity and |v| >= 1e9 -> null. */
+void json_float(JsonWriter &w, float v, uint8_t decimals);
+
+/**
+ * Flush whatever is left in the buffer (if a flush callback was given).
+ * @return False if the document is incomplete, overflowed or a flush failed.
+ */
+bool json_finish(JsonWriter &w);
+
+/** Bytes currently held in the buffer (the whole document without a flush callback). */
+inline size_t json_length(const JsonWriter &w) { return w.len; }
+
+#endif // JSON_WRITER_H
@@ -0,0 +1,155 @@
+/******************************************************************************
+ * @file    log.h
+ * @author  Thomas Zoldowski
+ * @date    October 18, 2026
+ * @brief   Leveled debug logging with compile-time filtering and deferred
+ *          formatting.
+ *
+ * Usage in a source file:
+ *
+ *   #define LOG_TAG    "UI"
+ *   #define LOG_LEVEL  LOG_LEVEL_UI      // per-module level from config.h
+ *   #include "log.h"
+ *
+ *   LOG_I("Selected %s (index %d)", label, idx);
+ *
+ * Calls above the module's level expand to nothing, so their arguments are
+ * not even evaluated. Enabled calls only copy the format pointer and the
+ * raw arguments into a binary record ring; the text is formatted later by
+ * the serial TX drain thread. Format strings must be string literals;
+ * %s arguments are copied (truncated to LOG_STR_BYTES in total).
+ *
+ * The ring keeps the last LOG_RING_RECORDS records, which log_dump() can
+ * re-print on demand (the Pi asks with TLM_CMD_DUMP_LOG, see
+ * command_channel.h). Not ISR-safe.
+ ******************************************************************************/
+
+#ifndef LOG_H
+#define LOG_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+#define LOG_LEVEL_NONE   0
+#define LOG_LEVEL_ERROR  1
+#define LOG_LEVEL_WARN   2
+#define LOG_LEVEL_INFO   3
+#define LOG_LEVEL_DEBUG  4
+
+#include "config.h"
+
+#define LOG_MAX_ARGS     6
+#define LOG_STR_BYTES    32
+
+enum LogArgType : uint8_t {
+    LOG_ARG_I32,
+    LOG_ARG_U32,
+    LOG_ARG_I64,
+    LOG_ARG_U64,
+    LOG_ARG_F64,
+    LOG_ARG_STR,   // value is an offset into strs[]
+    LOG_ARG_PTR,
+};
+
+typedef struct {
+    uint32_t    ts_ms;
+    const char *tag;
+    const char *fmt;
+    uint8_t     level;
+    uint8_t     nargs;
+    uint8_t     str_used;
+    uint8_t     types[LOG_MAX_ARGS];
+    union {
+        int32_t     i32;
+        uint32_t    u32;
+        int64_t     i64;
+        uint64_t    u64;
+        double      f64;
+        const void *ptr;
+        uint8_t     str;
+    } args[LOG_MAX_ARGS];
+    char        strs[LOG_STR_BYTES];
+} LogRecord;
+
+/** Fill in the header of a record (timestamp, level, tag, format). */
+void log_begin(LogRecord &r, uint8_t level, const char *tag, const char *fmt);
+
+/** Append the record to the ring and wake the drain thread. */
+void log_commit(const LogRecord &r);
+
+/** Format records not yet printed into DebugSerial. Called by the TX drain thread. */
+void log_drain();
+
+/** Re-print every record still held in the ring, after a line with log_dropped(). */
+void log_dump();
+
+/** Records overwritten before they could be printed. */
+uint32_t log_dropped();
+
+// ---- argument capture (one overload per argument class) ----
+void log_arg(LogRecord &r, const char *s);
+
+/** Claim the next argument slot; extra arguments are ignored. */
+static inline bool log_slot(LogRecord &r, LogArgType t) {
+    if (r.nargs >= LOG_MAX_ARGS) return false;
+    r.types[r.nargs] = t;
+    return true;
+}
+static inline void log_arg(LogRecord &r, int v)                { if (log_slot(r, LOG_ARG_I32)) r.args[r.nargs++].i32 = v; }
+static inline void log_arg(LogRecord &r, unsigned v)           { if (log_slot(r, LOG_ARG_U32)) r.args[r.nargs++].u32 = v; }
+static inline void log_arg(LogRecord &r, long v)               { if (log_slot(r, LOG_ARG_I64)) r.args[r.nargs++].i64 = v; }
+static inline void log_arg(LogRecord &r, unsigned long v)      { if (log_slot(r, LOG_ARG_U64)) r.args[r.nargs++].u64 = v; }
+static inline void log_arg(LogRecord &r, long long v)          { if (log_slot(r, LOG_ARG_I64)) r.args[r.nargs++].i64 = v; }
+static inline void log_arg(LogRecord &r, unsigned long long v) { if (log_slot(r, LOG_ARG_U64)) r.args[r.nargs++].u64 = v; }
+static inline void log_arg(LogRecord &r, double v)             { if (log_slot(r, LOG_ARG_F64)) r.args[r.nargs++].f64 = v; }
+static inline void log_arg(LogRecord &r, const void *p)        { if (log_slot(r, LOG_ARG_PTR)) r.args[r.nargs++].ptr = p; }
+static inline void log_arg(LogRecord &r, char *s)              { log_arg(r, (const char *)s); }
+
+static inline void log_args(LogRecord &r) { (void)r; }
+template <typename T, typename... Rest>
+static inline void log_args(LogRecord &r, T first, Rest... rest) {
+    log_arg(r, first);
+    log_args(r, rest...);
+}
+
+template <typename... Args>
+static inline void log_write(uint8_t level, const char *tag, const char *fmt, Args... args) {
+    LogRecord r;
+    log_begin(r, level, tag, fmt);
+    log_args(r, args...);
+    log_commit(r);
+}
+
+// ---- per-module macros ----
+#ifndef LOG_TAG
+#define LOG_TAG "APP"
+#endif
+#ifndef LOG_LEVEL
+#define LOG_LEVEL LOG_LEVEL_DEFAULT
+#endif
+
+#if LOG_LEVEL >= LOG_LEVEL_ERROR
+#define LOG_E(fmt, ...) log_write(LOG_LEVEL_ERROR, LOG_TAG, fmt, ##__VA_ARGS__)
+#else
+#define LOG_E(fmt, ...) do { } while (0)
+#endif
+
+#if LOG_LEVEL >= LOG_LEVEL_WARN
+#define LOG_W(fmt, ...) log_write(LOG_LEVEL_WARN, LOG_TAG, fmt, ##__VA_ARGS__)
+#else
+#define LOG_W(fmt, ...) do { } while (0)
+#endif
+
+#if LOG_LEVEL >= LOG_LEVEL_INFO
+#define LOG_I(fmt, ...) log_write(LOG_LEVEL_INFO, LOG_TAG, fmt, ##__VA_ARGS__)
+#else
+#define LOG_I(fmt, ...) do { } while (0)
+#endif
+
+#if LOG_LEVEL >= LOG_LEVEL_DEBUG
+#define LOG_D(fmt, ...) log_write(LOG_LEVEL_DEBUG, LOG_TAG, fmt, ##__VA_ARGS__)
+#else
+#define LOG_D(fmt, ...) do { } while (0)
+#endif
+
+#endif /* LOG_H */
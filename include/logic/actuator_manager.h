@@ -3,34 +3,76 @@
  * @author  Thomas Zoldowski
  * @date    May 19, 2025
  * @brief   Declarations for controlling compost actuators.
+ *
+ * Actuators are table driven (see actuator_manager.cpp):
+ *
+ *   outputs   SSR pins, one per ActuatorOutput
+ *   programs  a sequence of timed steps (output on for a setting or a
+ *             fixed time, or a pause), the programs it may not overlap
+ *             (interlock), and trigger predicates, each with its own
+ *             rearm interval since the program last started
+ *
+ * Adding an actuator means an ActuatorOutput / ActuatorProgram entry here
+ * and a row in each table; the engine and the UI read them generically.
  ******************************************************************************/
 #ifndef LOGIC_ACTUATOR_MANAGER_H
 #define LOGIC_ACTUATOR_MANAGER_H
 
 #include <cstdint>
 
-void LED_Init();
+#define ACT_MAX_STEPS 4   // steps per program
 
-void LED_On();
+// SSR outputs (bit i of actuator_outputs())
+enum ActuatorOutput : uint8_t {
+    ACT_OUT_PUMP,
+    ACT_OUT_BLOWER1,
+    ACT_OUT_BLOWER2,
+    ACT_OUT_COUNT,
+    ACT_OUT_NONE = 0xFF,   // a step that only waits
+};
 
-void LED_Off();
-
-/** @brief  Updates the LED status based on security state.
-*         Call this periodically to reflect the current security status.
-*/
-void LED_Update();
+// Programs; ids match TelemetryActuator
+enum ActuatorProgram : uint8_t {
+    ACT_PUMP,
+    ACT_BLOWERS,
+    ACT_PROGRAM_COUNT,
+};
 
 /** @brief  Initializes the actuator scheduler.
-*         Call this once in setup() to configure pins
-*         and prepare the scheduler for use.
+*         Call this once in setup() to configure pins and start the
+*         control thread ("act_ctl", osPriorityRealtime). It evaluates the
+*         trigger table; the steps themselves are timed by timer callbacks.
 */
 void initActuatorScheduler();
 
-/** @brief  Call this every loop() to manage pump and blower states.
-*         It will activate the pump and blowers based on the configured intervals.
+/** @brief  One pass of the control thread: log finished steps, evaluate the
+*         triggers. A host simulation (HAL_SIM) has no thread and calls it.
 */
-void scheduleHourlyActuators();
+void actuator_control_pass();
+
+/** @brief  Save trigger times the control thread recorded.
+*         Call from loop(); keeps flash writes off the control thread.
+*/
+void actuator_save_pending();
+
+/** @brief  Start a program immediately (remote command). Safe from any thread.
+*         Returns false if it is running or an interlocked program is.
+*/
+bool actuator_trigger(ActuatorProgram id);
+
+/** @brief  0 while idle, else the 1-based step the program is in. */
+uint8_t actuator_step(ActuatorProgram id);
+
+/** @brief  Outputs switched on right now, bit per ActuatorOutput. */
+uint8_t actuator_outputs();
+
+/** @brief  The SSR pin an output drives (host tools watch it with sim_pin_on_write()). */
+uint8_t actuator_output_pin(ActuatorOutput o);
 
-void ActuatorStatusToSerial();
+// Pump and blower shorthands used by the command channel and telemetry
+static inline bool actuator_trigger_pump()     { return actuator_trigger(ACT_PUMP); }
+static inline bool actuator_trigger_blowers()  { return actuator_trigger(ACT_BLOWERS); }
+static inline bool actuator_pump_active()      { return actuator_step(ACT_PUMP) != 0; }
+static inline uint8_t actuator_blower_state()  { return actuator_step(ACT_BLOWERS); }   // 0 idle, 1 blower 1, 2 pause, 3 blower 2
 
 #endif // LOGIC_ACTUATOR_MANAGER_H
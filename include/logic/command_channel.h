@@ -0,0 +1,82 @@
+/******************************************************************************
+ * @file    command_channel.h
+ * @author  Thomas Zoldowski
+ * @date    October 18, 2026
+ * @brief   Request/response commands from the Raspberry Pi over USB serial.
+ *
+ * Requests use the same COBS/CRC framing as telemetry (see telemetry.h).
+ * Every request payload starts with a uint16 req_id, which is echoed in
+ * the TLM_RESPONSE frame:
+ *
+ *   | req_id (2) | cmd (1) | status (CommandStatus, 1) | data |
+ *
+ * Commands (multi-byte fields little-endian):
+ *   TLM_CMD_GET_SNAPSHOT  -                       -> CommandSnapshot (packed)
+ *   TLM_CMD_GET_HISTORY   window, metric, series, max_points (uint8 each)
+ *                                                 -> uint8 count, int16 x count
+ *   TLM_CMD_GET_CONFIG    field, index (uint8)    -> float32 value
+ *   TLM_CMD_SET_CONFIG    field, index, float32   -> float32 value now in effect
+ *   TLM_CMD_TRIGGER       actuator (TelemetryActuator) -> -
+ *   TLM_CMD_DUMP_LOG      -                       -> uint32 log records dropped
+ *                         (the log ring is re-printed as debug text, see log.h)
+ *
+ * A background thread receives and decodes frames. Snapshot requests are
+ * answered from that thread using the copy published by loop() after each
+ * sensor update, so the Pi can poll at any rate without touching the I2C
+ * bus. History queries, config changes, actuator triggers, log dumps and
+ * telemetry ACK/RESEND frames touch loop()-owned state; they are queued and run by
+ * command_channel_poll().
+ ******************************************************************************/
+#ifndef LOGIC_COMMAND_CHANNEL_H
+#define LOGIC_COMMAND_CHANNEL_H
+
+#include <cstdint>
+#include <cstddef>
+
+#define CMD_QUEUE_LEN          8    // requests waiting for loop()
+#define CMD_HISTORY_MAX_POINTS 100  // int16 points per GET_HISTORY response
+#define CMD_RX_POLL_MS         5    // RX thread poll period
+
+enum CommandStatus : uint8_t {
+    CMD_OK           = 0,
+    CMD_BAD_REQUEST  = 1,   // wrong length or invalid field/index
+    CMD_OUT_OF_RANGE = 2,   // value rejected by settings_set_value()
+    CMD_BUSY         = 3,   // actuator already running
+    CMD_UNKNOWN      = 4,   // unsupported command
+    CMD_QUEUE_FULL   = 5,   // loop() has not caught up; retry later
+};
+
+// Latest readings and actuator state, published by loop()
+typedef struct {
+    uint32_t uptime_ms;
+    int16_t  temp_f10[3];      // °F x10, TLM_NONE if missing
+    int16_t  hum10[3];         // %RH x10
+    int16_t  o2_100;           // % x100
+    int16_t  board_temp_f10;   // °F x10
+    uint8_t  fill;             // %
+    uint8_t  switches;         // bit i = limit switch i closed
+    uint8_t  pump;             // 1 while the pump runs
+    uint8_t  blower_state;     // see actuator_blower_state()
+    uint32_t samples;          // telemetry samples recorded since boot
+} CommandSnapshot;
+
+typedef struct {
+    uint32_t rx_frames;    // valid frames received
+    uint32_t rx_errors;    // chunks failing COBS/CRC/version checks
+    uint32_t answered;     // responses sent
+    uint32_t queue_full;   // requests rejected with CMD_QUEUE_FULL
+} CommandStats;
+
+/** Start the RX thread. Call once in setup() after telemetry_init(). */
+void command_channel_init();
+
+/** Copy the current readings for snapshot requests. Call after each sensor update. */
+void command_channel_publish_snapshot(uint32_t now_ms);
+
+/** Run queued requests. Call every pass of loop(). */
+void command_channel_poll();
+
+/** Snapshot of the channel counters. */
+CommandStats command_channel_get_stats();
+
+#endif // LOGIC_COMMAND_CHANNEL_H
@@ -0,0 +1,130 @@
+/******************************************************************************
+ * @file    core_link.h
+ * @author  Thomas Zoldowski
+ * @date    October 18, 2026
+ * @brief   Shared-memory link between the M7 (UI) and M4 (control) cores.
+ *
+ * With CORE_SPLIT=1 the STM32H747's Cortex-M4 runs its own firmware
+ * (env:giga_r1_m4, sources in src/m4/) that owns the sensors, the limit
+ * switches and the pump/blower state machine. The M7 build
+ * (env:giga_r1_m7_split) keeps LVGL, storage, telemetry and networking and
+ * gets sensor_manager.h / actuator_manager.h from core_link.cpp instead,
+ * so none of the M7 modules change.
+ *
+ * Data moves through a block at CORE_LINK_ADDR in SRAM4, which both cores
+ * can reach:
+ *
+ *   M4 -> M7  snapshot  latest readings, switch and actuator state, behind
+ *                       a sequence counter (odd while the M4 writes it)
+ *   M4 -> M7  events    single-producer ring of door openings and actuator
+ *                       starts, so no edge is lost between M7 polls
+ *   M7 -> M4  settings  thresholds, on-times and the persisted last-run
+ *                       epochs, behind its own sequence counter
+ *
+ * Each side only writes its own cache lines. The M4 has no data cache; the
+ * M7 invalidates before it reads and cleans after it writes, so nothing is
+ * mapped non-cacheable. Requests that need an answer (manual pump/blower
+ * triggers) go over RPC, which also boots the M4 and carries its console
+ * output, forwarded by the M7 into DebugSerial.
+ ******************************************************************************/
+#ifndef LOGIC_CORE_LINK_H
+#define LOGIC_CORE_LINK_H
+
+#include <cstdint>
+#include "logic/sensor_manager.h"
+#include "logic/actuator_manager.h"
+
+#ifndef CORE_LINK_ADDR
+  // Top 4 KB of SRAM4, clear of the OpenAMP buffers at its start
+  #define CORE_LINK_ADDR  0x3800F000UL
+#endif
+
+#define CORE_LINK_MAGIC     0x434C4E4BUL   // "CLNK"
+#define CORE_LINK_VERSION   2
+#define CORE_LINE           32             // M7 D-cache line
+#define CORE_EVENT_SLOTS    32             // power of two
+
+enum CoreEventType : uint8_t {
+    CORE_EVT_DOOR     = 1,   // a = TelemetryDoor, b = loaded, epoch = when
+    CORE_EVT_ACTUATOR = 2,   // a = TelemetryActuator switched on, epoch = persisted trigger time
+};
+
+typedef struct {
+    uint8_t  type;
+    uint8_t  a;
+    uint8_t  b;
+    uint8_t  reserved;
+    uint32_t epoch;
+} CoreEvent;
+
+// Written by the M4 after every sensor or control pass
+typedef struct {
+    uint32_t       seq;              // odd while being written
+    uint32_t       published;        // increments every publish (heartbeat)
+    SensorSnapshot sensors;          // the M4's latest sensor_manager snapshot
+    uint8_t        steps[ACT_PROGRAM_COUNT];   // actuator_step() per program
+    uint8_t        outputs;          // actuator_outputs()
+} CoreSnapshot;
+
+// Written by the M7 whenever a control setting changes
+typedef struct {
+    uint32_t seq;                    // odd while being written, 0 = never
+    uint16_t pump_on_s;
+    uint16_t blower_on_s;
+    uint16_t interval_s;
+    uint16_t temp_high_f[3];
+    uint16_t hum_low[3];
+    uint32_t last_pump_epoch;
+    uint32_t last_blower_epoch;
+} CoreSettings;
+
+typedef struct {
+    // ---- M4-written lines ----
+    alignas(CORE_LINE) uint32_t magic;
+    uint32_t     version;
+    uint32_t     m4_boots;
+    uint32_t     ev_head;            // next event slot the M4 fills
+    uint32_t     ev_dropped;         // events lost to a full ring
+    alignas(CORE_LINE) CoreSnapshot snap;
+    alignas(CORE_LINE) CoreEvent    events[CORE_EVENT_SLOTS];
+    // ---- M7-written lines ----
+    alignas(CORE_LINE) uint32_t ev_tail;   // next event slot the M7 reads
+    alignas(CORE_LINE) CoreSettings settings;
+} CoreLink;
+
+static_assert(sizeof(CoreLink) <= 4096, "CoreLink must fit its SRAM4 window");
+
+static inline CoreLink *core_link_shared() {
+    return reinterpret_cast<CoreLink *>(CORE_LINK_ADDR);
+}
+
+#ifdef CORE_CM4
+// ---------------- M4 side (src/m4/) ----------------
+
+/** Stamp the block as alive and pick up the settings. Call first in setup(). */
+void core_link_m4_init();
+
+/** Apply settings the M7 changed since the last call. */
+void core_link_m4_sync();
+
+/** Publish the current readings and actuator state. */
+void core_link_publish();
+
+/** Queue an event for the M7. Dropped (and counted) if the ring is full. */
+void core_link_post(CoreEventType type, uint8_t a, uint8_t b, uint32_t epoch);
+
+#else
+// ---------------- M7 side (core_link.cpp, CORE_SPLIT only) ----------------
+
+/** Clear the block, share the settings and boot the M4. Call before sensor_manager_init(). */
+void core_link_init();
+
+/** Handle M4 events, forward its console and push changed settings. Call every loop() pass. */
+void core_link_poll();
+
+/** True while the M4 has published within CORE_LINK_STALE_MS. */
+bool core_link_m4_alive();
+
+#endif
+
+#endif // LOGIC_CORE_LINK_H
@@ -0,0 +1,67 @@
+/******************************************************************************
+ * @file    history_log.h
+ * @author  Thomas Zoldowski
+ * @date    October 18, 2026
+ * @brief   In-memory trend history for the History screen.
+ *
+ * Readings are averaged into two rings held in SDRAM:
+ *  - fine:   one sample every 10 s, 24 h deep (1 h and 24 h windows)
+ *  - coarse: one sample every 2 min, 30 d deep (7 d and 30 d windows)
+ *
+ * history_query() decimates a window with min/max buckets so the result
+ * never has more points than the chart is wide, whatever the raw count.
+ ******************************************************************************/
+#ifndef LOGIC_HISTORY_LOG_H
+#define LOGIC_HISTORY_LOG_H
+
+#include <cstdint>
+#include <cstddef>
+
+// Marker for a missing value (sensor absent for the whole bucket)
+#define HISTORY_NONE  INT16_MIN
+
+enum HistoryMetric {
+    HIST_TEMP,      // °F x10, per sensor (series 0-2)
+    HIST_HUM,       // %RH x10, per sensor (series 0-2)
+    HIST_O2,        // % x100
+    HIST_FILL,      // % (0-100)
+    HIST_METRIC_COUNT
+};
+
+enum HistoryWindow {
+    HIST_1H,
+    HIST_24H,
+    HIST_7D,
+    HIST_30D,
+    HIST_WINDOW_COUNT
+};
+
+// One stored sample (fixed-point, 16 bytes)
+typedef struct {
+    int16_t temp_f10[3];
+    int16_t hum10[3];
+    int16_t o2_100;
+    int16_t fill;
+} HistorySample;
+
+/** Allocate the rings in SDRAM. Call once after Display.begin(). */
+void history_init();
+
+/** Feed the current readings. Call on every sensor update. */
+void history_record(uint32_t now_ms);
+
+/** Number of series a metric has (3 for temp/hum, 1 otherwise). */
+uint8_t history_series_count(HistoryMetric metric);
+
+/**
+ * Copy a window of one series into @p out, decimated to at most @p max_points.
+ * Missing values are written as @p none_value.
+ * @return Number of points written.
+ */
+size_t history_query(HistoryWindow window, HistoryMetric metric, uint8_t series,
+                     int32_t *out, size_t max_points, int32_t none_value);
+
+/** Increments every time a new sample is stored; lets the UI skip re-queries. */
+uint32_t history_revision();
+
+#endif // LOGIC_HISTORY_LOG_H
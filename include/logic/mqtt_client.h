@@ -0,0 +1,80 @@
+/******************************************************************************
+ * @file    mqtt_client.h
+ * @author  Thomas Zoldowski
+ * @date    October 18, 2026
+ * @brief   Minimal MQTT 3.1.1 client: CONNECT, QoS 1 PUBLISH, PUBACK, PING.
+ *
+ * Only what the uploader needs to push readings to a broker: no
+ * subscriptions, no QoS 2, clean sessions. It runs over any Arduino
+ * Client (WiFiClient, WiFiSSLClient) and never buffers whole packets of
+ * its own: a PUBLISH is framed in place around a payload the caller has
+ * already encoded at buf + mqtt_publish_reserve(topic), then written in
+ * one call.
+ *
+ * All reads are bounded by a deadline; the caller owns the connection
+ * and the thread.
+ ******************************************************************************/
+#ifndef LOGIC_MQTT_CLIENT_H
+#define LOGIC_MQTT_CLIENT_H
+
+#include <Arduino.h>
+#include <cstdint>
+#include <cstddef>
+
+// Control packet types (upper nibble of the fixed header)
+#define MQTT_CONNECT     1
+#define MQTT_CONNACK     2
+#define MQTT_PUBLISH     3
+#define MQTT_PUBACK      4
+#define MQTT_PINGREQ     12
+#define MQTT_PINGRESP    13
+#define MQTT_DISCONNECT  14
+
+#define MQTT_RX_TIMEOUT_MS  2000   // rest of a packet once its first byte arrived
+
+typedef struct {
+    Client  *net;
+    uint16_t keepalive_s;
+    uint16_t next_id;         // last packet identifier used
+    uint32_t last_tx_ms;      // for keep-alive pings
+    bool     ping_pending;    // PINGREQ sent, PINGRESP not yet seen
+    uint8_t  connack_rc;      // return code of the last CONNACK
+} MqttSession;
+
+/**
+ * Send CONNECT (clean session) on an open connection and wait for CONNACK.
+ * user/pass may be nullptr.
+ * @return CONNACK return code (0 = accepted), or -1 on I/O error/timeout.
+ */
+int mqtt_connect(MqttSession &s, Client &net, const char *client_id,
+                 const char *user, const char *pass,
+                 uint16_t keepalive_s, uint32_t timeout_ms);
+
+/** Bytes the caller must leave free in front of a PUBLISH payload. */
+size_t mqtt_publish_reserve(const char *topic);
+
+/**
+ * Frame and send a QoS 1 PUBLISH whose payload is already at
+ * buf + mqtt_publish_reserve(topic).
+ * @return Packet identifier to match against PUBACK, or 0 if the write failed.
+ */
+uint16_t mqtt_publish(MqttSession &s, uint8_t *buf, const char *topic, size_t payload_len);
+
+/**
+ * Read one packet from the broker.
+ * @param packet_id Set for PUBACK.
+ * @return Packet type, 0 if nothing arrived before the deadline, -1 if
+ *         the connection failed or sent something malformed.
+ */
+int mqtt_read(MqttSession &s, uint32_t deadline, uint16_t &packet_id);
+
+/** Milliseconds until a PINGREQ is due (0 = now). */
+uint32_t mqtt_ping_due_in(const MqttSession &s);
+
+/** Send PINGREQ. @return False if the write failed. */
+bool mqtt_ping(MqttSession &s);
+
+/** Send DISCONNECT and close the connection. */
+void mqtt_disconnect(MqttSession &s);
+
+#endif // LOGIC_MQTT_CLIENT_H
@@ -0,0 +1,22 @@
+/******************************************************************************
+ * @file    net_encode.h
+ * @author  Thomas Zoldowski
+ * @date    October 18, 2026
+ * @brief   JSON fields of one upload reading, shared by both transports.
+ *
+ *   "timestamp":"2026-10-18T14:03:00Z",
+ *   "sensor":[{"id":0,"temp":131.2,"hum":48.5}, ...],
+ *   "o2":20.4
+ *
+ * Missing readings (NAN) are written as null.
+ ******************************************************************************/
+#ifndef LOGIC_NET_ENCODE_H
+#define LOGIC_NET_ENCODE_H
+
+#include "json_writer.h"
+#include "logic/network_manager.h"
+
+/** Write the reading's fields into the object open in w. */
+void net_encode_reading(JsonWriter &w, const NetReading &r);
+
+#endif // LOGIC_NET_ENCODE_H
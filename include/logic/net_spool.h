@@ -0,0 +1,46 @@
+/******************************************************************************
+ * @file    net_spool.h
+ * @author  Thomas Zoldowski
+ * @date    October 18, 2026
+ * @brief   LittleFS spool for readings that could not be uploaded.
+ *
+ * Records are appended to /user/net_spool.bin while the broker is
+ * unreachable and replayed oldest first once it is back. The number of
+ * records already delivered is kept in /user/net_spool.pos, so a reboot
+ * mid-replay resumes where it stopped (a batch in flight at the time may
+ * be delivered twice, which QoS 1 allows anyway). Both files are deleted
+ * once everything has been delivered.
+ *
+ * Only the uploader thread uses the spool; it is not locked.
+ ******************************************************************************/
+#ifndef LOGIC_NET_SPOOL_H
+#define LOGIC_NET_SPOOL_H
+
+#include <cstdint>
+#include "logic/network_manager.h"
+
+/** Pick up a spool left from before a reboot. Call once from the uploader thread. */
+void net_spool_init();
+
+/** Records waiting to be delivered. */
+uint32_t net_spool_count();
+
+/**
+ * Append records.
+ * @return Number stored; fewer than n once NET_SPOOL_MAX_RECORDS is reached.
+ */
+uint32_t net_spool_append(const NetReading *r, uint32_t n);
+
+/**
+ * Read waiting records, oldest first.
+ * @param skip Waiting records to skip (those already in flight).
+ * @param out  Destination.
+ * @param max  Records wanted.
+ * @return Records read.
+ */
+uint32_t net_spool_read(uint32_t skip, NetReading *out, uint32_t max);
+
+/** Mark the oldest n waiting records as delivered. */
+void net_spool_consume(uint32_t n);
+
+#endif // LOGIC_NET_SPOOL_H
@@ -2,17 +2,66 @@
  * @file    network_manager.h
  * @author  Thomas Zoldowski
  * @date    June 4, 2025
- * @brief   Declaration of Wi-Fi initialization and periodic sensor upload.
+ * @brief   Wi-Fi uploader: readings published to MQTT or POSTed over HTTP.
+ *
+ * loop() only copies the current readings into a small queue
+ * (network_submit_reading()); a background thread joins Wi-Fi, encodes the
+ * JSON into a fixed buffer and sends it over one long-lived connection
+ * (TLS by default), so the handshake is paid once, not once per reading.
+ * Every read and write is bounded by a buffer size and a deadline, and the
+ * loop never waits on the network.
+ *
+ * NET_TRANSPORT selects the protocol:
+ *   NET_TRANSPORT_MQTT  QoS 1 batches to MQTT_HOST on MQTT_TOPIC, spooled
+ *                       to LittleFS while the broker is unreachable
+ *   NET_TRANSPORT_HTTP  one POST per reading to API_HOST/API_PATH
+ *
+ * Off unless NET_UPLOAD_ENABLED is set. For bench testing against the
+ * local stand-ins (tools/mqtt_standin.py, tools/http_standin.py), build
+ * with e.g.
+ *   -DNET_UPLOAD_ENABLED=1 -DNET_USE_TLS=0 -DMQTT_HOST=\"192.168.1.20\"
+ *   -DNET_UPLOAD_ENABLED=1 -DNET_USE_TLS=0 -DNET_TRANSPORT=NET_TRANSPORT_HTTP
+ *       -DAPI_HOST=\"192.168.1.20\" -DAPI_PORT=8080
  ******************************************************************************/
 #pragma once
 
 #ifndef NETWORK_MANAGER_H
 #define NETWORK_MANAGER_H
 
-// Call once in setup() to initialize Wi-Fi and start the periodic upload.
+#include <cstdint>
+
+// One upload record; also the on-flash spool format, so fixed-width only
+typedef struct {
+    uint32_t timestamp;     // UTC seconds (time())
+    float    temp_f[3];     // NAN if the sensor is missing
+    float    hum[3];
+    float    o2;
+} NetReading;
+
+typedef struct {
+    uint32_t queued;        // readings accepted by network_submit_reading()
+    uint32_t sent;          // readings the server answered with 2xx
+    uint32_t rejected;      // HTTP: readings answered with 4xx (dropped)
+    uint32_t dropped;       // readings lost to a full queue or spool
+    uint32_t failures;      // attempts that failed (connect, write, timeout, 5xx)
+    uint32_t connects;      // new connections opened
+    uint32_t reused;        // HTTP: requests sent on an already open connection
+    uint32_t spooled;       // MQTT: readings written to the LittleFS spool
+    uint32_t spool_waiting; // MQTT: spooled readings not yet acknowledged
+    uint32_t last_ms;       // last request/PUBLISH round trip
+    uint32_t avg_ms;        // smoothed round trip (1/8 weight per delivery)
+} NetworkStats;
+
+/** Start the uploader thread. Call once in setup(). */
 void network_init();
 
-void network_update();
+/**
+ * Queue the current readings for upload. Never blocks; if the queue is
+ * full the reading is dropped.
+ */
+void network_submit_reading();
 
-#endif /* NETWORK_MANAGER_H */
+/** Snapshot of the uploader counters. */
+NetworkStats network_get_stats();
 
+#endif /* NETWORK_MANAGER_H */
@@ -8,10 +8,8 @@
 #define LOGIC_SENSOR_MANAGER_H
 
 #include <cstdint>
-#include <Adafruit_AHTX0.h>
-#include <Wire.h>
-#include <Arduino.h>
-#include <mbed.h>
+#include <cmath>
+#include "hal.h"
 
 // Structure representing I2C connection status of the mux and sensors
 typedef struct {
@@ -21,8 +19,42 @@ typedef struct {
     bool vl53[2]; // true for each VL53L1X that acknowledged
 } ConnectionStatus;
 
-// A mutex to guard all shared data
-extern rtos::Mutex   data_mutex;
+// Possible warnings bitmask
+enum WarningMask {
+    WARN_NONE          = 0,
+    WARN_FRONT_DOOR    = 1 << 0,
+    WARN_BACK_DOOR     = 1 << 1,
+    WARN_LOADING_DOOR  = 1 << 2,
+    WARN_HIGH_TEMP     = 1 << 3,
+};
+
+// Everything one acquisition pass produced, published as a unit so readers
+// in other threads never see temperatures from one pass and humidity from
+// the next. NAN marks a reading that is not available.
+typedef struct {
+    uint32_t         pass;           // sensor_manager_update() calls so far (0 = none yet)
+    uint32_t         taken_ms;       // millis() when the pass finished
+    float            temp_c[3];
+    float            hum[3];
+    float            o2;
+    float            tof_cm[2];
+    float            fill_percent;
+    float            board_temp_f;   // TMP117, °F
+    ConnectionStatus status;         // as probed at the start of the pass
+    uint8_t          switches;       // bit i = limit switch i closed
+    uint8_t          door_mask;      // WarningMask bits
+} SensorSnapshot;
+
+// The readings of one pass as the parts returned them, before the level
+// filter; a field trace records these (logic/trace.h). NAN = no reading.
+typedef struct {
+    ConnectionStatus status;
+    float            temp_c[3];
+    float            hum[3];
+    float            o2;             // the SEN0322 driver's running average
+    float            tof_cm[2];
+    float            board_temp_f;
+} SensorRaw;
 
 void sensorTask();
 
@@ -32,6 +64,27 @@ void sensor_manager_init();
 /** Poll/update all sensor readings. Call this periodically. */
 void sensor_manager_update();
 
+/**
+ * The second half of sensor_manager_update(): filter one pass of readings
+ * and publish the snapshot. A trace replay feeds recorded passes here.
+ */
+void sensor_manager_apply(const SensorRaw &raw);
+
+/**
+ * Start the acquisition thread ("sensing", osPriorityAboveNormal), which
+ * runs sensor_manager_update() every SENSOR_UPDATE_INTERVAL_MS and
+ * Limit_Switch_update() every LIMIT_SWITCH_INTERVAL_MS from then on.
+ * Call after sensor_manager_init() and Limit_Switch_Init().
+ */
+void sensor_manager_start();
+
+/**
+ * Send the door openings the acquisition thread queued (TLM_DOOR frames and
+ * warning rows). Call from loop() under lv_lock(); the split build gets them
+ * from core_link_poll() instead.
+ */
+void sensor_manager_poll_doors();
+
 /** Get the latest temperature (°C) for sensor `idx` (0-based). */
 float sensor_manager_get_temperature(uint8_t idx);
 
@@ -44,9 +97,19 @@ float sensor_manager_get_oxygen(void);
 /** Get the latest external temperature (°F) from the TMP117 sensor. */
 float getExternalTemperature();
 
-// Check and return connection status for mux and sensors
+// Probe the mux and sensors on the bus (acquisition thread only; others read
+// the status from the snapshot)
 ConnectionStatus sensor_manager_get_connection_status(void);
 
+/**
+ * Copy the latest snapshot. Never blocks and touches no bus, so it is safe
+ * from LVGL callbacks and any thread; the getters below read through it.
+ * sensor_manager_update() and Limit_Switch_update() are the only writers
+ * and must run in the same thread.
+ * @return False before anything was published (out is then all NAN).
+ */
+bool sensor_manager_get_snapshot(SensorSnapshot &out);
+
 void Limit_Switch_Init();
 
 void Limit_Switch_update();
@@ -55,6 +118,38 @@ bool Limit_Switch_isClosed(uint8_t index);
 
 extern bool limit_switch_states[5];
 
+/** Doors whose switch was closed at the last Limit_Switch_update() (WarningMask bits). */
+uint32_t Limit_Switch_get_warning_mask();
+
 float sensor_manager_get_tof_distance(uint8_t idx);
 
+/** Get the filtered compost fill level (0-100 %), or NAN before the first valid ToF reading. */
+float sensor_manager_get_fill_percent(void);
+
+// Compost level filter (ToF #1): moving average with outlier rejection
+#define FILL_FILTER_SAMPLES 5
+typedef struct {
+    float   buf[FILL_FILTER_SAMPLES];
+    uint8_t idx;
+    uint8_t cnt;
+    uint8_t outliers;
+} FillFilter;
+
+/**
+ * Feed one ToF distance (cm, NAN if unavailable) into a level filter that
+ * starts zeroed. sensor_manager_update() runs one on ToF #1.
+ * @return Fill level (0-100 %), NAN until the first valid reading.
+ */
+float fill_filter_update(FillFilter &f, float raw_cm);
+
+// What sensor_manager_apply() carries from one pass to the next, so a
+// trace can be replayed from the middle of a run (acquisition context only)
+typedef struct {
+    uint32_t   pass;         // snapshot pass count so far
+    FillFilter fill;
+} SensorTraceState;
+
+SensorTraceState sensor_manager_trace_state();
+void sensor_manager_restore(const SensorTraceState &s);
+
 #endif // LOGIC_SENSOR_MANAGER_H
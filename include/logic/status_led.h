@@ -0,0 +1,24 @@
+/******************************************************************************
+ * @file    status_led.h
+ * @author  Thomas Zoldowski
+ * @date    October 18, 2026
+ * @brief   Front panel LEDs that show the security (PIN) state.
+ *
+ * They follow the settings screen's PIN lock, so they stay with the UI on
+ * the M7 when sensing and actuator control run on the M4 (CORE_SPLIT).
+ ******************************************************************************/
+#ifndef LOGIC_STATUS_LED_H
+#define LOGIC_STATUS_LED_H
+
+void LED_Init();
+
+void LED_On();
+
+void LED_Off();
+
+/** @brief  Updates the LED status based on security state.
+*         Call this periodically to reflect the current security status.
+*/
+void LED_Update();
+
+#endif // LOGIC_STATUS_LED_H
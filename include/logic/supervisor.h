@@ -0,0 +1,46 @@
+/******************************************************************************
+ * @file    supervisor.h
+ * @author  Thomas Zoldowski
+ * @date    October 18, 2026
+ * @brief   Thread heartbeat supervisor that owns the hardware watchdog.
+ *
+ * The firmware runs as prioritized Mbed OS threads (highest first):
+ *
+ *   act_ctl     osPriorityRealtime     actuator trigger table (actuator_manager;
+ *                                      steps end in timer callbacks)
+ *   supervisor  osPriorityHigh         this module
+ *   sensing     osPriorityAboveNormal  sensors and limit switches (sensor_manager)
+ *   main        osPriorityNormal       loop(): LVGL under lv_lock(), telemetry, storage
+ *                                      (flash writes outside the lock)
+ *
+ * Each of those checks in with supervisor_checkin() on every pass. The
+ * watchdog is only kicked while every registered thread has checked in
+ * within its own limit, so one thread that hangs (or a higher one that
+ * spins and starves it) resets the board instead of being hidden by the
+ * others. Lower-priority helpers that block on I/O by design (serial_tx,
+ * cmd_rx, net_tx) are not registered.
+ ******************************************************************************/
+#ifndef LOGIC_SUPERVISOR_H
+#define LOGIC_SUPERVISOR_H
+
+#include <cstdint>
+
+#define SUPERVISOR_MAX_THREADS  4
+#define SUPERVISOR_NONE         0xFF   // returned when the table is full; check-ins ignored
+
+typedef uint8_t SupervisorId;
+
+/** @brief  Add a thread to the check-in table. Call during setup(), before
+*         supervisor_start(). Counts as its first check-in.
+*  @param name           Shown in the log when the thread goes silent.
+*  @param max_silence_ms Longest gap between check-ins that still kicks.
+*/
+SupervisorId supervisor_register(const char *name, uint32_t max_silence_ms);
+
+/** @brief  Record that the thread is alive. Cheap; call every pass. */
+void supervisor_checkin(SupervisorId id);
+
+/** @brief  Start the watchdog (WATCHDOG_TIMEOUT_MS) and the supervisor thread. */
+void supervisor_start();
+
+#endif // LOGIC_SUPERVISOR_H
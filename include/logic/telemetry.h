@@ -0,0 +1,128 @@
+/******************************************************************************
+ * @file    telemetry.h
+ * @author  Thomas Zoldowski
+ * @date    October 18, 2026
+ * @brief   Binary telemetry frames to the Raspberry Pi over USB serial.
+ *
+ * Frame layout before encoding (multi-byte fields little-endian):
+ *
+ *   | ver (1) | type (1) | seq (2) | payload (0-TLM_MAX_PAYLOAD, 240) | crc16 (2) |
+ *
+ * The CRC is CRC-16/CCITT-FALSE over ver..payload. The frame is COBS
+ * encoded and sent as 0x00 <cobs bytes> 0x00, so a receiver can resync at
+ * any zero byte. Text debug output on the same port is rejected by the
+ * CRC/version check with high probability.
+ *
+ * Payloads are fixed point; INT16_MIN (TLM_NONE) marks a missing reading.
+ *
+ * Sensor readings are not sent one by one. Each reading becomes a sample
+ * with its own 32-bit sequence number and is kept in a backlog until the
+ * Pi acknowledges it. Samples go out in TLM_SAMPLES batches; the Pi answers
+ * with TLM_ACK (everything below next_seq received) or TLM_RESEND (a range
+ * it is missing). Unacknowledged samples are sent again after
+ * TELEMETRY_ACK_TIMEOUT_MS, so a Pi that was rebooted or unplugged is
+ * backfilled automatically. boot_id is a random 32-bit number drawn on every
+ * GIGA reset and tells the Pi that sample numbering restarted.
+ ******************************************************************************/
+#ifndef LOGIC_TELEMETRY_H
+#define LOGIC_TELEMETRY_H
+
+#include <cstdint>
+#include <cstddef>
+
+#define TLM_VERSION       2
+#define TLM_MAX_PAYLOAD   240
+#define TLM_NONE          INT16_MIN
+
+enum TelemetryType : uint8_t {
+    TLM_DOOR         = 0x02,  // uint8 door (TelemetryDoor), uint8 loaded (1) / unloaded (0)
+    TLM_ACTUATOR     = 0x03,  // uint8 actuator (TelemetryActuator) switched on
+    TLM_CAMERA_DELAY = 0x04,  // uint16 seconds
+    TLM_SAMPLES      = 0x05,  // uint32 boot_id, uint32 now_ms, uint32 first_seq, uint8 count,
+                              //   count x { uint32 t_ms, int16 temp_f10[3], int16 hum10[3],
+                              //             int16 o2_100, uint8 fill }
+
+    TLM_RESPONSE     = 0x06,  // reply to a TLM_CMD_* request (see command_channel.h)
+    TLM_TRACE        = 0x07,  // uint32 offset (trace bytes sent before this frame since boot),
+                              //   whole trace records (logic/trace.h)
+
+    // Pi -> GIGA
+    TLM_ACK          = 0x81,  // uint32 boot_id, uint32 next_seq
+    TLM_RESEND       = 0x82,  // uint32 boot_id, uint32 from_seq, uint32 to_seq (inclusive)
+    TLM_CMD_GET_SNAPSHOT = 0x90,
+    TLM_CMD_GET_HISTORY  = 0x91,
+    TLM_CMD_GET_CONFIG   = 0x92,
+    TLM_CMD_DUMP_LOG     = 0x93,
+    TLM_CMD_SET_CONFIG   = 0xA0,
+    TLM_CMD_TRIGGER      = 0xA1,
+};
+
+enum TelemetryDoor : uint8_t {
+    TLM_DOOR_FRONT   = 0,
+    TLM_DOOR_BACK    = 1,
+    TLM_DOOR_LOADING = 2,
+};
+
+enum TelemetryActuator : uint8_t {
+    TLM_ACT_PUMP   = 0,
+    TLM_ACT_BLOWER = 1,
+};
+
+typedef struct {
+    uint32_t recorded;   // samples taken since boot
+    uint32_t acked;      // samples acknowledged by the Pi
+    uint32_t lost;       // samples overwritten before the Pi acknowledged them
+    uint32_t resends;    // times the send position was rewound (timeout or RESEND)
+} TelemetryStats;
+
+/** Pick a boot_id and reset the sample backlog. Call once in setup(). */
+void telemetry_init();
+
+/** Add the current sensor readings to the backlog as one sample. */
+void telemetry_record_sample(uint32_t now_ms);
+
+/**
+ * Send due TLM_SAMPLES batches. Call every pass of loop(); never blocks.
+ */
+void telemetry_poll(uint32_t now_ms);
+
+/** TLM_ACK from the Pi (delivered by the command channel, in loop()). */
+void telemetry_handle_ack(uint32_t boot_id, uint32_t next_seq);
+
+/** TLM_RESEND from the Pi (delivered by the command channel, in loop()). */
+void telemetry_handle_resend(uint32_t boot_id, uint32_t from_seq);
+
+/** Snapshot of the batching counters. */
+TelemetryStats telemetry_get_stats();
+
+/** Send a door event (TLM_DOOR). */
+void telemetry_send_door(TelemetryDoor door, bool loaded);
+
+/** Send an actuator start event (TLM_ACTUATOR). */
+void telemetry_send_actuator(TelemetryActuator actuator);
+
+/** Send the camera delay (TLM_CAMERA_DELAY). */
+void telemetry_send_camera_delay(uint16_t seconds);
+
+/**
+ * Frame, encode and queue one message for transmission. Thread-safe.
+ * @return False if the payload is too large or the TX ring is full.
+ */
+bool telemetry_send(uint8_t type, const uint8_t *payload, size_t len);
+
+/** CRC-16/CCITT-FALSE (poly 0x1021, init 0xFFFF). */
+uint16_t telemetry_crc16(const uint8_t *data, size_t len);
+
+/**
+ * COBS-encode @p len bytes into @p out (needs len + len/254 + 1 bytes).
+ * @return Encoded length.
+ */
+size_t telemetry_cobs_encode(const uint8_t *in, size_t len, uint8_t *out);
+
+/**
+ * COBS-decode one chunk (delimiters removed) into @p out (len bytes max).
+ * @return Decoded length, or 0 if the chunk is malformed.
+ */
+size_t telemetry_cobs_decode(const uint8_t *in, size_t len, uint8_t *out);
+
+#endif // LOGIC_TELEMETRY_H
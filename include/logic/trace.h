@@ -0,0 +1,163 @@
+/******************************************************************************
+ * @file    trace.h
+ * @author  Thomas Zoldowski
+ * @date    October 18, 2026
+ * @brief   Field trace: the inputs of the sensing and control logic, for replay.
+ *
+ * Everything the filters, the door warnings and the actuator scheduler
+ * act on is recorded in a compact binary stream: every raw sensor pass
+ * (before the level filter), every limit switch change, every remote
+ * trigger and config save, the snapshot pass and RTC time each control
+ * pass decided on, and every actuator transition as a check. Feeding the
+ * inputs back through the same code (src/replay/main_replay.cpp, on a
+ * host) reproduces the run bit for bit and compares the transitions.
+ *
+ * Records go to a RAM ring from any context (ISR-safe) and loop() flushes
+ * them to the sinks in TRACE_SINKS (config.h): two alternating files on
+ * LittleFS (/user/trace0.bin, /user/trace1.bin), and/or TLM_TRACE frames
+ * to the Pi (tools/trace_tool.py reassembles those into a file).
+ *
+ * File:    "CTRC" | version (1) | 0 (3) | seq (4) | records...
+ * Record:  type (1) | µs since the previous record (varint) | payload
+ *
+ * Varints are LEB128; signed ones zigzag encoded. Payloads:
+ *
+ *   TRACE_CONFIG   Config as saved (settings_storage.h)
+ *   TRACE_STATE    pass (varint), epoch (4), switches (1), outputs (1),
+ *                  last pump / blower epoch (4 + 4), FillFilter (5 x 4 + 3)
+ *   TRACE_PASS     changed (varint: bit 0 status, bits 1-10 the floats of
+ *                  SensorRaw in declaration order), status (1) if changed,
+ *                  then per changed float its bits XOR the previous pass's
+ *                  (varint)
+ *   TRACE_SWITCH   switch levels (1), bit per limit switch
+ *   TRACE_OUTPUT   outputs on (1), bit per ActuatorOutput
+ *   TRACE_CONTROL  snapshot pass (varint), epoch change (signed varint)
+ *   TRACE_TRIGGER  program (1), epoch change (signed varint)
+ *   TRACE_GAP      records dropped because the ring was full (varint)
+ *
+ * A TRACE_STATE is a sync point: it carries the filter and scheduler
+ * state and resets the bases of the XOR and epoch deltas, so decoding and
+ * replay can start there. One is written at trace_init(), every
+ * TRACE_STATE_PASSES passes, after records were dropped and when a file
+ * is started. Multi-byte fixed fields are little-endian.
+ ******************************************************************************/
+#ifndef LOGIC_TRACE_H
+#define LOGIC_TRACE_H
+
+#include <cstdint>
+#include <cstddef>
+#include "config.h"
+#include "settings_storage.h"
+#include "logic/sensor_manager.h"
+
+#define TRACE_VERSION      1
+#define TRACE_HEADER_LEN   12
+#define TRACE_PATH_0       "/user/trace0.bin"
+#define TRACE_PATH_1       "/user/trace1.bin"
+
+enum TraceType : uint8_t {
+    TRACE_CONFIG  = 1,
+    TRACE_STATE   = 2,
+    TRACE_PASS    = 3,
+    TRACE_SWITCH  = 4,
+    TRACE_OUTPUT  = 5,
+    TRACE_CONTROL = 6,
+    TRACE_TRIGGER = 7,
+    TRACE_GAP     = 8,
+};
+
+typedef struct {
+    uint32_t records;    // written to the ring since trace_init()
+    uint32_t dropped;    // lost to a full ring
+    uint32_t flushed;    // bytes handed to the sinks
+    uint32_t sink_errors;
+} TraceStats;
+
+#if TRACE_ENABLED
+/** Start recording: open the older trace file, write the config and a sync point. */
+void trace_init();
+
+/** A raw sensor pass, before sensor_manager_apply() (acquisition context). */
+void trace_pass(const SensorRaw &raw);
+
+/** Limit switch levels after a poll that changed one (acquisition context). */
+void trace_switches(uint8_t levels);
+
+/** Outputs on after a transition. ISR-safe. */
+void trace_outputs(uint8_t outputs);
+
+/** A control pass about to decide on this snapshot pass at this RTC time. */
+void trace_control(uint32_t pass, uint32_t epoch);
+
+/** A remote trigger of a program, accepted or not. */
+void trace_trigger(uint8_t program, uint32_t epoch);
+
+/** A config save. */
+void trace_config(const Config &c);
+
+/** Hand recorded bytes to the sinks when due. Call from loop(). */
+void trace_flush(uint32_t now_ms);
+
+TraceStats trace_get_stats();
+#else
+static inline void trace_init() {}
+static inline void trace_pass(const SensorRaw &) {}
+static inline void trace_switches(uint8_t) {}
+static inline void trace_outputs(uint8_t) {}
+static inline void trace_control(uint32_t, uint32_t) {}
+static inline void trace_trigger(uint8_t, uint32_t) {}
+static inline void trace_config(const Config &) {}
+static inline void trace_flush(uint32_t) {}
+static inline TraceStats trace_get_stats() { return TraceStats{}; }
+#endif
+
+// ========== READING ==========
+// Shared by the flusher (record boundaries), the replay and the tools.
+
+typedef struct {
+    SensorTraceState sensor;
+    uint32_t         epoch;
+    uint8_t          switches;
+    uint8_t          outputs;
+    uint32_t         last_pump_epoch;
+    uint32_t         last_blower_epoch;
+} TraceState;
+
+typedef struct {
+    TraceType  type;
+    uint64_t   t_us;         // since the start of the buffer
+    bool       synced;       // a TRACE_STATE was read since the start or the last gap
+    SensorRaw  raw;          // TRACE_PASS
+    TraceState state;        // TRACE_STATE
+    Config     config;       // TRACE_CONFIG
+    uint8_t    bits;         // TRACE_SWITCH levels, TRACE_OUTPUT outputs, TRACE_TRIGGER program
+    uint32_t   pass;         // TRACE_CONTROL
+    uint32_t   epoch;        // TRACE_STATE, TRACE_CONTROL, TRACE_TRIGGER
+    uint32_t   dropped;      // TRACE_GAP
+} TraceRecord;
+
+typedef struct {
+    const uint8_t *p;
+    const uint8_t *end;
+    uint64_t       t_us;
+    bool           synced;
+    SensorRaw      prev;     // XOR base of TRACE_PASS
+    uint32_t       epoch;    // delta base of TRACE_CONTROL / TRACE_TRIGGER
+} TraceReader;
+
+/**
+ * Length of the record at p.
+ * @return 0 if it runs past avail bytes or the type is unknown.
+ */
+size_t trace_record_len(const uint8_t *p, size_t avail);
+
+/**
+ * Start reading a trace file (header first) or a bare run of records.
+ * @return False if a file's header is wrong.
+ */
+bool trace_reader_init(TraceReader &r, const uint8_t *buf, size_t len, bool header);
+
+/** @return 1 with the next record in rec, 0 at the end, -1 if malformed. */
+int trace_read(TraceReader &r, TraceRecord &rec);
+
+#endif // LOGIC_TRACE_H
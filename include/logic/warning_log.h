@@ -0,0 +1,40 @@
+/******************************************************************************
+ * @file    warning_log.h
+ * @author  Thomas Zoldowski
+ * @date    October 18, 2026
+ * @brief   Footer warning text and the warning history, without widgets.
+ *
+ * The Warnings screen shows this history in its table and the footer shows
+ * warning_text() (screens/screen_warnings.h). Keeping the strings here,
+ * apart from LVGL, lets host builds and the benchmarks use them.
+ ******************************************************************************/
+#ifndef LOGIC_WARNING_LOG_H
+#define LOGIC_WARNING_LOG_H
+
+#include <cstdint>
+#include <cstddef>
+#include <ctime>
+
+// Max number of warnings we keep in memory
+#define WARNING_LOG_MAX 20
+
+/**
+ * Footer text for a WarningMask (sensor_manager.h), e.g.
+ * "LOADING DOOR OPEN, HIGH TEMP".
+ * @return False for WARN_NONE, which reads "ALL SYSTEMS NOMINAL".
+ */
+bool warning_text(uint32_t mask, char *buf, size_t buf_sz);
+
+/** Put a warning at the top of the history, stamped HH:MM:SS local time; the oldest drops off when full. */
+void warning_log_add(const char *description, time_t now);
+
+/** Warnings held, at most WARNING_LOG_MAX. */
+int warning_log_count();
+
+/** Time stamp of entry i, 0 = newest. */
+const char *warning_log_time(int i);
+
+/** Description of entry i, 0 = newest. */
+const char *warning_log_desc(int i);
+
+#endif // LOGIC_WARNING_LOG_H
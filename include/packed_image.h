@@ -0,0 +1,44 @@
+/******************************************************************************
+ * @file    packed_image.h
+ * @author  Thomas Zoldowski
+ * @date    October 18, 2026
+ * @brief   Palette + PackBits compressed images, decoded once into SDRAM.
+ *
+ * Large images are stored as 8-bit palette indices compressed with PackBits
+ * (generated by tools/pack_image.py). packed_image_decode() expands an image
+ * into an RGB565 buffer in SDRAM on first use and returns an ordinary LVGL
+ * image descriptor, so drawing costs the same as an uncompressed image.
+ ******************************************************************************/
+
+#ifndef PACKED_IMAGE_H
+#define PACKED_IMAGE_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include "lvgl.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct {
+    uint16_t        w;
+    uint16_t        h;
+    uint16_t        palette_len;
+    const uint16_t *palette;    // RGB565 colors
+    const uint8_t  *data;       // PackBits stream of palette indices
+    uint32_t        data_len;
+} packed_image_t;
+
+/**
+ * @brief Decode @p img into SDRAM (first call only) and return its descriptor.
+ * @return Cached RGB565 descriptor, or NULL if the image is corrupt or SDRAM
+ *         is out of memory.
+ */
+const lv_image_dsc_t *packed_image_decode(const packed_image_t *img);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* PACKED_IMAGE_H */
@@ -5,9 +5,9 @@
  * @brief   Header for the Historical Data Screen UI.
  *
  * Layout:
- *  - Line chart or bar chart showing trends over time
- *  - Tabs or dropdowns to switch between sensor types
- *  - Optional: export or save functionality (future)
+ *  - Metric selector (Temp / Hum / O2 / Fill) and window selector (1h - 30d)
+ *  - Line chart of the selected trend, decimated to the chart width
+ *  - Min/max of the visible window below the chart
  ******************************************************************************/
 
 #ifndef SCREEN_HISTORY_H
@@ -18,4 +18,10 @@
 // Create and return the history screen object
 lv_obj_t* create_history_screen(void);
 
+// Redraw the chart if new history has been stored since the last redraw
+void update_history_screen(void);
+
+// True while the history screen is loaded
+bool is_history_screen_active(void);
+
 #endif /* SCREEN_HISTORY_H */
@@ -19,7 +19,7 @@
 lv_obj_t* create_manual_control_screen(void);
 
 // Check if manual control screen is currently active
-void updateManualScreenLEDs(bool pumpActive, int blowState);
+void updateManualScreenLEDs(uint8_t outputs);
 
 
 #endif /* SCREEN_MOTORS_H */
@@ -22,8 +22,6 @@ lv_obj_t* create_sensor_screen(void);
 // update the sensor screen with current data
 void update_sensor_screen(void);
 
-void SensorDataToSerial();
-
 void CameraDelayToSerial();
 
 #endif /* SCREEN_SENSORS_H */
@@ -14,6 +14,7 @@
 #define SCREEN_SETTINGS_H
 
 #include <lvgl.h>
+#include "settings_storage.h"   // current setting values (getBlowerOnTime() etc.)
 
 lv_obj_t* create_settings_screen();
 
@@ -34,21 +35,27 @@ void security_timeout_check();
  */
 void lock_overlay_cb(lv_event_t *e);
 
-/** @brief  Returns the user-configured blower ON time (seconds). */
-uint16_t getBlowerOnTime();
-
-/** @brief  Returns the user-configured pump ON time (seconds). */
-uint16_t getPumpOnTime();
-
-uint16_t getActivationInterval();
-
-uint16_t getCameraDelay();
-
-uint16_t getSendInterval();
-
-uint16_t getTempHighThreshold(int sensor_id);
+// Settings that can be changed remotely (and through the keypad)
+enum SettingField : uint8_t {
+    SETTING_TEMP_LOW,           // °F, per sensor (index 0-2)
+    SETTING_TEMP_HIGH,          // °F, per sensor
+    SETTING_HUM_LOW,            // %RH, per sensor
+    SETTING_BLOWER_SEC,
+    SETTING_PUMP_SEC,
+    SETTING_ACTIVATION_MIN,
+    SETTING_CAMERA_DELAY_SEC,
+    SETTING_SEND_INTERVAL_MIN,
+    SETTING_FIELD_COUNT
+};
+
+/** @brief  Change a setting, save it to flash and refresh its label.
+ *         Returns false for an invalid field/index or out-of-range value.
+ *         Call from the LVGL/loop() context only.
+ */
+bool settings_set_value(SettingField field, uint8_t index, float value);
 
-uint16_t getHumLowThreshold(int sensor_id);
+/** @brief  Current value of a setting, NAN for an invalid field/index. */
+float settings_get_value(SettingField field, uint8_t index);
 
 extern unsigned long last_activity;
 
@@ -14,20 +14,14 @@
 #define SCREEN_WARNINGS_H
 
 #include <lvgl.h>
+#include "logic/sensor_manager.h"
 
 enum FooterStatus {
     FOOTER_OK,
     FOOTER_WARNING
 };
 
-// Possible warnings bitmask
-enum WarningMask {
-    WARN_NONE          = 0,
-    WARN_FRONT_DOOR    = 1 << 0,
-    WARN_BACK_DOOR     = 1 << 1,
-    WARN_LOADING_DOOR  = 1 << 2,
-    WARN_HIGH_TEMP     = 1 << 3,
-};
+// Possible warnings bitmask: WarningMask in sensor_manager.h
 
 // Add more warnings as needed
 void format_warnings(uint32_t mask, char *buf, size_t buf_sz, lv_obj_t *label);
@@ -0,0 +1,61 @@
+/******************************************************************************
+ * @file    serial_tx.h
+ * @author  Thomas Zoldowski
+ * @date    October 18, 2026
+ * @brief   Non-blocking USB serial output with a background drain thread.
+ *
+ * Nothing in loop() writes to Serial directly. Telemetry frames and debug
+ * text are copied into two fixed-size rings, and a low-priority thread
+ * performs the (possibly blocking) Serial.write() calls. If the Pi stops
+ * reading, only the drain thread stalls; compost control keeps running.
+ *
+ * Drop policy when a ring is full:
+ *  - debug:     the oldest whole lines are discarded to make room
+ *  - telemetry: never displaced by debug; a frame that does not fit in the
+ *               telemetry ring is rejected whole and counted
+ *
+ * Use DebugSerial exactly like Serial for text output. Not ISR-safe.
+ ******************************************************************************/
+
+#ifndef SERIAL_TX_H
+#define SERIAL_TX_H
+
+#include "hal.h"   // Arduino.h on the board
+#include <stdint.h>
+
+typedef struct {
+    uint32_t tlm_queued;    // telemetry bytes accepted
+    uint32_t tlm_dropped;   // telemetry bytes rejected (ring full)
+    uint32_t dbg_queued;    // debug bytes accepted
+    uint32_t dbg_dropped;   // debug bytes discarded (oldest first)
+    uint32_t written;       // bytes handed to Serial
+} SerialTxStats;
+
+/** Start the drain thread. Call right after Serial.begin(). */
+void serial_tx_init();
+
+/**
+ * Queue one complete telemetry frame (all or nothing).
+ * @return False if the telemetry ring has no room; the frame is dropped.
+ */
+bool serial_tx_write_telemetry(const uint8_t *data, size_t len);
+
+/** Wake the drain thread without queuing bytes (used by log.cpp). */
+void serial_tx_kick();
+
+/** Snapshot of the TX counters. */
+SerialTxStats serial_tx_get_stats();
+
+#if !HAL_SIM
+/** Print-compatible sink for debug text; queued into the debug ring. */
+class SerialTxDebug : public Print {
+public:
+    size_t write(uint8_t c) override;
+    size_t write(const uint8_t *buffer, size_t size) override;
+    using Print::write;
+};
+
+extern SerialTxDebug DebugSerial;
+#endif
+
+#endif /* SERIAL_TX_H */
@@ -1,7 +1,8 @@
-#include <Arduino.h>
-
 #ifndef SETTINGS_STORAGE_H
 #define SETTINGS_STORAGE_H
+
+#include "hal.h"   // Arduino.h on the board
+
 // This struct holds all of the user‐editable values
 // that you want to survive a reboot.
 typedef struct {
@@ -44,4 +45,24 @@ void loadConfig();
 // It will open "/config.bin" (creating/truncating if needed) and write all bytes.
 void saveConfig();
 
+// Current values of the settings. Defined by the settings screen, which
+// owns them; the M4 control firmware serves them from the copy the M7
+// shares (see core_link.h).
+
+/** @brief  Returns the user-configured blower ON time (seconds). */
+uint16_t getBlowerOnTime();
+
+/** @brief  Returns the user-configured pump ON time (seconds). */
+uint16_t getPumpOnTime();
+
+uint16_t getActivationInterval();
+
+uint16_t getCameraDelay();
+
+uint16_t getSendInterval();
+
+uint16_t getTempHighThreshold(int sensor_id);
+
+uint16_t getHumLowThreshold(int sensor_id);
+
 #endif /* SETTINGS_STORAGE_H_ */
\ No newline at end of file
@@ -0,0 +1,47 @@
+/******************************************************************************
+ * @file    Arduino.h
+ * @author  Thomas Zoldowski
+ * @date    October 18, 2026
+ * @brief   The few Arduino calls the UI makes, for host builds (HAL_SIM).
+ *
+ * Only on the include path of env:render, which builds the screens on a
+ * Linux host (src/render/main_render.cpp). Time is the sim's virtual
+ * clock (hal.h), so a run draws the same frames every time.
+ ******************************************************************************/
+#ifndef SIM_ARDUINO_H
+#define SIM_ARDUINO_H
+
+#include "hal.h"
+#include "sim/sim_bus.h"
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+static inline unsigned long millis() {
+    return hal_millis();
+}
+
+static inline unsigned long micros() {
+    return (unsigned long)hal_micros();
+}
+
+static inline void delay(unsigned long ms) {
+    hal_delay_ms((uint32_t)ms);
+}
+
+/** A number in [lo, hi), from the sim's seeded generator. */
+static inline long random(long lo, long hi) {
+    return hi > lo ? lo + (long)(sim_rand_ppm() % (uint32_t)(hi - lo)) : lo;
+}
+
+static inline long map(long x, long in_lo, long in_hi, long out_lo, long out_hi) {
+    return (x - in_lo) * (out_hi - out_lo) / (in_hi - in_lo) + out_lo;
+}
+
+template <typename T, typename L, typename H>
+static inline T constrain(T x, L lo, H hi) {
+    return x < lo ? (T)lo : (x > hi ? (T)hi : x);
+}
+
+#endif // SIM_ARDUINO_H
@@ -0,0 +1,23 @@
+/******************************************************************************
+ * @file    SDRAM.h
+ * @author  Thomas Zoldowski
+ * @date    October 18, 2026
+ * @brief   The GIGA's SDRAM heap as plain malloc, for host builds (HAL_SIM).
+ *
+ * Only on the include path of env:render (see Arduino.h next to it).
+ ******************************************************************************/
+#ifndef SIM_SDRAM_H
+#define SIM_SDRAM_H
+
+#include <cstdlib>
+
+class SDRAMClass {
+public:
+    int   begin()                 { return 1; }
+    void *malloc(size_t size)     { return ::malloc(size); }
+    void  free(void *ptr)         { ::free(ptr); }
+};
+
+inline SDRAMClass SDRAM;
+
+#endif // SIM_SDRAM_H
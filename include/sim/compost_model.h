@@ -0,0 +1,93 @@
+/******************************************************************************
+ * @file    compost_model.h
+ * @author  Thomas Zoldowski
+ * @date    October 18, 2026
+ * @brief   Lumped physical model of a compost batch for host runs (HAL_SIM).
+ *
+ * One well-mixed pile: wet mass, moisture, biodegradable volatile solids
+ * (VS), temperature and pore-gas O2, in a bin losing heat to the ambient.
+ *
+ *   - VS decays first order at k_max scaled by temperature (cardinal
+ *     temperature model), moisture (Haug's logistic) and O2 (Monod).
+ *   - Every kg of VS oxidised releases heat, uses O2 and forms water.
+ *   - Air through the pile (passive draught plus the blowers) refreshes
+ *     the O2 and carries away sensible heat and the water it evaporates.
+ *   - The pump adds water at ambient temperature; a load adds fresh
+ *     feedstock and mixes its heat into the pile.
+ *
+ * Everything is deterministic: the same parameters and actuator timings
+ * give the same batch. Sensor noise belongs to the sim_devices models.
+ ******************************************************************************/
+#ifndef SIM_COMPOST_MODEL_H
+#define SIM_COMPOST_MODEL_H
+
+#include <cstdint>
+
+typedef struct {
+    // Kinetics
+    float k_max_per_day;        // VS decay rate at optimal conditions
+    float t_min_c;              // cardinal temperatures of the microbial activity
+    float t_opt_c;
+    float t_max_c;
+    float o2_half_pct;          // O2 at which activity is halved
+    float heat_j_per_kg;        // heat of VS oxidation
+    float o2_m3_per_kg;         // O2 used per kg VS
+    float water_kg_per_kg;      // metabolic water per kg VS
+    // Bin and air
+    float ua_w_per_k;           // wall conduction
+    float gas_m3;               // pore and headspace gas volume
+    float passive_m3_s;         // natural draught
+    float blower_m3_s;          // each blower
+    float pump_kg_s;            // water the pump delivers
+    // Surroundings
+    float ambient_mean_c;
+    float ambient_swing_c;      // daily ± swing, warmest at 15:00
+    float ambient_rh;           // 0..1
+    // Feedstock
+    float feed_moisture;        // wet-basis water fraction of fresh feed
+    float feed_vs_fraction;     // biodegradable VS per kg of its dry matter
+    float feed_temp_c;
+    // Geometry (ToF looks down from MAX_DEPTH_CM above the floor)
+    float bin_depth_cm;
+    float cm_per_kg;            // pile height per kg
+} CompostParams;
+
+typedef struct {
+    float mass_kg;              // wet mass
+    float water_kg;
+    float vs_kg;                // biodegradable VS left
+    float vs_in_kg;             // biodegradable VS ever loaded
+    float temp_c;
+    float o2_pct;
+    float ambient_c;
+} CompostState;
+
+/** A ~1 m³ in-vessel composter with food and yard waste. */
+void compost_default_params(CompostParams &p);
+
+/** Start a batch of mass_kg fresh feed at feed_temp_c. */
+void compost_init(CompostState &s, const CompostParams &p, float mass_kg);
+
+/**
+ * @brief Integrate the batch over dt_s seconds with fixed actuator states.
+ * @param t_s     Simulated time at the start of the interval (ambient cycle).
+ * @param blowers Blowers running (0..2).
+ */
+void compost_step(CompostState &s, const CompostParams &p, double t_s, float dt_s,
+                  uint8_t blowers, bool pump);
+
+/** Add kg of fresh feed through the loading door. */
+void compost_load(CompostState &s, const CompostParams &p, float kg);
+
+/** Wet-basis moisture, 0..1. */
+static inline float compost_moisture(const CompostState &s) {
+    return s.mass_kg > 0 ? s.water_kg / s.mass_kg : 0;
+}
+
+/** Relative humidity an AHT20 in the pile's headspace reads, percent. */
+float compost_headspace_rh(const CompostState &s);
+
+/** Distance from the ToF sensor to the pile surface, cm. */
+float compost_surface_cm(const CompostState &s, const CompostParams &p);
+
+#endif // SIM_COMPOST_MODEL_H
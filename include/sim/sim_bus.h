@@ -0,0 +1,116 @@
+/******************************************************************************
+ * @file    sim_bus.h
+ * @author  Thomas Zoldowski
+ * @date    October 18, 2026
+ * @brief   Host side of hal.h (HAL_SIM): virtual clock, GPIO and I2C bus.
+ *
+ * Devices (sim/sim_devices.h) attach to the bus at an address, either on
+ * the main bus or behind a channel of the simulated TCA9548. Every
+ * transfer costs bus time at sim_i2c_set_hz() plus the device's own
+ * latency, and advances the virtual clock by that much; pending
+ * HalTimeouts fire at their exact due time as the clock passes it.
+ *
+ * Faults are injected per device from a seeded generator, so a run with
+ * the same seed, configuration and inputs is identical every time.
+ ******************************************************************************/
+#ifndef SIM_SIM_BUS_H
+#define SIM_SIM_BUS_H
+
+#include <cstddef>
+#include <cstdint>
+
+#define SIM_MUX_CHANNELS  8
+#define SIM_MAIN_BUS      -1     // attach() channel for devices not behind the mux
+#define SIM_MAX_DEVICES   16
+#define SIM_MAX_PINS      64
+
+typedef struct {
+    uint32_t nack_ppm;       // transfers refused (address NACK), per million
+    uint32_t timeout_ppm;    // transfers that hang until the bus times out, per million
+    uint32_t corrupt_ppm;    // reads with one bit flipped, per million
+    bool     offline;        // never acknowledges (unplugged)
+    bool     stuck;          // acknowledges but keeps returning its last reading
+} SimFaults;
+
+typedef struct {
+    uint32_t writes;
+    uint32_t reads;
+    uint32_t bytes;
+    uint32_t nacks;          // refused, offline or timed out
+    uint32_t corrupted;
+    uint64_t bus_us;         // bus time spent on this device
+} SimI2cStats;
+
+/** A device model. Subclasses decode the bytes like the real part. */
+class SimI2cDevice {
+public:
+    virtual ~SimI2cDevice() {}
+    virtual const char *name() const = 0;
+
+    /** A write transfer (may be empty: a probe). Return false to NACK the data. */
+    virtual bool on_write(const uint8_t *data, size_t len) = 0;
+
+    /** A read transfer. @return Bytes supplied (the rest read as 0xFF). */
+    virtual size_t on_read(uint8_t *data, size_t len) = 0;
+
+    /** Mux only: channels currently switched through, bit per channel. */
+    virtual uint8_t channels() const { return 0; }
+
+    SimFaults   faults      = {};
+    uint32_t    latency_us  = 0;     // clock stretching per transfer
+    SimI2cStats stats       = {};
+};
+
+// ========== SETUP ==========
+/** Detach every device, clear GPIO and timers, restart the clock at epoch. */
+void sim_reset(uint32_t seed, uint32_t epoch);
+
+/** Map the board's "/user" to a host directory (default "."). */
+void sim_fs_set_root(const char *dir);
+
+/** Bus speed for transfer timing (default 100 kHz). */
+void sim_i2c_set_hz(uint32_t hz);
+
+/**
+ * Attach a device. The caller keeps it alive.
+ * @param channel SIM_MAIN_BUS, or the TCA9548 channel it sits behind.
+ */
+bool sim_i2c_attach(SimI2cDevice *dev, uint8_t addr, int8_t channel);
+
+/** The mux whose channels() route the devices behind it; attach it on SIM_MAIN_BUS too. */
+void sim_i2c_set_mux(SimI2cDevice *mux);
+
+// ========== TIME ==========
+/** Move the clock forward, firing timeouts that fall due on the way. */
+void sim_advance_us(uint64_t us);
+
+static inline void sim_advance_ms(uint32_t ms) {
+    sim_advance_us((uint64_t)ms * 1000);
+}
+
+/** Set hal_epoch() to epoch now; it runs on with the clock (e.g. a recorded RTC). */
+void sim_set_epoch(uint32_t epoch);
+
+// ========== GPIO ==========
+/** Drive an input pin as the outside world would. */
+void sim_pin_set(uint8_t pin, bool high);
+
+/** Level the logic last wrote to an output pin. */
+bool sim_pin_get(uint8_t pin);
+
+/** Called on every hal_pin_write(), e.g. to log actuator edges. */
+void sim_pin_on_write(void (*cb)(uint8_t pin, bool high));
+
+// ========== STATS ==========
+typedef struct {
+    uint32_t transfers;
+    uint32_t collisions;     // more than one device answered an address
+    uint64_t busy_us;        // bus time, all devices
+} SimBusStats;
+
+SimBusStats sim_i2c_stats();
+
+/** Uniform 0..1e6-1 from the fault generator (for models' own noise). */
+uint32_t sim_rand_ppm();
+
+#endif // SIM_SIM_BUS_H
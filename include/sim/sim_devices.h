@@ -0,0 +1,93 @@
+/******************************************************************************
+ * @file    sim_devices.h
+ * @author  Thomas Zoldowski
+ * @date    October 18, 2026
+ * @brief   Simulated I2C parts for host runs (HAL_SIM).
+ *
+ * Each model answers the register protocol the firmware uses on the real
+ * part, with the physical quantity as a public field for the simulation to
+ * set. `noise` adds a uniform ±noise error to every reading, and the
+ * SimI2cDevice fields add latency and faults (sim/sim_bus.h).
+ *
+ *   SimTca9548  0x70  channel mask register
+ *   SimAht20    0x38  0xAC trigger, ~80 ms conversion, status + 20-bit RH/T
+ *   SimVl53l1x  0x29  16-bit registers: model id, start/stop, data ready,
+ *                     result block, interrupt clear; one range per period
+ *   SimSen0322  0x73  key register 0x0A, oxygen data 0x03 (3 bytes)
+ *   SimTmp117   0x48  temperature 0x00, configuration 0x01, id 0x0F
+ ******************************************************************************/
+#ifndef SIM_SIM_DEVICES_H
+#define SIM_SIM_DEVICES_H
+
+#include "sim/sim_bus.h"
+
+class SimTca9548 : public SimI2cDevice {
+public:
+    const char *name() const override { return "TCA9548"; }
+    bool    on_write(const uint8_t *data, size_t len) override;
+    size_t  on_read(uint8_t *data, size_t len) override;
+    uint8_t channels() const override { return control; }
+
+    uint8_t control = 0;
+};
+
+class SimAht20 : public SimI2cDevice {
+public:
+    const char *name() const override { return "AHT20"; }
+    bool   on_write(const uint8_t *data, size_t len) override;
+    size_t on_read(uint8_t *data, size_t len) override;
+
+    float    temp_c          = 20.0f;
+    float    rh              = 50.0f;
+    float    noise           = 0.0f;     // applied to both
+    uint32_t conversion_ms   = 80;
+private:
+    bool     calibrated      = true;
+    uint64_t ready_us        = 0;
+    uint32_t raw_h           = 0;
+    uint32_t raw_t           = 0;
+};
+
+class SimVl53l1x : public SimI2cDevice {
+public:
+    const char *name() const override { return "VL53L1X"; }
+    bool   on_write(const uint8_t *data, size_t len) override;
+    size_t on_read(uint8_t *data, size_t len) override;
+
+    float    distance_cm     = 50.0f;
+    float    noise           = 0.0f;
+    uint32_t period_ms       = 50;       // continuous-mode inter-measurement period
+private:
+    bool     data_ready() const;
+    uint16_t reg             = 0;
+    bool     ranging         = false;
+    uint64_t next_ready_us   = 0;
+};
+
+class SimSen0322 : public SimI2cDevice {
+public:
+    const char *name() const override { return "SEN0322"; }
+    bool   on_write(const uint8_t *data, size_t len) override;
+    size_t on_read(uint8_t *data, size_t len) override;
+
+    float    o2_percent      = 20.9f;
+    float    noise           = 0.0f;
+    uint8_t  key             = 0;        // 0 = uncalibrated (factor 20.9 / 120)
+private:
+    uint8_t  reg             = 0;
+};
+
+class SimTmp117 : public SimI2cDevice {
+public:
+    const char *name() const override { return "TMP117"; }
+    bool   on_write(const uint8_t *data, size_t len) override;
+    size_t on_read(uint8_t *data, size_t len) override;
+
+    float    temp_c          = 25.0f;
+    float    noise           = 0.0f;
+private:
+    uint8_t  reg             = 0;
+    uint16_t config          = 0x0220;   // power-on default
+};
+
+#endif // SIM_SIM_DEVICES_H
@@ -0,0 +1,120 @@
+/******************************************************************************
+ * @file    snapshot_ring.h
+ * @author  Thomas Zoldowski
+ * @date    October 18, 2026
+ * @brief   Wait-free single-producer ring of fixed-size records.
+ *
+ * One context publishes records (e.g. a SensorSnapshot per acquisition
+ * pass); readers in other threads copy the newest one, or one consumer
+ * walks every record in order. Nothing locks and nothing is allocated:
+ *
+ *   - publish() always completes in a fixed number of steps. When the
+ *     ring is full the oldest record is overwritten.
+ *   - latest() never waits. Every slot carries its own sequence number
+ *     (odd while being written), so a reader retries only if the producer
+ *     lapped the whole ring during its copy, and after SNAPSHOT_RETRIES
+ *     such laps it gives up rather than spin.
+ *   - pop() is for a single consumer that needs every record; records it
+ *     was too slow for are skipped and counted.
+ *
+ * Slots are aligned to SNAPSHOT_LINE (the M7's 32-byte D-cache line) so a
+ * write to one slot never touches a line holding another, which keeps
+ * per-slot cache maintenance exact if a ring is placed in memory shared
+ * with the M4 or a DMA engine.
+ *
+ *   static SnapshotRing<SensorSnapshot, 4> ring;
+ *   ring.publish(s);                    // producer
+ *   SensorSnapshot now;
+ *   if (ring.latest(now)) show(now);    // any reader
+ ******************************************************************************/
+#ifndef SNAPSHOT_RING_H
+#define SNAPSHOT_RING_H
+
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+#define SNAPSHOT_LINE     32   // M7 D-cache line
+#define SNAPSHOT_RETRIES  4    // laps a reader tolerates before giving up
+
+template <typename T, uint32_t N>
+class SnapshotRing {
+    static_assert(N >= 2 && (N & (N - 1)) == 0, "slot count must be a power of two >= 2");
+    static_assert(std::is_trivially_copyable<T>::value, "records are copied with memcpy");
+
+public:
+    /** Store a record, overwriting the oldest one if the ring is full. Producer only. */
+    void publish(const T &value) {
+        uint32_t n    = head_.load(std::memory_order_relaxed) + 1;   // record number, from 1
+        Slot    &slot = slots_[(n - 1) & (N - 1)];
+        slot.seq.store(2 * n - 1, std::memory_order_relaxed);       // odd: being written
+        std::atomic_thread_fence(std::memory_order_release);
+        memcpy(&slot.value, &value, sizeof(T));
+        slot.seq.store(2 * n, std::memory_order_release);
+        head_.store(n, std::memory_order_release);
+    }
+
+    /**
+     * Copy the newest record. Any number of readers.
+     * @return False if nothing was published yet, or the producer kept
+     *         overwriting the slot during the copy (out is then undefined).
+     */
+    bool latest(T &out) const {
+        for (uint8_t tries = 0; tries < SNAPSHOT_RETRIES; tries++) {
+            uint32_t n = head_.load(std::memory_order_acquire);
+            if (n == 0) return false;
+            if (copy(n, out)) return true;
+        }
+        return false;
+    }
+
+    /**
+     * Take the oldest record not yet consumed. Single consumer.
+     * @param lost Incremented by the records overwritten before they were read.
+     * @return False if there is nothing new.
+     */
+    bool pop(T &out, uint32_t &lost) {
+        for (;;) {
+            uint32_t head = head_.load(std::memory_order_acquire);
+            if (tail_ == head) return false;
+            if (head - tail_ > N) {              // lapped: skip to the oldest slot still held
+                lost += head - tail_ - N;
+                tail_ = head - N;
+            }
+            uint32_t n = tail_ + 1;
+            if (copy(n, out)) {
+                tail_ = n;
+                return true;
+            }
+            lost++;                              // overwritten while copying
+            tail_ = n;
+        }
+    }
+
+    /** Records published so far. */
+    uint32_t published() const {
+        return head_.load(std::memory_order_acquire);
+    }
+
+private:
+    struct alignas(SNAPSHOT_LINE) Slot {
+        std::atomic<uint32_t> seq{0};   // 2n once record n is complete
+        T                     value;
+    };
+
+    /** @brief Copy record n if its slot still holds it, complete and untorn. */
+    bool copy(uint32_t n, T &out) const {
+        const Slot &slot = slots_[(n - 1) & (N - 1)];
+        if (slot.seq.load(std::memory_order_acquire) != 2 * n) return false;
+        memcpy(&out, &slot.value, sizeof(T));
+        std::atomic_thread_fence(std::memory_order_acquire);
+        return slot.seq.load(std::memory_order_relaxed) == 2 * n;
+    }
+
+    Slot slots_[N];
+    alignas(SNAPSHOT_LINE) std::atomic<uint32_t> head_{0};   // records published (producer)
+    alignas(SNAPSHOT_LINE) uint32_t              tail_ = 0;  // records consumed (pop() only)
+};
+
+#endif // SNAPSHOT_RING_H
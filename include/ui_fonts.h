@@ -0,0 +1,36 @@
+/******************************************************************************
+ * @file    ui_fonts.h
+ * @author  Thomas Zoldowski
+ * @date    October 18, 2026
+ * @brief   Fonts used by the UI.
+ *
+ * When tools/gen_fonts.py could build the subset fonts it defines
+ * UI_SUBSET_FONTS, and the UI uses ui_font_36/40/48: Montserrat with only the
+ * glyphs that appear in the screens' strings. Otherwise the built-in
+ * lv_font_montserrat_* fonts are used. Screens should always use the
+ * UI_FONT_* macros so the two builds stay interchangeable.
+ *
+ * Text that only exists at runtime must be added to EXTRA_CHARS in
+ * gen_fonts.py, or its glyphs will be missing from the subset.
+ ******************************************************************************/
+
+#ifndef UI_FONTS_H
+#define UI_FONTS_H
+
+#include <lvgl.h>
+
+#ifdef UI_SUBSET_FONTS
+LV_FONT_DECLARE(ui_font_36);
+LV_FONT_DECLARE(ui_font_40);
+LV_FONT_DECLARE(ui_font_48);
+
+#define UI_FONT_36  (&ui_font_36)
+#define UI_FONT_40  (&ui_font_40)
+#define UI_FONT_48  (&ui_font_48)
+#else
+#define UI_FONT_36  (&lv_font_montserrat_36)
+#define UI_FONT_40  (&lv_font_montserrat_40)
+#define UI_FONT_48  (&lv_font_montserrat_48)
+#endif
+
+#endif /* UI_FONTS_H */
@@ -11,6 +11,10 @@
  * Functions:
  *  - ui_init(): Initializes the display and default screen
  *  - ui_switch_to(ScreenID): Switches to a specified screen
+ *
+ * The header bar, navigation dropdown and status footer are created once on
+ * lv_layer_top() and shared by every screen; only the title and the
+ * screen-specific header buttons change on navigation.
  ******************************************************************************/
 
 #ifndef UI_MANAGER_H
@@ -23,13 +27,17 @@ void create_global_dropdown(lv_obj_t *parent);
 void handle_screen_selection(const char *selected_label);
 
 /**
- * @brief Create a standard header bar on the given parent screen.
- * @param parent     The screen or container to attach the header to.
- * @param title_txt  The title string to display centered in the header.
+ * @brief Register a screen with the shared header bar.
+ * @param parent     The screen that shows this title while it is active.
+ * @param title_txt  The title string (must stay valid, e.g. a literal).
+ * @return Transparent container laid over the header area for the screen's
+ *         own header buttons. It is only visible while @p parent is active.
  */
-void create_header(lv_obj_t *parent, const char *title_txt);
+lv_obj_t* create_header(lv_obj_t *parent, const char *title_txt);
+
+/** @brief Show or hide the shared header, dropdown and footer (hidden on Home). */
+void ui_set_chrome_visible(bool visible);
 
-void create_footer(lv_obj_t *parent);
 void update_footer_status(uint32_t warning_mask);
 
 void ensure_dropdown_style();
@@ -38,4 +46,8 @@ extern int       selected_index;
 
 void ui_init();
 
+/** @brief Create the shared header, dropdown and footer. ui_init() does this first;
+ *  the render benchmark (src/render/main_render.cpp) calls it before building screens one at a time. */
+void create_chrome();
+
 #endif /* UI_MANAGER_H */
@@ -0,0 +1,253 @@
+/******************************************************************************
+ * @file    bench.cpp
+ * @author  Thomas Zoldowski
+ * @date    October 18, 2026
+ * @brief   Microbenchmarks of the firmware's hot paths.
+ ******************************************************************************/
+#include "bench/bench.h"
+#include "cycle_counter.h"
+#include "json_writer.h"
+#include "settings_storage.h"
+#include "logic/sensor_manager.h"
+#include "logic/telemetry.h"
+#include "logic/warning_log.h"
+#include "logic/net_encode.h"
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#if !HAL_SIM
+#include <lvgl.h>
+#include "screens/screen_warnings.h"
+#endif
+
+#define LOG_TAG   "BENCH"
+#define LOG_LEVEL LOG_LEVEL_INFO
+#include "log.h"
+
+// Every save is a LittleFS write; keep the board's flash wear small
+#if HAL_SIM
+#define BENCH_FLASH_ITERS  500
+#else
+#define BENCH_FLASH_ITERS  5
+#endif
+
+#define BENCH_EPOCH        1760800000u   // 2025-10-18, any fixed date will do
+#define BENCH_BATCH        10            // readings per MQTT-style batch
+
+typedef struct {
+    const char *name;
+    uint32_t    iters;              // per repetition
+    void      (*setup)();           // before the warm-up; may be nullptr
+    void      (*op)(uint32_t i);
+    void      (*teardown)();        // may be nullptr
+} BenchCase;
+
+// Results land here so the compiler can't drop the work
+static volatile uint32_t sink;
+
+#if HAL_SIM
+static FILE *out = stdout;
+
+void bench_set_output(FILE *f) {
+    out = f;
+}
+#endif
+
+// ========== Warnings ==========
+static void op_warning_text(uint32_t i) {
+    char buf[128];
+    warning_text(i & 0x0F, buf, sizeof(buf));   // every door/temperature combination
+    sink += (uint8_t)buf[0];
+}
+
+static void op_warning_log_add(uint32_t i) {
+    warning_log_add("LOADING DOOR OPENED", (time_t)(BENCH_EPOCH + i));
+}
+
+#if !HAL_SIM
+static lv_obj_t *bench_label = nullptr;
+
+static void setup_format_warnings() {
+    lv_lock();
+    bench_label = lv_label_create(lv_layer_top());
+    lv_unlock();
+}
+
+static void op_format_warnings(uint32_t i) {
+    char buf[128];
+    lv_lock();
+    format_warnings(i & 0x0F, buf, sizeof(buf), bench_label);
+    lv_unlock();
+    sink += (uint8_t)buf[0];
+}
+
+static void teardown_format_warnings() {
+    lv_lock();
+    lv_obj_delete(bench_label);
+    bench_label = nullptr;
+    lv_unlock();
+}
+
+static void op_add_warning(uint32_t i) {
+    (void)i;
+    lv_lock();
+    add_warning("LOADING DOOR OPENED");
+    lv_unlock();
+}
+#endif
+
+// ========== Fill level ==========
+static FillFilter fill_filter;
+static float      distances[64];
+
+/** @brief A slowly settling pile with noise, a dropout and the odd reflection. */
+static void setup_fill_filter() {
+    fill_filter = {};
+    for (int i = 0; i < 64; i++) {
+        float noise = (float)((i * 37) % 11 - 5) * 0.3f;
+        distances[i] = 60.0f + i * 0.05f + noise;
+        if (i % 16 == 7)  distances[i] = NAN;     // no echo
+        if (i % 16 == 12) distances[i] = 8.0f;    // lid reflection, an outlier
+    }
+}
+
+static void op_fill_filter(uint32_t i) {
+    float pct = fill_filter_update(fill_filter, distances[i & 63]);
+    sink += (uint32_t)pct;
+}
+
+// ========== Telemetry framing ==========
+// A full TLM_SAMPLES frame as telemetry_send() builds it, without queuing
+// it for the Pi
+static uint8_t tlm_raw[4 + TLM_MAX_PAYLOAD + 2];
+
+static void setup_tlm_encode() {
+    for (size_t i = 0; i < sizeof(tlm_raw); i++) {
+        tlm_raw[i] = (uint8_t)(i * 29 + 3);
+        if (i % 23 == 0) tlm_raw[i] = 0x00;      // fixed-point fields hold plenty of zeros
+    }
+}
+
+static void op_tlm_encode(uint32_t i) {
+    uint8_t wire[sizeof(tlm_raw) + sizeof(tlm_raw) / 254 + 3];
+    size_t n = sizeof(tlm_raw) - 2;
+    tlm_raw[2] = (uint8_t)i;
+    uint16_t crc = telemetry_crc16(tlm_raw, n);
+    tlm_raw[n]     = (uint8_t)crc;
+    tlm_raw[n + 1] = (uint8_t)(crc >> 8);
+    wire[0] = 0x00;
+    size_t w = 1 + telemetry_cobs_encode(tlm_raw, sizeof(tlm_raw), &wire[1]);
+    wire[w++] = 0x00;
+    sink += (uint32_t)w;
+}
+
+// ========== Upload JSON ==========
+static NetReading reading;
+
+static void setup_json() {
+    reading.timestamp = BENCH_EPOCH;
+    for (int i = 0; i < 3; i++) {
+        reading.temp_f[i] = 131.4f + i;
+        reading.hum[i]    = 54.25f - i;
+    }
+    reading.temp_f[2] = NAN;                     // one missing probe
+    reading.o2        = 17.8f;
+}
+
+static void op_json_reading(uint32_t i) {
+    char body[512];
+    JsonWriter w;
+    reading.timestamp = BENCH_EPOCH + i;
+    json_init(w, body, sizeof(body));
+    json_begin_object(w);
+    json_key(w, "deviceId"); json_string(w, "GIGA-001");
+    net_encode_reading(w, reading);
+    json_end_object(w);
+    json_finish(w);
+    sink += (uint32_t)json_length(w);
+}
+
+static void op_json_batch(uint32_t i) {
+    char payload[2048];
+    JsonWriter w;
+    json_init(w, payload, sizeof(payload));
+    json_begin_object(w);
+    json_key(w, "deviceId"); json_string(w, "GIGA-001");
+    json_key(w, "readings");
+    json_begin_array(w);
+    for (uint32_t k = 0; k < BENCH_BATCH; k++) {
+        reading.timestamp = BENCH_EPOCH + i * BENCH_BATCH + k;
+        json_begin_object(w);
+        net_encode_reading(w, reading);
+        json_end_object(w);
+    }
+    json_end_array(w);
+    json_end_object(w);
+    json_finish(w);
+    sink += (uint32_t)json_length(w);
+}
+
+// ========== Settings ==========
+static void op_config_save(uint32_t i) {
+    (void)i;
+    saveConfig();
+}
+
+static void op_config_load(uint32_t i) {
+    (void)i;
+    loadConfig();
+    sink += config.pump_duration_sec;
+}
+
+static const BenchCase cases[] = {
+    { "warning_text",    20000, nullptr,               op_warning_text,    nullptr },
+    { "warning_log_add",  5000, nullptr,               op_warning_log_add, nullptr },
+#if !HAL_SIM
+    { "format_warnings", 20000, setup_format_warnings, op_format_warnings, teardown_format_warnings },
+    { "add_warning",       200, nullptr,               op_add_warning,     nullptr },
+#endif
+    { "fill_filter",     20000, setup_fill_filter,     op_fill_filter,     nullptr },
+    { "tlm_encode",       5000, setup_tlm_encode,      op_tlm_encode,      nullptr },
+    { "json_reading",     5000, setup_json,            op_json_reading,    nullptr },
+    { "json_batch10",     1000, setup_json,            op_json_batch,      nullptr },
+    { "config_save",  BENCH_FLASH_ITERS, nullptr,      op_config_save,     nullptr },
+    { "config_load",  BENCH_FLASH_ITERS, nullptr,      op_config_load,     nullptr },
+};
+
+/** @brief Time one pass over all iterations, in cycles (ns on a host). */
+static uint32_t run_rep(const BenchCase &c) {
+    uint32_t c0 = cycle_count();
+    for (uint32_t i = 0; i < c.iters; i++) c.op(i);
+    return cycle_count() - c0;
+}
+
+static void report(const BenchCase &c, uint32_t best) {
+    double ns = (double)cycles_to_ns(best) / c.iters;
+#if HAL_SIM
+    fprintf(out, "BENCH: %s iters=%lu ns/op=%.1f\n", c.name, (unsigned long)c.iters, ns);
+    fflush(out);
+#else
+    double cycles = (double)best / c.iters;
+    LOG_I("%s iters=%lu ns/op=%.1f cycles/op=%.1f", c.name, (unsigned long)c.iters, ns, cycles);
+#endif
+}
+
+int bench_run(const char *filter, void (*between)()) {
+    cycle_counter_init();
+    int run = 0;
+    for (const BenchCase &c : cases) {
+        if (filter && !strstr(c.name, filter)) continue;
+        if (c.setup) c.setup();
+        run_rep(c);                                   // warm-up: caches, first-time allocations
+        uint32_t best = UINT32_MAX;
+        for (int r = 0; r < BENCH_REPS; r++) {
+            if (between) between();
+            uint32_t spent = run_rep(c);
+            if (spent < best) best = spent;
+        }
+        if (c.teardown) c.teardown();
+        report(c, best);
+        run++;
+    }
+    return run;
+}
@@ -0,0 +1,72 @@
+/******************************************************************************
+ * @file    main_bench.cpp
+ * @author  Thomas Zoldowski
+ * @date    October 18, 2026
+ * @brief   Host run of the microbenchmarks (bench/bench.h).
+ *
+ * The settings file goes to a fresh temporary directory standing in for
+ * LittleFS (hal_fs on the sim, see sim/sim_bus.h), so config_save and
+ * config_load time the same code as on the board against the host's disk.
+ *
+ *   pio run -e bench
+ *   .pio/build/bench/program | python tools/bench_compare.py --env bench
+ *
+ * Options:
+ *   --filter TEXT   only cases whose name contains TEXT
+ *   --log           print the firmware's log as well
+ ******************************************************************************/
+#include "hal.h"
+#include "settings_storage.h"
+#include "bench/bench.h"
+#include "sim/sim_bus.h"
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <dirent.h>
+#include <unistd.h>
+
+/** @brief Remove the temporary /user and the files the firmware left in it. */
+static void remove_dir(const char *dir) {
+    DIR *d = opendir(dir);
+    if (!d) return;
+    char path[256];
+    while (struct dirent *e = readdir(d)) {
+        if (!strcmp(e->d_name, ".") || !strcmp(e->d_name, "..")) continue;
+        if (snprintf(path, sizeof(path), "%s/%s", dir, e->d_name) < (int)sizeof(path)) unlink(path);
+    }
+    closedir(d);
+    rmdir(dir);
+}
+
+int main(int argc, char **argv) {
+    const char *filter  = nullptr;
+    bool        verbose = false;
+    for (int i = 1; i < argc; i++) {
+        const char *a = argv[i];
+        if (!strcmp(a, "--filter") && i + 1 < argc) filter  = argv[++i];
+        else if (!strcmp(a, "--log"))               verbose = true;
+        else { fprintf(stderr, "unknown option %s (see main_bench.cpp)\n", a); return 2; }
+    }
+
+    char tmp[] = "/tmp/composter-bench-XXXXXX";
+    if (!mkdtemp(tmp)) { perror("mkdtemp"); return 2; }
+    sim_reset(1, 1760800000u);
+    sim_fs_set_root(tmp);
+
+    // The firmware logs to stdout; results go to the real one unless --log
+    fflush(stdout);
+    FILE *report = fdopen(dup(STDOUT_FILENO), "w");
+    if (!verbose) freopen("/dev/null", "w", stdout);
+    bench_set_output(report);
+
+    loadConfig();   // writes the defaults, so config_load finds a file
+    int run = bench_run(filter, nullptr);
+
+    fclose(report);
+    remove_dir(tmp);
+    if (run == 0) {
+        fprintf(stderr, "no case matches '%s'\n", filter ? filter : "");
+        return 2;
+    }
+    return 0;
+}
@@ -0,0 +1,82 @@
+/******************************************************************************
+ * @file    display_power.cpp
+ * @author  Thomas Zoldowski
+ * @date    October 18, 2026
+ * @brief   Implementation of backlight dimming and render suspension.
+ ******************************************************************************/
+
+#include "display_power.h"
+#include "config.h"
+
+#include <Arduino.h>
+#include <lvgl.h>
+#include "Arduino_GigaDisplay.h"
+
+#define LOG_TAG   "PWR"
+#define LOG_LEVEL LOG_LEVEL_DISPLAY
+#include "log.h"
+
+static GigaDisplayBacklight backlight;
+static DisplayPowerState    power_state = DISPLAY_AWAKE;
+
+/** @brief Initialize the backlight at full brightness. */
+void display_power_init() {
+    backlight.begin();
+    backlight.set(DISPLAY_BRIGHTNESS_FULL);
+    power_state = DISPLAY_AWAKE;
+}
+
+/** @brief Advance the inactivity stages.
+ *  Dims the backlight after DISPLAY_DIM_TIMEOUT_MS, then turns it off and
+ *  stops LVGL from invalidating (and therefore rendering) after
+ *  DISPLAY_OFF_TIMEOUT_MS.
+ *  @param now           Current millis().
+ *  @param last_input_ms millis() of the last touch.
+ */
+void display_power_update(uint32_t now, uint32_t last_input_ms) {
+    uint32_t idle = now - last_input_ms;
+
+    if (power_state == DISPLAY_AWAKE && idle >= DISPLAY_DIM_TIMEOUT_MS) {
+        backlight.set(DISPLAY_BRIGHTNESS_DIM);
+        power_state = DISPLAY_DIMMED;
+        LOG_I("Display dimmed");
+    }
+
+    if (power_state == DISPLAY_DIMMED && idle >= DISPLAY_OFF_TIMEOUT_MS) {
+        backlight.set(0);
+        // Label/style changes no longer mark areas dirty, so the refresh
+        // timer stays paused and nothing is rendered while the panel is dark
+        lv_display_enable_invalidation(lv_display_get_default(), false);
+        power_state = DISPLAY_OFF;
+        LOG_I("Display off, rendering suspended");
+    }
+}
+
+/** @brief Bring the panel back to full brightness and resume rendering.
+ *  @return true if the panel was off.
+ */
+bool display_power_wake() {
+    if (power_state == DISPLAY_AWAKE) return false;
+
+    bool was_off = (power_state == DISPLAY_OFF);
+    if (was_off) {
+        lv_display_enable_invalidation(lv_display_get_default(), true);
+        // Everything that changed while dark was never drawn
+        lv_obj_invalidate(lv_screen_active());
+        lv_obj_invalidate(lv_layer_top());
+    }
+    backlight.set(DISPLAY_BRIGHTNESS_FULL);
+    power_state = DISPLAY_AWAKE;
+    LOG_I("Display awake");
+    return was_off;
+}
+
+/** @brief Get the current display power stage. */
+DisplayPowerState display_power_state() {
+    return power_state;
+}
+
+/** @brief Check whether LVGL is currently rendering. */
+bool display_power_is_rendering() {
+    return power_state != DISPLAY_OFF;
+}
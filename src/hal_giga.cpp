@@ -0,0 +1,116 @@
+/******************************************************************************
+ * @file    hal_giga.cpp
+ * @author  Thomas Zoldowski
+ * @date    October 18, 2026
+ * @brief   hal.h on the Arduino GIGA R1: Wire, GPIO, Mbed timers, LittleFS.
+ ******************************************************************************/
+#include "hal.h"
+#include <Wire.h>
+#include <mbed.h>
+#include <stdio.h>
+#include <time.h>
+#include "hal/ticker_api.h"
+#include "hal/trng_api.h"
+#include "hal/us_ticker_api.h"
+
+// ========== I2C ==========
+void hal_i2c_begin() {
+    Wire.begin();
+}
+
+uint8_t hal_i2c_write(uint8_t addr, const uint8_t *data, size_t len, bool stop) {
+    Wire.beginTransmission(addr);
+    if (len) Wire.write(data, len);
+    return Wire.endTransmission(stop);
+}
+
+size_t hal_i2c_read(uint8_t addr, uint8_t *data, size_t len) {
+    size_t n = Wire.requestFrom(addr, (uint8_t)len);
+    for (size_t i = 0; i < n; i++) data[i] = (uint8_t)Wire.read();
+    return n;
+}
+
+// ========== GPIO ==========
+void hal_pin_mode(uint8_t pin, HalPinMode mode) {
+    pinMode(pin, mode == HAL_OUTPUT ? OUTPUT : INPUT);
+}
+
+void hal_pin_write(uint8_t pin, bool high) {
+    digitalWrite(pin, high ? HIGH : LOW);   // pin was set up by pinMode(), so nothing is allocated here
+}
+
+bool hal_pin_read(uint8_t pin) {
+    return digitalRead(pin) == HIGH;
+}
+
+// ========== CLOCK ==========
+uint32_t hal_millis() {
+    return millis();
+}
+
+uint64_t hal_micros() {
+    return ticker_read_us(get_us_ticker_data());
+}
+
+uint32_t hal_epoch() {
+    return (uint32_t)time(nullptr);
+}
+
+void hal_delay_ms(uint32_t ms) {
+    delay(ms);
+}
+
+uint32_t hal_random32() {
+    uint32_t v = 0;
+#if DEVICE_TRNG
+    trng_t trng;
+    size_t got = 0;
+    trng_init(&trng);
+    int rc = trng_get_bytes(&trng, (uint8_t *)&v, sizeof(v), &got);
+    trng_free(&trng);
+    if (rc == 0 && got == sizeof(v)) return v;
+#endif
+    // No RNG in this core's build: boot timing is all there is
+    return (uint32_t)hal_micros() * 2654435761u;
+}
+
+void hal_timeout_start(HalTimeout &t, void (*fn)(void *), void *arg, uint32_t ms) {
+    t.attach(mbed::callback(fn, arg), std::chrono::milliseconds(ms));
+}
+
+void hal_timeout_stop(HalTimeout &t) {
+    t.detach();
+}
+
+void hal_critical_enter() {
+    core_util_critical_section_enter();
+}
+
+void hal_critical_exit() {
+    core_util_critical_section_exit();
+}
+
+// ========== FILESYSTEM ==========
+bool hal_fs_read(const char *path, void *buf, size_t len) {
+    FILE *f = fopen(path, "rb");
+    if (!f) return false;
+    size_t n = fread(buf, 1, len, f);
+    fclose(f);
+    return n == len;
+}
+
+bool hal_fs_write(const char *path, const void *buf, size_t len) {
+    FILE *f = fopen(path, "wb");
+    if (!f) return false;
+    size_t n = fwrite(buf, 1, len, f);
+    fclose(f);
+    return n == len;
+}
+
+bool hal_fs_append(const char *path, const void *buf, size_t len) {
+    FILE *f = fopen(path, "ab");
+    if (!f) return false;
+    size_t n = fwrite(buf, 1, len, f);
+    fclose(f);
+    return n == len;
+}
@@ -0,0 +1,218 @@
+/******************************************************************************
+ * @file    json_writer.cpp
+ * @author  Thomas Zoldowski
+ * @date    October 18, 2026
+ * @brief   Streaming JSON encoder (see json_writer.h).
+ ******************************************************************************/
+
+#include "json_writer.h"
+#include <math.h>
+#include <string.h>
+
+static const uint32_t pow10_table[JSON_MAX_DECIMALS + 1] = {
+    1, 10, 100, 1000, 10000, 100000, 1000000
+};
+
+/** @brief Hand the buffer to the flush callback. @return False if that is not possible. */
+static bool flush_buf(JsonWriter &w) {
+    if (!w.flush || !w.flush(w.ctx, w.buf, w.len)) {
+        w.failed = true;
+        return false;
+    }
+    w.len = 0;
+    return true;
+}
+
+/** @brief Append raw bytes. */
+static void put(JsonWriter &w, const char *s, size_t n) {
+    if (w.failed) return;
+    while (n > 0) {
+        if (w.len == w.size && !flush_buf(w)) return;
+        size_t room = w.size - w.len;
+        size_t k    = n < room ? n : room;
+        memcpy(&w.buf[w.len], s, k);
+        w.len   += k;
+        w.total += k;
+        s       += k;
+        n       -= k;
+    }
+}
+
+/** @brief Append one character. */
+static inline void put_c(JsonWriter &w, char c) {
+    put(w, &c, 1);
+}
+
+/** @brief Write the separator due before a new element of the current container. */
+static void separate(JsonWriter &w) {
+    if (w.after_key) {                  // value of a key: the ':' is already out
+        w.after_key = false;
+        return;
+    }
+    uint16_t bit = (uint16_t)(1u << w.depth);
+    if (w.has_items & bit) put_c(w, ',');
+    w.has_items |= bit;
+}
+
+/** @brief Append an unsigned value in decimal. */
+static void put_u32(JsonWriter &w, uint32_t v) {
+    char tmp[10];
+    int  i = sizeof(tmp);
+    do {
+        tmp[--i] = (char)('0' + v % 10);
+        v /= 10;
+    } while (v);
+    put(w, &tmp[i], sizeof(tmp) - i);
+}
+
+/** @brief Append a string with JSON escaping. */
+static void put_escaped(JsonWriter &w, const char *s) {
+    static const char hex[] = "0123456789abcdef";
+    put_c(w, '"');
+    const char *run = s;                // start of bytes not needing escapes
+    for (; *s; s++) {
+        unsigned char c = (unsigned char)*s;
+        if (c >= 0x20 && c != '"' && c != '\\') continue;
+        put(w, run, s - run);
+        char esc[6] = { '\\', 'u', '0', '0', hex[c >> 4], hex[c & 0xF] };
+        switch (c) {
+            case '"':  put(w, "\\\"", 2); break;
+            case '\\': put(w, "\\\\", 2); break;
+            case '\n': put(w, "\\n", 2);  break;
+            case '\r': put(w, "\\r", 2);  break;
+            case '\t': put(w, "\\t", 2);  break;
+            default:   put(w, esc, sizeof(esc)); break;
+        }
+        run = s + 1;
+    }
+    put(w, run, s - run);
+    put_c(w, '"');
+}
+
+/** @brief Start a document in buf. */
+void json_init(JsonWriter &w, char *buf, size_t size, JsonFlushFn flush, void *ctx) {
+    w.buf       = buf;
+    w.size      = size;
+    w.len       = 0;
+    w.total     = 0;
+    w.flush     = flush;
+    w.ctx       = ctx;
+    w.has_items = 0;
+    w.depth     = 0;
+    w.after_key = false;
+    w.failed    = (buf == nullptr || size == 0);
+}
+
+/** @brief Open a container. */
+static void open_container(JsonWriter &w, char c) {
+    separate(w);
+    if (w.depth + 1 >= JSON_MAX_DEPTH) {
+        w.failed = true;
+        return;
+    }
+    put_c(w, c);
+    w.depth++;
+    w.has_items &= (uint16_t)~(1u << w.depth);
+}
+
+/** @brief Close a container. */
+static void close_container(JsonWriter &w, char c) {
+    if (w.depth == 0 || w.after_key) {
+        w.failed = true;
+        return;
+    }
+    w.depth--;
+    put_c(w, c);
+}
+
+void json_begin_object(JsonWriter &w) { open_container(w, '{'); }
+void json_end_object(JsonWriter &w)   { close_container(w, '}'); }
+void json_begin_array(JsonWriter &w)  { open_container(w, '['); }
+void json_end_array(JsonWriter &w)    { close_container(w, ']'); }
+
+/** @brief Write a member name. */
+void json_key(JsonWriter &w, const char *key) {
+    if (w.after_key || w.depth == 0) {
+        w.failed = true;
+        return;
+    }
+    separate(w);
+    put_escaped(w, key ? key : "");
+    put_c(w, ':');
+    w.after_key = true;
+}
+
+/** @brief Write a string value. */
+void json_string(JsonWriter &w, const char *s) {
+    if (!s) {
+        json_null(w);
+        return;
+    }
+    separate(w);
+    put_escaped(w, s);
+}
+
+/** @brief Write a signed integer. */
+void json_int(JsonWriter &w, int32_t v) {
+    separate(w);
+    if (v < 0) {
+        put_c(w, '-');
+        put_u32(w, 0u - (uint32_t)v);
+    } else {
+        put_u32(w, (uint32_t)v);
+    }
+}
+
+/** @brief Write an unsigned integer. */
+void json_uint(JsonWriter &w, uint32_t v) {
+    separate(w);
+    put_u32(w, v);
+}
+
+/** @brief Write true or false. */
+void json_bool(JsonWriter &w, bool v) {
+    separate(w);
+    if (v) put(w, "true", 4);
+    else   put(w, "false", 5);
+}
+
+/** @brief Write null. */
+void json_null(JsonWriter &w) {
+    separate(w);
+    put(w, "null", 4);
+}
+
+/** @brief Write a number with a fixed number of decimals. */
+void json_float(JsonWriter &w, float v, uint8_t decimals) {
+    if (decimals > JSON_MAX_DECIMALS) decimals = JSON_MAX_DECIMALS;
+    if (!isfinite(v) || fabsf(v) >= 1e9f) {
+        json_null(w);
+        return;
+    }
+
+    // Scaled in double so 6 decimals of a 1e9 value still round exactly
+    double   scaled = fabs((double)v) * pow10_table[decimals] + 0.5;
+    uint64_t q      = (uint64_t)scaled;
+    uint32_t ipart  = (uint32_t)(q / pow10_table[decimals]);
+    uint32_t fpart  = (uint32_t)(q % pow10_table[decimals]);
+
+    separate(w);
+    if (v < 0 && q != 0) put_c(w, '-');     // no "-0.0"
+    put_u32(w, ipart);
+    if (decimals == 0) return;
+
+    char frac[JSON_MAX_DECIMALS + 1];
+    frac[0] = '.';
+    for (int i = decimals; i > 0; i--) {
+        frac[i] = (char)('0' + fpart % 10);
+        fpart /= 10;
+    }
+    put(w, frac, decimals + 1);
+}
+
+/** @brief Flush the tail and report whether the document is complete. */
+bool json_finish(JsonWriter &w) {
+    if (w.depth != 0 || w.after_key) w.failed = true;
+    if (!w.failed && w.flush && w.len > 0) flush_buf(w);
+    return !w.failed;
+}
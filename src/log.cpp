@@ -0,0 +1,308 @@
+/******************************************************************************
+ * @file    log.cpp
+ * @author  Thomas Zoldowski
+ * @date    October 18, 2026
+ * @brief   Binary log record ring and deferred formatter.
+ *
+ * Callers only copy a LogRecord into the ring. The serial TX drain thread
+ * calls log_drain(), which expands each record's format string argument by
+ * argument and queues the text into DebugSerial. In a host simulation
+ * (HAL_SIM) records are formatted to stdout as they are committed.
+ ******************************************************************************/
+
+#include <stdio.h>
+#include <string.h>
+#include "hal.h"
+#include "log.h"
+#if HAL_SIM
+#include <mutex>
+#else
+#include "serial_tx.h"
+#endif
+
+static LogRecord   ring[LOG_RING_RECORDS];
+static uint32_t    head    = 0;   // records ever committed
+static uint32_t    printed = 0;   // records handed to DebugSerial
+static uint32_t    dropped = 0;
+#if HAL_SIM
+static std::mutex  log_mutex;
+#else
+static rtos::Mutex log_mutex;
+#endif
+
+static const char level_chars[] = { '-', 'E', 'W', 'I', 'D' };
+
+/** @brief Hand formatted text to the output (DebugSerial, or stdout on a host). */
+static void emit(const uint8_t *data, size_t len) {
+#if HAL_SIM
+    fwrite(data, 1, len, stdout);
+#else
+    DebugSerial.write(data, len);
+#endif
+}
+
+static void emit_line(const char *text) {
+    emit((const uint8_t *)text, strlen(text));
+    emit((const uint8_t *)"\r\n", 2);
+}
+
+// Collects one formatted line so it reaches the debug ring in a single write
+class LineBuffer {
+public:
+    void write(uint8_t c) {
+        if (len == sizeof(buf)) flush();
+        buf[len++] = c;
+    }
+    void write(const uint8_t *data, size_t n) {
+        while (n--) write(*data++);
+    }
+    void print(const char *str) {
+        while (*str) write((uint8_t)*str++);
+    }
+    void print(char c) {
+        write((uint8_t)c);
+    }
+    void flush() {
+        emit(buf, len);
+        len = 0;
+    }
+private:
+    uint8_t buf[160];
+    size_t  len = 0;
+};
+
+/** @brief Fill in the header of a record. */
+void log_begin(LogRecord &r, uint8_t level, const char *tag, const char *fmt) {
+    r.ts_ms    = hal_millis();
+    r.tag      = tag;
+    r.fmt      = fmt;
+    r.level    = level;
+    r.nargs    = 0;
+    r.str_used = 0;
+}
+
+/** @brief Capture a string argument by copying it into the record. */
+void log_arg(LogRecord &r, const char *s) {
+    if (!log_slot(r, LOG_ARG_STR)) return;
+    if (!s) s = "(null)";
+    size_t room = LOG_STR_BYTES - r.str_used;
+    if (room == 0) {                       // string space used up
+        r.args[r.nargs++].str = LOG_STR_BYTES - 1;
+        return;
+    }
+    size_t n = strnlen(s, room - 1);
+    memcpy(&r.strs[r.str_used], s, n);
+    r.strs[r.str_used + n] = '\0';
+    r.args[r.nargs++].str = r.str_used;
+    r.str_used += n + 1;
+}
+
+/** @brief Append a record to the ring, overwriting the oldest unprinted one if full. */
+void log_commit(const LogRecord &r) {
+    log_mutex.lock();
+    if (head - printed >= LOG_RING_RECORDS) {
+        printed++;
+        dropped++;
+    }
+    ring[head % LOG_RING_RECORDS] = r;
+    head++;
+    log_mutex.unlock();
+#if HAL_SIM
+    log_drain();
+#else
+    serial_tx_kick();
+#endif
+}
+
+/** @brief Print an unsigned 64-bit value in decimal (printf may lack %llu). */
+static void put_u64(LineBuffer &out, uint64_t v) {
+    char buf[21];
+    int  i = sizeof(buf) - 1;
+    buf[i] = '\0';
+    do {
+        buf[--i] = '0' + (v % 10);
+        v /= 10;
+    } while (v);
+    out.print(&buf[i]);
+}
+
+/**
+ * @brief Expand one conversion.
+ * @param out  Destination.
+ * @param spec Flags/width/precision with length modifiers stripped.
+ * @param conv Conversion character.
+ * @param r    Record holding the argument.
+ * @param idx  Argument index.
+ */
+static void put_arg(LineBuffer &out, const char *spec, char conv, const LogRecord &r, uint8_t idx) {
+    char f[16];
+    char buf[48];
+
+    if (idx >= r.nargs) {
+        out.print('?');
+        return;
+    }
+
+    uint8_t t = r.types[idx];
+    const auto &a = r.args[idx];
+
+    switch (conv) {
+        case 's':
+            snprintf(f, sizeof(f), "%%%ss", spec);
+            snprintf(buf, sizeof(buf), f, t == LOG_ARG_STR ? &r.strs[a.str] : "?");
+            break;
+
+        case 'p':
+            snprintf(buf, sizeof(buf), "%p", t == LOG_ARG_PTR ? a.ptr : nullptr);
+            break;
+
+        case 'f': case 'F': case 'e': case 'E': case 'g': case 'G': {
+            double v;
+            switch (t) {
+                case LOG_ARG_F64: v = a.f64; break;
+                case LOG_ARG_I32: v = a.i32; break;
+                case LOG_ARG_U32: v = a.u32; break;
+                case LOG_ARG_I64: v = (double)a.i64; break;
+                case LOG_ARG_U64: v = (double)a.u64; break;
+                default:          v = 0; break;
+            }
+            snprintf(f, sizeof(f), "%%%s%c", spec, conv);
+            snprintf(buf, sizeof(buf), f, v);
+            break;
+        }
+
+        case 'd': case 'i': case 'u': case 'x': case 'X': case 'o': case 'c': {
+            bool is_signed;
+            int64_t  sv = 0;
+            uint64_t uv = 0;
+            switch (t) {
+                case LOG_ARG_I32: sv = a.i32; is_signed = true;  break;
+                case LOG_ARG_I64: sv = a.i64; is_signed = true;  break;
+                case LOG_ARG_U32: uv = a.u32; is_signed = false; break;
+                case LOG_ARG_U64: uv = a.u64; is_signed = false; break;
+                case LOG_ARG_F64: sv = (int64_t)a.f64; is_signed = true; break;
+                default:          out.print('?'); return;
+            }
+            if (is_signed) uv = (uint64_t)sv;
+
+            bool fits = is_signed ? (sv >= INT32_MIN && sv <= INT32_MAX) : (uv <= UINT32_MAX);
+            if (!fits) {               // rare; ignores width/flags
+                if (is_signed && sv < 0) {
+                    out.print('-');
+                    uv = 0 - uv;
+                }
+                put_u64(out, uv);
+                return;
+            }
+
+            snprintf(f, sizeof(f), "%%%sl%c", spec, conv == 'i' ? 'd' : conv);
+            if (conv == 'c')      snprintf(buf, sizeof(buf), "%c", (int)(is_signed ? sv : uv));
+            else if (conv == 'd' || conv == 'i')
+                                  snprintf(buf, sizeof(buf), f, (long)(is_signed ? sv : (int64_t)uv));
+            else                  snprintf(buf, sizeof(buf), f, (unsigned long)uv);
+            break;
+        }
+
+        default:
+            out.print('?');
+            return;
+    }
+    out.print(buf);
+}
+
+/** @brief Format one record as "[  12.345] I TAG: message". */
+static void format_record(LineBuffer &out, const LogRecord &r) {
+    char hdr[24];
+    snprintf(hdr, sizeof(hdr), "[%4lu.%03lu] %c ",
+             (unsigned long)(r.ts_ms / 1000), (unsigned long)(r.ts_ms % 1000),
+             level_chars[r.level < sizeof(level_chars) ? r.level : 0]);
+    out.print(hdr);
+    out.print(r.tag);
+    out.print(": ");
+
+    const char *p   = r.fmt;
+    const char *lit = p;
+    uint8_t     idx = 0;
+
+    while (*p) {
+        if (*p != '%') {
+            p++;
+            continue;
+        }
+        if (p > lit) out.write((const uint8_t *)lit, p - lit);
+        lit = p;
+        p++;
+        if (*p == '%') {
+            out.print('%');
+            lit = ++p;
+            continue;
+        }
+
+        char   spec[8];
+        size_t n = 0;
+        while (*p && strchr("-+ #0123456789.", *p)) {
+            if (n < sizeof(spec) - 1) spec[n++] = *p;
+            p++;
+        }
+        spec[n] = '\0';
+        while (*p && strchr("hlLqjzt", *p)) p++;   // width comes from the stored type
+        if (!*p) break;              // dangling '%' is printed as text below
+
+        put_arg(out, spec, *p, r, idx++);
+        lit = ++p;
+    }
+    if (p > lit) out.write((const uint8_t *)lit, p - lit);
+    out.print('\n');
+}
+
+/** @brief Format every record not yet printed. */
+void log_drain() {
+    LogRecord r;
+    for (;;) {
+        log_mutex.lock();
+        if (printed == head) {
+            log_mutex.unlock();
+            return;
+        }
+        r = ring[printed % LOG_RING_RECORDS];
+        printed++;
+        log_mutex.unlock();
+        LineBuffer line;
+        format_record(line, r);
+        line.flush();
+    }
+}
+
+/** @brief Re-print every record still held in the ring. */
+void log_dump() {
+    log_mutex.lock();
+    uint32_t end   = head;
+    uint32_t start = head > LOG_RING_RECORDS ? head - LOG_RING_RECORDS : 0;
+    uint32_t lost  = dropped;
+    log_mutex.unlock();
+
+    char title[48];
+    snprintf(title, sizeof(title), "---- log dump (%lu dropped) ----", (unsigned long)lost);
+    emit_line(title);
+    for (uint32_t i = start; i < end; i++) {
+        LogRecord r;
+        log_mutex.lock();
+        bool valid = head - i <= LOG_RING_RECORDS;   // not overwritten meanwhile
+        if (valid) r = ring[i % LOG_RING_RECORDS];
+        log_mutex.unlock();
+        if (valid) {
+            LineBuffer line;
+            format_record(line, r);
+            line.flush();
+        }
+    }
+    emit_line("---- end ----");
+}
+
+/** @brief Records overwritten before they could be printed. */
+uint32_t log_dropped() {
+    log_mutex.lock();
+    uint32_t d = dropped;
+    log_mutex.unlock();
+    return d;
+}
@@ -5,225 +5,389 @@
  * @brief   Definitions for controlling compost actuators.
  ******************************************************************************/
 #include "logic/actuator_manager.h"
-#include <Arduino.h>
-#include "screens/screen_settings.h"
+#include <atomic>
+#include "config.h"
+#include "cycle_counter.h"
+#include "hal.h"
 #include "settings_storage.h"
-#include "screens/screen_manual.h"
 #include "logic/sensor_manager.h"
-
-// LED pins
-const int LED_PINS[] = {28, 30, 32};
-
-// ─────────────────────────────────────────────────────────────────────────────
-// Pin defs
-static constexpr uint8_t PUMP_PIN     = D27;
-static constexpr uint8_t BLOWER1_PIN  = D25;
-static constexpr uint8_t BLOWER2_PIN  = D23;
+#include "logic/telemetry.h"
+#include "logic/trace.h"
+#ifdef CORE_CM4
+#include "logic/core_link.h"        // events and state go to the M7's UI
+#elif !HAL_SIM
+#include "logic/supervisor.h"
+#endif
+
+#define LOG_TAG   "ACT"
+#define LOG_LEVEL LOG_LEVEL_ACTUATOR
+#include "log.h"
 
 // ─────────────────────────────────────────────────────────────────────────────
-// State for pump
-static unsigned long  lastPumpMillis  = 0;
-static bool           pumpActive      = false;
-static unsigned long  pumpEndMillis   = 0;
-
-// State for blower sequence
-enum BlowState {BLOW_IDLE, BLOW_RUN1, BLOW_PAUSE, BLOW_RUN2 };
-static BlowState     blowState        = BLOW_IDLE;
-static unsigned long lastBlowerMillis = 0;
-static unsigned long blowStartMillis  = 0;
-
-// 30 minutes re-arm for pump, in seconds:
-static constexpr uint32_t PUMP_REARM_INTERVAL = 30 * 60;  
-static constexpr uint32_t BLOWER_REARM_INTERVAL = 30 * 60;
-// Edge-detect flag for blower-by-temperature:
-static bool blower_temp_triggered = false;
-
-// LED Functions
-void LED_Init() {
-    for (int i = 0; i < 3; i++) {
-        pinMode(LED_PINS[i], OUTPUT);
-        digitalWrite(LED_PINS[i], LOW); // Turn off initially
-        //pinMode(LED_PINS[i], INPUT_PULLDOWN);
-    }
+// Tables
+
+typedef struct {
+    const char *name;
+    uint8_t     pin;
+} OutputDef;
+
+typedef struct {
+    uint8_t     output;            // ActuatorOutput, or ACT_OUT_NONE to just wait
+    uint16_t  (*seconds)();        // on-time setting, latched when the program starts...
+    uint32_t    fixed_ms;          // ...or a fixed time when seconds is null
+} SeqStep;
+
+typedef struct {
+    bool      (*when)(const SensorSnapshot &s);
+    uint32_t  (*rearm_s)();        // since the program last started
+    const char *reason;
+} TriggerDef;
+
+typedef struct {
+    const char        *name;
+    TelemetryActuator  tlm;
+    const SeqStep     *steps;
+    uint8_t            n_steps;
+    const TriggerDef  *triggers;   // first match starts the program
+    uint8_t            n_triggers;
+    uint8_t            excludes;   // bit per ActuatorProgram that must be idle (interlock)
+    uint32_t Config::*last_epoch;  // persisted start time
+} ProgramDef;
+
+static const OutputDef OUTPUTS[ACT_OUT_COUNT] = {
+    { "Pump",    HAL_D(27) },   // ACT_OUT_PUMP
+    { "Blower1", HAL_D(25) },   // ACT_OUT_BLOWER1
+    { "Blower2", HAL_D(23) },   // ACT_OUT_BLOWER2
+};
+
+// Trigger predicates; NAN readings compare false
+static bool always(const SensorSnapshot &) {
+    return true;
 }
 
-/** * @brief Turn on all LEDs.
- * This function sets all LED pins to HIGH, indicating the system is active.
- */
-void LED_On() {
+static bool any_dry(const SensorSnapshot &s) {
     for (int i = 0; i < 3; i++) {
-        digitalWrite(LED_PINS[i], HIGH);
+        if (s.hum[i] < getHumLowThreshold(i)) return true;
     }
+    return false;
 }
 
-/** * @brief Turn off all LEDs.
- * This function sets all LED pins to LOW, indicating the system is inactive.
- */
-void LED_Off() {
+static bool any_hot(const SensorSnapshot &s) {
     for (int i = 0; i < 3; i++) {
-        digitalWrite(LED_PINS[i], LOW);
+        float tempF = s.temp_c[i] * 9.0f / 5.0f + 32.0f;
+        if (tempF >= getTempHighThreshold(i)) return true;
     }
+    return false;
 }
 
-/** @brief initialize the actuator scheduler.
- * This function sets the pin modes for the pump and blower pins, initializes their states,
- * and sets the last activation times to the current time.
- */
-void initActuatorScheduler() {
-  pinMode(PUMP_PIN,    OUTPUT);
-  pinMode(BLOWER1_PIN, OUTPUT);
-  pinMode(BLOWER2_PIN, OUTPUT);
+// Rearm intervals, in seconds
+static uint32_t pump_rearm()     { return 30 * 60; }
+static uint32_t blower_rearm()   { return getActivationInterval(); }
+static uint32_t hot_rearm()      { return getActivationInterval() / 3; }
+
+static const SeqStep PUMP_STEPS[] = {
+    { ACT_OUT_PUMP,    getPumpOnTime,   0 },
+};
+static const TriggerDef PUMP_TRIGGERS[] = {
+    { any_dry, pump_rearm, "dry" },
+};
+
+static const SeqStep BLOWER_STEPS[] = {
+    { ACT_OUT_BLOWER1, getBlowerOnTime, 0 },
+    { ACT_OUT_NONE,    nullptr,         1000 },     // let the supply recover
+    { ACT_OUT_BLOWER2, getBlowerOnTime, 0 },
+};
+static const TriggerDef BLOWER_TRIGGERS[] = {
+    { always,  blower_rearm, "interval" },
+    { any_hot, hot_rearm,    "HIGH temp" },
+};
+
+#define COUNT(a) (uint8_t)(sizeof(a) / sizeof((a)[0]))
+
+// Indexed by ActuatorProgram and evaluated in this order each tick
+static const ProgramDef PROGRAMS[ACT_PROGRAM_COUNT] = {
+    { "pump",    TLM_ACT_PUMP,   PUMP_STEPS,   COUNT(PUMP_STEPS),
+      PUMP_TRIGGERS,   COUNT(PUMP_TRIGGERS),   1u << ACT_BLOWERS, &Config::lastPumpEpoch },
+    { "blowers", TLM_ACT_BLOWER, BLOWER_STEPS, COUNT(BLOWER_STEPS),
+      BLOWER_TRIGGERS, COUNT(BLOWER_TRIGGERS), 1u << ACT_PUMP,    &Config::lastBlowerEpoch },
+};
+
+static_assert(COUNT(PUMP_STEPS) <= ACT_MAX_STEPS && COUNT(BLOWER_STEPS) <= ACT_MAX_STEPS, "raise ACT_MAX_STEPS");
+static_assert(ACT_OUT_COUNT <= 8, "actuator_outputs() is a uint8_t mask");
+static_assert(ACT_PROGRAM_COUNT * ACT_MAX_STEPS <= 32, "step_done is a uint32_t mask");
 
-  digitalWrite(PUMP_PIN,    LOW);
-  digitalWrite(BLOWER1_PIN, LOW);
-  digitalWrite(BLOWER2_PIN, LOW);
-
-  lastPumpMillis   = millis();
-  lastBlowerMillis = millis();
+// ─────────────────────────────────────────────────────────────────────────────
+// Control thread. Evaluates the trigger table and logs finished steps; it
+// wakes every ACTUATOR_CHECK_MS or when a step ended. A host simulation
+// has no thread and calls actuator_control_pass() itself.
+#if !HAL_SIM
+static rtos::Mutex     state_mutex;             // control thread vs. triggers from other threads
+static rtos::Semaphore control_wake(0, 1);      // a step finished
+static rtos::Thread    control_thread(osPriorityRealtime, 2048, nullptr, "act_ctl");
+
+static void control_loop();
+#endif
+#if !defined(CORE_CM4) && !HAL_SIM
+static SupervisorId    control_id = SUPERVISOR_NONE;
+#endif
+#ifndef CORE_CM4
+static std::atomic<bool> save_pending(false);   // trigger epochs for loop() to persist
+#endif
+
+static inline void state_lock() {
+#if !HAL_SIM
+    state_mutex.lock();
+#endif
 }
 
-/** @brief Update the LED status based on the current security state.
- * This function checks if the security is unlocked and updates the LED status accordingly.
- */
-void LED_Update() {
-
-    // check if security unlocked and activate buttons
-    if (check_pin()) LED_On();
-    else LED_Off();
+static inline void state_unlock() {
+#if !HAL_SIM
+    state_mutex.unlock();
+#endif
+}
 
+/** @brief Let the control thread log a finished step now. ISR-safe. */
+static inline void wake_control() {
+#if !HAL_SIM
+    control_wake.release();
+#endif
 }
 
+// ─────────────────────────────────────────────────────────────────────────────
+// Steps. Each one ends in an mbed::Timeout callback (interrupt context) that
+// switches the SSR pin at the deadline and enters the next step,
+// independent of any thread. Steps are measured on a free-running µs clock
+// and logged by the control thread once they end.
+typedef struct {
+    std::atomic<uint8_t> step;               // 0 idle, else 1-based step running
+    HalTimeout           timeout;
+    uint32_t             set_ms[ACT_MAX_STEPS];   // latched at start
+    int64_t              start_us;           // of the current step
+    int64_t              len_us[ACT_MAX_STEPS];   // measured
+} ProgramState;
+
+static ProgramState  progs[ACT_PROGRAM_COUNT];
+static std::atomic<uint8_t>  outputs_on(0);  // bit per ActuatorOutput
+static std::atomic<uint32_t> step_done(0);   // bit per program step, not yet logged
+static int64_t       pulse_err_max_us = 0;   // worst |measured - requested|
+
+// Trigger evaluation cost (ticks that started nothing)
+static uint32_t      eval_worst_ns = 0;
+
+static inline int64_t clock_us() {
+    return (int64_t)hal_micros();
+}
 
-/**
- * @brief Schedule hourly actuators (pump and blower).
- * This function checks the current time against the last activation times
- * and activates the pump and blower as per the configured intervals.
- */
-void scheduleHourlyActuators() {
-    uint32_t nowSec = (uint32_t)time(nullptr);
-    uint32_t Interval = getActivationInterval();
-
-   // Serial.println(nowSec-config.lastPumpEpoch);
-
-    bool dry = false;
-    for(int i = 0; i < 3; i++) {
-        
-        if(sensor_manager_get_humidity(i) < getHumLowThreshold(i)) {
-            dry = true;
-            break;
-        }
-    }
+static void step_isr(void *arg);
 
-    // ── Pump (only if not mid‐blower) ─────────────────────
-    if (!pumpActive 
-        && blowState == BLOW_IDLE
-        && dry
-        && (nowSec - config.lastPumpEpoch) >= PUMP_REARM_INTERVAL) 
-    {
-        pumpActive          = true;
-        pumpEndMillis       = millis() + (unsigned long)getPumpOnTime() * 1000UL;
-        config.lastPumpEpoch = nowSec;        // persist the trigger time
-        digitalWrite(PUMP_PIN, HIGH);
-        Serial.println("[Actuator1] Starting pump...");
-        saveConfig();
+/** @brief Switch on step i of a program and arm its end. */
+static void enter_step(ProgramState *ps, uint8_t i) {
+    const SeqStep &s = PROGRAMS[ps - progs].steps[i];
+    if (s.output != ACT_OUT_NONE) {
+        uint8_t bit = (uint8_t)(1u << s.output);
+        hal_pin_write(OUTPUTS[s.output].pin, true);
+        trace_outputs(outputs_on.fetch_or(bit, std::memory_order_relaxed) | bit);
     }
+    ps->start_us = clock_us();
+    ps->step.store(i + 1, std::memory_order_release);
+    hal_timeout_start(ps->timeout, step_isr, ps, ps->set_ms[i]);
+}
 
-    if (pumpActive && millis() >= pumpEndMillis) {
-        pumpActive = false;
-        digitalWrite(PUMP_PIN, LOW);
-        Serial.println("[Actuator1] Pump done, turning off.");
+/** @brief Timer callback: the current step is over; enter the next or go idle. */
+static void step_isr(void *arg) {
+    ProgramState *ps = (ProgramState *)arg;
+    uint8_t step = ps->step.load(std::memory_order_relaxed);
+    if (step == 0) return;
+
+    uint8_t           p = (uint8_t)(ps - progs);
+    const ProgramDef &d = PROGRAMS[p];
+    uint8_t           i = step - 1;
+    const SeqStep    &s = d.steps[i];
+
+    if (s.output != ACT_OUT_NONE) {
+        uint8_t bit = (uint8_t)(1u << s.output);
+        hal_pin_write(OUTPUTS[s.output].pin, false);
+        trace_outputs(outputs_on.fetch_and((uint8_t)~bit, std::memory_order_relaxed) & ~bit);
     }
+    ps->len_us[i] = clock_us() - ps->start_us;
+    step_done.fetch_or(1ul << (p * ACT_MAX_STEPS + i), std::memory_order_release);
 
-    // ── Blower sequence ───────────────────────────────────
-    bool overTemp = false;
+    if (i + 1 < d.n_steps) enter_step(ps, i + 1);
+    else                   ps->step.store(0, std::memory_order_release);
+    wake_control();
+}
 
-    for(int i = 0; i < 3; i++) {
-        float tempC = sensor_manager_get_temperature(i);
-        float tempF = tempC * 9.0f / 5.0f + 32.0f;
-        if(tempF >= getTempHighThreshold(i)) {
-            overTemp = true;
-            break;
+/** @brief Log every step that ended since the last call with its measured length. */
+static void log_finished_steps() {
+    uint32_t done = step_done.exchange(0, std::memory_order_acquire);
+    for (uint8_t p = 0; done && p < ACT_PROGRAM_COUNT; p++) {
+        for (uint8_t i = 0; i < PROGRAMS[p].n_steps; i++) {
+            uint32_t bit = 1ul << (p * ACT_MAX_STEPS + i);
+            if (!(done & bit)) continue;
+            done &= ~bit;
+
+            uint8_t     out  = PROGRAMS[p].steps[i].output;
+            const char *name = out == ACT_OUT_NONE ? "Pause" : OUTPUTS[out].name;
+            uint32_t    set  = progs[p].set_ms[i];
+            int64_t     len  = progs[p].len_us[i];
+            int64_t     err  = len - (int64_t)set * 1000;
+            int64_t     mag  = err < 0 ? -err : err;
+            if (mag > pulse_err_max_us) pulse_err_max_us = mag;
+            if (mag > (int64_t)ACTUATOR_LATE_WARN_MS * 1000) {
+                LOG_W("%s lasted %lu.%03lu ms, set %lu ms (%+ld us)", name,
+                      (unsigned long)(len / 1000), (unsigned long)(len % 1000),
+                      (unsigned long)set, (long)err);
+            } else {
+                LOG_I("%s lasted %lu.%03lu ms, set %lu ms (%+ld us, worst %ld us)", name,
+                      (unsigned long)(len / 1000), (unsigned long)(len % 1000),
+                      (unsigned long)set, (long)err, (long)pulse_err_max_us);
+            }
         }
     }
-    // If back below threshold, clear the one-shot flag
-    if(!overTemp) blower_temp_triggered = false;
-
-    // If blower was triggered by temperature, but now below threshold,
-    if (blowState == BLOW_IDLE
-        && !pumpActive
-        && (nowSec - config.lastBlowerEpoch) >= Interval) 
-    {
-        Serial.println("[Actuator1] Starting blower 1...");
-        // start blower1
-        blowState          = BLOW_RUN1;
-        blowStartMillis    = millis();
-        config.lastBlowerEpoch = nowSec;      // persist the trigger time
-        digitalWrite(BLOWER1_PIN, HIGH);
-        saveConfig();
-    } else if ((overTemp && !pumpActive) && (nowSec - config.lastBlowerEpoch) >= Interval/3) {  //
-        blowState             = BLOW_RUN1;
-        blowStartMillis       = millis();
-        config.lastBlowerEpoch = nowSec;
-        digitalWrite(BLOWER1_PIN, HIGH);
-        Serial.println("[Actuator] Starting blower due to HIGH temp");
-        saveConfig();
-        blower_temp_triggered = true;
-    }
+}
 
-    // blower1 timeout → blower2
-    if (blowState == BLOW_RUN1
-        && (millis() - blowStartMillis) >= (unsigned long)getBlowerOnTime() * 1000UL)
-    {
-        digitalWrite(BLOWER1_PIN, LOW);
-        blowState       = BLOW_PAUSE;
-        blowStartMillis = millis();
-        Serial.println("[Actuator2] Blower1 done, starting blower2...");
-    }
+/** @brief initialize the actuator scheduler.
+ * This function sets the pin modes for every output, switches them off,
+ * and starts the control thread.
+ */
+void initActuatorScheduler() {
+  for (uint8_t o = 0; o < ACT_OUT_COUNT; o++) {
+    hal_pin_mode(OUTPUTS[o].pin, HAL_OUTPUT);
+    hal_pin_write(OUTPUTS[o].pin, false);
+  }
+
+  cycle_counter_init();
+
+#if !HAL_SIM
+#ifndef CORE_CM4
+  control_id = supervisor_register("act_ctl", CONTROL_MAX_SILENCE_MS);
+#endif
+  control_thread.start(mbed::callback(control_loop));
+#endif
+}
 
-    if (blowState == BLOW_PAUSE
-    && (millis() - blowStartMillis) >= 1000UL)   // 1 second delay
-    {
-        blowState       = BLOW_RUN2;
-        blowStartMillis = millis();
-        digitalWrite(BLOWER2_PIN, HIGH);
-        Serial.println("[Actuator] Starting blower2 after 1s pause...");
+/** @brief True if the program and everything it is interlocked with are idle. */
+static bool can_start(uint8_t p) {
+    if (progs[p].step.load(std::memory_order_acquire) != 0) return false;
+    for (uint8_t q = 0; q < ACT_PROGRAM_COUNT; q++) {
+        if ((PROGRAMS[p].excludes & (1u << q)) && progs[q].step.load(std::memory_order_acquire) != 0) return false;
     }
+    return true;
+}
 
-    // blower2 timeout → done
-    if (blowState == BLOW_RUN2
-        && (millis() - blowStartMillis) >= (unsigned long)getBlowerOnTime() * 1000UL)
-    {
-        digitalWrite(BLOWER2_PIN, LOW);
-        blowState      = BLOW_IDLE;
-        Serial.println("[Actuator2] Blower2 done, sequence complete.");
+/** @brief Latch the step times, enter step 1, persist and announce the start. State mutex held. */
+static void start_program(uint8_t p, uint32_t nowSec, const char *reason) {
+    const ProgramDef &d  = PROGRAMS[p];
+    ProgramState     &ps = progs[p];
+    for (uint8_t i = 0; i < d.n_steps; i++) {
+        const SeqStep &s = d.steps[i];
+        ps.set_ms[i] = s.seconds ? (uint32_t)s.seconds() * 1000UL : s.fixed_ms;
     }
-    ActuatorStatusToSerial();
-    updateManualScreenLEDs(pumpActive, blowState);
+    config.*d.last_epoch = nowSec;        // persist the trigger time
+    enter_step(&ps, 0);
+    LOG_I("Starting %s (%s)", d.name, reason);
+
+#ifdef CORE_CM4
+    core_link_post(CORE_EVT_ACTUATOR, d.tlm, 0, nowSec);   // the M7 saves it on the event
+#else
+    telemetry_send_actuator(d.tlm);
+    save_pending = true;
+#endif
 }
 
-/** * @brief Send the current actuator status to Serial.
- * This function sends the current state of the pump and blower to Serial for monitoring.
+/**
+ * @brief Start a program now, outside the schedule.
+ * @return False if it or a program it is interlocked with is running.
  */
-void ActuatorStatusToSerial() {
-    // remember last state across calls
-    static bool prevPumpActive      = false;
-    static bool prevBlowerRun1      = false;
-    bool       currBlowerRun1       = (blowState == BLOW_RUN1);
-
-    // Pump just turned on?
-    if (pumpActive && !prevPumpActive) {
-        Serial.println("Pump:");
-    }
+bool actuator_trigger(ActuatorProgram id) {
+    if (id >= ACT_PROGRAM_COUNT) return false;
+    state_lock();
+    uint32_t nowSec = hal_epoch();
+    bool     ok     = can_start(id);
+    trace_trigger(id, nowSec);         // under the lock, in order with control passes
+    if (ok) start_program(id, nowSec, "on request");
+    state_unlock();
+    return ok;
+}
 
-    // Blower1 just turned on?
-    if (currBlowerRun1 && !prevBlowerRun1) {
-        Serial.println("Blower:");
-    }
+/** @brief 0 while idle, else the 1-based step the program is in. */
+uint8_t actuator_step(ActuatorProgram id) {
+    return id < ACT_PROGRAM_COUNT ? progs[id].step.load(std::memory_order_acquire) : 0;
+}
 
-    // update saved state
-    prevPumpActive  = pumpActive;
-    prevBlowerRun1  = currBlowerRun1;
+/** @brief Outputs switched on right now, bit per ActuatorOutput. */
+uint8_t actuator_outputs() {
+    return outputs_on.load(std::memory_order_relaxed);
 }
 
+/** @brief The SSR pin an output drives. */
+uint8_t actuator_output_pin(ActuatorOutput o) {
+    return o < ACT_OUT_COUNT ? OUTPUTS[o].pin : 0xFF;
+}
 
+#ifndef CORE_CM4
+/** @brief Persist trigger times recorded by the control thread. */
+void actuator_save_pending() {
+    if (save_pending.exchange(false)) saveConfig();
+}
+#endif
 
+/**
+ * @brief Walk the trigger table once.
+ * Every idle, non-interlocked program has its triggers checked in order
+ * against one sensor snapshot; the first whose rearm interval has passed
+ * and whose predicate holds starts it. The work is bounded by the table
+ * size, and is timed on ticks that start nothing so the figure is the
+ * steady-state cost. Runs on the control thread with state_mutex held.
+ */
+static void run_schedule() {
+    SensorSnapshot snap;
+    sensor_manager_get_snapshot(snap);
+    uint32_t nowSec  = hal_epoch();
+    uint8_t  checked = 0;
+    bool     started = false;
+    trace_control(snap.pass, nowSec);
+
+    uint32_t c0 = cycle_count();
+    for (uint8_t p = 0; p < ACT_PROGRAM_COUNT; p++) {
+        if (!can_start(p)) continue;
+        const ProgramDef &d     = PROGRAMS[p];
+        uint32_t          since = nowSec - config.*d.last_epoch;
+        for (uint8_t t = 0; t < d.n_triggers; t++) {
+            const TriggerDef &tr = d.triggers[t];
+            checked++;
+            if (since >= tr.rearm_s() && tr.when(snap)) {
+                start_program(p, nowSec, tr.reason);
+                started = true;
+                break;
+            }
+        }
+    }
+    uint32_t ns = cycles_to_ns(cycle_count() - c0);
+
+    if (!started && ns > eval_worst_ns) {
+        eval_worst_ns = ns;
+        LOG_I("Trigger table: %u trigger(s) checked in %lu ns (new worst)", (unsigned)checked, (unsigned long)ns);
+    }
+}
+
+/** @brief One control pass: log finished steps, then run the schedule. */
+void actuator_control_pass() {
+    log_finished_steps();
+    state_lock();
+    run_schedule();
+    state_unlock();
+}
+
+#if !HAL_SIM
+/** @brief Control thread: a pass, then sleep until a step ends or the next check. */
+static void control_loop() {
+    for (;;) {
+        actuator_control_pass();
+#ifndef CORE_CM4
+        supervisor_checkin(control_id);
+#endif
+        control_wake.try_acquire_for(std::chrono::milliseconds(ACTUATOR_CHECK_MS));
+    }
+}
+#endif
@@ -0,0 +1,363 @@
+/******************************************************************************
+ * @file    command_channel.cpp
+ * @author  Thomas Zoldowski
+ * @date    October 18, 2026
+ * @brief   RX thread, request queue and handlers for Pi commands.
+ ******************************************************************************/
+
+#include "logic/command_channel.h"
+#include "logic/telemetry.h"
+#include "logic/sensor_manager.h"
+#include "logic/actuator_manager.h"
+#include "logic/history_log.h"
+#include "screens/screen_settings.h"
+#include <Arduino.h>
+#include <mbed.h>
+
+#define LOG_TAG "CMD"
+#include "log.h"
+
+#define CMD_RX_MAX        64   // largest encoded request we accept
+#define CMD_ARGS_MAX      16   // request payload bytes kept in the queue
+#define TLM_HEADER_LEN    4    // ver, type, seq (see telemetry.cpp)
+#define TLM_CRC_LEN       2
+
+// A request waiting for loop()
+typedef struct {
+    uint8_t type;
+    uint8_t len;
+    uint8_t payload[CMD_ARGS_MAX];
+} QueuedCommand;
+
+static QueuedCommand queue[CMD_QUEUE_LEN];
+static uint8_t       queue_head  = 0;
+static uint8_t       queue_count = 0;
+static rtos::Mutex   queue_mutex;
+
+static CommandSnapshot snapshot;
+static rtos::Mutex     snapshot_mutex;
+
+static CommandStats stats = { 0, 0, 0, 0 };
+static rtos::Thread rx_thread(osPriorityBelowNormal, 2048, nullptr, "cmd_rx");
+
+/** @brief Store a 16-bit value little-endian. */
+static inline uint8_t *put_u16(uint8_t *p, uint16_t v) {
+    p[0] = (uint8_t)(v & 0xFF);
+    p[1] = (uint8_t)(v >> 8);
+    return p + 2;
+}
+
+/** @brief Store a 32-bit value little-endian. */
+static inline uint8_t *put_u32(uint8_t *p, uint32_t v) {
+    p = put_u16(p, (uint16_t)(v & 0xFFFF));
+    return put_u16(p, (uint16_t)(v >> 16));
+}
+
+/** @brief Store an IEEE-754 float little-endian. */
+static inline uint8_t *put_f32(uint8_t *p, float v) {
+    uint32_t bits;
+    memcpy(&bits, &v, sizeof(bits));
+    return put_u32(p, bits);
+}
+
+/** @brief Read a 16-bit little-endian value. */
+static inline uint16_t get_u16(const uint8_t *p) {
+    return (uint16_t)(p[0] | (p[1] << 8));
+}
+
+/** @brief Read a 32-bit little-endian value. */
+static inline uint32_t get_u32(const uint8_t *p) {
+    return (uint32_t)get_u16(p) | ((uint32_t)get_u16(p + 2) << 16);
+}
+
+/** @brief Read a little-endian IEEE-754 float. */
+static inline float get_f32(const uint8_t *p) {
+    uint32_t bits = get_u32(p);
+    float v;
+    memcpy(&v, &bits, sizeof(v));
+    return v;
+}
+
+/** @brief Convert a float to fixed point, mapping NAN to TLM_NONE. */
+static inline int16_t to_fixed(float v, float scale) {
+    if (isnan(v)) return TLM_NONE;
+    return (int16_t)constrain(roundf(v * scale), -32767.0f, 32767.0f);
+}
+
+/** @brief Send a TLM_RESPONSE frame.
+ *  @param req_id Request id to echo.
+ *  @param cmd    Command being answered.
+ *  @param status CommandStatus.
+ *  @param data   Response data (may be nullptr).
+ *  @param len    Data length.
+ */
+static void respond(uint16_t req_id, uint8_t cmd, uint8_t status, const uint8_t *data, size_t len) {
+    uint8_t buf[TLM_MAX_PAYLOAD];
+    if (len > sizeof(buf) - 4) len = sizeof(buf) - 4;
+    uint8_t *p = put_u16(buf, req_id);
+    *p++ = cmd;
+    *p++ = status;
+    if (len) memcpy(p, data, len);
+    telemetry_send(TLM_RESPONSE, buf, 4 + len);
+    core_util_atomic_incr_u32(&stats.answered, 1);
+}
+
+/** @brief Answer GET_SNAPSHOT from the published copy (RX thread). */
+static void answer_snapshot(uint16_t req_id) {
+    snapshot_mutex.lock();
+    CommandSnapshot s = snapshot;
+    snapshot_mutex.unlock();
+
+    uint8_t data[28];
+    uint8_t *p = put_u32(data, s.uptime_ms);
+    for (uint8_t i = 0; i < 3; i++) p = put_u16(p, (uint16_t)s.temp_f10[i]);
+    for (uint8_t i = 0; i < 3; i++) p = put_u16(p, (uint16_t)s.hum10[i]);
+    p = put_u16(p, (uint16_t)s.o2_100);
+    p = put_u16(p, (uint16_t)s.board_temp_f10);
+    *p++ = s.fill;
+    *p++ = s.switches;
+    *p++ = s.pump;
+    *p++ = s.blower_state;
+    p = put_u32(p, s.samples);
+    respond(req_id, TLM_CMD_GET_SNAPSHOT, CMD_OK, data, (size_t)(p - data));
+}
+
+/** @brief Queue a request for loop().
+ *  @return False if the queue is full.
+ */
+static bool enqueue(uint8_t type, const uint8_t *payload, size_t len) {
+    queue_mutex.lock();
+    bool ok = queue_count < CMD_QUEUE_LEN;
+    if (ok) {
+        QueuedCommand &c = queue[(queue_head + queue_count) % CMD_QUEUE_LEN];
+        c.type = type;
+        c.len  = (uint8_t)len;
+        memcpy(c.payload, payload, len);
+        queue_count++;
+    }
+    queue_mutex.unlock();
+    return ok;
+}
+
+/** @brief Validate and dispatch one decoded frame (RX thread). */
+static void handle_frame(const uint8_t *raw, size_t len) {
+    if (len < TLM_HEADER_LEN + TLM_CRC_LEN
+        || get_u16(&raw[len - TLM_CRC_LEN]) != telemetry_crc16(raw, len - TLM_CRC_LEN)
+        || raw[0] != TLM_VERSION) {
+        core_util_atomic_incr_u32(&stats.rx_errors, 1);
+        return;
+    }
+    core_util_atomic_incr_u32(&stats.rx_frames, 1);
+
+    uint8_t        type   = raw[1];
+    const uint8_t *pl     = &raw[TLM_HEADER_LEN];
+    size_t         pl_len = len - TLM_HEADER_LEN - TLM_CRC_LEN;
+    if (pl_len < 2 || pl_len > CMD_ARGS_MAX) return;   // every message starts with an id
+    uint16_t req_id = get_u16(pl);
+
+    switch (type) {
+        case TLM_CMD_GET_SNAPSHOT:
+            answer_snapshot(req_id);
+            break;
+
+        case TLM_ACK:
+        case TLM_RESEND:
+            if (!enqueue(type, pl, pl_len)) core_util_atomic_incr_u32(&stats.queue_full, 1);
+            break;
+
+        case TLM_CMD_GET_HISTORY:
+        case TLM_CMD_GET_CONFIG:
+        case TLM_CMD_SET_CONFIG:
+        case TLM_CMD_TRIGGER:
+        case TLM_CMD_DUMP_LOG:
+            if (!enqueue(type, pl, pl_len)) {
+                core_util_atomic_incr_u32(&stats.queue_full, 1);
+                respond(req_id, type, CMD_QUEUE_FULL, nullptr, 0);
+            }
+            break;
+
+        default:
+            respond(req_id, type, CMD_UNKNOWN, nullptr, 0);
+            break;
+    }
+}
+
+/** @brief RX thread: split the byte stream at zero bytes and decode frames. */
+static void rx_thread_fn() {
+    static uint8_t chunk[CMD_RX_MAX];
+    static uint8_t raw[CMD_RX_MAX];
+    size_t len      = 0;
+    bool   overflow = false;
+
+    for (;;) {
+        int avail = Serial.available();
+        if (avail <= 0) {
+            rtos::ThisThread::sleep_for(std::chrono::milliseconds(CMD_RX_POLL_MS));
+            continue;
+        }
+        while (avail-- > 0) {
+            int c = Serial.read();
+            if (c < 0) break;
+            if (c != 0) {
+                if (len < sizeof(chunk)) chunk[len++] = (uint8_t)c;
+                else overflow = true;
+                continue;
+            }
+            if (len > 0) {
+                size_t n = overflow ? 0 : telemetry_cobs_decode(chunk, len, raw);
+                if (n) handle_frame(raw, n);
+                else core_util_atomic_incr_u32(&stats.rx_errors, 1);
+            }
+            len      = 0;
+            overflow = false;
+        }
+    }
+}
+
+/** @brief Start the RX thread. */
+void command_channel_init() {
+    rx_thread.start(mbed::callback(rx_thread_fn));
+}
+
+/** @brief Copy the current readings and actuator state for snapshot requests.
+ *  @param now_ms Current millis().
+ */
+void command_channel_publish_snapshot(uint32_t now_ms) {
+    CommandSnapshot s;
+    s.uptime_ms = now_ms;
+    for (uint8_t i = 0; i < 3; i++) {
+        float tempC = sensor_manager_get_temperature(i);
+        s.temp_f10[i] = to_fixed(tempC * 9.0f / 5.0f + 32.0f, 10.0f);
+        s.hum10[i]    = to_fixed(sensor_manager_get_humidity(i), 10.0f);
+    }
+    s.o2_100         = to_fixed(sensor_manager_get_oxygen(), 100.0f);
+    s.board_temp_f10 = to_fixed(getExternalTemperature(), 10.0f);
+    float fill = sensor_manager_get_fill_percent();
+    s.fill = isnan(fill) ? 0 : (uint8_t)fill;
+    s.switches = 0;
+    for (uint8_t i = 0; i < 5; i++) {
+        if (Limit_Switch_isClosed(i)) s.switches |= (uint8_t)(1u << i);
+    }
+    s.pump         = actuator_pump_active() ? 1 : 0;
+    s.blower_state = actuator_blower_state();
+    s.samples      = telemetry_get_stats().recorded;
+
+    snapshot_mutex.lock();
+    snapshot = s;
+    snapshot_mutex.unlock();
+}
+
+/** @brief Run one queued request in loop() context. */
+static void run_command(const QueuedCommand &c) {
+    const uint8_t *pl = c.payload;
+    uint16_t req_id   = get_u16(pl);
+
+    switch (c.type) {
+        case TLM_ACK:
+            if (c.len == 8) telemetry_handle_ack(get_u32(pl), get_u32(&pl[4]));
+            break;
+
+        case TLM_RESEND:
+            if (c.len == 12) telemetry_handle_resend(get_u32(pl), get_u32(&pl[4]));
+            break;
+
+        case TLM_CMD_GET_HISTORY: {
+            if (c.len != 6 || pl[2] >= HIST_WINDOW_COUNT || pl[3] >= HIST_METRIC_COUNT
+                || pl[4] >= history_series_count((HistoryMetric)pl[3])
+                || pl[5] == 0 || pl[5] > CMD_HISTORY_MAX_POINTS) {
+                respond(req_id, c.type, CMD_BAD_REQUEST, nullptr, 0);
+                break;
+            }
+            int32_t points[CMD_HISTORY_MAX_POINTS];
+            size_t n = history_query((HistoryWindow)pl[2], (HistoryMetric)pl[3], pl[4],
+                                     points, pl[5], TLM_NONE);
+            uint8_t data[1 + 2 * CMD_HISTORY_MAX_POINTS];
+            uint8_t *p = data;
+            *p++ = (uint8_t)n;
+            for (size_t i = 0; i < n; i++) p = put_u16(p, (uint16_t)(int16_t)points[i]);
+            respond(req_id, c.type, CMD_OK, data, (size_t)(p - data));
+            break;
+        }
+
+        case TLM_CMD_GET_CONFIG: {
+            float v = c.len == 4 ? settings_get_value((SettingField)pl[2], pl[3]) : NAN;
+            if (isnan(v)) {
+                respond(req_id, c.type, CMD_BAD_REQUEST, nullptr, 0);
+                break;
+            }
+            uint8_t data[4];
+            put_f32(data, v);
+            respond(req_id, c.type, CMD_OK, data, sizeof(data));
+            break;
+        }
+
+        case TLM_CMD_SET_CONFIG: {
+            if (c.len != 8 || isnan(settings_get_value((SettingField)pl[2], pl[3]))) {
+                respond(req_id, c.type, CMD_BAD_REQUEST, nullptr, 0);
+                break;
+            }
+            SettingField field = (SettingField)pl[2];
+            float value = get_f32(&pl[4]);
+            uint8_t status = settings_set_value(field, pl[3], value) ? CMD_OK : CMD_OUT_OF_RANGE;
+            if (status == CMD_OK) LOG_I("Setting %u[%u] set to %.1f by Pi", field, pl[3], value);
+
+            uint8_t data[4];
+            put_f32(data, settings_get_value(field, pl[3]));
+            respond(req_id, c.type, status, data, sizeof(data));
+            break;
+        }
+
+        case TLM_CMD_TRIGGER: {
+            bool ok = false;
+            if (c.len != 3) {
+                respond(req_id, c.type, CMD_BAD_REQUEST, nullptr, 0);
+                break;
+            }
+            if (pl[2] == TLM_ACT_PUMP)        ok = actuator_trigger_pump();
+            else if (pl[2] == TLM_ACT_BLOWER) ok = actuator_trigger_blowers();
+            else {
+                respond(req_id, c.type, CMD_BAD_REQUEST, nullptr, 0);
+                break;
+            }
+            respond(req_id, c.type, ok ? CMD_OK : CMD_BUSY, nullptr, 0);
+            break;
+        }
+
+        case TLM_CMD_DUMP_LOG: {
+            if (c.len != 2) {
+                respond(req_id, c.type, CMD_BAD_REQUEST, nullptr, 0);
+                break;
+            }
+            log_dump();
+            uint8_t data[4];
+            put_u32(data, log_dropped());
+            respond(req_id, c.type, CMD_OK, data, sizeof(data));
+            break;
+        }
+
+        default:
+            break;
+    }
+}
+
+/** @brief Run every queued request. */
+void command_channel_poll() {
+    for (;;) {
+        QueuedCommand c;
+        queue_mutex.lock();
+        bool have = queue_count > 0;
+        if (have) {
+            c = queue[queue_head];
+            queue_head = (queue_head + 1) % CMD_QUEUE_LEN;
+            queue_count--;
+        }
+        queue_mutex.unlock();
+        if (!have) return;
+        run_command(c);
+    }
+}
+
+/** @brief Get a snapshot of the channel counters. */
+CommandStats command_channel_get_stats() {
+    return stats;
+}
@@ -0,0 +1,345 @@
+/******************************************************************************
+ * @file    core_link.cpp
+ * @author  Thomas Zoldowski
+ * @date    October 18, 2026
+ * @brief   M7 side of the dual-core split (see core_link.h).
+ *
+ * In the split build this file stands in for sensor_manager.cpp and the
+ * control half of actuator_manager.cpp: the same API, served from the M4's
+ * snapshot, with M4 events turned back into the telemetry frames, warnings
+ * and config saves the single-core build produces itself.
+ ******************************************************************************/
+
+#include "config.h"
+
+#if CORE_SPLIT
+
+#include "logic/core_link.h"
+#include "logic/sensor_manager.h"
+#include "logic/actuator_manager.h"
+#include "logic/telemetry.h"
+#include "screens/screen_warnings.h"
+#include "settings_storage.h"
+#include "serial_tx.h"
+#include <RPC.h>
+#include <mbed.h>
+#include <string.h>
+
+#define LOG_TAG   "CORE"
+#define LOG_LEVEL LOG_LEVEL_CORE
+#include "log.h"
+
+#define CORE_CONSOLE_CHUNK  64    // M4 console bytes forwarded per write
+
+static CoreLink *const shm = core_link_shared();
+
+static CoreSnapshot snap;                  // last consistent copy
+static bool         have_snap      = false;
+static uint32_t     last_published = 0;
+static uint32_t     last_beat_ms   = 0;
+static bool         m4_alive       = false;
+static CoreSettings pushed;                // last settings handed to the M4
+
+bool limit_switch_states[5] = { false, false, false, false, false };
+
+// ================= CACHE =================
+// The M7 D-cache does not see the M4's writes (and vice versa) until lines
+// are invalidated/cleaned. Every region is CORE_LINE aligned.
+
+/** @brief Round a region out to whole cache lines. */
+static inline void line_span(const void *p, size_t len, uint32_t *&start, int32_t &size) {
+    uintptr_t a = (uintptr_t)p & ~(uintptr_t)(CORE_LINE - 1);
+    uintptr_t e = ((uintptr_t)p + len + CORE_LINE - 1) & ~(uintptr_t)(CORE_LINE - 1);
+    start = (uint32_t *)a;
+    size  = (int32_t)(e - a);
+}
+
+/** @brief Drop cached copies so the next read sees the M4's data. */
+static void cache_invalidate(const void *p, size_t len) {
+    uint32_t *start;
+    int32_t   size;
+    line_span(p, len, start, size);
+    SCB_InvalidateDCache_by_Addr(start, size);
+}
+
+/** @brief Write our lines back so the M4 sees them. */
+static void cache_clean(const void *p, size_t len) {
+    uint32_t *start;
+    int32_t   size;
+    line_span(p, len, start, size);
+    SCB_CleanDCache_by_Addr(start, size);
+}
+
+// ================= SNAPSHOT =================
+/**
+ * @brief Copy the M4's snapshot if it is not being written.
+ * @return False if the M4 was mid-update on every try (keep the old copy).
+ */
+static bool read_snapshot(CoreSnapshot &out) {
+    volatile uint32_t *seq = &shm->snap.seq;
+    for (uint8_t tries = 0; tries < 4; tries++) {
+        cache_invalidate(&shm->snap, sizeof(CoreSnapshot));
+        uint32_t s1 = *seq;
+        if (s1 & 1) continue;
+        __DMB();
+        memcpy(&out, &shm->snap, sizeof(CoreSnapshot));
+        __DMB();
+        cache_invalidate(&shm->snap.seq, sizeof(uint32_t));
+        if (*seq == s1) return true;
+    }
+    return false;
+}
+
+/** @brief Refresh the local copy and track the M4 heartbeat. */
+static void refresh_snapshot(uint32_t now) {
+    CoreSnapshot s;
+    if (read_snapshot(s)) {
+        if (s.published != last_published) {
+            last_published = s.published;
+            last_beat_ms   = now;
+            if (!m4_alive) LOG_I("M4 publishing (boot %lu)", (unsigned long)shm->m4_boots);
+            m4_alive = true;
+        }
+        snap      = s;
+        have_snap = true;
+    }
+    if (m4_alive && now - last_beat_ms > CORE_LINK_STALE_MS) {
+        LOG_E("M4 stopped publishing; readings marked unavailable");
+        m4_alive = false;
+    }
+    for (uint8_t i = 0; i < 5; i++) {
+        limit_switch_states[i] = m4_alive && (snap.sensors.switches & (1u << i));
+    }
+}
+
+/** @brief A snapshot value, NAN while the M4 is not publishing. */
+static inline float live(float v) {
+    return (have_snap && m4_alive) ? v : NAN;
+}
+
+// ================= EVENTS =================
+/** @brief Turn an M4 event into what the single-core build does inline. */
+static void handle_event(const CoreEvent &e) {
+    switch (e.type) {
+        case CORE_EVT_DOOR:
+            telemetry_send_door((TelemetryDoor)e.a, e.b != 0);
+            if (e.a == TLM_DOOR_FRONT)     add_warning("Unloaded front door Opened");
+            else if (e.a == TLM_DOOR_BACK) add_warning("Unloaded back door Opened");
+            else                           add_warning("Loaded loading door Opened");
+            break;
+        case CORE_EVT_ACTUATOR:
+            if (e.a == TLM_ACT_PUMP) config.lastPumpEpoch   = e.epoch;
+            else                     config.lastBlowerEpoch = e.epoch;
+            saveConfig();
+            telemetry_send_actuator((TelemetryActuator)e.a);
+            break;
+        default:
+            LOG_W("Unknown M4 event %u", e.type);
+            break;
+    }
+}
+
+/** @brief Handle every event the M4 queued since the last call. */
+static void drain_events() {
+    cache_invalidate(&shm->magic, CORE_LINE);          // ev_head, ev_dropped
+    uint32_t head = *(volatile uint32_t *)&shm->ev_head;
+    uint32_t tail = shm->ev_tail;
+    if (head == tail) return;
+    __DMB();
+
+    cache_invalidate(shm->events, sizeof(shm->events));
+    if (head - tail > CORE_EVENT_SLOTS) {              // cannot happen unless the block is corrupt
+        LOG_E("Event ring out of step (%lu/%lu)", (unsigned long)head, (unsigned long)tail);
+        tail = head;
+    }
+    while (tail != head) {
+        CoreEvent e = shm->events[tail % CORE_EVENT_SLOTS];
+        handle_event(e);
+        tail++;
+    }
+    __DMB();
+    shm->ev_tail = tail;
+    cache_clean(&shm->ev_tail, sizeof(uint32_t));
+}
+
+// ================= SETTINGS =================
+/** @brief Share the control settings if any changed since the last push. */
+static void push_settings() {
+    CoreSettings s;
+    memset(&s, 0, sizeof(s));
+    s.pump_on_s   = getPumpOnTime();
+    s.blower_on_s = getBlowerOnTime();
+    s.interval_s  = getActivationInterval();
+    for (int i = 0; i < 3; i++) {
+        s.temp_high_f[i] = getTempHighThreshold(i);
+        s.hum_low[i]     = getHumLowThreshold(i);
+    }
+    s.last_pump_epoch   = config.lastPumpEpoch;
+    s.last_blower_epoch = config.lastBlowerEpoch;
+
+    s.seq = pushed.seq;
+    if (s.seq != 0 && memcmp(&s, &pushed, sizeof(s)) == 0) return;
+
+    // Seqlock write; the M4 reads SRAM directly, so clean after each step
+    volatile uint32_t *seq = &shm->settings.seq;
+    *seq = pushed.seq + 1;
+    cache_clean(&shm->settings, sizeof(CoreSettings));
+    __DSB();
+    s.seq = pushed.seq + 1;
+    memcpy(&shm->settings, &s, sizeof(s));
+    cache_clean(&shm->settings, sizeof(CoreSettings));
+    __DSB();
+    *seq = pushed.seq + 2;
+    cache_clean(&shm->settings, sizeof(CoreSettings));
+    __DSB();
+
+    s.seq  = pushed.seq + 2;
+    pushed = s;
+}
+
+// ================= M4 CONSOLE =================
+/** @brief Copy the M4's log output into our DebugSerial. */
+static void forward_console() {
+    uint8_t buf[CORE_CONSOLE_CHUNK];
+    size_t  n = 0;
+    while (RPC.available() > 0) {
+        buf[n++] = (uint8_t)RPC.read();
+        if (n == sizeof(buf)) {
+            DebugSerial.write(buf, n);
+            n = 0;
+        }
+    }
+    if (n) DebugSerial.write(buf, n);
+}
+
+// ================= LINK =================
+/** @brief Clear the block, share the settings and boot the M4. */
+void core_link_init() {
+    memset(shm, 0, sizeof(CoreLink));
+    cache_clean(shm, sizeof(CoreLink));
+    memset(&pushed, 0, sizeof(pushed));
+    push_settings();
+
+    if (!RPC.begin()) {
+        LOG_E("RPC init failed; M4 not started");
+        return;
+    }
+    last_beat_ms = millis();
+    LOG_I("M4 booting, link at 0x%08lx (%u B)", (unsigned long)CORE_LINK_ADDR, (unsigned)sizeof(CoreLink));
+}
+
+/** @brief Handle M4 events, forward its console and push changed settings. */
+void core_link_poll() {
+    refresh_snapshot(millis());
+    drain_events();
+    push_settings();
+    forward_console();
+}
+
+/** @brief True while the M4 publishes. */
+bool core_link_m4_alive() {
+    return m4_alive;
+}
+
+// ================= sensor_manager.h =================
+void sensor_manager_init() {
+    LOG_I("Sensors are read by the M4");
+}
+
+void sensor_manager_update() {
+    // core_link_poll() already refreshed the snapshot this pass
+}
+
+void sensor_manager_start() {
+    // The M4 runs acquisition in its own loop()
+}
+
+float sensor_manager_get_temperature(uint8_t idx) {
+    return (idx < 3) ? live(snap.sensors.temp_c[idx]) : NAN;
+}
+
+float sensor_manager_get_humidity(uint8_t idx) {
+    return (idx < 3) ? live(snap.sensors.hum[idx]) : NAN;
+}
+
+float sensor_manager_get_oxygen(void) {
+    return live(snap.sensors.o2);
+}
+
+float getExternalTemperature() {
+    return live(snap.sensors.board_temp_f);
+}
+
+float sensor_manager_get_tof_distance(uint8_t idx) {
+    return (idx < 2) ? live(snap.sensors.tof_cm[idx]) : NAN;
+}
+
+float sensor_manager_get_fill_percent(void) {
+    return live(snap.sensors.fill_percent);
+}
+
+/** @brief The M4's snapshot; all NAN while it is not publishing. */
+bool sensor_manager_get_snapshot(SensorSnapshot &out) {
+    if (have_snap && m4_alive) {
+        out = snap.sensors;
+        return true;
+    }
+    memset(&out, 0, sizeof(out));
+    for (uint8_t i = 0; i < 3; i++) {
+        out.temp_c[i] = NAN;
+        out.hum[i]    = NAN;
+    }
+    out.o2           = NAN;
+    out.tof_cm[0]    = NAN;
+    out.tof_cm[1]    = NAN;
+    out.fill_percent = NAN;
+    out.board_temp_f = NAN;
+    return false;
+}
+
+/** @brief Bus status as last probed by the M4 (all false while it is down). */
+ConnectionStatus sensor_manager_get_connection_status(void) {
+    SensorSnapshot s;
+    sensor_manager_get_snapshot(s);
+    return s.status;
+}
+
+void Limit_Switch_Init() {
+}
+
+void Limit_Switch_update() {
+    // The M4 polls the switches; loop() shows the mask in the footer
+}
+
+bool Limit_Switch_isClosed(uint8_t index) {
+    return (index < 5) ? limit_switch_states[index] : false;
+}
+
+uint32_t Limit_Switch_get_warning_mask() {
+    return m4_alive ? snap.sensors.door_mask : (uint32_t)WARN_NONE;
+}
+
+// ================= actuator_manager.h =================
+void initActuatorScheduler() {
+    LOG_I("Actuators are driven by the M4");
+}
+
+void actuator_save_pending() {
+    // Trigger times are saved as the M4's start events arrive (handle_event)
+}
+
+bool actuator_trigger(ActuatorProgram id) {
+    // Actuator starts arrive as M4 events (drain_events)
+    if (!m4_alive || id >= ACT_PROGRAM_COUNT) return false;
+    return RPC.call("act_trigger", (int)id).as<bool>();
+}
+
+uint8_t actuator_step(ActuatorProgram id) {
+    return (m4_alive && id < ACT_PROGRAM_COUNT) ? snap.steps[id] : 0;
+}
+
+uint8_t actuator_outputs() {
+    return m4_alive ? snap.outputs : 0;
+}
+
+#endif // CORE_SPLIT
@@ -0,0 +1,209 @@
+/******************************************************************************
+ * @file    history_log.cpp
+ * @author  Thomas Zoldowski
+ * @date    October 18, 2026
+ * @brief   Trend history rings and min/max decimation for the History screen.
+ ******************************************************************************/
+
+#include "logic/history_log.h"
+#include "logic/sensor_manager.h"
+#include <Arduino.h>
+#include "SDRAM.h"
+
+#define LOG_TAG   "HIST"
+#include "log.h"
+
+#define HISTORY_FIELDS 8   // temp x3, hum x3, o2, fill
+
+static_assert(sizeof(HistorySample) == HISTORY_FIELDS * sizeof(int16_t),
+              "HistorySample is read as a flat int16_t array");
+
+// One averaging ring
+struct HistoryRing {
+    HistorySample *samples;
+    uint32_t capacity;
+    uint32_t period_ms;
+    uint32_t head;            // next write index
+    uint32_t count;           // valid samples
+    uint32_t next_push_ms;
+    int32_t  sum[HISTORY_FIELDS];
+    uint16_t cnt[HISTORY_FIELDS];
+};
+
+static HistoryRing rings[2] = {
+    { nullptr,  8640,  10000UL, 0, 0, 0, {0}, {0} },   // fine:   10 s x 24 h
+    { nullptr, 21600, 120000UL, 0, 0, 0, {0}, {0} },   // coarse:  2 min x 30 d
+};
+
+// Which ring and how many of its samples make up each window
+static const struct {
+    uint8_t  ring;
+    uint32_t samples;
+} windows[HIST_WINDOW_COUNT] = {
+    { 0,   360 },   // 1 h
+    { 0,  8640 },   // 24 h
+    { 1,  5040 },   // 7 d
+    { 1, 21600 },   // 30 d
+};
+
+static uint32_t revision = 0;
+static bool     started  = false;
+
+/** @brief Allocate the history rings in SDRAM.
+ * SDRAM is brought up by Display.begin() (it also holds the framebuffers),
+ * so this must run after the display is initialized.
+ */
+void history_init() {
+    for (HistoryRing &r : rings) {
+        r.samples = (HistorySample *)SDRAM.malloc(r.capacity * sizeof(HistorySample));
+        if (!r.samples) {
+            LOG_E("SDRAM allocation failed, history disabled");
+            rings[0].samples = rings[1].samples = nullptr;
+            return;
+        }
+    }
+    LOG_I("History rings allocated");
+}
+
+/** @brief Convert a float to fixed point, mapping NAN to HISTORY_NONE. */
+static inline int16_t to_fixed(float v, float scale) {
+    if (isnan(v)) return HISTORY_NONE;
+    return (int16_t)constrain(roundf(v * scale), -32767.0f, 32767.0f);
+}
+
+/** @brief Store the accumulated average of a ring and reset the accumulator. */
+static void push_average(HistoryRing &r) {
+    int16_t *dst = (int16_t *)&r.samples[r.head];
+    for (uint8_t f = 0; f < HISTORY_FIELDS; f++) {
+        dst[f] = r.cnt[f] ? (int16_t)(r.sum[f] / r.cnt[f]) : HISTORY_NONE;
+        r.sum[f] = 0;
+        r.cnt[f] = 0;
+    }
+    r.head = (r.head + 1) % r.capacity;
+    if (r.count < r.capacity) r.count++;
+}
+
+/** @brief Accumulate the current sensor readings into both rings.
+ * A ring stores one averaged sample each time its period elapses.
+ * @param now_ms Current millis().
+ */
+void history_record(uint32_t now_ms) {
+    if (!rings[0].samples) return;
+
+    int16_t v[HISTORY_FIELDS];
+    for (uint8_t i = 0; i < 3; i++) {
+        float tC = sensor_manager_get_temperature(i);
+        v[i]     = to_fixed(tC * 9.0f / 5.0f + 32.0f, 10.0f);
+        v[3 + i] = to_fixed(sensor_manager_get_humidity(i), 10.0f);
+    }
+    v[6] = to_fixed(sensor_manager_get_oxygen(), 100.0f);
+    v[7] = to_fixed(sensor_manager_get_fill_percent(), 1.0f);
+
+    for (HistoryRing &r : rings) {
+        if (!started) r.next_push_ms = now_ms + r.period_ms;
+
+        for (uint8_t f = 0; f < HISTORY_FIELDS; f++) {
+            if (v[f] == HISTORY_NONE) continue;
+            r.sum[f] += v[f];
+            r.cnt[f]++;
+        }
+
+        if ((int32_t)(now_ms - r.next_push_ms) >= 0) {
+            push_average(r);
+            r.next_push_ms += r.period_ms;
+            // Don't try to catch up after a long stall
+            if ((int32_t)(now_ms - r.next_push_ms) >= 0) r.next_push_ms = now_ms + r.period_ms;
+            revision++;
+        }
+    }
+    started = true;
+}
+
+/** @brief Get the number of series for a metric. */
+uint8_t history_series_count(HistoryMetric metric) {
+    return (metric == HIST_TEMP || metric == HIST_HUM) ? 3 : 1;
+}
+
+/** @brief Get the history revision counter. */
+uint32_t history_revision() {
+    return revision;
+}
+
+/** @brief Query one series of a window, decimated for display.
+ * The window always spans its full duration ending now; time before the
+ * first stored sample is reported as missing. When the window holds more
+ * samples than @p max_points, each pair of output points is the min and max
+ * of one bucket (in time order), so peaks survive decimation.
+ * @param window     Time window.
+ * @param metric     Metric to read.
+ * @param series     Sensor index for temp/hum (0-2), otherwise 0.
+ * @param out        Destination array.
+ * @param max_points Capacity of @p out (e.g. the chart width in pixels).
+ * @param none_value Value written for missing samples.
+ * @return Number of points written.
+ */
+size_t history_query(HistoryWindow window, HistoryMetric metric, uint8_t series,
+                     int32_t *out, size_t max_points, int32_t none_value) {
+    if (window >= HIST_WINDOW_COUNT || metric >= HIST_METRIC_COUNT || max_points < 2) return 0;
+    const HistoryRing &r = rings[windows[window].ring];
+    if (!r.samples) return 0;
+
+    uint8_t field;
+    switch (metric) {
+        case HIST_TEMP: field = series;     break;
+        case HIST_HUM:  field = 3 + series; break;
+        case HIST_O2:   field = 6;          break;
+        default:        field = 7;          break;
+    }
+    if (field >= HISTORY_FIELDS) return 0;
+
+    const int16_t *flat = (const int16_t *)r.samples;
+    uint32_t n     = windows[window].samples;
+    uint32_t avail = (r.count < n) ? r.count : n;
+    uint32_t pad   = n - avail;                                  // missing, oldest end
+    uint32_t first = (r.head + r.capacity - avail) % r.capacity; // ring index of oldest kept
+
+    // Value at logical position i (0 = oldest in the window)
+    auto value_at = [&](uint32_t i) -> int16_t {
+        if (i < pad) return HISTORY_NONE;
+        uint32_t idx = first + (i - pad);
+        if (idx >= r.capacity) idx -= r.capacity;
+        return flat[idx * HISTORY_FIELDS + field];
+    };
+
+    // Few enough samples: one point per sample
+    if (n <= max_points) {
+        for (uint32_t i = 0; i < n; i++) {
+            int16_t v = value_at(i);
+            out[i] = (v == HISTORY_NONE) ? none_value : v;
+        }
+        return n;
+    }
+
+    // Min/max decimation: two points per bucket
+    size_t buckets = max_points / 2;
+    size_t w = 0;
+    for (size_t b = 0; b < buckets; b++) {
+        uint32_t start = (uint32_t)((uint64_t)b * n / buckets);
+        uint32_t end   = (uint32_t)((uint64_t)(b + 1) * n / buckets);
+        int16_t vmin = INT16_MAX, vmax = HISTORY_NONE;
+        uint32_t imin = 0, imax = 0;
+        for (uint32_t i = start; i < end; i++) {
+            int16_t v = value_at(i);
+            if (v == HISTORY_NONE) continue;
+            if (v < vmin) { vmin = v; imin = i; }
+            if (v > vmax) { vmax = v; imax = i; }
+        }
+        if (vmax == HISTORY_NONE) {
+            out[w++] = none_value;
+            out[w++] = none_value;
+        } else if (imin <= imax) {
+            out[w++] = vmin;
+            out[w++] = vmax;
+        } else {
+            out[w++] = vmax;
+            out[w++] = vmin;
+        }
+    }
+    return w;
+}
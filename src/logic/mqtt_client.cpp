@@ -0,0 +1,189 @@
+/******************************************************************************
+ * @file    mqtt_client.cpp
+ * @author  Thomas Zoldowski
+ * @date    October 18, 2026
+ * @brief   Minimal MQTT 3.1.1 client (see mqtt_client.h).
+ ******************************************************************************/
+
+#include "logic/mqtt_client.h"
+#include <mbed.h>
+#include <string.h>
+
+#define MQTT_POLL_MS      2
+#define MQTT_CONNECT_MAX  192   // CONNECT packet buffer (ids and credentials)
+
+/** @brief True once the deadline has passed (wrap-safe). */
+static inline bool expired(uint32_t deadline) {
+    return (int32_t)(millis() - deadline) >= 0;
+}
+
+/** @brief Read one byte, waiting up to the deadline. @return Byte, -1 on close, -2 on timeout. */
+static int read_byte(Client &net, uint32_t deadline) {
+    for (;;) {
+        if (net.available() > 0) return net.read();
+        if (!net.connected()) return -1;
+        if (expired(deadline)) return -2;
+        rtos::ThisThread::sleep_for(std::chrono::milliseconds(MQTT_POLL_MS));
+    }
+}
+
+/** @brief Store a 16-bit value big-endian (MQTT byte order). */
+static inline uint8_t *put_u16(uint8_t *p, uint16_t v) {
+    p[0] = (uint8_t)(v >> 8);
+    p[1] = (uint8_t)(v & 0xFF);
+    return p + 2;
+}
+
+/** @brief Store a length-prefixed UTF-8 string. */
+static inline uint8_t *put_str(uint8_t *p, const char *s, size_t n) {
+    p = put_u16(p, (uint16_t)n);
+    memcpy(p, s, n);
+    return p + n;
+}
+
+/** @brief Encode a remaining length. @return Bytes used (1-4). */
+static size_t put_varint(uint8_t *p, uint32_t v) {
+    size_t n = 0;
+    do {
+        uint8_t b = v & 0x7F;
+        v >>= 7;
+        p[n++] = v ? (uint8_t)(b | 0x80) : b;
+    } while (v);
+    return n;
+}
+
+/** @brief Write a whole buffer. */
+static bool send_all(MqttSession &s, const uint8_t *buf, size_t len) {
+    if (s.net->write(buf, len) != len) return false;
+    s.last_tx_ms = millis();
+    return true;
+}
+
+/** @brief Send CONNECT and wait for CONNACK. */
+int mqtt_connect(MqttSession &s, Client &net, const char *client_id,
+                 const char *user, const char *pass,
+                 uint16_t keepalive_s, uint32_t timeout_ms) {
+    s.net          = &net;
+    s.keepalive_s  = keepalive_s;
+    s.next_id      = 0;
+    s.ping_pending = false;
+    s.connack_rc   = 0xFF;
+
+    size_t id_len   = strlen(client_id);
+    size_t user_len = user ? strlen(user) : 0;
+    size_t pass_len = pass ? strlen(pass) : 0;
+    size_t body     = 10 + 2 + id_len + (user ? 2 + user_len : 0) + (pass ? 2 + pass_len : 0);
+    if (body + 5 > MQTT_CONNECT_MAX) return -1;
+
+    uint8_t  pkt[MQTT_CONNECT_MAX];
+    uint8_t *p = pkt;
+    *p++ = MQTT_CONNECT << 4;
+    p += put_varint(p, (uint32_t)body);
+    p  = put_str(p, "MQTT", 4);
+    *p++ = 4;                                             // protocol level 3.1.1
+    *p++ = 0x02 | (user ? 0x80 : 0) | (pass ? 0x40 : 0);  // clean session
+    p  = put_u16(p, keepalive_s);
+    p  = put_str(p, client_id, id_len);
+    if (user) p = put_str(p, user, user_len);
+    if (pass) p = put_str(p, pass, pass_len);
+    if (!send_all(s, pkt, p - pkt)) return -1;
+
+    uint16_t unused;
+    int type = mqtt_read(s, millis() + timeout_ms, unused);
+    if (type != MQTT_CONNACK) return -1;
+    return s.connack_rc;
+}
+
+/** @brief Bytes to leave in front of a PUBLISH payload. */
+size_t mqtt_publish_reserve(const char *topic) {
+    return 1 + 4 + 2 + strlen(topic) + 2;   // header, max varint, topic, packet id
+}
+
+/** @brief Frame and send a QoS 1 PUBLISH in place. */
+uint16_t mqtt_publish(MqttSession &s, uint8_t *buf, const char *topic, size_t payload_len) {
+    size_t topic_len = strlen(topic);
+    size_t reserve   = mqtt_publish_reserve(topic);
+
+    if (++s.next_id == 0) s.next_id = 1;       // 0 is not a valid identifier
+
+    // Variable header sits right in front of the payload
+    size_t   vh_len = 2 + topic_len + 2;
+    uint8_t *vh     = buf + reserve - vh_len;
+    put_u16(put_str(vh, topic, topic_len), s.next_id);
+
+    // Fixed header is right-aligned against it (the varint length varies)
+    uint8_t hdr[5];
+    hdr[0] = (MQTT_PUBLISH << 4) | 0x02;       // QoS 1
+    size_t   hlen  = 1 + put_varint(&hdr[1], (uint32_t)(vh_len + payload_len));
+    uint8_t *start = vh - hlen;
+    memcpy(start, hdr, hlen);
+
+    if (!send_all(s, start, hlen + vh_len + payload_len)) return 0;
+    return s.next_id;
+}
+
+/** @brief Read one packet; only PUBACK, CONNACK and PINGRESP carry anything we use. */
+int mqtt_read(MqttSession &s, uint32_t deadline, uint16_t &packet_id) {
+    int first = read_byte(*s.net, deadline);
+    if (first == -2) return 0;
+    if (first < 0)   return -1;
+
+    // Remaining length
+    uint32_t len = 0;
+    uint32_t rx_deadline = millis() + MQTT_RX_TIMEOUT_MS;
+    for (uint8_t shift = 0; ; shift += 7) {
+        int b = read_byte(*s.net, rx_deadline);
+        if (b < 0 || shift > 21) return -1;
+        len |= (uint32_t)(b & 0x7F) << shift;
+        if (!(b & 0x80)) break;
+    }
+
+    // Keep the first bytes, skip anything longer (e.g. an unexpected PUBLISH)
+    uint8_t body[4];
+    for (uint32_t i = 0; i < len; i++) {
+        int b = read_byte(*s.net, rx_deadline);
+        if (b < 0) return -1;
+        if (i < sizeof(body)) body[i] = (uint8_t)b;
+    }
+
+    int type = (first >> 4) & 0x0F;
+    switch (type) {
+        case MQTT_CONNACK:
+            if (len != 2) return -1;
+            s.connack_rc = body[1];
+            break;
+        case MQTT_PUBACK:
+            if (len != 2) return -1;
+            packet_id = (uint16_t)((body[0] << 8) | body[1]);
+            break;
+        case MQTT_PINGRESP:
+            s.ping_pending = false;
+            break;
+        default:
+            break;
+    }
+    return type;
+}
+
+/** @brief Milliseconds until a PINGREQ is due. */
+uint32_t mqtt_ping_due_in(const MqttSession &s) {
+    uint32_t period  = (uint32_t)s.keepalive_s * 1000UL / 2;   // well inside the broker's 1.5x
+    uint32_t elapsed = millis() - s.last_tx_ms;
+    return elapsed >= period ? 0 : period - elapsed;
+}
+
+/** @brief Send PINGREQ. */
+bool mqtt_ping(MqttSession &s) {
+    const uint8_t pkt[2] = { MQTT_PINGREQ << 4, 0 };
+    if (!send_all(s, pkt, sizeof(pkt))) return false;
+    s.ping_pending = true;
+    return true;
+}
+
+/** @brief Send DISCONNECT and close. */
+void mqtt_disconnect(MqttSession &s) {
+    if (!s.net) return;
+    const uint8_t pkt[2] = { MQTT_DISCONNECT << 4, 0 };
+    if (s.net->connected()) s.net->write(pkt, sizeof(pkt));
+    s.net->stop();
+}
@@ -0,0 +1,31 @@
+/******************************************************************************
+ * @file    net_encode.cpp
+ * @author  Thomas Zoldowski
+ * @date    October 18, 2026
+ * @brief   JSON fields of one upload reading, shared by both transports.
+ ******************************************************************************/
+#include "logic/net_encode.h"
+#include <time.h>
+
+/** @brief Fields shared by both transports, written into an open object. */
+void net_encode_reading(JsonWriter &w, const NetReading &r) {
+    char ts[24];
+    time_t t = (time_t)r.timestamp;
+    struct tm gm;
+    gmtime_r(&t, &gm);
+    strftime(ts, sizeof(ts), "%Y-%m-%dT%H:%M:%SZ", &gm);
+
+    // Missing readings (NAN) are sent as null
+    json_key(w, "timestamp"); json_string(w, ts);
+    json_key(w, "sensor");
+    json_begin_array(w);
+    for (uint8_t i = 0; i < 3; i++) {
+        json_begin_object(w);
+        json_key(w, "id");   json_uint(w, i);
+        json_key(w, "temp"); json_float(w, r.temp_f[i], 1);
+        json_key(w, "hum");  json_float(w, r.hum[i], 1);
+        json_end_object(w);
+    }
+    json_end_array(w);
+    json_key(w, "o2"); json_float(w, r.o2, 1);
+}
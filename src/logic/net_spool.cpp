@@ -0,0 +1,111 @@
+/******************************************************************************
+ * @file    net_spool.cpp
+ * @author  Thomas Zoldowski
+ * @date    October 18, 2026
+ * @brief   LittleFS spool for undelivered readings (see net_spool.h).
+ ******************************************************************************/
+
+#include "logic/net_spool.h"
+#include "config.h"
+#include <stdio.h>
+
+#define LOG_TAG   "NET"
+#define LOG_LEVEL LOG_LEVEL_NETWORK
+#include "log.h"
+
+#ifndef NET_SPOOL_DIR
+  #define NET_SPOOL_DIR "/user"
+#endif
+
+static const char *SPOOL_PATH = NET_SPOOL_DIR "/net_spool.bin";
+static const char *POS_PATH   = NET_SPOOL_DIR "/net_spool.pos";
+
+static uint32_t total     = 0;   // complete records in the file
+static uint32_t delivered = 0;   // records at the front already delivered
+
+/** @brief Persist the delivered count. */
+static void save_pos() {
+    FILE *f = fopen(POS_PATH, "wb");
+    if (!f) {
+        LOG_E("Cannot write %s", POS_PATH);
+        return;
+    }
+    fwrite(&delivered, sizeof(delivered), 1, f);
+    fclose(f);
+}
+
+/** @brief Pick up a spool left from before a reboot. */
+void net_spool_init() {
+    total     = 0;
+    delivered = 0;
+
+    FILE *f = fopen(SPOOL_PATH, "rb");
+    if (!f) return;
+    fseek(f, 0, SEEK_END);
+    long size = ftell(f);
+    fclose(f);
+    total = size > 0 ? (uint32_t)size / sizeof(NetReading) : 0;   // a torn last record is ignored
+
+    f = fopen(POS_PATH, "rb");
+    if (f) {
+        if (fread(&delivered, sizeof(delivered), 1, f) != 1) delivered = 0;
+        fclose(f);
+    }
+    if (delivered >= total) {
+        net_spool_consume(0);              // nothing left: remove the files
+        return;
+    }
+    LOG_I("%lu spooled readings to replay", (unsigned long)(total - delivered));
+}
+
+/** @brief Records waiting to be delivered. */
+uint32_t net_spool_count() {
+    return total - delivered;
+}
+
+/** @brief Append records. */
+uint32_t net_spool_append(const NetReading *r, uint32_t n) {
+    // The file only shrinks once fully replayed, so delivered records count too
+    if (total >= NET_SPOOL_MAX_RECORDS) return 0;
+    if (n > NET_SPOOL_MAX_RECORDS - total) n = NET_SPOOL_MAX_RECORDS - total;
+
+    FILE *f = fopen(SPOOL_PATH, "ab");
+    if (!f) {
+        LOG_E("Cannot open %s", SPOOL_PATH);
+        return 0;
+    }
+    uint32_t written = (uint32_t)fwrite(r, sizeof(NetReading), n, f);
+    fclose(f);
+    total += written;
+    return written;
+}
+
+/** @brief Read waiting records, oldest first. */
+uint32_t net_spool_read(uint32_t skip, NetReading *out, uint32_t max) {
+    uint32_t first = delivered + skip;
+    if (first >= total || max == 0) return 0;
+    if (max > total - first) max = total - first;
+
+    FILE *f = fopen(SPOOL_PATH, "rb");
+    if (!f) return 0;
+    uint32_t got = 0;
+    if (fseek(f, (long)first * sizeof(NetReading), SEEK_SET) == 0) {
+        got = (uint32_t)fread(out, sizeof(NetReading), max, f);
+    }
+    fclose(f);
+    return got;
+}
+
+/** @brief Mark the oldest n waiting records as delivered. */
+void net_spool_consume(uint32_t n) {
+    delivered += n;
+    if (delivered < total) {
+        save_pos();
+        return;
+    }
+    // Fully replayed: start the next outage with an empty file
+    remove(SPOOL_PATH);
+    remove(POS_PATH);
+    total     = 0;
+    delivered = 0;
+}
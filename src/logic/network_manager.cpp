@@ -2,22 +2,43 @@
  * @file    network_manager.cpp
  * @author  Thomas Zoldowski
  * @date    June 4, 2025
- * @brief   Wi-Fi connection and Ticker-driven sensor-data HTTPS POST
- *          (manual HTTP, no ArduinoHttpClient).
+ * @brief   Wi-Fi uploader thread: MQTT publisher or kept-alive HTTP/1.1.
+ *
+ * MQTT (NET_TRANSPORT_MQTT): readings waiting in the queue are published in
+ * batches of up to NET_MQTT_BATCH with QoS 1, with NET_MQTT_INFLIGHT
+ * PUBLISHes outstanding. A batch leaves the queue (or the spool) only when
+ * its PUBACK arrives. While the broker is unreachable the queue is moved to
+ * the LittleFS spool (net_spool.h), which is replayed first once the broker
+ * is back, so readings survive outages and reboots.
+ *
+ * HTTP (NET_TRANSPORT_HTTP): each reading is sent as one request on a
+ * connection that stays open between uploads. The JSON body is encoded by json_writer straight into
+ * the request buffer behind the headers, and the whole request goes out in
+ * a single write. The connection is closed when the server asks for it,
+ * after NET_IDLE_CLOSE_MS without use (or the server's Keep-Alive timeout,
+ * if shorter) and after any error.
+ * Responses are parsed line by line into a fixed buffer and the body is
+ * skipped by Content-Length or chunk sizes, so the stream stays in step
+ * for the next request without ever holding a whole response in RAM.
  ******************************************************************************/
 
-/* NOTE: THIS FILE IS NOT USED BUT IF YOU EVER NEED TO SEND DATA TO A SERVER,
- *       YOU CAN USE THIS AS A TEMPLATE.
- *       IT USES Ticker TO SCHEDULE PERIODIC UPLOADS.
- */
-
 #include <Arduino.h>
-#include <WiFi.h>             
-#include <Ticker.h>
-#include "logic/sensor_manager.h"
+#include <mbed.h>
+#include <WiFi.h>
+#include <WiFiSSLClient.h>
+#include <time.h>
+#include <strings.h>
 #include "logic/network_manager.h"
+#include "logic/sensor_manager.h"
+#include "logic/mqtt_client.h"
+#include "logic/net_spool.h"
+#include "logic/net_encode.h"
+#include "json_writer.h"
 #include "config.h"
-#include <SPI.h>
+
+#define LOG_TAG   "NET"
+#define LOG_LEVEL LOG_LEVEL_NETWORK
+#include "log.h"
 
 // Override via platformio.ini or defaults here:
 #ifndef WIFI_SSID
@@ -32,181 +53,723 @@
 #ifndef API_PATH
   #define API_PATH "/prod/readings"
 #endif
-static const uint16_t API_PORT = 443;  // HTTPS port
+#ifndef NET_USE_TLS
+  #define NET_USE_TLS 1      // 0 = plain HTTP (local stand-in server)
+#endif
+#ifndef API_PORT
+  #define API_PORT (NET_USE_TLS ? 443 : 80)
+#endif
+#ifndef MQTT_HOST
+  #define MQTT_HOST "mqtt.local"
+#endif
+#ifndef MQTT_PORT
+  #define MQTT_PORT (NET_USE_TLS ? 8883 : 1883)
+#endif
+#ifndef MQTT_USER
+  #define MQTT_USER nullptr
+#endif
+#ifndef MQTT_PASS
+  #define MQTT_PASS nullptr
+#endif
+#ifndef MQTT_TOPIC
+  #define MQTT_TOPIC "composter/GIGA-001/readings"
+#endif
+
+#define NET_DEVICE_ID       "GIGA-001"
+#define NET_HEADER_MAX      256    // request line + headers
+#define NET_LEN_DIGITS      5      // Content-Length field width
+#define NET_POLL_MS         2      // wait between checks for response bytes
+#define NET_WIFI_TIMEOUT_MS 10000  // give up joining after this
+
+// Result of one request when no HTTP status is available
+#define NET_ERR_NO_RESPONSE (-2)   // write failed or not a single byte came back
+#define NET_ERR_PROTOCOL    (-1)   // timeout or malformed response mid-way
+
+static NetReading      queue[NET_QUEUE_LEN];
+static uint8_t         queue_head  = 0;
+static uint8_t         queue_count = 0;
+static NetworkStats    stats       = {};
+static rtos::Mutex     queue_mutex;           // guards the queue and stats
+static rtos::Semaphore wake(0, 1);            // released when a reading is queued
+
+// Everything below is only touched by the uploader thread
+#if NET_USE_TLS
+static WiFiSSLClient client;
+#else
+static WiFiClient    client;
+#endif
+
+static rtos::Thread net_thread(osPriorityLow, 8192, nullptr, "net_tx");   // TLS handshake needs the stack
+
+#if NET_TRANSPORT == NET_TRANSPORT_HTTP
+static bool     conn_open    = false;
+static uint32_t conn_idle_ms = NET_IDLE_CLOSE_MS;
+static uint32_t last_used_ms = 0;
+static char     req_buf[NET_HEADER_MAX + NET_BODY_MAX];
+
+// Everything up to the Content-Length value, which is patched in once the
+// body has been encoded behind it
+static const char REQ_HEAD[] =
+    "POST " API_PATH " HTTP/1.1\r\n"
+    "Host: " API_HOST "\r\n"
+    "Content-Type: application/json\r\n"
+    "Connection: keep-alive\r\n"
+    "Content-Length: ";
+
+static_assert(sizeof(REQ_HEAD) - 1 + NET_LEN_DIGITS + 4 <= NET_HEADER_MAX,
+              "API_HOST/API_PATH too long for NET_HEADER_MAX");
+static_assert(NET_BODY_MAX <= 99999, "NET_BODY_MAX needs more NET_LEN_DIGITS");
+#endif
+
+/** @brief Block this thread for a number of milliseconds. */
+static inline void net_sleep(uint32_t ms) {
+    rtos::ThisThread::sleep_for(std::chrono::milliseconds(ms));
+}
+
+/** @brief True once the deadline has passed (wrap-safe). */
+static inline bool expired(uint32_t deadline) {
+    return (int32_t)(millis() - deadline) >= 0;
+}
+
+// ================= QUEUE =================
+/**
+ * @brief Copy queued readings without removing them.
+ * @param skip Entries at the front to skip (already in flight).
+ * @return Number copied.
+ */
+static uint32_t queue_copy(uint32_t skip, NetReading *out, uint32_t max) {
+    queue_mutex.lock();
+    uint32_t n = 0;
+    for (uint32_t i = skip; i < queue_count && n < max; i++) {
+        out[n++] = queue[(queue_head + i) % NET_QUEUE_LEN];
+    }
+    queue_mutex.unlock();
+    return n;
+}
+
+/** @brief Remove the oldest n queued readings. */
+static void queue_pop(uint32_t n) {
+    queue_mutex.lock();
+    if (n > queue_count) n = queue_count;
+    queue_head   = (queue_head + n) % NET_QUEUE_LEN;
+    queue_count -= n;
+    queue_mutex.unlock();
+}
+
+/** @brief Sample the sensors into the queue (loop() context). */
+void network_submit_reading() {
+    NetReading r;
+    r.timestamp = (uint32_t)time(nullptr);
+    for (uint8_t i = 0; i < 3; i++) {
+        float tC    = sensor_manager_get_temperature(i);
+        r.temp_f[i] = tC * 9.0f / 5.0f + 32.0f;
+        r.hum[i]    = sensor_manager_get_humidity(i);
+    }
+    r.o2 = sensor_manager_get_oxygen();
+
+    // The front of the queue may be in flight, so a full queue refuses the
+    // new reading rather than overwriting the oldest
+    queue_mutex.lock();
+    if (queue_count == NET_QUEUE_LEN) {
+        stats.dropped++;
+    } else {
+        queue[(queue_head + queue_count) % NET_QUEUE_LEN] = r;
+        queue_count++;
+        stats.queued++;
+    }
+    queue_mutex.unlock();
+    wake.release();
+}
 
-// Prototype function
-static void sendSensorData();
+/** @brief Snapshot of the uploader counters. */
+NetworkStats network_get_stats() {
+    queue_mutex.lock();
+    NetworkStats s = stats;
+    queue_mutex.unlock();
+    return s;
+}
+
+// ================= CONNECTION =================
+/** @brief Join the access point if not already joined. @return True when joined. */
+static bool wifi_join() {
+    if (WiFi.status() == WL_CONNECTED) return true;
+
+    LOG_I("Joining %s", WIFI_SSID);
+    WiFi.begin(WIFI_SSID, WIFI_PW);   // blocks this thread only
+    uint32_t deadline = millis() + NET_WIFI_TIMEOUT_MS;
+    while (WiFi.status() != WL_CONNECTED && !expired(deadline)) net_sleep(250);
+
+    if (WiFi.status() != WL_CONNECTED) {
+        LOG_W("Wi-Fi join failed");
+        return false;
+    }
+    IPAddress ip = WiFi.localIP();
+    LOG_I("Wi-Fi joined, IP %d.%d.%d.%d", ip[0], ip[1], ip[2], ip[3]);
+    return true;
+}
+
+/** @brief Record a delivery's round-trip time. */
+static void note_delivered(uint32_t readings, uint32_t took) {
+    queue_mutex.lock();
+    stats.sent   += readings;
+    stats.last_ms = took;
+    stats.avg_ms  = (stats.sent == readings) ? took : stats.avg_ms + ((int32_t)(took - stats.avg_ms) / 8);
+    queue_mutex.unlock();
+}
+
+/** @brief Count a failed attempt. */
+static void note_failure() {
+    queue_mutex.lock();
+    stats.failures++;
+    queue_mutex.unlock();
+}
+
+#if NET_TRANSPORT == NET_TRANSPORT_HTTP
+// ================= HTTP =================
+/** @brief Drop the connection. */
+static void close_conn() {
+    if (conn_open) LOG_D("Closing connection");
+    client.stop();
+    conn_open    = false;
+    conn_idle_ms = NET_IDLE_CLOSE_MS;
+}
+
+/** @brief Open a new connection to the API host. @return True on success. */
+static bool open_conn() {
+    client.setSocketTimeout(NET_CONNECT_TIMEOUT_MS);
+    if (!client.connect(API_HOST, API_PORT)) {
+        LOG_W("Connect to %s:%d failed", API_HOST, (int)API_PORT);
+        return false;
+    }
+    conn_open    = true;
+    last_used_ms = millis();
+    queue_mutex.lock();
+    stats.connects++;
+    queue_mutex.unlock();
+    return true;
+}
+
+/** @brief Close the connection if it has idled out or the server closed it. */
+static void expire_idle() {
+    if (!conn_open) return;
+    if (millis() - last_used_ms >= conn_idle_ms || !client.connected()) close_conn();
+}
+
+// ================= RESPONSE PARSING =================
+/** @brief Read one byte, waiting up to the deadline. @return Byte, or -1. */
+static int read_byte(uint32_t deadline) {
+    for (;;) {
+        if (client.available() > 0) return client.read();
+        if (!client.connected() || expired(deadline)) return -1;
+        net_sleep(NET_POLL_MS);
+    }
+}
+
+/**
+ * @brief Read one CRLF-terminated line. Characters beyond the buffer are
+ *        read and discarded.
+ * @return Length stored (0 for a blank line), or -1 on timeout/close.
+ */
+static int read_line(char *buf, size_t size, uint32_t deadline) {
+    size_t n = 0;
+    for (;;) {
+        int c = read_byte(deadline);
+        if (c < 0)    return -1;
+        if (c == '\n') break;
+        if (c != '\r' && n < size - 1) buf[n++] = (char)c;
+    }
+    buf[n] = '\0';
+    return (int)n;
+}
 
-// Interval between uploads in milliseconds (60 000 ms = 60 s)
-static const unsigned long UPLOAD_INTERVAL_MS = 60000UL;
+/** @brief Read and throw away exactly n bytes. @return False on timeout/close. */
+static bool discard(uint32_t n, uint32_t deadline) {
+    uint8_t scratch[64];
+    while (n > 0) {
+        int avail = client.available();
+        if (avail <= 0) {
+            if (!client.connected() || expired(deadline)) return false;
+            net_sleep(NET_POLL_MS);
+            continue;
+        }
+        size_t want = min((uint32_t)avail, min(n, (uint32_t)sizeof(scratch)));
+        int got = client.read(scratch, want);
+        if (got <= 0) return false;
+        n -= (uint32_t)got;
+    }
+    return true;
+}
 
-// Create a single Ticker instance (uninitialized for now).
-//static Ticker sensorTicker;
-static Ticker sensorTicker(sendSensorData, UPLOAD_INTERVAL_MS, 0, MILLIS);
+/** @brief Skip a chunked body, including any trailer lines. */
+static bool discard_chunked(uint32_t deadline) {
+    char line[NET_LINE_MAX];
+    for (;;) {
+        if (read_line(line, sizeof(line), deadline) < 0) return false;
+        uint32_t size = strtoul(line, nullptr, 16);
+        if (size == 0) break;
+        if (!discard(size + 2, deadline)) return false;   // data + CRLF
+    }
+    for (;;) {
+        int n = read_line(line, sizeof(line), deadline);
+        if (n < 0)  return false;
+        if (n == 0) return true;
+    }
+}
 
-/// Fill buf (length ≥32) with current UTC in ISO-8601 (e.g. "2025-06-04T15:04:00Z")
-static void getIsoTimestamp(char *buf, size_t len) {
-  time_t now = time(nullptr);
-  struct tm *gm = gmtime(&now);
-  strftime(buf, len, "%Y-%m-%dT%H:%M:%SZ", gm);
+/** @brief Value of a "Name: value" header line, or nullptr if the name differs. */
+static const char *header_value(const char *line, const char *name) {
+    size_t n = strlen(name);
+    if (strncasecmp(line, name, n) != 0 || line[n] != ':') return nullptr;
+    const char *v = line + n + 1;
+    while (*v == ' ' || *v == '\t') v++;
+    return v;
 }
 
-/// Called by the Ticker once per interval to read sensors + HTTPS-POST JSON.
-static void sendSensorData() {
+/**
+ * @brief Read a response and skip its body so the next request can reuse
+ *        the connection.
+ * @return HTTP status, or NET_ERR_NO_RESPONSE / NET_ERR_PROTOCOL.
+ */
+static int read_response(uint32_t deadline) {
+    char line[NET_LINE_MAX];
+
+    // Nothing at all usually means the server dropped an idle connection
+    int first = read_byte(deadline);
+    if (first < 0) return NET_ERR_NO_RESPONSE;
+    line[0] = (char)first;
+    if (read_line(&line[1], sizeof(line) - 1, deadline) < 0) return NET_ERR_PROTOCOL;
+
+    int status = 0;
+    if (sscanf(line, "HTTP/1.%*d %d", &status) != 1) return NET_ERR_PROTOCOL;
+    bool keep_alive     = strncmp(line, "HTTP/1.1", 8) == 0;   // 1.0 closes by default
+    bool chunked        = false;
+    long content_length = -1;
+
+    for (;;) {
+        int n = read_line(line, sizeof(line), deadline);
+        if (n < 0)  return NET_ERR_PROTOCOL;
+        if (n == 0) break;
+        const char *v;
+        if ((v = header_value(line, "Content-Length"))) {
+            content_length = strtol(v, nullptr, 10);
+        } else if ((v = header_value(line, "Transfer-Encoding"))) {
+            chunked = strncasecmp(v, "chunked", 7) == 0;
+        } else if ((v = header_value(line, "Connection"))) {
+            keep_alive = strncasecmp(v, "close", 5) != 0;
+        } else if ((v = header_value(line, "Keep-Alive"))) {
+            // "timeout=5": close on our side a second before the server does
+            const char *t = strstr(v, "timeout=");
+            if (t) {
+                uint32_t ms = strtoul(t + 8, nullptr, 10) * 1000UL;
+                if (ms > 1000 && ms - 1000 < conn_idle_ms) conn_idle_ms = ms - 1000;
+            }
+        }
+    }
+
+    bool ok;
+    if (status == 204 || status == 304 || status < 200) {
+        ok = true;                                  // no body
+    } else if (chunked) {
+        ok = discard_chunked(deadline);
+    } else if (content_length >= 0) {
+        ok = discard((uint32_t)content_length, deadline);
+    } else {
+        // Body runs until the server closes
+        keep_alive = false;
+        while (read_byte(deadline) >= 0) {}
+        ok = true;
+    }
+    if (!ok) return NET_ERR_PROTOCOL;
+    if (!keep_alive) close_conn();
+    return status;
+}
 
-    float temps[3], hums[3], o2val = NAN;
+// ================= REQUEST =================
+/**
+ * @brief Build the POST for a reading in req_buf.
+ * @return Request length, or 0 if the body does not fit in NET_BODY_MAX.
+ */
+static size_t build_request(const NetReading &r) {
+    size_t head = sizeof(REQ_HEAD) - 1;
+    memcpy(req_buf, REQ_HEAD, head);
+    char *len_field = &req_buf[head];
+    memcpy(&req_buf[head + NET_LEN_DIGITS], "\r\n\r\n", 4);
+    size_t body_at = head + NET_LEN_DIGITS + 4;
+
+    JsonWriter w;
+    json_init(w, &req_buf[body_at], NET_BODY_MAX);
+    json_begin_object(w);
+    json_key(w, "deviceId"); json_string(w, NET_DEVICE_ID);
+    net_encode_reading(w, r);
+    json_end_object(w);
+    if (!json_finish(w)) return 0;
+
+    // Right-aligned; the leading spaces are allowed header whitespace
+    size_t len = json_length(w);
+    for (int i = NET_LEN_DIGITS - 1; i >= 0; i--) {
+        len_field[i] = (len || i == NET_LEN_DIGITS - 1) ? (char)('0' + len % 10) : ' ';
+        len /= 10;
+    }
+    return body_at + json_length(w);
+}
 
-    #ifdef SIMULATION_MODE
-    // ---------------- Simulated data path ----------------
-    for (int i = 0; i < 3; i++) {
-        // Pick a random temperature between 20.0°F and 30.0°F for example
-        float tempF = 20.0f + (random(0, 101) * 0.1f);   // 20.0 -> 30.0
-        float humPct = 40.0f + (random(0, 201) * 0.1f);  // 40.0% -> 60.0%
+/** @brief Write the request in req_buf (one write, so one TLS record) and read the reply. */
+static int send_request(size_t total) {
+    if (client.write((const uint8_t *)req_buf, total) != total) return NET_ERR_NO_RESPONSE;
+    return read_response(millis() + NET_RESPONSE_TIMEOUT_MS);
+}
 
-        temps[i] = tempF;
-        hums[i]  = humPct;
+/**
+ * @brief Send the request in req_buf, reusing the open connection when there is one.
+ * @return HTTP status, or a negative NET_ERR_* code.
+ */
+static int upload(size_t total) {
+    bool reused = conn_open;
+    if (!conn_open && !open_conn()) return NET_ERR_NO_RESPONSE;
+
+    int status = send_request(total);
+    if (status == NET_ERR_NO_RESPONSE && reused) {
+        // The server closed the idle connection before we noticed; the
+        // request never got an answer, so sending it again is safe
+        LOG_D("Stale connection, reconnecting");
+        close_conn();
+        if (!open_conn()) return NET_ERR_NO_RESPONSE;
+        reused = false;
+        status = send_request(total);
+    }
+    if (status < 0) {
+        close_conn();
+        return status;
     }
-    // Simulate O₂ around 20.9%
-    o2val = 20.0f + (random(0, 21) * 0.01f);  // 20.00 -> 20.20
-    #else
-        // ---------------- Real‐sensor path ----------------
-        ConnectionStatus st = sensor_manager_get_connection_status();
-        for (int i = 0; i < 3; i++) {
-            if (st.sensor[i]) {
-            float tC = sensor_manager_get_temperature(i);
-            temps[i] = (tC * 9.0f / 5.0f) + 32.0f;
-            hums[i]  = sensor_manager_get_humidity(i);
+    last_used_ms = millis();
+    if (reused) {
+        queue_mutex.lock();
+        stats.reused++;
+        queue_mutex.unlock();
+    }
+    return status;
+}
+
+/** @brief HTTP uploader loop: one reading per request, back off on failure. */
+static void run_http() {
+    uint32_t backoff = NET_RETRY_MIN_MS;
+    for (;;) {
+        expire_idle();
+
+        NetReading r;
+        if (queue_copy(0, &r, 1) == 0) {
+            // Sleep until a reading is queued (or the idle connection is due to close)
+            if (conn_open) {
+                uint32_t idle = millis() - last_used_ms;
+                wake.try_acquire_for(std::chrono::milliseconds(idle < conn_idle_ms ? conn_idle_ms - idle : 0));
             } else {
-            temps[i] = NAN;
-            hums[i]  = NAN;
+                wake.acquire();
             }
+            continue;
+        }
+
+        if (!wifi_join()) {
+            net_sleep(backoff);
+            backoff = min(backoff * 2, (uint32_t)NET_RETRY_MAX_MS);
+            continue;
+        }
+
+        size_t total = build_request(r);
+        if (total == 0) {
+            LOG_E("Reading does not fit in NET_BODY_MAX");
+            queue_pop(1);
+            continue;
+        }
+
+        uint32_t start  = millis();
+        int      status = upload(total);
+        uint32_t took   = millis() - start;
+
+        if (status >= 200 && status < 300) {
+            queue_pop(1);
+            note_delivered(1, took);
+            LOG_D("Uploaded in %lu ms", (unsigned long)took);
+            backoff = NET_RETRY_MIN_MS;
+        } else if (status >= 400 && status < 500) {
+            // The server will not take this reading however often it is sent
+            queue_pop(1);
+            queue_mutex.lock();
+            stats.rejected++;
+            queue_mutex.unlock();
+            LOG_W("Reading rejected with HTTP %d", status);
+            backoff = NET_RETRY_MIN_MS;
+        } else {
+            note_failure();
+            LOG_W("Upload failed (%d), retrying in %lu ms", status, (unsigned long)backoff);
+            net_sleep(backoff);
+            backoff = min(backoff * 2, (uint32_t)NET_RETRY_MAX_MS);
         }
-        // If you have an O₂ sensor, do:
-        //     o2val = sensor_manager_get_o2();
-        // otherwise leave as NAN (it will become 0.0 in the JSON below)
-    #endif
-
-  char tsbuf[32];
-  getIsoTimestamp(tsbuf, sizeof(tsbuf));
-
-  // Build JSON payload
-  char json[512];
-  int len = snprintf(json, sizeof(json),
-    "{"
-      "\"deviceId\":\"GIGA-001\","
-      "\"timestamp\":\"%s\","
-      "\"sensor\":["
-        "{\"id\":0,\"temp\":%.1f,\"hum\":%.1f},"
-        "{\"id\":1,\"temp\":%.1f,\"hum\":%.1f},"
-        "{\"id\":2,\"temp\":%.1f,\"hum\":%.1f}"
-      "],"
-      "\"o2\":%.1f"
-    "}",
-    tsbuf,
-    isnan(temps[0]) ? 0.0f : temps[0],
-    isnan(hums[0])  ? 0.0f : hums[0],
-    isnan(temps[1]) ? 0.0f : temps[1],
-    isnan(hums[1])  ? 0.0f : hums[1],
-    isnan(temps[2]) ? 0.0f : temps[2],
-    isnan(hums[2])  ? 0.0f : hums[2],
-    isnan(o2val)    ? 0.0f : o2val
-  );
-  if (len < 0 || len >= (int)sizeof(json)) {
-    Serial.println("[Error] JSON buffer overflow");
-    return;
-  }
-
-  // 1) Create a TLS client (WiFiClientSecure)
-  WiFiClient tlsClient;
-  // For testing, skip certificate verification:
-
-  // 2) Connect to the host on port 443
-  if (!tlsClient.connect(API_HOST, API_PORT)) {
-    Serial.println("[HTTPS] Connection failed");
-    return;
-  }
-
-  // 3) Manually format and send the HTTP/1.1 POST request
-  String request =
-    String("POST ") + API_PATH + " HTTP/1.1\r\n" +
-    "Host: " + API_HOST + "\r\n" +
-    "Content-Type: application/json\r\n" +
-    "Content-Length: " + String(len) + "\r\n" +
-    "Connection: close\r\n\r\n" +
-    String(json);
-
-  tlsClient.print(request);
-
-  // 4) Read the status line (e.g. "HTTP/1.1 200 OK")
-  String statusLine = tlsClient.readStringUntil('\n');
-  statusLine.trim();
-  Serial.print("[HTTPS] ");
-  Serial.println(statusLine);
-
-  // 5) Skip HTTP headers until a blank line
-  while (tlsClient.connected()) {
-    String line = tlsClient.readStringUntil('\n');
-    if (line == "\r" || line == "\n" || line.length() == 0) break;
-  }
-
-  // 6) Optionally read any response body
-  String body = tlsClient.readString();
-  if (body.length()) {
-    Serial.print("[HTTPS] Body: ");
-    Serial.println(body);
-  }
-
-  tlsClient.stop();
+    }
 }
 
-void network_init() {
-    // 1) Check that the Wi-Fi module is present
-    if (WiFi.status() == WL_NO_MODULE) {
-        Serial.println("Communication with WiFi module failed!");
-        // don’t continue if no hardware
-        while (true) {}
+#else
+// ================= MQTT =================
+/** @brief Readings waiting in the queue. */
+static uint32_t queue_size() {
+    queue_mutex.lock();
+    uint32_t n = queue_count;
+    queue_mutex.unlock();
+    return n;
+}
+
+// A PUBLISH waiting for its PUBACK
+typedef struct {
+    uint16_t packet_id;
+    uint8_t  count;         // readings in the batch
+    bool     from_spool;    // else from the RAM queue
+    bool     acked;
+    uint32_t sent_ms;
+} InFlight;
+
+#define MQTT_RESERVE (sizeof(MQTT_TOPIC) + 8)   // mqtt_publish_reserve(MQTT_TOPIC)
+
+static MqttSession mqtt;
+static bool        mqtt_up        = false;
+static InFlight    inflight[NET_MQTT_INFLIGHT];
+static uint8_t     inflight_head  = 0;
+static uint8_t     inflight_count = 0;
+static uint32_t    spool_reserved = 0;   // spooled readings in flight
+static uint32_t    queue_reserved = 0;   // queued readings in flight
+static NetReading  batch[NET_MQTT_BATCH];
+static uint8_t     tx_buf[MQTT_RESERVE + NET_MQTT_PAYLOAD_MAX];
+
+/** @brief Publish the spool counters. */
+static void note_spool() {
+    uint32_t waiting = net_spool_count();
+    queue_mutex.lock();
+    stats.spool_waiting = waiting;
+    queue_mutex.unlock();
+}
+
+/** @brief Connect to the broker. @return True once CONNACK accepted the session. */
+static bool mqtt_open() {
+    client.setSocketTimeout(NET_CONNECT_TIMEOUT_MS);
+    if (!client.connect(MQTT_HOST, MQTT_PORT)) {
+        LOG_W("Connect to %s:%d failed", MQTT_HOST, (int)MQTT_PORT);
+        return false;
     }
-    Serial.println("WiFi module detected!");
+    int rc = mqtt_connect(mqtt, client, NET_DEVICE_ID, MQTT_USER, MQTT_PASS,
+                          NET_MQTT_KEEPALIVE_S, NET_RESPONSE_TIMEOUT_MS);
+    if (rc != 0) {
+        if (rc < 0) LOG_W("No CONNACK from the broker");
+        else        LOG_W("Broker refused the connection (%d)", rc);
+        client.stop();
+        return false;
+    }
+    mqtt_up = true;
+    queue_mutex.lock();
+    stats.connects++;
+    queue_mutex.unlock();
+    LOG_I("Connected to %s:%d", MQTT_HOST, (int)MQTT_PORT);
+    return true;
+}
 
-    // 2) Start connecting, but don’t block forever
-    Serial.print("[WiFi] Connecting to ");
-    Serial.print(WIFI_SSID);
-    Serial.print(" …");
+/** @brief Drop the connection; unacknowledged batches are sent again after reconnecting. */
+static void mqtt_lost(const char *why) {
+    LOG_W("%s, %d batch(es) unacknowledged", why, inflight_count);
+    note_failure();
+    client.stop();
+    mqtt_up        = false;
+    inflight_count = 0;
+    spool_reserved = 0;
+    queue_reserved = 0;
+}
 
-    WiFi.begin(WIFI_SSID, WIFI_PW);
+/** @brief Move everything in the RAM queue to the spool (broker unreachable). */
+static void spool_queue() {
+    uint32_t n;
+    while ((n = queue_copy(0, batch, NET_MQTT_BATCH)) > 0) {
+        uint32_t stored = net_spool_append(batch, n);
+        queue_pop(n);
+        queue_mutex.lock();
+        stats.spooled += stored;
+        stats.dropped += n - stored;      // spool full
+        queue_mutex.unlock();
+    }
+    note_spool();
+}
 
-    unsigned long start = millis();
-    const unsigned long timeout = 10UL * 1000UL;  // 10 seconds
+/** @brief Wait out a reconnect backoff, spooling readings as they arrive. */
+static void offline_wait(uint32_t ms) {
+    uint32_t until = millis() + ms;
+    while (!expired(until)) {
+        wake.try_acquire_for(std::chrono::milliseconds(until - millis()));
+        spool_queue();
+    }
+}
 
-    while (WiFi.status() != WL_CONNECTED && (millis() - start) < timeout) {
-        delay(500);
-        Serial.print(".");
+/** @brief Retire acknowledged batches from the front of the window, in order. */
+static void on_puback(uint16_t packet_id) {
+    for (uint8_t i = 0; i < inflight_count; i++) {
+        InFlight &f = inflight[(inflight_head + i) % NET_MQTT_INFLIGHT];
+        if (f.packet_id == packet_id && !f.acked) {
+            f.acked = true;
+            note_delivered(f.count, millis() - f.sent_ms);
+            break;
+        }
     }
+    bool spool_changed = false;
+    while (inflight_count > 0 && inflight[inflight_head].acked) {
+        InFlight &f = inflight[inflight_head];
+        if (f.from_spool) {
+            net_spool_consume(f.count);
+            spool_reserved -= f.count;
+            spool_changed   = true;
+        } else {
+            queue_pop(f.count);
+            queue_reserved -= f.count;
+        }
+        inflight_head = (inflight_head + 1) % NET_MQTT_INFLIGHT;
+        inflight_count--;
+    }
+    if (spool_changed) note_spool();
+}
 
-    // 3) Check result after timeout or successful connect
-    if (WiFi.status() == WL_CONNECTED) {
-        Serial.print("\n[WiFi] Connected (IP=");
-        Serial.print(WiFi.localIP());
-        Serial.println(")");
-    } else {
-        Serial.println("\n[WiFi] Failed to connect within 10 s – continuing without Wi-Fi");
-        // You could call WiFi.disconnect() here if you want to clean up
+/** @brief Encode a batch payload at tx_buf + MQTT_RESERVE. @return Length, 0 if it does not fit. */
+static size_t encode_batch(uint32_t n) {
+    JsonWriter w;
+    json_init(w, (char *)&tx_buf[MQTT_RESERVE], NET_MQTT_PAYLOAD_MAX);
+    json_begin_object(w);
+    json_key(w, "deviceId"); json_string(w, NET_DEVICE_ID);
+    json_key(w, "readings");
+    json_begin_array(w);
+    for (uint32_t i = 0; i < n; i++) {
+        json_begin_object(w);
+        net_encode_reading(w, batch[i]);
+        json_end_object(w);
     }
+    json_end_array(w);
+    json_end_object(w);
+    return json_finish(w) ? json_length(w) : 0;
 }
 
+/**
+ * @brief Publish the next batch: spooled readings first, then the queue.
+ * @return 1 if a batch was sent, 0 if nothing is waiting, -1 if the write failed.
+ */
+static int publish_batch() {
+    bool     from_spool = true;
+    uint32_t n = net_spool_read(spool_reserved, batch, NET_MQTT_BATCH);
+    if (n == 0) {
+        if (net_spool_count() > spool_reserved) return 0;   // unreadable; retried later
+        from_spool = false;
+        n = queue_copy(queue_reserved, batch, NET_MQTT_BATCH);
+        if (n == 0) return 0;
+    }
+
+    // Unusually long numbers can overflow the payload: send fewer readings
+    size_t len;
+    while ((len = encode_batch(n)) == 0 && n > 1) n /= 2;
+    if (len == 0) {
+        LOG_E("Reading does not fit in NET_MQTT_PAYLOAD_MAX, dropped");
+        if (inflight_count > 0) return 0;          // retire it once the window is empty
+        if (from_spool) net_spool_consume(1);
+        else            queue_pop(1);
+        queue_mutex.lock();
+        stats.dropped++;
+        queue_mutex.unlock();
+        return 1;
+    }
 
-void network_update() {
-  // Must call update() each loop so Ticker can check if it's time to call sendSensorData()
-  sensorTicker.update();
+    uint16_t id = mqtt_publish(mqtt, tx_buf, MQTT_TOPIC, len);
+    if (id == 0) return -1;
+
+    InFlight &f  = inflight[(inflight_head + inflight_count) % NET_MQTT_INFLIGHT];
+    f.packet_id  = id;
+    f.count      = (uint8_t)n;
+    f.from_spool = from_spool;
+    f.acked      = false;
+    f.sent_ms    = millis();
+    inflight_count++;
+    if (from_spool) spool_reserved += n;
+    else            queue_reserved += n;
+    return 1;
 }
 
-void start_Network(){
-  // 3) Send one payload immediately
-  sendSensorData();
+/** @brief MQTT publisher loop. */
+static void run_mqtt() {
+    static_assert(NET_MQTT_BATCH <= 255, "InFlight.count is 8 bits");
+    net_spool_init();
+    note_spool();
+
+    uint32_t backoff = NET_RETRY_MIN_MS;
+    for (;;) {
+        if (!mqtt_up) {
+            // Connect only once there is something to send
+            if (queue_size() == 0 && net_spool_count() == 0) {
+                wake.acquire();
+                continue;
+            }
+            if (!wifi_join() || !mqtt_open()) {
+                spool_queue();
+                note_failure();
+                LOG_W("Broker unreachable, retrying in %lu ms", (unsigned long)backoff);
+                offline_wait(backoff);
+                backoff = min(backoff * 2, (uint32_t)NET_RETRY_MAX_MS);
+                continue;
+            }
+            backoff = NET_RETRY_MIN_MS;
+        }
+
+        // Keep the window full
+        int sent = 1;
+        while (inflight_count < NET_MQTT_INFLIGHT && (sent = publish_batch()) > 0) {}
+        if (sent < 0) {
+            mqtt_lost("Publish failed");
+            continue;
+        }
+
+        // Idle: sleep until a reading is queued or a keep-alive ping is due
+        if (inflight_count == 0 && !mqtt.ping_pending) {
+            uint32_t ping_in = mqtt_ping_due_in(mqtt);
+            if (ping_in > 0) {
+                wake.try_acquire_for(std::chrono::milliseconds(ping_in));
+                continue;
+            }
+            if (!mqtt_ping(mqtt)) {
+                mqtt_lost("Ping failed");
+                continue;
+            }
+        }
+
+        uint16_t id   = 0;
+        int      type = mqtt_read(mqtt, millis() + NET_RESPONSE_TIMEOUT_MS, id);
+        if (type <= 0) {
+            mqtt_lost(type == 0 ? "Broker timed out" : "Connection lost");
+            continue;
+        }
+        if (type == MQTT_PUBACK) on_puback(id);
+    }
+}
+#endif
 
-  // 4) Construct the Ticker:
-  //    callback=sendSensorData, interval=UPLOAD_INTERVAL_MS, repeat=0 (infinite), resolution=MILLIS
-  
-  sensorTicker.start();
+// ================= THREAD =================
+/** @brief Uploader thread. */
+static void net_thread_fn() {
+    if (WiFi.status() == WL_NO_MODULE) {
+        LOG_E("Wi-Fi module not found, uploads disabled");
+        return;
+    }
+#if NET_TRANSPORT == NET_TRANSPORT_HTTP
+    run_http();
+#else
+    run_mqtt();
+#endif
+}
 
+/** @brief Start the uploader thread. */
+void network_init() {
+    net_thread.start(mbed::callback(net_thread_fn));
+#if NET_TRANSPORT == NET_TRANSPORT_HTTP
+    LOG_I("Uploader started (%s://%s:%d%s)", NET_USE_TLS ? "https" : "http",
+          API_HOST, (int)API_PORT, API_PATH);
+#else
+    LOG_I("Uploader started (mqtt%s://%s:%d, topic %s)", NET_USE_TLS ? "s" : "",
+          MQTT_HOST, (int)MQTT_PORT, MQTT_TOPIC);
+#endif
 }
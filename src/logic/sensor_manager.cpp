@@ -5,16 +5,31 @@
  * @brief   Definitions for initializing and reading compost sensors.
  ******************************************************************************/
 
-#include <DFRobot_OxygenSensor.h>
 #include "logic/sensor_manager.h"
+#include "logic/telemetry.h"
+#include "logic/trace.h"
+#include "hal.h"
+#include "snapshot_ring.h"
+#include <atomic>
+#include <cmath>
+#include <cstring>
+#ifdef CORE_CM4
+#include "logic/core_link.h"        // door events go to the M7's UI
+#elif !HAL_SIM
+#include "logic/supervisor.h"
 #include "screens/screen_sensors.h"
 #include "screens/screen_warnings.h"
-#include "ui_manager.h"
-#include "TCA9548.h"
+#endif
+#if !HAL_SIM
 #include <VL53L1X.h>
-#include "mbed.h"
+#include <Wire.h>
+#endif
 
-#define Oxygen_IICAddress ADDRESS_3
+#define LOG_TAG   "SENS"
+#define LOG_LEVEL LOG_LEVEL_SENSOR
+#include "log.h"
+
+#define OXYGEN_ADDRESS    0x73  // SEN0322 with A0 = A1 = 1 (ADDRESS_3)
 #define TOF_ADDRESS       0x29  // Default VL53L1X I2C address
 
 const uint8_t TMP117_ADDR       = 0x48;   // 0x48–0x4B depending on ADR pin
@@ -22,224 +37,462 @@ const uint8_t TMP117_TEMP_REG   = 0x00;   // Temperature Result register
 float         boardTempF        = NAN;    // make this global so UI can read it
 
 // Limit Switches
-constexpr uint8_t LIMIT_SWITCH_PINS[5] = { D0, D1, D2, D3, D4 };
+constexpr uint8_t LIMIT_SWITCH_PINS[5] = { HAL_D(0), HAL_D(1), HAL_D(2), HAL_D(3), HAL_D(4) };
 bool limit_switch_states[5] = {false, false, false, false, false};
 
 // Gravity O₂ sensor
-static DFRobot_OxygenSensor o2Sensor;
-static float oxygen_level = NAN;
-extern int8_t o2Channel;
-
-// Structure to hold sensor readings
-struct SensorData {
-    float temperature;
-    float humidity;
-};
+int8_t o2Channel = -1;
 
+// Compost level filter (ToF #1): moving average with outlier rejection
+static const float MAX_DEPTH_CM      = 111.0f;    // maximum sensor range
+static const float OUTLIER_THRESH_CM = 20.0f;     // ignore changes >20 cm
+static FillFilter fill_filter = {};
+static float      fill_percent = NAN;
 
-// VL53L1X Time-of-Flight sensors (ports 4 & 5 on the mux)
-static VL53L1X tof_sensors[2];
-static float tof_distance[2] = { NAN, NAN };
-
-// I2C multiplexer on address 0x70
-static TCA9548 tca(0x70);
-// Array of AHT20 sensor objects
-static Adafruit_AHTX0 aht_sensors[3];
-// Array to store latest readings
-static SensorData sensor_data[3];
 // Corresponding TCA9548 channels for each sensor
 static const uint8_t sensor_channels[8] = {0, 1, 2, 3, 4, 5, 6, 7};
 // AHT20 I2C address
 static const uint8_t AHT20_ADDRESS = 0x38;
 
-// Mutex to protect shared data
-rtos::Mutex           data_mutex;
-ConnectionStatus      latest_status;
-float                 latest_temps[3];
-float                 latest_hums[3];
-float                 latest_o2;
-float                 latest_depth_cm;
+// ================= DEVICE ACCESS =================
+// Register-level drivers over hal.h, so the same code runs against the
+// simulated parts on a host (sim/sim_devices.h).
+
+/** @brief Route the bus to one TCA9548 channel. */
+static void mux_select(uint8_t channel) {
+    uint8_t mask = (uint8_t)(1u << channel);
+    hal_i2c_write(I2C_MUX_ADDR, &mask, 1);
+}
+
+/** @brief Disconnect every mux channel. */
+static void mux_disable_all() {
+    uint8_t mask = 0;
+    hal_i2c_write(I2C_MUX_ADDR, &mask, 1);
+}
+
+/** @brief Set the register pointer, then read len bytes (repeated start). */
+static bool read_reg(uint8_t addr, uint8_t reg, uint8_t *buf, size_t len) {
+    return hal_i2c_write(addr, &reg, 1, false) == HAL_I2C_OK &&
+           hal_i2c_read(addr, buf, len) == len;
+}
+
+// ---- AHT20 (datasheet sequence, as Adafruit_AHTX0 drives it) ----
+#define AHT20_CMD_RESET     0xBA
+#define AHT20_CMD_INIT      0xBE
+#define AHT20_CMD_TRIGGER   0xAC
+#define AHT20_STATUS_BUSY   0x80
+#define AHT20_STATUS_CAL    0x08
+#define AHT20_CONVERSION_MS 80
+#define AHT20_POLL_MS       10
+#define AHT20_POLL_TRIES    10
+
+/** @brief Poll the status byte until the conversion or command is done. */
+static bool aht20_wait(uint8_t *status) {
+    for (uint8_t i = 0; i < AHT20_POLL_TRIES; i++) {
+        if (hal_i2c_read(AHT20_ADDRESS, status, 1) != 1) return false;
+        if (!(*status & AHT20_STATUS_BUSY)) return true;
+        hal_delay_ms(AHT20_POLL_MS);
+    }
+    return false;
+}
+
+/** @brief Reset and calibrate the AHT20 on the selected channel. */
+static bool aht20_begin() {
+    uint8_t reset = AHT20_CMD_RESET;
+    uint8_t init[3] = { AHT20_CMD_INIT, 0x08, 0x00 };
+    uint8_t status;
+    if (hal_i2c_write(AHT20_ADDRESS, &reset, 1) != HAL_I2C_OK) return false;
+    hal_delay_ms(20);
+    if (!aht20_wait(&status)) return false;
+    if (hal_i2c_write(AHT20_ADDRESS, init, sizeof(init)) != HAL_I2C_OK) return false;
+    return aht20_wait(&status) && (status & AHT20_STATUS_CAL);
+}
+
+/** @brief One conversion on the selected channel. */
+static bool aht20_read(float *temp_c, float *rh) {
+    uint8_t trigger[3] = { AHT20_CMD_TRIGGER, 0x33, 0x00 };
+    uint8_t d[6];
+    if (hal_i2c_write(AHT20_ADDRESS, trigger, sizeof(trigger)) != HAL_I2C_OK) return false;
+    hal_delay_ms(AHT20_CONVERSION_MS);
+    if (!aht20_wait(&d[0])) return false;
+    if (hal_i2c_read(AHT20_ADDRESS, d, sizeof(d)) != sizeof(d)) return false;
+    uint32_t h = ((uint32_t)d[1] << 12) | ((uint32_t)d[2] << 4) | (d[3] >> 4);
+    uint32_t t = ((uint32_t)(d[3] & 0x0F) << 16) | ((uint32_t)d[4] << 8) | d[5];
+    *rh     = h * 100.0f / 1048576.0f;
+    *temp_c = t * 200.0f / 1048576.0f - 50.0f;
+    return true;
+}
+
+// ---- SEN0322 (as DFRobot_OxygenSensor::getOxygenData(20)) ----
+#define O2_DATA_REG         0x03
+#define O2_KEY_REG          0x0A
+#define O2_KEY_DELAY_MS     50
+#define O2_DATA_DELAY_MS    100
+#define O2_AVERAGE          20     // readings in the running average
+
+static float   o2_factor = 20.9f / 120.0f;
+static float   o2_hist[O2_AVERAGE];
+static uint8_t o2_hist_idx = 0, o2_hist_cnt = 0;
+
+/** @brief Write the register pointer, wait for the sensor, then read. */
+static bool o2_read_reg(uint8_t reg, uint8_t *buf, size_t len, uint32_t wait_ms) {
+    if (hal_i2c_write(OXYGEN_ADDRESS, &reg, 1) != HAL_I2C_OK) return false;
+    hal_delay_ms(wait_ms);
+    return hal_i2c_read(OXYGEN_ADDRESS, buf, len) == len;
+}
+
+/** @brief Probe the sensor and read its calibration key once (it only
+ *  changes when the sensor is recalibrated). */
+static bool o2_begin() {
+    uint8_t key;
+    if (!hal_i2c_probe(OXYGEN_ADDRESS)) return false;
+    if (!o2_read_reg(O2_KEY_REG, &key, 1, O2_KEY_DELAY_MS)) return false;
+    o2_factor   = key ? key / 1000.0f : 20.9f / 120.0f;
+    o2_hist_cnt = 0;
+    return true;
+}
+
+/** @brief Read the O₂ concentration and return the running average. */
+static float o2_read() {
+    uint8_t d[3];
+    if (!o2_read_reg(O2_DATA_REG, d, sizeof(d), O2_DATA_DELAY_MS)) return NAN;
+    o2_hist[o2_hist_idx] = o2_factor * (d[0] + d[1] / 10.0f + d[2] / 100.0f);
+    o2_hist_idx = (o2_hist_idx + 1) % O2_AVERAGE;
+    if (o2_hist_cnt < O2_AVERAGE) o2_hist_cnt++;
+    float sum = 0;
+    for (uint8_t k = 0; k < o2_hist_cnt; k++) sum += o2_hist[k];
+    return sum / o2_hist_cnt;
+}
+
+// ---- VL53L1X ----
+#if HAL_SIM
+// Continuous ranging at register level; the simulated part needs none of
+// the ST calibration sequence
+#define VL_MODEL_ID         0x010F
+#define VL_GPIO_HV_STATUS   0x0031
+#define VL_INTERRUPT_CLEAR  0x0086
+#define VL_MODE_START       0x0087
+#define VL_RESULT_STATUS    0x0089
+#define VL_TIMEOUT_MS       500
+
+static bool vl_read(uint16_t reg, uint8_t *buf, size_t len) {
+    uint8_t r[2] = { (uint8_t)(reg >> 8), (uint8_t)reg };
+    return hal_i2c_write(TOF_ADDRESS, r, 2, false) == HAL_I2C_OK &&
+           hal_i2c_read(TOF_ADDRESS, buf, len) == len;
+}
+
+static bool vl_write8(uint16_t reg, uint8_t v) {
+    uint8_t b[3] = { (uint8_t)(reg >> 8), (uint8_t)reg, v };
+    return hal_i2c_write(TOF_ADDRESS, b, 3) == HAL_I2C_OK;
+}
+
+/** @brief Check the model id and start continuous ranging. */
+static bool tof_begin(uint8_t j) {
+    uint8_t id[2];
+    (void)j;
+    if (!vl_read(VL_MODEL_ID, id, 2) || id[0] != 0xEA || id[1] != 0xCC) return false;
+    return vl_write8(VL_MODE_START, 0x40);
+}
+
+/** @brief Wait for the next range (polling, like the Pololu driver) and read it. */
+static float tof_read_cm(uint8_t j) {
+    (void)j;
+    uint32_t start = hal_millis();
+    uint8_t  st    = 1;
+    while (!vl_read(VL_GPIO_HV_STATUS, &st, 1) || (st & 0x01)) {
+        if (hal_millis() - start > VL_TIMEOUT_MS) return NAN;
+    }
+    uint8_t res[17];
+    bool ok = vl_read(VL_RESULT_STATUS, res, sizeof(res));
+    vl_write8(VL_INTERRUPT_CLEAR, 0x01);
+    if (!ok) return NAN;
+    return (uint16_t)((res[13] << 8) | res[14]) * 0.1f;
+}
+#else
+// The Pololu driver keeps ST's ~90-register calibration sequence
+static VL53L1X tof_sensors[2];
+
+static bool tof_begin(uint8_t j) {
+    tof_sensors[j].setBus(&Wire);
+    if (!tof_sensors[j].init()) return false;
+    tof_sensors[j].setAddress(TOF_ADDRESS);
+    tof_sensors[j].setTimeout(500);
+    tof_sensors[j].startContinuous(50);
+    return true;
+}
+
+static float tof_read_cm(uint8_t j) {
+    uint16_t mm = tof_sensors[j].readRangeContinuousMillimeters();
+    return tof_sensors[j].timeoutOccurred() ? NAN : mm * 0.1f;
+}
+#endif
+
+// ---- TMP117 ----
+/** @brief Continuous conversion at 15 Hz, no averaging. */
+static void tmp117_begin() {
+    uint8_t cfg[3] = { 0x01, 0x06, 0x00 };   // configuration register = 0x0600
+    hal_i2c_write(TMP117_ADDR, cfg, sizeof(cfg));
+}
+
+/** @brief Board temperature in °F, or NAN. */
+static float tmp117_read_f() {
+    uint8_t d[2];
+    if (!read_reg(TMP117_ADDR, TMP117_TEMP_REG, d, 2)) return NAN;   // 2 bytes, MSB first
+    int16_t raw = (int16_t)((d[0] << 8) | d[1]);
+    return raw * 0.0078125f * 9.0f / 5.0f + 32.0f;
+}
+
+// Published readings: written only by the acquisition context, read
+// anywhere without locking (see sensor_manager_get_snapshot())
+static SnapshotRing<SensorSnapshot, SENSOR_SNAPSHOT_SLOTS> snapshots;
+static SensorSnapshot current;   // working copy of the acquisition context
+
+/** @brief A snapshot with every reading unavailable. */
+static void clear_snapshot(SensorSnapshot &s) {
+    memset(&s, 0, sizeof(s));
+    for (uint8_t i = 0; i < 3; i++) {
+        s.temp_c[i] = NAN;
+        s.hum[i]    = NAN;
+    }
+    s.o2           = NAN;
+    s.tof_cm[0]    = NAN;
+    s.tof_cm[1]    = NAN;
+    s.fill_percent = NAN;
+    s.board_temp_f = NAN;
+}
+
+/** @brief Latest snapshot, or an all-NAN one before the first pass. */
+static SensorSnapshot latest() {
+    SensorSnapshot s;
+    if (!snapshots.latest(s)) clear_snapshot(s);
+    return s;
+}
 
 /** @brief Initialize the sensor manager.
  * This function initializes the I2C bus, the TCA9548 multiplexer, and all sensors.
  * It also sets up the O₂ sensor and VL53L1X sensors.
  */
 void sensor_manager_init() {
+    clear_snapshot(current);
     o2Channel = -1;
-    Wire.begin();           // Initialize I2C bus
+    hal_i2c_begin();        // Initialize I2C bus
 
-    if (tca.begin() == false)
+    if (!hal_i2c_probe(I2C_MUX_ADDR))
     {
-        Serial.println("COULD NOT CONNECT TO MULTIPLEXER");
+        LOG_E("Could not connect to multiplexer");
     }
     else{
-        Serial.println("MULTIPLEXER DETECTED"); 
+        LOG_I("Multiplexer detected");
     }
 
     // Initialize AHT20 sensors
-    Serial.println("Initializing AHT20 sensors...");
+    LOG_I("Initializing AHT20 sensors...");
     for (uint8_t i = 0; i < 3; i++) {
-        tca.selectChannel(sensor_channels[i]);
-        if (!aht_sensors[i].begin()) {
-            Serial.print("AHT20 #");
-            Serial.print(i);
-            Serial.println(" not found!");
+        mux_select(sensor_channels[i]);
+        if (!aht20_begin()) {
+            LOG_W("AHT20 #%u not found!", i);
         } else {
-            Serial.print("AHT20 #");
-            Serial.print(i);
-            Serial.println(" initialized.");
+            LOG_I("AHT20 #%u initialized.", i);
         }
     }
     
     // Initialize VL53L1X TOF sensors
-    Serial.println("Initializing VL53L1X sensors...");
+    LOG_I("Initializing VL53L1X sensors...");
     for (uint8_t j = 0; j < 2; j++) {
-        tca.selectChannel(sensor_channels[3 + j]);
-        tof_sensors[j].setBus(&Wire);
-        if (tof_sensors[j].init()) {
-            tof_sensors[j].setAddress(TOF_ADDRESS);
-            Serial.print("VL53L1X #"); Serial.print(j); Serial.println(" initialized.");
-            tof_sensors[j].setTimeout(500);
-            tof_sensors[j].startContinuous(50);
+        mux_select(sensor_channels[3 + j]);
+        if (tof_begin(j)) {
+            LOG_I("VL53L1X #%u initialized.", j);
         } else {
-            Serial.print("VL53L1X #"); 
-            Serial.print(j); Serial.println(" not found!");
+            LOG_W("VL53L1X #%u not found!", j);
         }
     }
 
     // Initialize O₂ sensor
-    Serial.println("Initializing SEN0322 sensor...");
-    tca.selectChannel(sensor_channels[5]);
-    if (o2Sensor.begin(Oxygen_IICAddress) == 0) {
-        Serial.print("O₂ sensor initialized on channel ");
-        Serial.println(sensor_channels[5]);
+    LOG_I("Initializing SEN0322 sensor...");
+    mux_select(sensor_channels[5]);
+    if (o2_begin()) {
+        LOG_I("O2 sensor initialized on channel %u", sensor_channels[5]);
         o2Channel = sensor_channels[5];
     } else {
-        Serial.println("O₂ sensor not found on channel 5!");
+        LOG_W("O2 sensor not found on channel 5!");
     }
 
     // Deselect all channels to avoid bus conflicts
-    tca.disableAllChannels();
+    mux_disable_all();
 
-    Wire.beginTransmission(TMP117_ADDR);
-    Wire.write(0x01);            // Configuration register
-    Wire.write(0x06); Wire.write(0x00);   // 0x0600 = continuous, 15‑Hz, avg = 1
-    Wire.endTransmission();
-    
+    tmp117_begin();
 }
 
 
 /** @brief Update sensor readings.
- * This function reads data from all sensors and updates the sensor_data array.
- * It also checks the connection status of each sensor.
+ * This function reads data from all sensors, then filters and publishes
+ * them (sensor_manager_apply()). It also checks the connection status of
+ * each sensor.
  */
 void sensor_manager_update() {
+    SensorRaw raw;
+
     // Only read sensors that acknowledged on the bus
-    ConnectionStatus status = sensor_manager_get_connection_status();
+    raw.status = sensor_manager_get_connection_status();
 
     // AHT20 Sensors (ports 0-2)
     for (uint8_t i = 0; i < 3; i++) {
-        tca.selectChannel(sensor_channels[i]);
-        if (status.sensor[i]) {
-            sensors_event_t hum_evt, tmp_evt;
-            if (aht_sensors[i].getEvent(&hum_evt, &tmp_evt)) {
-                sensor_data[i].humidity    = hum_evt.relative_humidity;
-                sensor_data[i].temperature = tmp_evt.temperature;
-            } else {
-                sensor_data[i].humidity    = NAN;
-                sensor_data[i].temperature = NAN;
-            }
-        } else {
-            sensor_data[i].humidity    = NAN;
-            sensor_data[i].temperature = NAN;
+        mux_select(sensor_channels[i]);
+        if (!raw.status.sensor[i] || !aht20_read(&raw.temp_c[i], &raw.hum[i])) {
+            raw.hum[i]    = NAN;
+            raw.temp_c[i] = NAN;
         }
     }
-    //Serial.println("AHT20 sensors updated.");
 
     // VL53L1X Sensors (ports 3-4)
     for (uint8_t j = 0; j < 2; j++) {
-        tca.selectChannel(sensor_channels[3 + j]);
-        if (status.vl53[j]) {
-            uint16_t mm = tof_sensors[j].readRangeContinuousMillimeters();
-            tof_distance[j] = tof_sensors[j].timeoutOccurred() ? NAN : mm * 0.1f; // cm
-            // Serial.print("VL53L1X #");
-            // Serial.print(j);
-            // Serial.print(": ");
-        } else {
-            tof_distance[j] = NAN;
-        }
+        mux_select(sensor_channels[3 + j]);
+        raw.tof_cm[j] = raw.status.vl53[j] ? tof_read_cm(j) : NAN;   // cm
     }
-    //Serial.println("VL53L1X sensors updated.");
 
     // O₂ Sensor (port 5)
-    if (status.o2) {
-        tca.selectChannel(sensor_channels[5]);
-        oxygen_level = o2Sensor.getOxygenData(20);
+    if (raw.status.o2) {
+        mux_select(sensor_channels[5]);
+        raw.o2 = o2_read();
     } else {
-        oxygen_level = NAN;
+        raw.o2 = NAN;
     }
-   // Serial.println("O₂ sensor updated.");
 
     // Deselect all channels to avoid conflicts
-    tca.disableAllChannels();
+    mux_disable_all();
 
-    Wire.beginTransmission(TMP117_ADDR);
-    Wire.write(TMP117_TEMP_REG);
+    raw.board_temp_f = tmp117_read_f();
 
-    // Send a repeated‑START (false) so we can immediately read
-    if (Wire.endTransmission(false) == 0 &&
-        Wire.requestFrom(TMP117_ADDR, (uint8_t)2) == 2)            // 2 bytes, MSB first
-    {
-        int16_t raw = (Wire.read() << 8) | Wire.read();            // combine MSB/LSB
-        boardTempF  = raw * 0.0078125f * 9.0f / 5.0f + 32.0f;       // °F conversion
+    trace_pass(raw);
+    sensor_manager_apply(raw);
+}
+
+/** @brief Filter one pass of readings and publish the whole pass at once.
+ * @param raw Readings as sensor_manager_update() took them, or from a trace.
+ */
+void sensor_manager_apply(const SensorRaw &raw) {
+    fill_percent = fill_filter_update(fill_filter, raw.tof_cm[0]);
+    boardTempF   = raw.board_temp_f;
+
+    for (uint8_t i = 0; i < 3; i++) {
+        current.temp_c[i] = raw.temp_c[i];
+        current.hum[i]    = raw.hum[i];
     }
-    else {
-        boardTempF = NAN;
+    current.o2           = raw.o2;
+    current.tof_cm[0]    = raw.tof_cm[0];
+    current.tof_cm[1]    = raw.tof_cm[1];
+    current.fill_percent = fill_percent;
+    current.board_temp_f = raw.board_temp_f;
+    current.status       = raw.status;
+    current.pass++;
+    current.taken_ms     = hal_millis();
+    snapshots.publish(current);
+}
+
+/** @brief Filter state and pass count, for a trace's sync points. */
+SensorTraceState sensor_manager_trace_state() {
+    SensorTraceState s;
+    s.pass = current.pass;
+    s.fill = fill_filter;
+    return s;
 }
 
+/** @brief Continue from a trace's sync point (replay). */
+void sensor_manager_restore(const SensorTraceState &s) {
+    current.pass = s.pass;
+    fill_filter  = s.fill;
 }
 
 /** @brief Get the latest external temperature in Fahrenheit.
  * @return The external temperature in Fahrenheit, or NAN if not available.
- * This function retrieves the board temperature from the TMP117 sensor.
+ * Read from the latest snapshot, so it is safe from any thread.
  */
 float getExternalTemperature() {
-    return boardTempF; // Return the board temperature in Fahrenheit
+    return latest().board_temp_f;
 }
 
 /** @brief Get the latest temperature reading for a specific sensor.
  * @param idx Index of the sensor (0-2).
  * @return Temperature in Celsius, or NAN if the sensor is not available.
- * This function retrieves the temperature reading from the sensor_data array.
+ * Read from the latest snapshot, so it is safe from any thread.
  */
 float sensor_manager_get_temperature(uint8_t idx) {
-    return (idx < 6) ? sensor_data[idx].temperature : NAN;
+    return (idx < 3) ? latest().temp_c[idx] : NAN;
 }
 
 /** @brief Get the latest humidity reading for a specific sensor.
  * @param idx Index of the sensor (0-2).
  * @return Humidity in percentage, or NAN if the sensor is not available.
- * This function retrieves the humidity reading from the sensor_data array.
+ * Read from the latest snapshot, so it is safe from any thread.
  */
 float sensor_manager_get_humidity(uint8_t idx) {
-    return (idx < 6) ? sensor_data[idx].humidity : NAN;
+    return (idx < 3) ? latest().hum[idx] : NAN;
 }
 
 /** @brief Get the latest O₂ concentration reading.
  * @return O₂ concentration in percentage, or NAN if the sensor is not available.
- * This function retrieves the oxygen concentration from the o2Sensor object.
+ * Read from the latest snapshot, so it is safe from any thread.
  */
 float sensor_manager_get_oxygen(void) {
-    return oxygen_level;
+    return latest().o2;
 }
 
 /** @brief Get the latest distance reading from a VL53L1X sensor.
  * @param idx Index of the VL53L1X sensor (0-1).
  * @return Distance in centimeters, or NAN if the sensor is not available.
- * This function retrieves the distance reading from the tof_distance array.
+ * Read from the latest snapshot, so it is safe from any thread.
  */
 float sensor_manager_get_tof_distance(uint8_t idx) {
-    return (idx < 2) ? tof_distance[idx] : NAN;
+    return (idx < 2) ? latest().tof_cm[idx] : NAN;
+}
+
+/** @brief Get the filtered compost fill level.
+ * @return Fill level in percent (0 = empty, 100 = full), or NAN if no valid reading yet.
+ */
+float sensor_manager_get_fill_percent(void) {
+    return latest().fill_percent;
+}
+
+/** @brief Feed one ToF distance into a compost level filter.
+ * Readings more than OUTLIER_THRESH_CM away from the running average are ignored
+ * unless they persist for FILL_FILTER_SAMPLES samples, in which case the buffer resets.
+ * @param f   Filter state.
+ * @param raw Distance in cm, or NAN if the sensor is unavailable.
+ * @return Fill level in percent, or NAN if no valid reading yet.
+ */
+float fill_filter_update(FillFilter &f, float raw) {
+    if (!std::isnan(raw)) {
+        float avg = 0;
+        if (f.cnt > 0) {
+            for (uint8_t k = 0; k < f.cnt; k++) avg += f.buf[k];
+            avg /= f.cnt;
+        }
+        if (f.cnt == 0 || fabs(raw - avg) <= OUTLIER_THRESH_CM) {
+            // valid reading
+            f.buf[f.idx] = raw;
+            f.idx = (f.idx + 1) % FILL_FILTER_SAMPLES;
+            if (f.cnt < FILL_FILTER_SAMPLES) f.cnt++;
+            f.outliers = 0;
+        } else {
+            // potential outlier
+            f.outliers++;
+            if (f.outliers >= FILL_FILTER_SAMPLES) {
+                // sustained new value: reset buffer
+                for (uint8_t k = 0; k < FILL_FILTER_SAMPLES; k++) f.buf[k] = raw;
+                f.cnt = FILL_FILTER_SAMPLES;
+                f.idx = 0;
+                f.outliers = 0;
+            }
+        }
+    }
+    if (f.cnt == 0) return NAN;
+
+    // Compute filtered average and map to 0..100 (inverted: short distance = full)
+    float avg_depth = 0;
+    for (uint8_t k = 0; k < f.cnt; k++) avg_depth += f.buf[k];
+    avg_depth /= f.cnt;
+    float depth_pct = std::fmin(std::fmax((avg_depth / MAX_DEPTH_CM) * 100.0f, 0.0f), 100.0f);
+    return 100.0f - depth_pct;
 }
 
 /** @brief Get the connection status of all sensors.
@@ -256,42 +509,107 @@ ConnectionStatus sensor_manager_get_connection_status() {
     };
     
     // Test multiplexer at 0x70
-    Wire.beginTransmission(0x70);
-    status.mux = (Wire.endTransmission() == 0);
+    status.mux = hal_i2c_probe(I2C_MUX_ADDR);
 
     // Test each sensor behind the mux
     for (uint8_t i = 0; i < 3; i++) {
-        tca.selectChannel(sensor_channels[i]);
-        Wire.beginTransmission(AHT20_ADDRESS);
-        status.sensor[i] = (Wire.endTransmission() == 0);
+        mux_select(sensor_channels[i]);
+        status.sensor[i] = hal_i2c_probe(AHT20_ADDRESS);
     }
     
     // VL53L1X sensors
     for (uint8_t j = 0; j < 2; j++) {
-        tca.selectChannel(sensor_channels[3 + j]);
-        Wire.beginTransmission(TOF_ADDRESS);
-        status.vl53[j] = (Wire.endTransmission() == 0);
+        mux_select(sensor_channels[3 + j]);
+        status.vl53[j] = hal_i2c_probe(TOF_ADDRESS);
     }
     
     // Check O₂ sensor
-    tca.selectChannel(sensor_channels[5]);
-    Wire.beginTransmission(Oxygen_IICAddress);    // define O2_I2C_ADDRESS (e.g. 0x??)
-    status.o2 = (Wire.endTransmission() == 0);
+    mux_select(sensor_channels[5]);
+    status.o2 = hal_i2c_probe(OXYGEN_ADDRESS);
         
     // Deselect all channels to avoid bus conflicts
-    tca.disableAllChannels();
+    mux_disable_all();
 
     return status;
 }
 
-/** @brief Get the latest connection status.
- * @return ConnectionStatus structure containing the latest status of each sensor.
- * This function retrieves the latest connection status of the sensors
- * and updates the latest_status variable.
+#if !defined(CORE_CM4) && !HAL_SIM
+// ================= ACQUISITION THREAD =================
+// The M4 firmware and the host simulation drive these from their own loop instead
+static rtos::Thread acq_thread(osPriorityAboveNormal, 4096, nullptr, "sensing");
+static SupervisorId acq_id = SUPERVISOR_NONE;
+
+/** @brief Read the sensors and poll the switches at their own rates; the
+ *  only writer of the snapshot ring.
+ */
+static void acquisition_thread() {
+    uint32_t last_pass = millis() - SENSOR_UPDATE_INTERVAL_MS;   // first pass at once
+    for (;;) {
+        uint32_t now = millis();
+        if (now - last_pass >= SENSOR_UPDATE_INTERVAL_MS) {
+            sensor_manager_update();
+            last_pass = now;
+        }
+        Limit_Switch_update();
+        supervisor_checkin(acq_id);
+        rtos::ThisThread::sleep_for(std::chrono::milliseconds(LIMIT_SWITCH_INTERVAL_MS));
+    }
+}
+
+/** @brief Start the acquisition thread. */
+void sensor_manager_start() {
+    acq_id = supervisor_register("sensing", ACQ_MAX_SILENCE_MS);
+    acq_thread.start(mbed::callback(acquisition_thread));
+}
+
+// Door openings on their way to loop(). The acquisition thread only appends
+// and loop() only takes, so neither waits for the other (or for lv_lock())
+#define DOOR_EVENT_SLOTS 8
+static uint8_t               door_events[DOOR_EVENT_SLOTS];
+static std::atomic<uint32_t> door_head{0};   // next slot to write
+static std::atomic<uint32_t> door_tail{0};   // next slot to read
+
+/** @brief Queue a door opening for sensor_manager_poll_doors() (acquisition thread). */
+static void post_door(TelemetryDoor door) {
+    uint32_t h = door_head.load(std::memory_order_relaxed);
+    if (h - door_tail.load(std::memory_order_acquire) >= DOOR_EVENT_SLOTS) {
+        LOG_W("Door event queue full; door %u opening dropped", (unsigned)door);
+        return;
+    }
+    door_events[h % DOOR_EVENT_SLOTS] = (uint8_t)door;
+    door_head.store(h + 1, std::memory_order_release);
+}
+
+/** @brief Send the queued door openings and add their warnings (loop(), under lv_lock()). */
+void sensor_manager_poll_doors() {
+    uint32_t t = door_tail.load(std::memory_order_relaxed);
+    uint32_t h = door_head.load(std::memory_order_acquire);
+    for (; t != h; t++) {
+        TelemetryDoor door = (TelemetryDoor)door_events[t % DOOR_EVENT_SLOTS];
+        telemetry_send_door(door, door == TLM_DOOR_LOADING);
+        if (door == TLM_DOOR_FRONT)     add_warning("Unloaded front door Opened");
+        else if (door == TLM_DOOR_BACK) add_warning("Unloaded back door Opened");
+        else                            add_warning("Loaded loading door Opened");
+    }
+    door_tail.store(t, std::memory_order_release);
+}
+#endif
+
+/** @brief Copy the latest published snapshot.
+ * @param out Receives the snapshot (all NAN before the first publish).
+ * @return False before anything was published.
+ */
+bool sensor_manager_get_snapshot(SensorSnapshot &out) {
+    if (snapshots.latest(out)) return true;
+    clear_snapshot(out);
+    return false;
+}
+
+/** @brief Configure the limit switch inputs.
  */
 void Limit_Switch_Init() {
     for (uint8_t i = 0; i < 5; ++i) {
-        pinMode(LIMIT_SWITCH_PINS[i], INPUT);  // Externally pulled high
+        hal_pin_mode(LIMIT_SWITCH_PINS[i], HAL_INPUT);  // Externally pulled high
     }
 }
 
@@ -304,7 +622,7 @@ void Limit_Switch_update() {
     static bool prev_closed[5] = { false, false, false, false, false };
 
     for (uint8_t i = 0; i < 5; ++i) {
-        bool closed = (digitalRead(LIMIT_SWITCH_PINS[i]) == HIGH);
+        bool closed = hal_pin_read(LIMIT_SWITCH_PINS[i]);
         limit_switch_states[i] = closed;
 
         // edge: only fire when we go from open → closed
@@ -321,19 +639,22 @@ void Limit_Switch_update() {
             }
         }
         if (closed && !prev_closed[i]) {
-            // home in on which door
-            if (i == 0 || i == 1) {
-                Serial.println("Unloaded");
-                add_warning("Unloaded front door Opened");  // Add warning for front door
-            }
-            else if (i == 2 || i == 3) {
-                Serial.println("Unloaded");
-                add_warning("Unloaded back door Opened");  // Add warning for back door
-            }
-            else { // i == 4
-                Serial.println("Loaded");
-                add_warning("Loaded loading door Opened");  // Add warning for loading door
-            }
+#ifdef CORE_CM4
+            // The M7 sends the telemetry frame and adds the warning
+            if (i == 0 || i == 1)      core_link_post(CORE_EVT_DOOR, TLM_DOOR_FRONT, 0, hal_epoch());
+            else if (i == 2 || i == 3) core_link_post(CORE_EVT_DOOR, TLM_DOOR_BACK, 0, hal_epoch());
+            else                       core_link_post(CORE_EVT_DOOR, TLM_DOOR_LOADING, 1, hal_epoch());
+#elif HAL_SIM
+            // No UI on a host; the event is all there is
+            if (i == 0 || i == 1)      telemetry_send_door(TLM_DOOR_FRONT, false);
+            else if (i == 2 || i == 3) telemetry_send_door(TLM_DOOR_BACK, false);
+            else                       telemetry_send_door(TLM_DOOR_LOADING, true);
+#else
+            // loop() sends the event and adds the warning; widgets are its alone
+            if (i == 0 || i == 1)      post_door(TLM_DOOR_FRONT);
+            else if (i == 2 || i == 3) post_door(TLM_DOOR_BACK);
+            else                       post_door(TLM_DOOR_LOADING);
+#endif
         }
 
 
@@ -346,16 +667,33 @@ void Limit_Switch_update() {
         prev_closed[i] = closed;
     }
 
-    update_footer_status(mask);
+    uint8_t sw = 0;
+    for (uint8_t i = 0; i < 5; ++i) {
+        if (limit_switch_states[i]) sw |= (uint8_t)(1u << i);
+    }
+    if (sw != current.switches || mask != current.door_mask) {
+        if (sw != current.switches) trace_switches(sw);
+        current.switches  = sw;
+        current.door_mask = (uint8_t)mask;
+        snapshots.publish(current);
+    }
+    // loop() shows the mask in the footer (on the M7 when CORE_SPLIT)
 }
 
 
 /** @brief Check if a specific limit switch is closed.
  * @param index Index of the limit switch (0-4).
  * @return True if the limit switch is closed, false otherwise.
- * This function checks the state of a specific limit switch and returns its status.
+ * Read from the latest snapshot, so it is safe from any thread.
  */
 bool Limit_Switch_isClosed(uint8_t index) {
-    if (index < 5) return limit_switch_states[index];
+    if (index < 5) return (latest().switches >> index) & 1;
     return false;
 }
+
+/** @brief Doors whose switch is closed.
+ * @return WarningMask bits (WARN_FRONT_DOOR etc.) from the last Limit_Switch_update().
+ */
+uint32_t Limit_Switch_get_warning_mask() {
+    return latest().door_mask;
+}
@@ -0,0 +1,50 @@
+/******************************************************************************
+ * @file    status_led.cpp
+ * @author  Thomas Zoldowski
+ * @date    October 18, 2026
+ * @brief   Front panel LEDs that show the security (PIN) state.
+ ******************************************************************************/
+#include "logic/status_led.h"
+#include <Arduino.h>
+#include "screens/screen_settings.h"
+
+// LED pins
+const int LED_PINS[] = {28, 30, 32};
+
+// LED Functions
+void LED_Init() {
+    for (int i = 0; i < 3; i++) {
+        pinMode(LED_PINS[i], OUTPUT);
+        digitalWrite(LED_PINS[i], LOW); // Turn off initially
+        //pinMode(LED_PINS[i], INPUT_PULLDOWN);
+    }
+}
+
+/** * @brief Turn on all LEDs.
+ * This function sets all LED pins to HIGH, indicating the system is active.
+ */
+void LED_On() {
+    for (int i = 0; i < 3; i++) {
+        digitalWrite(LED_PINS[i], HIGH);
+    }
+}
+
+/** * @brief Turn off all LEDs.
+ * This function sets all LED pins to LOW, indicating the system is inactive.
+ */
+void LED_Off() {
+    for (int i = 0; i < 3; i++) {
+        digitalWrite(LED_PINS[i], LOW);
+    }
+}
+
+/** @brief Update the LED status based on the current security state.
+ * This function checks if the security is unlocked and updates the LED status accordingly.
+ */
+void LED_Update() {
+
+    // check if security unlocked and activate buttons
+    if (check_pin()) LED_On();
+    else LED_Off();
+
+}
@@ -0,0 +1,81 @@
+/******************************************************************************
+ * @file    supervisor.cpp
+ * @author  Thomas Zoldowski
+ * @date    October 18, 2026
+ * @brief   Thread heartbeat supervisor that owns the hardware watchdog.
+ ******************************************************************************/
+#include "logic/supervisor.h"
+#include "config.h"
+#include <Arduino.h>
+#include <mbed.h>
+#include <atomic>
+
+#define LOG_TAG   "SUP"
+#define LOG_LEVEL LOG_LEVEL_SUPERVISOR
+#include "log.h"
+
+typedef struct {
+    const char           *name;
+    uint32_t              max_silence_ms;
+    std::atomic<uint32_t> last_ms;        // millis() of the last check-in
+} Member;
+
+static Member       members[SUPERVISOR_MAX_THREADS];
+static uint8_t      member_count = 0;     // only grows during setup()
+static rtos::Thread sup_thread(osPriorityHigh, 1536, nullptr, "supervisor");
+
+/** @brief Add a thread to the check-in table. */
+SupervisorId supervisor_register(const char *name, uint32_t max_silence_ms) {
+    if (member_count >= SUPERVISOR_MAX_THREADS) {
+        LOG_E("No room to supervise '%s'", name);
+        return SUPERVISOR_NONE;
+    }
+    Member &m = members[member_count];
+    m.name           = name;
+    m.max_silence_ms = max_silence_ms;
+    m.last_ms.store(millis(), std::memory_order_relaxed);
+    return member_count++;
+}
+
+/** @brief Record that the thread is alive. */
+void supervisor_checkin(SupervisorId id) {
+    if (id < member_count) members[id].last_ms.store(millis(), std::memory_order_relaxed);
+}
+
+/**
+ * @brief Kick the watchdog while every thread is checking in.
+ * A silent thread is logged once; if it recovers before the watchdog fires
+ * kicking resumes, otherwise the board resets.
+ */
+static void supervisor_thread() {
+    SupervisorId late = SUPERVISOR_NONE;
+    for (;;) {
+        SupervisorId now_late = SUPERVISOR_NONE;
+        uint32_t     gap      = 0;
+        for (uint8_t i = 0; i < member_count; i++) {
+            uint32_t last = members[i].last_ms.load(std::memory_order_relaxed);
+            gap = millis() - last;       // read after last, so it cannot go negative
+            if (gap > members[i].max_silence_ms) {
+                now_late = i;
+                break;
+            }
+        }
+
+        if (now_late == SUPERVISOR_NONE) {
+            mbed::Watchdog::get_instance().kick();
+            if (late != SUPERVISOR_NONE) LOG_I("'%s' checking in again", members[late].name);
+        } else if (now_late != late) {
+            LOG_E("'%s' silent for %lu ms; watchdog not kicked", members[now_late].name, (unsigned long)gap);
+        }
+        late = now_late;
+
+        rtos::ThisThread::sleep_for(std::chrono::milliseconds(SUPERVISOR_PERIOD_MS));
+    }
+}
+
+/** @brief Start the watchdog and the supervisor thread. */
+void supervisor_start() {
+    mbed::Watchdog::get_instance().start(WATCHDOG_TIMEOUT_MS);
+    sup_thread.start(mbed::callback(supervisor_thread));
+    LOG_I("Watchdog %u ms, %u thread(s) supervised", (unsigned)WATCHDOG_TIMEOUT_MS, (unsigned)member_count);
+}
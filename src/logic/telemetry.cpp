@@ -0,0 +1,334 @@
+/******************************************************************************
+ * @file    telemetry.cpp
+ * @author  Thomas Zoldowski
+ * @date    October 18, 2026
+ * @brief   Binary telemetry frames to the Raspberry Pi over USB serial.
+ ******************************************************************************/
+
+#include "logic/telemetry.h"
+#include "logic/sensor_manager.h"
+#include "serial_tx.h"
+#include "config.h"
+#include "hal.h"
+#include <cmath>
+#include <cstring>
+#if HAL_SIM
+#include <mutex>
+#endif
+
+#define LOG_TAG "TLM"
+#include "log.h"
+
+#define TLM_HEADER_LEN  4   // ver, type, seq
+#define TLM_CRC_LEN     2
+#define TLM_RAW_MAX     (TLM_HEADER_LEN + TLM_MAX_PAYLOAD + TLM_CRC_LEN)
+#define TLM_WIRE_MAX    (TLM_RAW_MAX + TLM_RAW_MAX / 254 + 1 + 2)   // COBS + two delimiters
+
+#define TLM_SAMPLES_HDR 13  // boot_id, now_ms, first_seq, count
+#define TLM_SAMPLE_LEN  19  // t_ms, 7 x int16, fill
+
+static_assert(TLM_SAMPLES_HDR + TELEMETRY_BATCH_MAX * TLM_SAMPLE_LEN <= TLM_MAX_PAYLOAD,
+              "TELEMETRY_BATCH_MAX does not fit in one frame");
+
+typedef struct {
+    uint32_t t_ms;
+    int16_t  temp_f10[3];
+    int16_t  hum10[3];
+    int16_t  o2_100;
+    uint8_t  fill;
+} TelemetrySample;
+
+static uint16_t tx_seq = 0;
+
+// Sample backlog: seq N lives in backlog[N % TELEMETRY_BACKLOG] while
+// oldest_seq() <= N < head_seq
+static TelemetrySample backlog[TELEMETRY_BACKLOG];
+static uint32_t head_seq     = 0;   // next sample number to record
+static uint32_t acked_seq    = 0;   // everything below was acknowledged
+static uint32_t send_seq     = 0;   // next sample to put in a frame
+static uint32_t sent_hi_seq  = 0;   // everything below has been sent at least once
+static uint32_t last_send_ms = 0;
+static uint32_t boot_id      = 0;
+static TelemetryStats stats  = { 0, 0, 0, 0 };
+
+// Frames are sent from loop() and from the command channel's RX thread
+#if HAL_SIM
+static std::mutex  send_mutex;
+#else
+static rtos::Mutex send_mutex;
+#endif
+
+/** @brief Store a 16-bit value little-endian. */
+static inline uint8_t *put_u16(uint8_t *p, uint16_t v) {
+    p[0] = (uint8_t)(v & 0xFF);
+    p[1] = (uint8_t)(v >> 8);
+    return p + 2;
+}
+
+/** @brief Store a 32-bit value little-endian. */
+static inline uint8_t *put_u32(uint8_t *p, uint32_t v) {
+    p = put_u16(p, (uint16_t)(v & 0xFFFF));
+    return put_u16(p, (uint16_t)(v >> 16));
+}
+
+/** @brief Convert a float to fixed point, mapping NAN to TLM_NONE. */
+static inline int16_t to_fixed(float v, float scale) {
+    if (std::isnan(v)) return TLM_NONE;
+    return (int16_t)std::fmin(std::fmax(roundf(v * scale), -32767.0f), 32767.0f);
+}
+
+/** @brief CRC-16/CCITT-FALSE.
+ *  @param data Bytes to checksum.
+ *  @param len  Number of bytes.
+ *  @return CRC value.
+ */
+uint16_t telemetry_crc16(const uint8_t *data, size_t len) {
+    uint16_t crc = 0xFFFF;
+    while (len--) {
+        crc ^= (uint16_t)(*data++) << 8;
+        for (uint8_t i = 0; i < 8; i++) {
+            crc = (crc & 0x8000) ? (uint16_t)((crc << 1) ^ 0x1021) : (uint16_t)(crc << 1);
+        }
+    }
+    return crc;
+}
+
+/** @brief COBS-encode a buffer (no delimiters added).
+ *  @param in  Source bytes.
+ *  @param len Number of source bytes.
+ *  @param out Destination, at least len + len/254 + 1 bytes.
+ *  @return Number of encoded bytes.
+ */
+size_t telemetry_cobs_encode(const uint8_t *in, size_t len, uint8_t *out) {
+    uint8_t *code_ptr = out;     // where the current block's code byte goes
+    uint8_t *dst      = out + 1;
+    uint8_t  code     = 1;
+
+    for (size_t i = 0; i < len; i++) {
+        if (in[i] == 0) {
+            *code_ptr = code;
+            code_ptr  = dst++;
+            code      = 1;
+        } else {
+            *dst++ = in[i];
+            if (++code == 0xFF) {
+                *code_ptr = code;
+                code_ptr  = dst++;
+                code      = 1;
+            }
+        }
+    }
+    *code_ptr = code;
+    return (size_t)(dst - out);
+}
+
+/** @brief COBS-decode one chunk (no delimiters).
+ *  @param in  Encoded bytes.
+ *  @param len Number of encoded bytes.
+ *  @param out Destination, at least len bytes.
+ *  @return Number of decoded bytes, 0 if malformed.
+ */
+size_t telemetry_cobs_decode(const uint8_t *in, size_t len, uint8_t *out) {
+    size_t i = 0, o = 0;
+    while (i < len) {
+        uint8_t code = in[i];
+        if (code == 0 || i + code > len) return 0;
+        memcpy(&out[o], &in[i + 1], code - 1);
+        o += code - 1;
+        i += code;
+        if (code < 0xFF && i < len) out[o++] = 0;
+    }
+    return o;
+}
+
+/** @brief Frame, encode and write one message.
+ *  @param type    Message type (TelemetryType).
+ *  @param payload Payload bytes.
+ *  @param len     Payload length (at most TLM_MAX_PAYLOAD).
+ *  @return False if the payload is too large.
+ */
+bool telemetry_send(uint8_t type, const uint8_t *payload, size_t len) {
+    if (len > TLM_MAX_PAYLOAD) return false;
+
+    // Held across numbering and queuing so frames hit the wire in seq order
+    send_mutex.lock();
+    uint8_t raw[TLM_RAW_MAX];
+    raw[0] = TLM_VERSION;
+    raw[1] = type;
+    put_u16(&raw[2], tx_seq++);
+    memcpy(&raw[TLM_HEADER_LEN], payload, len);
+    size_t n = TLM_HEADER_LEN + len;
+    put_u16(&raw[n], telemetry_crc16(raw, n));
+    n += TLM_CRC_LEN;
+
+    // Leading delimiter ends any partial text line the Pi may be holding
+    uint8_t wire[TLM_WIRE_MAX];
+    wire[0] = 0x00;
+    size_t w = 1 + telemetry_cobs_encode(raw, n, &wire[1]);
+    wire[w++] = 0x00;
+
+    // Queued for the drain thread; a stalled host never blocks the caller
+    bool ok = serial_tx_write_telemetry(wire, w);
+    send_mutex.unlock();
+    return ok;
+}
+
+/** @brief Send a door event.
+ *  @param door   Which door.
+ *  @param loaded True for the loading door (material added), false for unloading.
+ */
+void telemetry_send_door(TelemetryDoor door, bool loaded) {
+    uint8_t buf[2] = { door, (uint8_t)(loaded ? 1 : 0) };
+    telemetry_send(TLM_DOOR, buf, sizeof(buf));
+}
+
+/** @brief Send an actuator start event.
+ *  @param actuator Which actuator switched on.
+ */
+void telemetry_send_actuator(TelemetryActuator actuator) {
+    uint8_t buf[1] = { actuator };
+    telemetry_send(TLM_ACTUATOR, buf, sizeof(buf));
+}
+
+/** @brief Send the camera delay.
+ *  @param seconds Delay in seconds.
+ */
+void telemetry_send_camera_delay(uint16_t seconds) {
+    uint8_t buf[2];
+    put_u16(buf, seconds);
+    telemetry_send(TLM_CAMERA_DELAY, buf, sizeof(buf));
+}
+
+/** @brief Oldest sample number still held in the backlog. */
+static inline uint32_t oldest_seq() {
+    return head_seq > TELEMETRY_BACKLOG ? head_seq - TELEMETRY_BACKLOG : 0;
+}
+
+/** @brief Pick a boot_id and reset the backlog. */
+void telemetry_init() {
+    // Must differ from the previous boot, or the Pi takes the new samples
+    // for ones it already has. Boot timing is too repeatable for that.
+    boot_id = hal_random32();
+    head_seq = acked_seq = send_seq = sent_hi_seq = 0;
+    LOG_I("Telemetry boot_id %08lx, backlog %u samples", (unsigned long)boot_id, TELEMETRY_BACKLOG);
+}
+
+/** @brief Add the current sensor readings to the backlog.
+ *  @param now_ms millis() at the time of the reading.
+ */
+void telemetry_record_sample(uint32_t now_ms) {
+    TelemetrySample &s = backlog[head_seq % TELEMETRY_BACKLOG];
+    s.t_ms = now_ms;
+    for (uint8_t i = 0; i < 3; i++) {
+        float tempC = sensor_manager_get_temperature(i);
+        s.temp_f10[i] = to_fixed(tempC * 9.0f / 5.0f + 32.0f, 10.0f);
+        s.hum10[i]    = to_fixed(sensor_manager_get_humidity(i), 10.0f);
+    }
+    s.o2_100 = to_fixed(sensor_manager_get_oxygen(), 100.0f);
+    float fill = sensor_manager_get_fill_percent();
+    s.fill = std::isnan(fill) ? 0 : (uint8_t)fill;
+
+    head_seq++;
+    stats.recorded++;
+
+    // Backlog full: the oldest unacknowledged sample was just overwritten
+    uint32_t oldest = oldest_seq();
+    if (acked_seq < oldest) {
+        stats.lost += oldest - acked_seq;
+        acked_seq = oldest;
+    }
+    if (send_seq < oldest) send_seq = oldest;
+}
+
+/** @brief Queue one TLM_SAMPLES frame starting at send_seq.
+ *  @return False if the TX ring had no room (nothing is advanced).
+ */
+static bool send_batch(uint32_t now_ms) {
+    uint8_t  buf[TLM_SAMPLES_HDR + TELEMETRY_BATCH_MAX * TLM_SAMPLE_LEN];
+    uint32_t count = head_seq - send_seq;
+    if (count > TELEMETRY_BATCH_MAX) count = TELEMETRY_BATCH_MAX;
+
+    uint8_t *p = buf;
+    p = put_u32(p, boot_id);
+    p = put_u32(p, now_ms);
+    p = put_u32(p, send_seq);
+    *p++ = (uint8_t)count;
+    for (uint32_t i = 0; i < count; i++) {
+        const TelemetrySample &s = backlog[(send_seq + i) % TELEMETRY_BACKLOG];
+        p = put_u32(p, s.t_ms);
+        for (uint8_t j = 0; j < 3; j++) p = put_u16(p, (uint16_t)s.temp_f10[j]);
+        for (uint8_t j = 0; j < 3; j++) p = put_u16(p, (uint16_t)s.hum10[j]);
+        p = put_u16(p, (uint16_t)s.o2_100);
+        *p++ = s.fill;
+    }
+
+    if (!telemetry_send(TLM_SAMPLES, buf, (size_t)(p - buf))) return false;
+    send_seq += count;
+    if (send_seq > sent_hi_seq) sent_hi_seq = send_seq;
+    last_send_ms = now_ms;
+    return true;
+}
+
+/** @brief Rewind the send position so samples from @p from_seq go out again. */
+static void rewind_to(uint32_t from_seq) {
+    if (from_seq < acked_seq)  from_seq = acked_seq;
+    if (from_seq < send_seq) {
+        send_seq = from_seq;
+        stats.resends++;
+    }
+}
+
+/** @brief The Pi has every sample below @p next_seq.
+ *  @param ack_boot_id boot_id the Pi is acknowledging (stale ones are ignored).
+ *  @param next_seq First sample number the Pi does not have yet.
+ */
+void telemetry_handle_ack(uint32_t ack_boot_id, uint32_t next_seq) {
+    if (ack_boot_id != boot_id) return;   // numbering from a previous boot
+    if (next_seq > sent_hi_seq) next_seq = sent_hi_seq;
+    if (next_seq > acked_seq) {
+        stats.acked += next_seq - acked_seq;
+        acked_seq = next_seq;
+        if (send_seq < acked_seq) send_seq = acked_seq;
+    }
+    last_send_ms = hal_millis();   // link is alive; restart the ack timer
+}
+
+/** @brief The Pi is missing samples from @p from_seq on; resend them.
+ *  @param req_boot_id boot_id the request refers to (stale ones are ignored).
+ *  @param from_seq First missing sample number.
+ */
+void telemetry_handle_resend(uint32_t req_boot_id, uint32_t from_seq) {
+    if (req_boot_id != boot_id) return;
+    if (from_seq < oldest_seq()) {
+        LOG_W("Resend from %lu requested, oldest kept is %lu", from_seq, oldest_seq());
+    }
+    rewind_to(from_seq);       // go-back-N: resends through the newest sample
+}
+
+/** @brief Send due sample batches (and resends).
+ *  @param now_ms Current millis().
+ */
+void telemetry_poll(uint32_t now_ms) {
+    // Nothing acknowledged for a while: assume the Pi missed it and go back
+    if (acked_seq < send_seq && send_seq == head_seq
+        && now_ms - last_send_ms >= TELEMETRY_ACK_TIMEOUT_MS) {
+        rewind_to(acked_seq);
+    }
+
+    uint32_t waiting = head_seq - send_seq;
+    if (waiting == 0) return;
+
+    bool due = send_seq < sent_hi_seq                       // resending
+            || waiting >= TELEMETRY_BATCH_SAMPLES
+            || now_ms - backlog[send_seq % TELEMETRY_BACKLOG].t_ms >= TELEMETRY_BATCH_MAX_AGE_MS;
+    if (!due) return;
+
+    for (uint8_t i = 0; i < TELEMETRY_FRAMES_PER_POLL && send_seq < head_seq; i++) {
+        if (!send_batch(now_ms)) break;   // TX ring full; retry next pass
+    }
+}
+
+/** @brief Get a snapshot of the batching counters. */
+TelemetryStats telemetry_get_stats() {
+    return stats;
+}
@@ -0,0 +1,549 @@
+/******************************************************************************
+ * @file    trace.cpp
+ * @author  Thomas Zoldowski
+ * @date    October 18, 2026
+ * @brief   Field trace: the inputs of the sensing and control logic, for replay.
+ ******************************************************************************/
+#include "logic/trace.h"
+#include "logic/actuator_manager.h"
+#include "logic/telemetry.h"
+#include "hal.h"
+#include <atomic>
+#include <cstring>
+
+#define LOG_TAG   "TRC"
+#define LOG_LEVEL LOG_LEVEL_STORAGE
+#include "log.h"
+
+#define PASS_FLOATS      10    // SensorRaw's floats, in declaration order
+#define STATE_FIXED_LEN  37    // TRACE_STATE after the pass varint
+#define RECORD_MAX       96    // longest record (TRACE_CONFIG) with its header
+#define FLUSH_CHUNK      512   // ring bytes handed to the sinks at a time
+#define PI_CHUNK_MAX     (TLM_MAX_PAYLOAD - 4)   // after the stream offset
+
+// Records hold these byte for byte; the GIGA and a host agree on the layout
+static_assert(sizeof(Config) == 68, "Config changed: bump TRACE_VERSION and the readers");
+static_assert(sizeof(FillFilter) == 24, "FillFilter changed: bump TRACE_VERSION");
+static_assert((TRACE_RING_BYTES & (TRACE_RING_BYTES - 1)) == 0, "TRACE_RING_BYTES must be a power of two");
+static_assert(RECORD_MAX <= PI_CHUNK_MAX && RECORD_MAX <= FLUSH_CHUNK, "a record must fit in a chunk");
+
+static const uint8_t MAGIC[4] = { 'C', 'T', 'R', 'C' };
+
+// ========== ENCODING ==========
+/** @brief Store a 32-bit value little-endian. */
+static inline uint8_t *put_u32(uint8_t *p, uint32_t v) {
+    p[0] = (uint8_t)v;
+    p[1] = (uint8_t)(v >> 8);
+    p[2] = (uint8_t)(v >> 16);
+    p[3] = (uint8_t)(v >> 24);
+    return p + 4;
+}
+
+/** @brief Store an unsigned LEB128 varint. */
+static inline uint8_t *put_varint(uint8_t *p, uint64_t v) {
+    while (v >= 0x80) {
+        *p++ = (uint8_t)(v | 0x80);
+        v >>= 7;
+    }
+    *p++ = (uint8_t)v;
+    return p;
+}
+
+/** @brief Signed to unsigned, small magnitudes first (0, -1, 1, -2, ...). */
+static inline uint64_t zigzag(int32_t v) {
+    return ((uint64_t)(uint32_t)v << 1) ^ (uint64_t)(int64_t)(v >> 31);
+}
+
+static inline int32_t unzigzag(uint64_t v) {
+    return (int32_t)((uint32_t)(v >> 1) ^ (uint32_t)-(int32_t)(v & 1));
+}
+
+/** @brief The floats of a pass as bit patterns (NAN is one pattern). */
+static void pass_bits(const SensorRaw &r, uint32_t bits[PASS_FLOATS]) {
+    const float f[PASS_FLOATS] = {
+        r.temp_c[0], r.temp_c[1], r.temp_c[2], r.hum[0], r.hum[1], r.hum[2],
+        r.o2, r.tof_cm[0], r.tof_cm[1], r.board_temp_f,
+    };
+    memcpy(bits, f, sizeof(f));
+}
+
+static void set_pass_bits(SensorRaw &r, const uint32_t bits[PASS_FLOATS]) {
+    float f[PASS_FLOATS];
+    memcpy(f, bits, sizeof(f));
+    for (uint8_t i = 0; i < 3; i++) {
+        r.temp_c[i] = f[i];
+        r.hum[i]    = f[3 + i];
+    }
+    r.o2           = f[6];
+    r.tof_cm[0]    = f[7];
+    r.tof_cm[1]    = f[8];
+    r.board_temp_f = f[9];
+}
+
+static uint8_t status_bits(const ConnectionStatus &s) {
+    return (uint8_t)(s.mux | s.sensor[0] << 1 | s.sensor[1] << 2 | s.sensor[2] << 3 |
+                     s.o2 << 4 | s.vl53[0] << 5 | s.vl53[1] << 6);
+}
+
+static ConnectionStatus status_from(uint8_t b) {
+    ConnectionStatus s;
+    s.mux       = b & 0x01;
+    s.sensor[0] = b & 0x02;
+    s.sensor[1] = b & 0x04;
+    s.sensor[2] = b & 0x08;
+    s.o2        = b & 0x10;
+    s.vl53[0]   = b & 0x20;
+    s.vl53[1]   = b & 0x40;
+    return s;
+}
+
+#if TRACE_ENABLED
+// ========== RECORDING ==========
+// Everything below the ring is touched with interrupts masked, since
+// actuator transitions are recorded from timer callbacks
+static bool      active = false;
+static uint8_t   ring[TRACE_RING_BYTES];
+static uint32_t  head = 0;                    // free-running write position
+static std::atomic<uint32_t> tail(0);         // advanced by trace_flush() only
+static uint64_t  last_us       = 0;           // time of the last record written
+static uint32_t  epoch_base    = 0;           // of the epoch deltas
+static uint32_t  prev_bits[PASS_FLOATS];      // XOR base of TRACE_PASS
+static uint8_t   prev_status   = 0;
+static uint32_t  passes_since  = 0;           // since the last TRACE_STATE
+static bool      state_due     = false;
+static uint32_t  gap           = 0;           // records dropped since the last one written
+static TraceStats stats        = {};
+
+// Sinks, loop() only
+static uint32_t  last_flush_ms = 0;
+#if TRACE_SINKS & TRACE_SINK_FS
+static bool      fs_ok      = false;
+static uint8_t   file_idx   = 0;
+static uint32_t  file_seq   = 0;
+static uint32_t  file_bytes = 0;
+#endif
+#if TRACE_SINKS & TRACE_SINK_PI
+static uint32_t  stream_pos = 0;              // bytes sent since trace_init()
+#endif
+
+static void ring_write(const uint8_t *p, size_t n) {
+    for (size_t i = 0; i < n; i++) ring[(head + i) & (TRACE_RING_BYTES - 1)] = p[i];
+    head += (uint32_t)n;
+}
+
+/**
+ * @brief Append one record, preceded by a TRACE_GAP if some were dropped.
+ * Interrupts masked. @return False if the ring is full (the record is dropped).
+ */
+static bool put_locked(uint8_t type, const uint8_t *payload, size_t len) {
+    uint8_t  hdr[24];
+    uint8_t *p   = hdr;
+    uint64_t now = hal_micros();
+    if (gap) {
+        *p++ = TRACE_GAP;
+        p    = put_varint(p, now - last_us);
+        p    = put_varint(p, gap);
+        *p++ = type;
+        *p++ = 0;                             // same instant as the gap
+    } else {
+        *p++ = type;
+        p    = put_varint(p, now - last_us);
+    }
+    size_t n = (size_t)(p - hdr);
+    if (TRACE_RING_BYTES - (head - tail.load(std::memory_order_acquire)) < n + len) {
+        gap++;
+        stats.dropped++;
+        state_due = true;                     // replay resyncs at the next one
+        return false;
+    }
+    ring_write(hdr, n);
+    ring_write(payload, len);
+    last_us = now;
+    gap     = 0;
+    stats.records++;
+    return true;
+}
+
+/** @brief A sync point; resets the delta bases. Interrupts masked. */
+static void put_state_locked(const SensorTraceState &s, uint32_t epoch) {
+    uint8_t  buf[5 + STATE_FIXED_LEN];
+    uint8_t *p = put_varint(buf, s.pass);
+    p = put_u32(p, epoch);
+    uint8_t sw = 0;
+    for (uint8_t i = 0; i < 5; i++) {
+        if (limit_switch_states[i]) sw |= (uint8_t)(1u << i);
+    }
+    *p++ = sw;
+    *p++ = actuator_outputs();
+    p = put_u32(p, config.lastPumpEpoch);
+    p = put_u32(p, config.lastBlowerEpoch);
+    for (uint8_t k = 0; k < FILL_FILTER_SAMPLES; k++) {
+        uint32_t u;
+        memcpy(&u, &s.fill.buf[k], 4);
+        p = put_u32(p, u);
+    }
+    *p++ = s.fill.idx;
+    *p++ = s.fill.cnt;
+    *p++ = s.fill.outliers;
+    if (put_locked(TRACE_STATE, buf, (size_t)(p - buf))) {
+        epoch_base   = epoch;
+        memset(prev_bits, 0, sizeof(prev_bits));
+        prev_status  = 0;
+        passes_since = 0;
+        state_due    = false;
+    }
+}
+
+/** @brief Start recording to the older of the two trace files. */
+void trace_init() {
+#if TRACE_SINKS & TRACE_SINK_FS
+    uint32_t seq[2] = { 0, 0 };
+    const char *paths[2] = { TRACE_PATH_0, TRACE_PATH_1 };
+    for (uint8_t i = 0; i < 2; i++) {
+        uint8_t h[TRACE_HEADER_LEN];
+        if (hal_fs_read(paths[i], h, sizeof(h)) && memcmp(h, MAGIC, 4) == 0) {
+            seq[i] = (uint32_t)h[8] | (uint32_t)h[9] << 8 | (uint32_t)h[10] << 16 | (uint32_t)h[11] << 24;
+        }
+    }
+    file_idx = seq[0] <= seq[1] ? 0 : 1;
+    file_seq = (seq[0] > seq[1] ? seq[0] : seq[1]) + 1;
+    uint8_t h[TRACE_HEADER_LEN] = { 'C', 'T', 'R', 'C', TRACE_VERSION, 0, 0, 0 };
+    put_u32(&h[8], file_seq);
+    fs_ok      = hal_fs_write(paths[file_idx], h, sizeof(h));
+    file_bytes = sizeof(h);
+    if (fs_ok) LOG_I("Recording to %s (seq %lu)", paths[file_idx], (unsigned long)file_seq);
+    else       LOG_E("Cannot create %s, not recording to flash", paths[file_idx]);
+#endif
+    hal_critical_enter();
+    last_us   = hal_micros();
+    state_due = true;                         // with the first pass
+    active    = true;
+    hal_critical_exit();
+    last_flush_ms = hal_millis();
+    trace_config(config);
+}
+
+/** @brief Record a raw pass, after a sync point when one is due. */
+void trace_pass(const SensorRaw &raw) {
+    if (!active) return;
+    SensorTraceState s     = sensor_manager_trace_state();
+    uint32_t         epoch = hal_epoch();     // the RTC takes a lock: not with interrupts masked
+    uint32_t         bits[PASS_FLOATS];
+    uint8_t          status = status_bits(raw.status);
+    pass_bits(raw, bits);
+
+    hal_critical_enter();
+    if (state_due || ++passes_since >= TRACE_STATE_PASSES) put_state_locked(s, epoch);
+
+    uint8_t  buf[3 + 1 + PASS_FLOATS * 5];
+    uint8_t *p       = buf + 3;               // changed mask goes in front
+    uint32_t changed = 0;
+    if (status != prev_status) {
+        changed |= 1;
+        *p++ = status;
+    }
+    for (uint8_t i = 0; i < PASS_FLOATS; i++) {
+        uint32_t x = bits[i] ^ prev_bits[i];
+        if (!x) continue;
+        changed |= 2u << i;
+        p = put_varint(p, x);
+    }
+    uint8_t  mask[3];
+    size_t   m     = (size_t)(put_varint(mask, changed) - mask);
+    uint8_t *start = buf + 3 - m;
+    memcpy(start, mask, m);
+    if (put_locked(TRACE_PASS, start, (size_t)(p - start))) {
+        memcpy(prev_bits, bits, sizeof(bits));
+        prev_status = status;
+    }
+    hal_critical_exit();
+}
+
+/** @brief Record the switch levels after a poll that changed one. */
+void trace_switches(uint8_t levels) {
+    if (!active) return;
+    hal_critical_enter();
+    put_locked(TRACE_SWITCH, &levels, 1);
+    hal_critical_exit();
+}
+
+/** @brief Record the outputs after a transition. ISR-safe. */
+void trace_outputs(uint8_t outputs) {
+    if (!active) return;
+    hal_critical_enter();
+    put_locked(TRACE_OUTPUT, &outputs, 1);
+    hal_critical_exit();
+}
+
+/** @brief Record what a control pass is about to decide on. */
+void trace_control(uint32_t pass, uint32_t epoch) {
+    if (!active) return;
+    uint8_t buf[16];
+    hal_critical_enter();
+    uint8_t *p = put_varint(buf, pass);
+    p = put_varint(p, zigzag((int32_t)(epoch - epoch_base)));
+    if (put_locked(TRACE_CONTROL, buf, (size_t)(p - buf))) epoch_base = epoch;
+    hal_critical_exit();
+}
+
+/** @brief Record a remote trigger, whether or not it started the program. */
+void trace_trigger(uint8_t program, uint32_t epoch) {
+    if (!active) return;
+    uint8_t buf[8];
+    buf[0] = program;
+    hal_critical_enter();
+    uint8_t *p = put_varint(&buf[1], zigzag((int32_t)(epoch - epoch_base)));
+    if (put_locked(TRACE_TRIGGER, buf, (size_t)(p - buf))) epoch_base = epoch;
+    hal_critical_exit();
+}
+
+/** @brief Record a config save. */
+void trace_config(const Config &c) {
+    if (!active) return;
+    hal_critical_enter();
+    put_locked(TRACE_CONFIG, (const uint8_t *)&c, sizeof(Config));
+    hal_critical_exit();
+}
+
+#if TRACE_SINKS & TRACE_SINK_FS
+/** @brief Append whole records to the current file; start the other one when it is full. */
+static void sink_fs(const uint8_t *p, size_t n) {
+    if (!fs_ok) return;
+    const char *paths[2] = { TRACE_PATH_0, TRACE_PATH_1 };
+    if (file_bytes + n > TRACE_FILE_BYTES) {
+        uint8_t h[TRACE_HEADER_LEN] = { 'C', 'T', 'R', 'C', TRACE_VERSION, 0, 0, 0 };
+        file_idx ^= 1;
+        put_u32(&h[8], ++file_seq);
+        fs_ok      = hal_fs_write(paths[file_idx], h, sizeof(h));
+        file_bytes = sizeof(h);
+        if (!fs_ok) {
+            stats.sink_errors++;
+            LOG_E("Cannot create %s, not recording to flash", paths[file_idx]);
+            return;
+        }
+        // The new file becomes replayable from the config and the sync
+        // point these queue; what is ahead of them is skipped
+        trace_config(config);
+        hal_critical_enter();
+        state_due = true;
+        hal_critical_exit();
+    }
+    if (hal_fs_append(paths[file_idx], p, n)) {
+        file_bytes += (uint32_t)n;
+    } else {
+        stats.sink_errors++;
+    }
+}
+#endif
+
+#if TRACE_SINKS & TRACE_SINK_PI
+/** @brief Send whole records as TLM_TRACE frames of up to PI_CHUNK_MAX bytes. */
+static void sink_pi(const uint8_t *p, size_t n) {
+    while (n) {
+        size_t len = 0;
+        while (len < n) {
+            size_t r = trace_record_len(p + len, n - len);
+            if (!r || len + r > PI_CHUNK_MAX) break;
+            len += r;
+        }
+        if (!len) return;
+        uint8_t frame[TLM_MAX_PAYLOAD];
+        put_u32(frame, stream_pos);
+        memcpy(&frame[4], p, len);
+        if (!telemetry_send(TLM_TRACE, frame, 4 + len)) {
+            // The Pi sees the offset jump and waits for the next sync point
+            stats.sink_errors++;
+            hal_critical_enter();
+            state_due = true;
+            hal_critical_exit();
+        }
+        stream_pos += (uint32_t)len;
+        p += len;
+        n -= len;
+    }
+}
+#endif
+
+/** @brief Hand waiting records to the sinks once enough wait or enough time passed. */
+void trace_flush(uint32_t now_ms) {
+    if (!active) return;
+    hal_critical_enter();
+    uint32_t h = head;
+    hal_critical_exit();
+    uint32_t t = tail.load(std::memory_order_relaxed);
+    if (h == t || (h - t < TRACE_FLUSH_BYTES && now_ms - last_flush_ms < TRACE_FLUSH_MS)) return;
+    last_flush_ms = now_ms;
+
+    while (t != h) {
+        uint8_t chunk[FLUSH_CHUNK];
+        size_t  n = h - t < sizeof(chunk) ? h - t : sizeof(chunk);
+        for (size_t i = 0; i < n; i++) chunk[i] = ring[(t + i) & (TRACE_RING_BYTES - 1)];
+
+        // Sinks only ever see whole records, so every file and frame parses
+        size_t whole = 0;
+        while (whole < n) {
+            size_t r = trace_record_len(chunk + whole, n - whole);
+            if (!r) break;
+            whole += r;
+        }
+        if (!whole) break;
+#if TRACE_SINKS & TRACE_SINK_FS
+        sink_fs(chunk, whole);
+#endif
+#if TRACE_SINKS & TRACE_SINK_PI
+        sink_pi(chunk, whole);
+#endif
+        t += (uint32_t)whole;
+        tail.store(t, std::memory_order_release);
+        stats.flushed += (uint32_t)whole;
+    }
+}
+
+TraceStats trace_get_stats() {
+    hal_critical_enter();
+    TraceStats s = stats;
+    hal_critical_exit();
+    return s;
+}
+#endif // TRACE_ENABLED
+
+// ========== READING ==========
+typedef struct {
+    const uint8_t *p;
+    const uint8_t *end;
+} Cursor;
+
+static bool get_u8(Cursor &c, uint8_t &v) {
+    if (c.p >= c.end) return false;
+    v = *c.p++;
+    return true;
+}
+
+static bool get_u32(Cursor &c, uint32_t &v) {
+    if (c.end - c.p < 4) return false;
+    v = (uint32_t)c.p[0] | (uint32_t)c.p[1] << 8 | (uint32_t)c.p[2] << 16 | (uint32_t)c.p[3] << 24;
+    c.p += 4;
+    return true;
+}
+
+static bool get_varint(Cursor &c, uint64_t &v) {
+    v = 0;
+    for (uint8_t shift = 0; shift < 64; shift += 7) {
+        uint8_t b;
+        if (!get_u8(c, b)) return false;
+        v |= (uint64_t)(b & 0x7F) << shift;
+        if (!(b & 0x80)) return true;
+    }
+    return false;
+}
+
+bool trace_reader_init(TraceReader &r, const uint8_t *buf, size_t len, bool header) {
+    memset(&r, 0, sizeof(r));
+    r.p   = buf;
+    r.end = buf + len;
+    if (!header) return true;
+    if (len < TRACE_HEADER_LEN || memcmp(buf, MAGIC, 4) != 0 || buf[4] != TRACE_VERSION) return false;
+    r.p += TRACE_HEADER_LEN;
+    return true;
+}
+
+int trace_read(TraceReader &r, TraceRecord &rec) {
+    if (r.p >= r.end) return 0;
+    Cursor   c = { r.p, r.end };
+    uint8_t  type;
+    uint64_t dt, v;
+    if (!get_u8(c, type) || !get_varint(c, dt)) return -1;
+    rec.type = (TraceType)type;
+
+    switch (type) {
+    case TRACE_CONFIG:
+        if ((size_t)(c.end - c.p) < sizeof(Config)) return -1;
+        memcpy(&rec.config, c.p, sizeof(Config));
+        c.p += sizeof(Config);
+        break;
+
+    case TRACE_STATE: {
+        TraceState &s = rec.state;
+        uint32_t    u = 0;
+        if (!get_varint(c, v) || (size_t)(c.end - c.p) < STATE_FIXED_LEN) return -1;
+        s.sensor.pass = (uint32_t)v;
+        get_u32(c, s.epoch);
+        get_u8(c, s.switches);
+        get_u8(c, s.outputs);
+        get_u32(c, s.last_pump_epoch);
+        get_u32(c, s.last_blower_epoch);
+        for (uint8_t k = 0; k < FILL_FILTER_SAMPLES; k++) {
+            get_u32(c, u);
+            memcpy(&s.sensor.fill.buf[k], &u, 4);
+        }
+        get_u8(c, s.sensor.fill.idx);
+        get_u8(c, s.sensor.fill.cnt);
+        get_u8(c, s.sensor.fill.outliers);
+        rec.epoch = s.epoch;
+        r.synced  = true;
+        r.epoch   = s.epoch;
+        memset(&r.prev, 0, sizeof(r.prev));
+        break;
+    }
+
+    case TRACE_PASS: {
+        uint32_t bits[PASS_FLOATS];
+        uint8_t  status = status_bits(r.prev.status);
+        if (!get_varint(c, v)) return -1;
+        if ((v & 1) && !get_u8(c, status)) return -1;
+        pass_bits(r.prev, bits);
+        for (uint8_t i = 0; i < PASS_FLOATS; i++) {
+            uint64_t x;
+            if (!(v & (2u << i))) continue;
+            if (!get_varint(c, x)) return -1;
+            bits[i] ^= (uint32_t)x;
+        }
+        rec.raw.status = status_from(status);
+        set_pass_bits(rec.raw, bits);
+        r.prev = rec.raw;
+        break;
+    }
+
+    case TRACE_SWITCH:
+    case TRACE_OUTPUT:
+        if (!get_u8(c, rec.bits)) return -1;
+        break;
+
+    case TRACE_CONTROL: {
+        uint64_t d;
+        if (!get_varint(c, v) || !get_varint(c, d)) return -1;
+        rec.pass  = (uint32_t)v;
+        rec.epoch = r.epoch + (uint32_t)unzigzag(d);
+        r.epoch   = rec.epoch;
+        break;
+    }
+
+    case TRACE_TRIGGER:
+        if (!get_u8(c, rec.bits) || !get_varint(c, v)) return -1;
+        rec.epoch = r.epoch + (uint32_t)unzigzag(v);
+        r.epoch   = rec.epoch;
+        break;
+
+    case TRACE_GAP:
+        if (!get_varint(c, v)) return -1;
+        rec.dropped = (uint32_t)v;
+        r.synced    = false;
+        break;
+
+    default:
+        return -1;
+    }
+
+    r.p        = c.p;
+    r.t_us    += dt;
+    rec.t_us   = r.t_us;
+    rec.synced = r.synced;
+    return 1;
+}
+
+size_t trace_record_len(const uint8_t *p, size_t avail) {
+    TraceReader r;
+    TraceRecord rec;
+    trace_reader_init(r, p, avail, false);
+    return trace_read(r, rec) == 1 ? (size_t)(r.p - p) : 0;
+}
@@ -0,0 +1,81 @@
+/******************************************************************************
+ * @file    warning_log.cpp
+ * @author  Thomas Zoldowski
+ * @date    October 18, 2026
+ * @brief   Footer warning text and the warning history, without widgets.
+ ******************************************************************************/
+#include "logic/warning_log.h"
+#include "logic/sensor_manager.h"
+#include <cstdio>
+#include <cstring>
+
+// Newest first; the table cells point into these, so they stay put
+static char ts_buf  [WARNING_LOG_MAX][32];
+static char desc_buf[WARNING_LOG_MAX][64];
+
+// How many warnings we've added so far
+static int warning_count = 0;
+
+/** @brief Format warnings into a human-readable string.
+ *  @param mask   The warning mask to format.
+ *  @param buf    The buffer to store the formatted string.
+ *  @param buf_sz The size of the buffer.
+ *  @return False if nothing is wrong.
+ */
+bool warning_text(uint32_t mask, char *buf, size_t buf_sz) {
+    if(mask == WARN_NONE) {
+        snprintf(buf, buf_sz, "ALL SYSTEMS NOMINAL");
+        return false;
+    }
+    buf[0] = '\0';
+    bool first = true;
+    auto append = [&](const char* msg) {
+        if(!first) strncat(buf, ", ", buf_sz - strlen(buf) - 1);
+        strncat(buf, msg, buf_sz - strlen(buf) - 1);
+        first = false;
+    };
+    if(mask & WARN_FRONT_DOOR)   append("FRONT UNLOADING DOOR OPEN");
+    if(mask & WARN_BACK_DOOR)    append("BACK UNLOADING DOOR OPEN");
+    if(mask & WARN_LOADING_DOOR) append("LOADING DOOR OPEN");
+    if(mask & WARN_HIGH_TEMP)    append("HIGH TEMP");
+    return true;
+}
+
+/** @brief Add a warning to the top of the history.
+ *  @param description The description of the warning.
+ *  @param now         When it happened.
+ */
+void warning_log_add(const char *description, time_t now) {
+    // 1) Generate the time "HH:MM:SS" into a temporary buffer
+    char new_ts[16];
+    struct tm tm_info;
+    localtime_r(&now, &tm_info);
+    strftime(new_ts, sizeof(new_ts), "%H:%M:%S", &tm_info);
+
+    // 2) If not full yet, grow by one entry
+    if(warning_count < WARNING_LOG_MAX) warning_count++;
+
+    // 3) Shift existing entries down one (0→1, 1→2, …)
+    //    If at capacity, the last one is dropped
+    for(int i = warning_count - 1; i >= 1; --i) {
+        strcpy(ts_buf[i],   ts_buf[i - 1]);
+        strcpy(desc_buf[i], desc_buf[i - 1]);
+    }
+
+    // 4) Insert the new entry at the top
+    strcpy(ts_buf[0], new_ts);
+    strncpy(desc_buf[0], description, sizeof(desc_buf[0]) - 1);
+    desc_buf[0][sizeof(desc_buf[0]) - 1] = '\0';
+}
+
+int warning_log_count() {
+    return warning_count;
+}
+
+const char *warning_log_time(int i) {
+    return (i >= 0 && i < warning_count) ? ts_buf[i] : "";
+}
+
+const char *warning_log_desc(int i) {
+    return (i >= 0 && i < warning_count) ? desc_buf[i] : "";
+}
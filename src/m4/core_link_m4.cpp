@@ -0,0 +1,104 @@
+/******************************************************************************
+ * @file    core_link_m4.cpp
+ * @author  Thomas Zoldowski
+ * @date    October 18, 2026
+ * @brief   M4 side of the dual-core split (see core_link.h).
+ *
+ * Publishes the snapshot, queues events and serves the control settings
+ * (settings_storage.h getters and the config epochs) from the copy the M7
+ * shares. The M4 has no data cache, so plain barriers are enough here.
+ ******************************************************************************/
+
+#include "logic/core_link.h"
+#include "logic/actuator_manager.h"
+#include "settings_storage.h"
+#include <mbed.h>
+#include <string.h>
+
+#define LOG_TAG   "M4"
+#define LOG_LEVEL LOG_LEVEL_CORE
+#include "log.h"
+
+static CoreLink *const shm = core_link_shared();
+
+static CoreSettings settings;           // last applied copy
+static rtos::Mutex  link_mutex;         // loop() and the RPC thread both publish/post
+static bool         ring_full = false;  // warn once per full spell
+
+// Only the fields the control code uses are filled; the M7 owns the file
+Config config;
+
+/** @brief Stamp the block as alive and pick up the settings. */
+void core_link_m4_init() {
+    memset(&settings, 0, sizeof(settings));
+    shm->magic   = CORE_LINK_MAGIC;
+    shm->version = CORE_LINK_VERSION;
+    shm->m4_boots++;
+    core_link_m4_sync();
+    LOG_I("Control core up, settings seq %lu", (unsigned long)settings.seq);
+}
+
+/** @brief Apply settings the M7 changed since the last call. */
+void core_link_m4_sync() {
+    volatile uint32_t *seq = &shm->settings.seq;
+    uint32_t s1 = *seq;
+    if (s1 == settings.seq || (s1 & 1)) return;   // unchanged, or being written
+    __DMB();
+    CoreSettings s;
+    memcpy(&s, &shm->settings, sizeof(s));
+    __DMB();
+    if (*seq != s1) return;                       // torn; next pass picks it up
+
+    settings = s;
+    // An actuator that just started here may not have reached the M7's copy yet
+    if (s.last_pump_epoch > config.lastPumpEpoch)     config.lastPumpEpoch   = s.last_pump_epoch;
+    if (s.last_blower_epoch > config.lastBlowerEpoch) config.lastBlowerEpoch = s.last_blower_epoch;
+    LOG_D("Settings seq %lu applied", (unsigned long)s1);
+}
+
+/** @brief Publish the current readings and actuator state. */
+void core_link_publish() {
+    link_mutex.lock();
+    CoreSnapshot &p = shm->snap;
+    p.seq++;                      // odd: the M7 retries
+    __DMB();
+    sensor_manager_get_snapshot(p.sensors);
+    for (uint8_t i = 0; i < ACT_PROGRAM_COUNT; i++) p.steps[i] = actuator_step((ActuatorProgram)i);
+    p.outputs = actuator_outputs();
+    p.published++;
+    __DMB();
+    p.seq++;
+    link_mutex.unlock();
+}
+
+/** @brief Queue an event for the M7. */
+void core_link_post(CoreEventType type, uint8_t a, uint8_t b, uint32_t epoch) {
+    link_mutex.lock();
+    uint32_t head = shm->ev_head;
+    uint32_t tail = *(volatile uint32_t *)&shm->ev_tail;
+    if (head - tail >= CORE_EVENT_SLOTS) {
+        shm->ev_dropped++;
+        bool first = !ring_full;
+        ring_full = true;
+        link_mutex.unlock();
+        if (first) LOG_W("Event ring full (M7 not polling?), dropping events");
+        return;
+    }
+    ring_full = false;
+    CoreEvent &e = shm->events[head % CORE_EVENT_SLOTS];
+    e.type     = type;
+    e.a        = a;
+    e.b        = b;
+    e.reserved = 0;
+    e.epoch    = epoch;
+    __DMB();                      // event visible before the index moves
+    shm->ev_head = head + 1;
+    link_mutex.unlock();
+}
+
+// ================= settings_storage.h =================
+uint16_t getBlowerOnTime()               { return settings.blower_on_s; }
+uint16_t getPumpOnTime()                 { return settings.pump_on_s; }
+uint16_t getActivationInterval()         { return settings.interval_s; }
+uint16_t getTempHighThreshold(int id)    { return (id >= 0 && id < 3) ? settings.temp_high_f[id] : 0; }
+uint16_t getHumLowThreshold(int id)      { return (id >= 0 && id < 3) ? settings.hum_low[id] : 0; }
@@ -0,0 +1,93 @@
+/******************************************************************************
+ * @file    main_m4.cpp
+ * @author  Thomas Zoldowski
+ * @date    October 18, 2026
+ * @brief   Entry point for the Cortex-M4 control firmware (CORE_SPLIT).
+ *
+ * Runs sensor acquisition, the limit switches and the pump/blower
+ * scheduler on the M4, so their timing no longer depends on how long the
+ * M7 spends rendering. Results go to the M7 through core_link.h; the M7
+ * boots this core with RPC.begin() and forwards its log output.
+ *
+ * Built by env:giga_r1_m4 and flashed into the M4's share of the 75_25
+ * flash layout.
+ ******************************************************************************/
+
+#include <Arduino.h>
+#include <mbed.h>
+#include <RPC.h>
+
+#include "config.h"
+#include "serial_tx.h"
+#include "logic/core_link.h"
+#include "logic/sensor_manager.h"
+#include "logic/actuator_manager.h"
+#include "logic/telemetry.h"
+
+#define LOG_TAG   "M4"
+#define LOG_LEVEL LOG_LEVEL_CORE
+#include "log.h"
+
+static uint32_t lastSensorUpdate     = 0;
+static uint32_t lastSwitchUpdate     = 0;
+static uint32_t lastPublish          = 0;
+
+/** @brief RPC from the M7: start an actuator program now (ActuatorProgram). */
+static bool rpc_act_trigger(int program) {
+    bool ok = false;
+    if (program >= 0 && program < ACT_PROGRAM_COUNT) ok = actuator_trigger((ActuatorProgram)program);
+    core_link_publish();           // the M7 sees the new state on its next pass
+    return ok;
+}
+
+/** @brief Milliseconds until a periodic task is due (0 if already due). */
+static inline uint32_t ms_until(uint32_t last, uint32_t interval, uint32_t now) {
+  uint32_t elapsed = now - last;
+  return (elapsed >= interval) ? 0 : interval - elapsed;
+}
+
+void setup() {
+  RPC.begin();
+  serial_tx_init();              // log output goes to the M7 over RPC
+  core_link_m4_init();
+  RPC.bind("act_trigger", rpc_act_trigger);
+
+  sensor_manager_init();
+  Limit_Switch_Init();
+  initActuatorScheduler();   // the pump/blower schedule runs on its own thread
+  core_link_publish();
+  LOG_I("Setup complete");
+}
+
+void loop() {
+  uint32_t now = millis();
+  bool changed = false;
+
+  core_link_m4_sync();
+
+  if (now - lastSensorUpdate >= SENSOR_UPDATE_INTERVAL_MS) {
+    sensor_manager_update();
+    lastSensorUpdate = now;
+    changed = true;
+  }
+
+  if (now - lastSwitchUpdate >= CORE_M4_SWITCH_MS) {
+    Limit_Switch_update();
+    lastSwitchUpdate = now;
+    changed = true;
+  }
+
+  if (changed || now - lastPublish >= CORE_M4_PUBLISH_MS) {
+    core_link_publish();
+    lastPublish = now;
+  }
+
+  // Sleep until the next task is due
+  now = millis();
+  uint32_t wait_ms = ms_until(lastSensorUpdate, SENSOR_UPDATE_INTERVAL_MS, now);
+  uint32_t c = ms_until(lastSwitchUpdate, CORE_M4_SWITCH_MS, now);
+  if (c < wait_ms) wait_ms = c;
+  c = ms_until(lastPublish, CORE_M4_PUBLISH_MS, now);
+  if (c < wait_ms) wait_ms = c;
+  if (wait_ms) rtos::ThisThread::sleep_for(std::chrono::milliseconds(wait_ms));
+}
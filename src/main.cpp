@@ -39,13 +39,20 @@
 
 // Local Files
 #include "ui_manager.h"
+#include "display_power.h"
+#include "serial_tx.h"
 #include "config.h"
 
+#define LOG_TAG   "MAIN"
+#define LOG_LEVEL LOG_LEVEL_MAIN
+#include "log.h"
+
 // SCreens
 #include "screens/screen_home.h"
 #include "screens/screen_sensors.h"
 #include "screens/screen_warnings.h"
 #include "screens/screen_diagnostics.h"
+#include "screens/screen_history.h"
 #include "screens/screen_settings.h"
 
 // LCD
@@ -54,10 +61,27 @@
 
 // Sensors
 #include "logic/sensor_manager.h"
+#include "logic/history_log.h"
+#include "logic/telemetry.h"
+#include "logic/command_channel.h"
 
 // Network
+#include "logic/network_manager.h"
 #include "logic/actuator_manager.h"
+#include "logic/status_led.h"
+#include "logic/core_link.h"
+#include "logic/supervisor.h"
+#include "logic/trace.h"
+#include "screens/screen_manual.h"
 #include "settings_storage.h"
+#if BENCH_ON_BOOT
+#include "bench/bench.h"
+#endif
+
+// Sensing and actuator control run in their own threads and touch widgets
+#if LV_USE_OS == LV_OS_NONE
+#error "lv_lock() needs LVGL's OS layer: build with -DLV_USE_OS=LV_OS_CMSIS_RTOS2 (platformio.ini)"
+#endif
 
 #define CHUNK_LINES 7
 
@@ -87,35 +111,52 @@ unsigned long input_time = 0; // For serial output
 static uint32_t lastSensorUpdate    = 0;
 static uint32_t lastLEDUpdate       = 0;
 static uint32_t lastSecurityCheck   = 0;
-static uint32_t lastActuatorSchedule= 0;
+#if NET_UPLOAD_ENABLED
+static uint32_t lastNetUpload       = 0;
+#endif
 
 constexpr uint32_t SENSOR_INTERVAL_MS      = 1000;
 constexpr uint32_t LED_INTERVAL_MS         = 250;
 constexpr uint32_t SECURITY_CHECK_MS       = 500;
-constexpr uint32_t ACTUATOR_SCHEDULE_MS    = 1000; // hourly
+
+static SupervisorId ui_id = SUPERVISOR_NONE;
+
+// ================= IDLE PARKING =================
+// loop() sleeps between passes until LVGL's next timer, the next task above
+// or a touch interrupt, instead of spinning lv_timer_handler().
+static rtos::Semaphore   ui_wake(0, 1);
+static mbed::InterruptIn *touch_irq   = nullptr;
+static lv_indev_t        *touch_indev = nullptr;
+static uint32_t           last_touch_irq = 0;
+static bool               touch_poll_fast = true;
+
+static void touch_irq_handler();
+static void idle_wait(uint32_t lv_next_ms, uint32_t lv_called_at);
 
 // Instantiate the raw flash driver on its default pins
 QSPIFBlockDevice root(QSPI_SO0, QSPI_SO1, QSPI_SO2, QSPI_SO3,  QSPI_SCK, QSPI_CS, QSPIF_POLARITY_MODE_1, 40000000);
 mbed::MBRBlockDevice user_data(&root, 3);
 mbed::LittleFileSystem user_data_fs("user");
 
-// ================= WATCH DOG =================
-mbed::Watchdog &watchdog = mbed::Watchdog::get_instance();
-
 int selected_index = -1;
 
 // ================= INIT SETUP =================
 void setup() {
   Serial.begin(SERIAL_BAUDRATE);
+  serial_tx_init();   // all output from here on is queued, never blocking
   //Serial2.begin(9600);
 
   delay(2000);
-  Serial.println("DEBUG: Serial.println working");
+  LOG_I("Serial output ready");
   
   // Initialize the display and touch controller
   Display.begin();
   TouchDetector.begin();
   lv_init();
+  display_power_init();
+
+  // Trend history lives in SDRAM, which Display.begin() brings up
+  history_init();
 
   // Initialize the display driver
   lv_disp_t *disp = lv_display_get_default();
@@ -129,38 +170,68 @@ void setup() {
 
   // Initialize your UI modules, including screen_manual’s static globals
   settings_init_from_config();
-  Serial.println("5...................");
+  LOG_D("setup step 5");
 
 
-  Serial.println("10...................");
+  LOG_D("setup step 10");
+#if CORE_SPLIT
+  core_link_init();         // boots the M4, which owns sensors and actuators
+#endif
   // Initialize sensors
   sensor_manager_init();
-  Serial.println("20...................");
+  LOG_D("setup step 20");
   // Init Pins
   Limit_Switch_Init();
   LED_Init();
-  initActuatorScheduler();
+  trace_init();             // field trace of the sensing and control inputs, from the first pass
+  initActuatorScheduler();  // control thread: pump/blower timing from here on
+  telemetry_init();
+  command_channel_init();   // Pi requests are received from here on
+#if NET_UPLOAD_ENABLED
+  network_init();           // Wi-Fi join and uploads run in their own thread
+#endif
 
   // Init Screens
-  Serial.println("30...................");
+  LOG_D("setup step 30");
 
-  Serial.println("40...................");;
+  LOG_D("setup step 40");
 
-  Serial.println("50...................");
+  LOG_D("setup step 50");
 
-  Serial.println("60...................");
-  // Setup watchdog
-  watchdog.start(2000); // Enable the watchdog and configure the duration of the timeout (ms).
+  LOG_D("setup step 60");
 
   lv_log_register_print_cb(my_print);
 
+  // Wake the idle loop as soon as the touch controller signals a touch
+  touch_indev = lv_indev_get_next(NULL);
+  // Every touch, on any screen, counts as activity (and wakes the panel)
+  if (touch_indev) lv_indev_add_event_cb(touch_indev, global_input_event_cb, LV_EVENT_PRESSED, NULL);
+  touch_irq = new mbed::InterruptIn(TOUCH_IRQ_PIN);
+  touch_irq->rise(touch_irq_handler);
+
+  lv_lock();
   ui_init(); // Initialize the UI screens
 
   // Init Diagnostic screen
   handle_screen_selection("Home");
+  lv_unlock();
+
+  // After ui_init(): a door already closed fires on the first poll, and its
+  // warning needs the table
+  sensor_manager_start();   // acquisition thread: sensors and limit switches
+
+  // Watchdog is kicked only while the control, acquisition and UI threads check in
+  ui_id = supervisor_register("ui", UI_MAX_SILENCE_MS);
+  supervisor_start();
   //update_footer_status(FOOTER_OK);
 
-  Serial.println("100...................");
+#if BENCH_ON_BOOT
+  // Hot-path timings on DebugSerial (tools/bench_compare.py); the watchdog
+  // still expects the UI thread, which is this one
+  bench_run(nullptr, [] { supervisor_checkin(ui_id); });
+#endif
+
+  LOG_I("Setup complete");
 
 }
 
@@ -168,38 +239,58 @@ void setup() {
 
 // ================= MAIN LOOP =================
 void loop() {
-  lv_timer_handler();
-
+  // Returns the time until the next LVGL timer is due. The display refresh
+  // timer pauses itself when no area is invalidated, so an idle UI only
+  // leaves the touch read timer running.
+  uint32_t lv_next_ms = lv_timer_handler();
+
+  // Everything up to the idle park may touch widgets. No other thread does:
+  // door warnings come through sensor_manager_poll_doors().
+  lv_lock();
   uint32_t now = millis();
 
-  // Poll sensor data at defined interval
+#if CORE_SPLIT
+  core_link_poll();   // M4 snapshot, door/actuator events and its log output
+#else
+  sensor_manager_poll_doors();   // door openings the acquisition thread queued
+#endif
+
+  // Readings come from the acquisition thread's latest snapshot
   if (now - lastSensorUpdate >= SENSOR_UPDATE_INTERVAL_MS) {
-    sensor_manager_update();
-    // Diagnostics screen updates
-    if (is_diagnostics_screen_active()) { // Diagnostics screen is active
-      update_diagnostics_screen();
+    history_record(now);
+    command_channel_publish_snapshot(now);
+#if NET_UPLOAD_ENABLED
+    if (now - lastNetUpload >= NET_UPLOAD_INTERVAL_MS) {
+      network_submit_reading();   // only copies; the uploader thread sends it
+      lastNetUpload = now;
     }
-    // Sensor screen updates
-    else if (selected_index == 0) { // Sensor screen is active
-      update_sensor_screen();
-      Serial.println("Sensor screen updated");
+#endif
+    // Screen refreshes are skipped while the panel is off; sensing continues
+    if (display_power_is_rendering()) {
+      // Diagnostics screen updates
+      if (is_diagnostics_screen_active()) { // Diagnostics screen is active
+        update_diagnostics_screen();
+      }
+      // Sensor screen updates
+      else if (selected_index == 0) { // Sensor screen is active
+        update_sensor_screen();
+        LOG_D("Sensor screen updated");
+      }
+      // History chart only redraws when a new sample was stored
+      else if (is_history_screen_active()) {
+        update_history_screen();
+      }
     }
     lastSensorUpdate = now;  // Reset the last sensor update time
   }
 
-  // LED status update (2 Hz)
+  // LED status, door footer and actuator indicators (4 Hz)
   if (now - lastLEDUpdate >= LED_INTERVAL_MS) {
     LED_Update();
-    Limit_Switch_update();
+    update_footer_status(Limit_Switch_get_warning_mask());
+    updateManualScreenLEDs(actuator_outputs());
     lastLEDUpdate = now;
   }
- 
-  // Hourly actuators and limit switches
-  if (now - lastActuatorSchedule >= ACTUATOR_SCHEDULE_MS) {
-    scheduleHourlyActuators();
-    lastActuatorSchedule = now;
-  }
-    
 
   // Security PIN timeout (0.5 Hz)
   if (now - lastSecurityCheck >= SECURITY_CHECK_MS) {
@@ -207,6 +298,9 @@ void loop() {
     lastSecurityCheck = now;
   }
 
+  // Dim, then switch off the display when nobody is using it
+  display_power_update(now, glast_input_time);
+
   // Inactivity timeout check
   if (now - glast_input_time > INACTIVITY_TIMEOUT_MS) {
     handle_screen_selection("Home"); // Go back to home screen after timeout
@@ -214,22 +308,103 @@ void loop() {
   }
 
   // Timeout for security PIN
-  // Send Data to Raspberry Pi every 10 seconds
+  // Sample for the Raspberry Pi every send interval (10 s default);
+  // samples are batched and kept until the Pi acknowledges them
   if (now - input_time > getSendInterval()* 1000) {
-    SensorDataToSerial();
+    telemetry_record_sample(now);
     
     input_time = now;  // Reset the input time
   }
+  command_channel_poll();   // Pi ACKs and config/actuator/history requests
+  telemetry_poll(now);
   CameraDelayToSerial();
 
-  // Keep the watchdog alive
-  watchdog.kick();
+  // Flash writes touch no widgets; don't hold the lock through them
+  lv_unlock();
+  actuator_save_pending();  // trigger times the control thread recorded
+  trace_flush(now);         // field trace to flash / the Pi when enough is waiting
+  lv_lock();
+
+  supervisor_checkin(ui_id);
+
+  // Park until there is something to do (the lock is released while parked)
+  idle_wait(lv_next_ms, now);
+  lv_unlock();
+}
+
+// ================= IDLE PARKING =================
+/** @brief Touch controller interrupt: wake the parked main loop. */
+static void touch_irq_handler() {
+  ui_wake.release();
+}
+
+/** @brief Milliseconds until a periodic task is due (0 if already due). */
+static inline uint32_t ms_until(uint32_t last, uint32_t interval, uint32_t now) {
+  uint32_t elapsed = now - last;
+  return (elapsed >= interval) ? 0 : interval - elapsed;
+}
+
+/** @brief Sleep until the earliest of LVGL's next timer, the next scheduled
+ *  task in loop() or a touch interrupt.
+ *  While idle the touch read timer is slowed to TOUCH_POLL_IDLE_MS; a touch
+ *  interrupt restores the fast period and forces an immediate read, so
+ *  responsiveness is unchanged while the CPU can sit in WFI most of the time.
+ *  Called with lv_lock() held; it is released while parked.
+ *  @param lv_next_ms   Return value of lv_timer_handler().
+ *  @param lv_called_at millis() right after lv_timer_handler() returned.
+ */
+static void idle_wait(uint32_t lv_next_ms, uint32_t lv_called_at) {
+  uint32_t now = millis();
+  lv_timer_t *read_timer = touch_indev ? lv_indev_get_read_timer(touch_indev) : nullptr;
+
+  // Drop to slow touch polling once the panel has been left alone
+  if (read_timer && touch_poll_fast
+      && now - last_touch_irq > TOUCH_IDLE_AFTER_MS
+      && lv_indev_get_state(touch_indev) == LV_INDEV_STATE_RELEASED) {
+    lv_timer_set_period(read_timer, TOUCH_POLL_IDLE_MS);
+    touch_poll_fast = false;
+  }
+
+  uint32_t wait_ms = IDLE_MAX_SLEEP_MS;
+  uint32_t since_lv = now - lv_called_at;
+  uint32_t candidates[] = {
+    (lv_next_ms > since_lv) ? lv_next_ms - since_lv : 0,
+    ms_until(lastSensorUpdate,     SENSOR_UPDATE_INTERVAL_MS, now),
+    ms_until(lastLEDUpdate,        LED_INTERVAL_MS,           now),
+    ms_until(lastSecurityCheck,    SECURITY_CHECK_MS,         now),
+    ms_until(input_time,           getSendInterval() * 1000UL, now),
+  };
+  for (uint32_t c : candidates) {
+    if (c < wait_ms) wait_ms = c;
+  }
+  if (wait_ms == 0) return;
+
+  lv_unlock();
+  bool touched = ui_wake.try_acquire_for(std::chrono::milliseconds(wait_ms));
+  lv_lock();
+  if (touched) {
+    // Touch: read it on the next pass and keep polling fast while in use
+    last_touch_irq = millis();
+    if (read_timer) {
+      if (!touch_poll_fast) {
+        lv_timer_set_period(read_timer, TOUCH_POLL_ACTIVE_MS);
+        touch_poll_fast = true;
+      }
+      lv_timer_ready(read_timer);
+    }
+  }
 }
 
 // ================= FUNCTIONS =================
 void global_input_event_cb(lv_event_t * e) {
   glast_input_time = millis();  // Reset inactivity timer
   last_activity = millis();
+
+  // A touch on a dark panel only wakes it; don't let it click what's underneath
+  if (display_power_wake()) {
+    lv_indev_t *indev = lv_indev_active();
+    if (indev) lv_indev_wait_release(indev);
+  }
 }
 
 // ================= LITTLEFS SETUP =================
@@ -237,35 +412,31 @@ void Init_LittleFS(void){
   // 1) Initialize root and the user_data partition
   int err = root.init();
   if (err) {
-    Serial.println("root.init() failed");
-    while (true) {}
+    LOG_E("root.init() failed");
+    while (true) { delay(1000); }   // let the TX thread flush the error
   }
   if (user_data.init() != 0) {
-    Serial.println("user_data.init() failed");
-    while (true) {}
+    LOG_E("user_data.init() failed");
+    while (true) { delay(1000); }
   }
-  //  Serial.println("Mounting the filesystem…");
+  //  LOG_I("Mounting the filesystem…");
   err = user_data_fs.mount(&user_data);
   if (err) {
-    Serial.println("Mount failed—reformatting…");
+    LOG_W("Mount failed, reformatting");
     int fmtErr = user_data_fs.reformat(&user_data);
     if (fmtErr) {
-      Serial.print("Reformat failed: ");
-      Serial.print(strerror(-fmtErr));
-      Serial.print(" (");
-      Serial.print(fmtErr);
-      Serial.println(")");
-      while (true) {}
+      LOG_E("Reformat failed: %s (%d)", strerror(-fmtErr), fmtErr);
+      while (true) { delay(1000); }
     }
     // Now that LittleFS has been formatted, mount again:
     if (user_data_fs.mount(&user_data) != 0) {
-      Serial.println("Mount after reformat still failed!");
-      while (true) {}
+      LOG_E("Mount after reformat still failed!");
+      while (true) { delay(1000); }
     }
   }
-  Serial.println("LittleFS mounted OK.");
+  LOG_I("LittleFS mounted OK.");
  }
 
 void my_print(lv_log_level_t level, const char * buf){
-  Serial.println(buf);
+  DebugSerial.println(buf);
 }
@@ -0,0 +1,95 @@
+/******************************************************************************
+ * @file    packed_image.cpp
+ * @author  Thomas Zoldowski
+ * @date    October 18, 2026
+ * @brief   Decoder and SDRAM cache for palette + PackBits images.
+ ******************************************************************************/
+
+#include "packed_image.h"
+#include <Arduino.h>
+#include "SDRAM.h"
+
+#define LOG_TAG   "IMG"
+#include "log.h"
+
+#define PACKED_IMAGE_CACHE_SLOTS 2
+
+// Decoded images, keyed by their packed source
+static struct {
+    const packed_image_t *src;
+    lv_image_dsc_t        dsc;
+} cache[PACKED_IMAGE_CACHE_SLOTS];
+
+/** @brief Expand a PackBits stream of palette indices into RGB565 pixels.
+ *  @return True if exactly w*h pixels were produced.
+ */
+static bool unpack(const packed_image_t *img, uint16_t *dst) {
+    const uint8_t *in  = img->data;
+    const uint8_t *end = img->data + img->data_len;
+    const uint16_t *pal = img->palette;
+    uint32_t left = (uint32_t)img->w * img->h;
+
+    while (in < end && left) {
+        uint8_t n = *in++;
+        if (n < 128) {                       // n+1 literal indices
+            uint32_t cnt = n + 1;
+            if (cnt > left || in + cnt > end) return false;
+            for (uint32_t i = 0; i < cnt; i++) {
+                uint8_t idx = *in++;
+                if (idx >= img->palette_len) return false;
+                *dst++ = pal[idx];
+            }
+            left -= cnt;
+        } else if (n > 128) {                // one index repeated 257-n times
+            uint32_t cnt = 257 - n;
+            if (cnt > left || in >= end || *in >= img->palette_len) return false;
+            uint16_t c = pal[*in++];
+            for (uint32_t i = 0; i < cnt; i++) *dst++ = c;
+            left -= cnt;
+        }                                    // 128 is a no-op
+    }
+    return left == 0;
+}
+
+/** @brief Decode a packed image into SDRAM once and return its descriptor.
+ *  @param img Packed image (from a generated asset file).
+ *  @return Cached RGB565 descriptor, or NULL on failure.
+ */
+const lv_image_dsc_t *packed_image_decode(const packed_image_t *img) {
+    for (auto &slot : cache) {
+        if (slot.src == img) return &slot.dsc;
+    }
+
+    for (auto &slot : cache) {
+        if (slot.src) continue;
+
+        uint32_t size = (uint32_t)img->w * img->h * sizeof(uint16_t);
+        uint16_t *pixels = (uint16_t *)SDRAM.malloc(size);
+        if (!pixels) {
+            LOG_E("SDRAM allocation failed");
+            return nullptr;
+        }
+        uint32_t t0 = micros();
+        if (!unpack(img, pixels)) {
+            LOG_E("corrupt packed image");
+            SDRAM.free(pixels);
+            return nullptr;
+        }
+        LOG_I("Decoded %ux%u image in %lu us", img->w, img->h, micros() - t0);
+
+        lv_image_dsc_t &dsc = slot.dsc;
+        memset(&dsc, 0, sizeof(dsc));
+        dsc.header.magic  = LV_IMAGE_HEADER_MAGIC;
+        dsc.header.cf     = LV_COLOR_FORMAT_RGB565;
+        dsc.header.w      = img->w;
+        dsc.header.h      = img->h;
+        dsc.header.stride = img->w * sizeof(uint16_t);
+        dsc.data_size     = size;
+        dsc.data          = (const uint8_t *)pixels;
+        slot.src = img;
+        return &dsc;
+    }
+
+    LOG_E("image cache full");
+    return nullptr;
+}
@@ -0,0 +1,421 @@
+/******************************************************************************
+ * @file    main_render.cpp
+ * @author  Thomas Zoldowski
+ * @date    October 18, 2026
+ * @brief   Host render benchmark of every screen (HAL_SIM, no display).
+ *
+ * Builds the shared header/footer and each screen against an in-memory
+ * 800x480 RGB565 display. The display is fed the same way the GIGA's is:
+ * CHUNK_LINES-row partial buffers, which flush_cb copies into a framebuffer.
+ * For every screen it reports:
+ *
+ *   create   time to build it, its LVGL objects and the LVGL heap it took
+ *   full     a full-screen redraw (the screen invalidated, lv_refr_now())
+ *   update   one loop() refresh: a new sensor pass, the screen's own update
+ *            call, the footer and the actuator LEDs, then the redraw of
+ *            whatever they invalidated
+ *
+ * Times are the fastest of the frames/ticks run. Timing lines use the
+ * microbenchmarks' format, so tools/bench_compare.py gates them against
+ * tools/bench_baseline.json (--env render). A SCREEN line per screen adds
+ * object count, heap and pixels flushed. A PNG of each screen is written
+ * after its first full redraw.
+ *
+ * Sensor readings come from the simulated bus (sim/sim_devices.h) on the
+ * virtual clock, so every run draws the same frames and the PNGs can be
+ * diffed. The times are host times: compare them with each other and with
+ * the baseline, not with the board.
+ *
+ *   pio run -e render
+ *   .pio/build/render/program --out render_out
+ *   .pio/build/render/program | python tools/bench_compare.py --env render
+ *
+ * Options:
+ *   --out DIR       where the PNGs go (default: render_out)
+ *   --frames N      full redraws per screen (default 20)
+ *   --ticks N       loop() refreshes per screen (default 50)
+ *   --filter TEXT   only screens whose name contains TEXT
+ *   --log           print the firmware's log as well
+ *   --help          print these options
+ ******************************************************************************/
+#include <lvgl.h>
+#include "hal.h"
+#include "config.h"
+#include "cycle_counter.h"
+#include "settings_storage.h"
+#include "ui_manager.h"
+#include "logic/sensor_manager.h"
+#include "logic/actuator_manager.h"
+#include "logic/history_log.h"
+#include "screens/screen_home.h"
+#include "screens/screen_sensors.h"
+#include "screens/screen_manual.h"
+#include "screens/screen_warnings.h"
+#include "screens/screen_history.h"
+#include "screens/screen_settings.h"
+#include "screens/screen_diagnostics.h"
+#include "sim/sim_bus.h"
+#include "sim/sim_devices.h"
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <dirent.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#define SCREEN_W     800
+#define SCREEN_H     480
+#define CHUNK_LINES  7        // as main.cpp
+
+// ========== What main.cpp provides on the board ==========
+unsigned long last_activity  = 0;
+int           selected_index = -1;
+
+void global_input_event_cb(lv_event_t *e) {
+    (void)e;
+}
+
+// Screen globals of ui_manager.cpp
+extern lv_obj_t *home_screen, *sensor_screen, *manual_screen;
+extern lv_obj_t *warnings_screen, *history_screen, *settings_screen;
+
+// ========== Display ==========
+// lv_display_set_buffers() rejects buffers off the draw buffer alignment
+alignas(LV_DRAW_BUF_ALIGN) static uint8_t buf1[SCREEN_W * CHUNK_LINES * 2];
+alignas(LV_DRAW_BUF_ALIGN) static uint8_t buf2[SCREEN_W * CHUNK_LINES * 2];
+static uint16_t framebuffer[SCREEN_W * SCREEN_H];
+static uint32_t flushed_px = 0;
+
+static void flush_cb(lv_display_t *disp, const lv_area_t *area, uint8_t *px) {
+    int32_t w = lv_area_get_width(area);
+    for (int32_t y = area->y1; y <= area->y2; y++) {
+        memcpy(&framebuffer[y * SCREEN_W + area->x1], px, w * 2);
+        px += w * 2;
+    }
+    flushed_px += w * lv_area_get_height(area);
+    lv_display_flush_ready(disp);
+}
+
+static uint32_t tick_cb() {
+    return hal_millis();
+}
+
+// ========== PNG ==========
+static uint32_t crc_table[256];
+
+static uint32_t crc32(uint32_t crc, const uint8_t *p, size_t n) {
+    if (!crc_table[1]) {
+        for (uint32_t i = 0; i < 256; i++) {
+            uint32_t c = i;
+            for (int k = 0; k < 8; k++) c = (c & 1) ? 0xEDB88320u ^ (c >> 1) : c >> 1;
+            crc_table[i] = c;
+        }
+    }
+    crc = ~crc;
+    while (n--) crc = crc_table[(crc ^ *p++) & 0xFF] ^ (crc >> 8);
+    return ~crc;
+}
+
+static void put_be32(uint8_t *p, uint32_t v) {
+    p[0] = (uint8_t)(v >> 24); p[1] = (uint8_t)(v >> 16); p[2] = (uint8_t)(v >> 8); p[3] = (uint8_t)v;
+}
+
+static void write_chunk(FILE *f, const char *type, const uint8_t *data, uint32_t len) {
+    uint8_t hdr[8];
+    put_be32(hdr, len);
+    memcpy(&hdr[4], type, 4);
+    uint32_t crc = crc32(crc32(0, &hdr[4], 4), data, len);
+    uint8_t tail[4];
+    put_be32(tail, crc);
+    fwrite(hdr, 1, 8, f);
+    fwrite(data, 1, len, f);
+    fwrite(tail, 1, 4, f);
+}
+
+/**
+ * @brief Save the framebuffer as an RGB PNG.
+ * The zlib stream uses stored (uncompressed) blocks: no library needed and
+ * still a valid PNG, at about 1.1 MB a screen.
+ */
+static bool write_png(const char *path) {
+    const size_t row   = 1 + SCREEN_W * 3;              // filter byte + RGB
+    const size_t raw_n = row * SCREEN_H;
+    uint8_t *raw = (uint8_t *)malloc(raw_n);
+    if (!raw) return false;
+    for (int y = 0; y < SCREEN_H; y++) {
+        uint8_t *r = &raw[y * row];
+        *r++ = 0;                                       // filter: none
+        for (int x = 0; x < SCREEN_W; x++) {
+            uint16_t c = framebuffer[y * SCREEN_W + x];
+            *r++ = (uint8_t)(((c >> 11) & 0x1F) * 255 / 31);
+            *r++ = (uint8_t)(((c >> 5)  & 0x3F) * 255 / 63);
+            *r++ = (uint8_t)((c & 0x1F) * 255 / 31);
+        }
+    }
+
+    size_t   blocks = (raw_n + 65534) / 65535;
+    size_t   z_n    = 2 + raw_n + blocks * 5 + 4;
+    uint8_t *z      = (uint8_t *)malloc(z_n);
+    if (!z) { free(raw); return false; }
+    size_t o = 0;
+    z[o++] = 0x78;
+    z[o++] = 0x01;
+    uint32_t a = 1, b = 0;                              // Adler-32
+    for (size_t at = 0; at < raw_n; at += 65535) {
+        uint16_t n = (uint16_t)(raw_n - at < 65535 ? raw_n - at : 65535);
+        z[o++] = at + n == raw_n;                       // BFINAL, BTYPE 00
+        z[o++] = (uint8_t)n;
+        z[o++] = (uint8_t)(n >> 8);
+        z[o++] = (uint8_t)~n;
+        z[o++] = (uint8_t)(~n >> 8);
+        memcpy(&z[o], &raw[at], n);
+        o += n;
+        for (size_t i = at; i < at + n; i++) {
+            a = (a + raw[i]) % 65521;
+            b = (b + a) % 65521;
+        }
+    }
+    put_be32(&z[o], (b << 16) | a);
+    o += 4;
+
+    FILE *f = fopen(path, "wb");
+    bool ok = f != nullptr;
+    if (ok) {
+        static const uint8_t sig[8] = { 0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n' };
+        uint8_t ihdr[13];
+        put_be32(&ihdr[0], SCREEN_W);
+        put_be32(&ihdr[4], SCREEN_H);
+        ihdr[8]  = 8;                                   // bits per channel
+        ihdr[9]  = 2;                                   // RGB
+        ihdr[10] = ihdr[11] = ihdr[12] = 0;
+        fwrite(sig, 1, 8, f);
+        write_chunk(f, "IHDR", ihdr, sizeof(ihdr));
+        write_chunk(f, "IDAT", z, (uint32_t)o);
+        write_chunk(f, "IEND", nullptr, 0);
+        ok = fclose(f) == 0;
+    }
+    free(z);
+    free(raw);
+    return ok;
+}
+
+// ========== Simulated bus ==========
+static SimTca9548 mux;
+static SimAht20   aht[3];
+static SimVl53l1x tof[2];
+static SimSen0322 o2;
+static SimTmp117  tmp117;
+
+/** @brief The composter's bus as wired on the board, reading an active batch. */
+static void build_bus() {
+    sim_i2c_attach(&mux, I2C_MUX_ADDR, SIM_MAIN_BUS);
+    sim_i2c_set_mux(&mux);
+    for (uint8_t i = 0; i < 3; i++) {
+        aht[i].temp_c = 58.0f - 2.5f * i;
+        aht[i].rh     = 62.0f;
+        aht[i].noise  = 0.3f;
+        sim_i2c_attach(&aht[i], 0x38, i);
+    }
+    for (uint8_t j = 0; j < 2; j++) {
+        tof[j].distance_cm = 64.0f;
+        tof[j].noise       = 1.0f;
+        sim_i2c_attach(&tof[j], 0x29, 3 + j);
+    }
+    o2.o2_percent = 14.5f;
+    o2.noise      = 0.1f;
+    sim_i2c_attach(&o2, 0x73, 5);
+    tmp117.temp_c = 28.0f;
+    sim_i2c_attach(&tmp117, 0x48, SIM_MAIN_BUS);
+}
+
+// ========== Screens ==========
+typedef struct {
+    const char  *name;
+    lv_obj_t  *(*create)();
+    lv_obj_t   **global;            // ui_manager.cpp's pointer, nullptr if none
+    void       (*update)(uint32_t tick);  // the screen's part of a loop() refresh; may be nullptr
+} RenderScreen;
+
+static void update_sensors(uint32_t tick)     { (void)tick; update_sensor_screen(); }
+static void update_diagnostics(uint32_t tick) { (void)tick; update_diagnostics_screen(); }
+static void update_history(uint32_t tick)     { (void)tick; update_history_screen(); }
+
+/** @brief A door warning every fourth refresh, as the acquisition thread adds them. */
+static void update_warnings(uint32_t tick) {
+    if (tick % 4 == 0) add_warning(tick % 8 ? "LOADING DOOR OPENED" : "LOADING DOOR CLOSED");
+}
+
+static const RenderScreen screens[] = {
+    { "home",        create_home_screen,           &home_screen,     nullptr            },
+    { "sensors",     create_sensor_screen,         &sensor_screen,   update_sensors     },
+    { "manual",      create_manual_control_screen, &manual_screen,   nullptr            },
+    { "warnings",    create_warnings_screen,       &warnings_screen, update_warnings    },
+    { "history",     create_history_screen,        &history_screen,  update_history     },
+    { "settings",    create_settings_screen,       &settings_screen, nullptr            },
+    { "diagnostics", create_diagnostics_screen,    nullptr,          update_diagnostics },
+};
+
+static FILE *out = stdout;
+
+static const char USAGE[] =
+    "usage: program [options]\n"
+    "  --out DIR       where the PNGs go (default: render_out)\n"
+    "  --frames N      full redraws per screen (default 20)\n"
+    "  --ticks N       loop() refreshes per screen (default 50)\n"
+    "  --filter TEXT   only screens whose name contains TEXT\n"
+    "  --log           print the firmware's log as well\n"
+    "  --help          print these options\n";
+
+static uint32_t count_objects(lv_obj_t *obj) {
+    uint32_t n = 1;
+    for (uint32_t i = 0; i < lv_obj_get_child_count(obj); i++) n += count_objects(lv_obj_get_child(obj, i));
+    return n;
+}
+
+static size_t heap_used() {
+    lv_mem_monitor_t mon;
+    lv_mem_monitor(&mon);
+    return mon.total_size - mon.free_size;
+}
+
+static void report(const char *screen, const char *what, uint32_t iters, uint32_t best_ns) {
+    fprintf(out, "BENCH: render_%s_%s iters=%lu ns/op=%.1f\n", screen, what, (unsigned long)iters, (double)best_ns);
+}
+
+/** @brief Build, draw and refresh one screen. */
+static void run_screen(lv_display_t *disp, const RenderScreen &s, const char *dir,
+                       uint32_t frames, uint32_t ticks) {
+    // Build; create_header() adds the screen's header buttons to the top layer
+    uint32_t top0  = count_objects(lv_layer_top());
+    size_t   heap0 = heap_used();
+    uint32_t c0    = cycle_count();
+    lv_obj_t *scr  = s.create();
+    uint32_t create_ns = cycles_to_ns(cycle_count() - c0);
+    size_t   heap  = heap_used() - heap0;
+    uint32_t objs  = count_objects(scr) + count_objects(lv_layer_top()) - top0;
+    if (s.global) *s.global = scr;
+
+    lv_screen_load(scr);
+    report(s.name, "create", 1, create_ns);
+
+    // Full redraws
+    uint32_t best = UINT32_MAX;
+    uint32_t full_px = 0;
+    for (uint32_t f = 0; f < frames; f++) {
+        lv_obj_invalidate(scr);
+        flushed_px = 0;
+        c0 = cycle_count();
+        lv_refr_now(disp);
+        uint32_t spent = cycles_to_ns(cycle_count() - c0);
+        if (spent < best) best = spent;
+        full_px = flushed_px;
+        if (f == 0) {
+            char path[256];
+            if (snprintf(path, sizeof(path), "%s/%s.png", dir, s.name) < (int)sizeof(path) && !write_png(path)) {
+                fprintf(stderr, "could not write %s\n", path);
+            }
+        }
+    }
+    report(s.name, "full", frames, best);
+
+    // loop() refreshes at the sensor rate
+    best = UINT32_MAX;
+    uint64_t update_px = 0;
+    for (uint32_t t = 0; t < ticks; t++) {
+        sim_advance_us((uint64_t)SENSOR_UPDATE_INTERVAL_MS * 1000);
+        sensor_manager_update();
+        history_record(hal_millis());
+
+        flushed_px = 0;
+        c0 = cycle_count();
+        if (s.update) s.update(t);
+        update_footer_status(Limit_Switch_get_warning_mask());
+        updateManualScreenLEDs(actuator_outputs());
+        lv_refr_now(disp);
+        uint32_t spent = cycles_to_ns(cycle_count() - c0);
+        if (spent < best) best = spent;
+        update_px += flushed_px;
+    }
+    report(s.name, "update", ticks, best);
+
+    fprintf(out, "SCREEN: %s objects=%lu heap=%lu full_px=%lu update_px=%lu\n", s.name,
+            (unsigned long)objs, (unsigned long)heap, (unsigned long)full_px,
+            (unsigned long)(ticks ? update_px / ticks : 0));
+    fflush(out);
+}
+
+/** @brief Remove the temporary /user and the files the firmware left in it. */
+static void remove_dir(const char *dir) {
+    DIR *d = opendir(dir);
+    if (!d) return;
+    char path[256];
+    while (struct dirent *e = readdir(d)) {
+        if (!strcmp(e->d_name, ".") || !strcmp(e->d_name, "..")) continue;
+        if (snprintf(path, sizeof(path), "%s/%s", dir, e->d_name) < (int)sizeof(path)) unlink(path);
+    }
+    closedir(d);
+    rmdir(dir);
+}
+
+int main(int argc, char **argv) {
+    const char *dir     = "render_out";
+    const char *filter  = nullptr;
+    uint32_t    frames  = 20;
+    uint32_t    ticks   = 50;
+    bool        verbose = false;
+    for (int i = 1; i < argc; i++) {
+        const char *a = argv[i];
+        bool more = i + 1 < argc;
+        if      (!strcmp(a, "--help") || !strcmp(a, "-h")) { fputs(USAGE, stdout); return 0; }
+        else if (!strcmp(a, "--out") && more)     dir     = argv[++i];
+        else if (!strcmp(a, "--frames") && more)  frames  = (uint32_t)strtoul(argv[++i], nullptr, 0);
+        else if (!strcmp(a, "--ticks") && more)   ticks   = (uint32_t)strtoul(argv[++i], nullptr, 0);
+        else if (!strcmp(a, "--filter") && more)  filter  = argv[++i];
+        else if (!strcmp(a, "--log"))             verbose = true;
+        else { fprintf(stderr, "unknown option %s (see --help)\n", a); return 2; }
+    }
+    if (frames == 0) frames = 1;
+    mkdir(dir, 0777);
+
+    // The firmware logs to stdout; results go to the real one unless --log
+    fflush(stdout);
+    out = fdopen(dup(STDOUT_FILENO), "w");
+    if (!out) { perror("stdout"); return 2; }
+    if (!verbose && !freopen("/dev/null", "w", stdout)) { perror("/dev/null"); return 2; }
+
+    char tmp[] = "/tmp/composter-render-XXXXXX";
+    if (!mkdtemp(tmp)) { perror("mkdtemp"); return 2; }
+    sim_reset(1, 1760800000u);
+    sim_fs_set_root(tmp);
+    build_bus();
+
+    loadConfig();
+    settings_init_from_config();
+    history_init();
+    sensor_manager_init();
+    Limit_Switch_Init();
+    sensor_manager_update();
+
+    lv_init();
+    lv_tick_set_cb(tick_cb);
+    lv_display_t *disp = lv_display_create(SCREEN_W, SCREEN_H);
+    lv_display_set_color_format(disp, LV_COLOR_FORMAT_RGB565);
+    lv_display_set_flush_cb(disp, flush_cb);
+    lv_display_set_buffers(disp, buf1, buf2, sizeof(buf1), LV_DISPLAY_RENDER_MODE_PARTIAL);
+
+    create_chrome();
+    int run = 0;
+    for (const RenderScreen &s : screens) {
+        if (filter && !strstr(s.name, filter)) continue;
+        run_screen(disp, s, dir, frames, ticks);
+        run++;
+    }
+
+    fclose(out);
+    remove_dir(tmp);
+    if (run == 0) {
+        fprintf(stderr, "no screen matches '%s'\n", filter ? filter : "");
+        return 2;
+    }
+    return 0;
+}
@@ -0,0 +1,377 @@
+/******************************************************************************
+ * @file    main_replay.cpp
+ * @author  Thomas Zoldowski
+ * @date    October 18, 2026
+ * @brief   Host replay of a field trace (logic/trace.h).
+ *
+ * Feeds the recorded inputs back through sensor_manager_apply(), the limit
+ * switches and actuator_manager on the virtual clock (HAL_SIM), each at
+ * the time it was recorded: raw passes into the level filter and the
+ * snapshot, switch levels onto the pins, control passes at the RTC time
+ * they ran with, remote triggers and config saves. A day of trace replays
+ * in well under a second.
+ *
+ * The replay starts at the first sync point (TRACE_STATE) with the
+ * actuators idle, after a config is known, and checks itself against the
+ * trace:
+ *
+ *   sync points       filter state, switches, outputs and trigger times
+ *                     must equal the recorded ones bit for bit
+ *   control passes    must see the snapshot pass the board saw
+ *   transitions       every actuator transition, in order, with the time
+ *                     difference to the recorded one (the board's timer
+ *                     latency; a host recording matches to the µs)
+ *
+ * Exit status is 1 if anything differed. Both files of a unit can be given
+ * in any order; consecutive ones are joined into one stream.
+ *
+ *   pio run -e replay
+ *   .pio/build/replay/program trace0.bin trace1.bin --csv passes.csv
+ *
+ * Options:
+ *   --csv FILE   one line per replayed pass: readings, fill level, switches,
+ *                outputs and the footer warning text
+ *   --log        print the firmware's log as it replays
+ *   --help       print these options
+ ******************************************************************************/
+#include "hal.h"
+#include "settings_storage.h"
+#include "sim/sim_bus.h"
+#include "logic/sensor_manager.h"
+#include "logic/actuator_manager.h"
+#include "logic/warning_log.h"
+#include "logic/trace.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <unistd.h>
+#include <vector>
+
+#define SWITCH_COUNT  5     // limit switches on D0..D4 (LIMIT_SWITCH_PINS in sensor_manager)
+
+typedef struct {
+    uint64_t t_us;          // trace time
+    uint8_t  outputs;
+} Transition;
+
+typedef struct {
+    std::vector<uint8_t> data;
+    uint32_t             seq;
+    const char          *path;
+} TraceFile;
+
+typedef struct {
+    uint32_t passes, switches, controls, triggers, configs, gaps, dropped;
+    uint32_t syncs, sync_checks, sync_diffs;
+    uint32_t control_diffs;
+    uint32_t door_openings;
+    uint32_t transitions_rec, transitions_rep, transition_diffs;
+    int64_t  worst_dt_us;
+    uint64_t span_us;
+    char     first_diff[160];
+} ReplayResult;
+
+static ReplayResult            res;
+static FILE                   *csv     = nullptr;
+static bool                    running = false;     // synced and replaying
+static int64_t                 offset  = 0;         // trace time - virtual time
+static uint8_t                 outputs = 0;         // as replayed, from the pins
+static std::vector<Transition> recorded, replayed;
+
+/** @brief Keep the first difference for the report. */
+static void differ(uint64_t t_us, const char *what) {
+    if (!res.first_diff[0]) snprintf(res.first_diff, sizeof(res.first_diff), "%.3f s: %s", t_us / 1e6, what);
+}
+
+/** @brief Actuator edges the replay produces, in trace time. */
+static void on_pin(uint8_t pin, bool high) {
+    for (uint8_t o = 0; o < ACT_OUT_COUNT; o++) {
+        if (pin != actuator_output_pin((ActuatorOutput)o)) continue;
+        uint8_t now = high ? (uint8_t)(outputs | 1u << o) : (uint8_t)(outputs & ~(1u << o));
+        if (now == outputs) return;
+        outputs = now;
+        if (running) replayed.push_back({ hal_micros() + offset, now });
+    }
+}
+
+/** @brief Compare the transitions of one synced stretch, then forget them. */
+static void compare_transitions() {
+    size_t n = std::min(recorded.size(), replayed.size());
+    for (size_t i = 0; i < n; i++) {
+        int64_t dt = (int64_t)(replayed[i].t_us - recorded[i].t_us);
+        if (recorded[i].outputs != replayed[i].outputs) {
+            char what[96];
+            snprintf(what, sizeof(what), "outputs 0x%02x recorded, 0x%02x replayed",
+                     recorded[i].outputs, replayed[i].outputs);
+            differ(recorded[i].t_us, what);
+            res.transition_diffs++;
+        } else if ((dt < 0 ? -dt : dt) > (res.worst_dt_us < 0 ? -res.worst_dt_us : res.worst_dt_us)) {
+            res.worst_dt_us = dt;
+        }
+    }
+    if (recorded.size() != replayed.size()) {
+        const Transition &t = recorded.size() > n ? recorded[n] : replayed[n];
+        differ(t.t_us, recorded.size() > n ? "transition missing from the replay"
+                                           : "transition only in the replay");
+        res.transition_diffs += (uint32_t)(std::max(recorded.size(), replayed.size()) - n);
+    }
+    res.transitions_rec += (uint32_t)recorded.size();
+    res.transitions_rep += (uint32_t)replayed.size();
+    recorded.clear();
+    replayed.clear();
+}
+
+static void set_switches(uint8_t levels) {
+    for (uint8_t i = 0; i < SWITCH_COUNT; i++) sim_pin_set(HAL_D(i), (levels >> i) & 1);
+    Limit_Switch_update();
+}
+
+/** @brief A running replay against a sync point: must match bit for bit. */
+static void check_state(const TraceRecord &rec) {
+    const TraceState &s    = rec.state;
+    SensorTraceState  mine = sensor_manager_trace_state();
+    uint8_t           sw   = 0;
+    for (uint8_t i = 0; i < SWITCH_COUNT; i++) {
+        if (limit_switch_states[i]) sw |= (uint8_t)(1u << i);
+    }
+    const char *what = nullptr;
+    if (mine.pass != s.sensor.pass)                                   what = "pass count";
+    else if (memcmp(&mine.fill, &s.sensor.fill, sizeof(FillFilter)))  what = "fill level filter";
+    else if (sw != s.switches)                                        what = "limit switches";
+    else if (actuator_outputs() != s.outputs)                         what = "actuator outputs";
+    else if (config.lastPumpEpoch != s.last_pump_epoch ||
+             config.lastBlowerEpoch != s.last_blower_epoch)           what = "program start times";
+    res.sync_checks++;
+    if (what) {
+        char buf[96];
+        snprintf(buf, sizeof(buf), "%s differ at a sync point", what);
+        differ(rec.t_us, buf);
+        res.sync_diffs++;
+    }
+}
+
+/** @brief Take over a sync point's state and start (or resume) replaying. */
+static void sync_to(const TraceRecord &rec) {
+    const TraceState &s = rec.state;
+    sensor_manager_restore(s.sensor);
+    set_switches(s.switches);
+    config.lastPumpEpoch   = s.last_pump_epoch;
+    config.lastBlowerEpoch = s.last_blower_epoch;
+    sim_set_epoch(s.epoch);
+    if (!running) {
+        offset = (int64_t)rec.t_us - (int64_t)hal_micros();
+        res.syncs++;
+    }
+    running = true;
+}
+
+static void write_csv(const TraceRecord &rec) {
+    SensorSnapshot s;
+    sensor_manager_get_snapshot(s);
+    char warn[128] = "";
+    warning_text(s.door_mask, warn, sizeof(warn));
+    fprintf(csv, "%.3f,%lu,%lu", rec.t_us / 1e6, (unsigned long)hal_epoch(), (unsigned long)s.pass);
+    for (int i = 0; i < 3; i++) fprintf(csv, ",%.2f", s.temp_c[i]);
+    for (int i = 0; i < 3; i++) fprintf(csv, ",%.2f", s.hum[i]);
+    fprintf(csv, ",%.2f,%.1f,%.1f,%.2f,%.2f,0x%02x,0x%02x,\"%s\"\n", s.o2, s.tof_cm[0], s.tof_cm[1],
+            s.fill_percent, s.board_temp_f, s.switches, actuator_outputs(), warn);
+}
+
+/** @brief Bring the virtual clock up to a record's time. */
+static void advance_to(uint64_t t_us) {
+    int64_t target = (int64_t)t_us - offset;
+    if (target > (int64_t)hal_micros()) sim_advance_us((uint64_t)target - hal_micros());
+}
+
+static void replay_record(const TraceRecord &rec, bool &have_config) {
+    if (rec.type == TRACE_CONFIG) {
+        // Trigger times are the scheduler's own output once it runs
+        uint32_t pump = config.lastPumpEpoch, blower = config.lastBlowerEpoch;
+        config = rec.config;
+        if (running) {
+            config.lastPumpEpoch   = pump;
+            config.lastBlowerEpoch = blower;
+        }
+        have_config = true;
+        res.configs++;
+        return;
+    }
+    if (rec.type == TRACE_GAP) {
+        res.gaps++;
+        res.dropped += rec.dropped;
+        compare_transitions();
+        running = false;
+        return;
+    }
+    if (!rec.synced) return;
+    if (rec.type == TRACE_STATE) {
+        if (running) {
+            advance_to(rec.t_us);
+            check_state(rec);
+            sync_to(rec);              // carry on from the board's state either way
+        } else if (have_config && rec.state.outputs == 0 && actuator_outputs() == 0) {
+            sync_to(rec);
+        }
+        return;
+    }
+    if (!running) return;
+
+    advance_to(rec.t_us);
+    switch (rec.type) {
+    case TRACE_PASS:
+        sensor_manager_apply(rec.raw);
+        res.passes++;
+        if (csv) write_csv(rec);
+        break;
+    case TRACE_SWITCH: {
+        uint8_t before = 0;
+        for (uint8_t i = 0; i < SWITCH_COUNT; i++) {
+            if (limit_switch_states[i]) before |= (uint8_t)(1u << i);
+        }
+        set_switches(rec.bits);
+        for (uint8_t opened = rec.bits & ~before; opened; opened &= opened - 1) res.door_openings++;
+        res.switches++;
+        break;
+    }
+    case TRACE_OUTPUT:
+        recorded.push_back({ rec.t_us, rec.bits });
+        break;
+    case TRACE_CONTROL: {
+        SensorSnapshot s;
+        sensor_manager_get_snapshot(s);
+        if (s.pass != rec.pass) {
+            differ(rec.t_us, "a control pass saw another snapshot");
+            res.control_diffs++;
+        }
+        sim_set_epoch(rec.epoch);
+        actuator_control_pass();
+        res.controls++;
+        break;
+    }
+    case TRACE_TRIGGER:
+        sim_set_epoch(rec.epoch);
+        actuator_trigger((ActuatorProgram)rec.bits);
+        res.triggers++;
+        break;
+    default:
+        break;
+    }
+}
+
+/** @brief Read a whole trace file. */
+static bool load(const char *path, TraceFile &f) {
+    FILE *in = fopen(path, "rb");
+    if (!in) { perror(path); return false; }
+    uint8_t buf[4096];
+    size_t  n;
+    while ((n = fread(buf, 1, sizeof(buf), in)) > 0) f.data.insert(f.data.end(), buf, buf + n);
+    fclose(in);
+    TraceReader r;
+    if (!trace_reader_init(r, f.data.data(), f.data.size(), true)) {
+        fprintf(stderr, "%s: not a trace file (version %d expected)\n", path, TRACE_VERSION);
+        return false;
+    }
+    const uint8_t *h = f.data.data();
+    f.seq  = (uint32_t)h[8] | (uint32_t)h[9] << 8 | (uint32_t)h[10] << 16 | (uint32_t)h[11] << 24;
+    f.path = path;
+    return true;
+}
+
+/** @brief Oldest file first, joined where the sequence numbers follow on; a gap where they don't. */
+static std::vector<uint8_t> join(std::vector<TraceFile> &files) {
+    std::sort(files.begin(), files.end(), [](const TraceFile &a, const TraceFile &b) { return a.seq < b.seq; });
+    std::vector<uint8_t> stream;
+    for (size_t i = 0; i < files.size(); i++) {
+        if (i > 0 && files[i].seq != files[i - 1].seq + 1) {
+            const uint8_t gap[3] = { TRACE_GAP, 0, 0 };
+            stream.insert(stream.end(), gap, gap + sizeof(gap));
+        }
+        stream.insert(stream.end(), files[i].data.begin() + TRACE_HEADER_LEN, files[i].data.end());
+    }
+    return stream;
+}
+
+static void print_report(double wall_s, int status) {
+    printf("Replayed %.1f s of trace in %.2f s wall (%.0fx real time)\n", res.span_us / 1e6, wall_s,
+           wall_s > 0 ? res.span_us / 1e6 / wall_s : 0.0);
+    printf("Inputs: %u passes, %u switch changes (%u doors opened), %u control passes, %u triggers, %u config saves\n",
+           (unsigned)res.passes, (unsigned)res.switches, (unsigned)res.door_openings, (unsigned)res.controls,
+           (unsigned)res.triggers, (unsigned)res.configs);
+    printf("Sync points: started from %u, %u checked, %u differed; %u gaps (%u records lost)\n",
+           (unsigned)res.syncs, (unsigned)res.sync_checks, (unsigned)res.sync_diffs, (unsigned)res.gaps,
+           (unsigned)res.dropped);
+    printf("Control passes on another snapshot than recorded: %u\n", (unsigned)res.control_diffs);
+    printf("Actuator transitions: %u recorded, %u replayed, %u differ, largest time difference %+lld us\n",
+           (unsigned)res.transitions_rec, (unsigned)res.transitions_rep, (unsigned)res.transition_diffs,
+           (long long)res.worst_dt_us);
+    if (res.first_diff[0]) printf("First difference at %s\n", res.first_diff);
+    if (status < 0)        printf("Trace ends in a damaged record (cut off by a reset?); replayed up to it\n");
+    if (!res.syncs)        printf("No sync point with the actuators idle: nothing replayed\n");
+}
+
+static const char USAGE[] =
+    "usage: program TRACE... [--csv FILE] [--log]\n"
+    "  TRACE        trace files of one unit (trace0.bin, trace1.bin), in any order\n"
+    "  --csv FILE   one line per replayed pass: readings, fill level, switches,\n"
+    "               outputs and the footer warning text\n"
+    "  --log        print the firmware's log as it replays\n";
+
+int main(int argc, char **argv) {
+    std::vector<TraceFile> files;
+    const char *csv_path = nullptr;
+    bool        verbose  = false;
+    for (int i = 1; i < argc; i++) {
+        const char *a = argv[i];
+        if (!strcmp(a, "--help") || !strcmp(a, "-h")) { fputs(USAGE, stdout); return 0; }
+        else if (!strcmp(a, "--csv") && i + 1 < argc) csv_path = argv[++i];
+        else if (!strcmp(a, "--log"))                 verbose  = true;
+        else if (a[0] == '-') { fprintf(stderr, "unknown option %s (see --help)\n", a); return 2; }
+        else {
+            files.emplace_back();
+            if (!load(a, files.back())) return 2;
+        }
+    }
+    if (files.empty()) { fputs(USAGE, stderr); return 2; }
+    if (csv_path) {
+        csv = fopen(csv_path, "w");
+        if (!csv) { perror(csv_path); return 2; }
+        fprintf(csv, "t_s,epoch,pass,temp0_c,temp1_c,temp2_c,hum0,hum1,hum2,o2,tof0_cm,tof1_cm,"
+                     "fill_pct,board_f,switches,outputs,warnings\n");
+    }
+    std::vector<uint8_t> stream = join(files);
+
+    // The firmware logs to stdout; keep it for the report unless --log
+    fflush(stdout);
+    int report_fd = dup(STDOUT_FILENO);
+    if (!verbose) freopen("/dev/null", "w", stdout);
+
+    auto wall0 = std::chrono::steady_clock::now();
+    sim_reset(1, 0);
+    sim_pin_on_write(on_pin);
+    Limit_Switch_Init();
+    initActuatorScheduler();
+
+    TraceReader r;
+    TraceRecord rec;
+    bool        have_config = false;
+    int         status;
+    trace_reader_init(r, stream.data(), stream.size(), false);
+    uint64_t first_us = UINT64_MAX;
+    while ((status = trace_read(r, rec)) == 1) {
+        replay_record(rec, have_config);
+        if (running && first_us == UINT64_MAX) first_us = rec.t_us;
+        if (running) res.span_us = rec.t_us - first_us;
+    }
+    compare_transitions();
+    double wall_s = std::chrono::duration<double>(std::chrono::steady_clock::now() - wall0).count();
+
+    fflush(stdout);
+    dup2(report_fd, STDOUT_FILENO);
+    close(report_fd);
+    if (csv) fclose(csv);
+
+    print_report(wall_s, status);
+    bool same = res.syncs && !res.sync_diffs && !res.control_diffs && !res.transition_diffs;
+    return same ? 0 : 1;
+}
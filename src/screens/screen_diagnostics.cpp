@@ -11,6 +11,11 @@
 #include "screens/screen_warnings.h"
 #include "logic/sensor_manager.h"
 #include "ui_manager.h"
+#include "ui_fonts.h"
+
+#define LOG_TAG   "DIAG"
+#define LOG_LEVEL LOG_LEVEL_UI
+#include "log.h"
 
 // Screen and label handles
 lv_obj_t* diag_screen = NULL;
@@ -23,7 +28,7 @@ static lv_obj_t* label_tof_status[2];  // VL53L1X sensors
  *  @return Pointer to the created diagnostics screen object.
  */
 lv_obj_t* create_diagnostics_screen(void) {
-    Serial.println("Creating Diagnostics Screen...");
+    LOG_I("Creating Diagnostics Screen...");
     diag_screen = lv_obj_create(NULL);
     lv_obj_set_style_bg_color(diag_screen, lv_color_black(), LV_PART_MAIN);
     lv_obj_set_style_bg_opa(diag_screen, LV_OPA_COVER, LV_PART_MAIN);
@@ -54,54 +59,54 @@ lv_obj_t* create_diagnostics_screen(void) {
     lv_obj_t *label_mux_title = lv_label_create(grid);
     lv_label_set_text(label_mux_title, "TCA9548A:");
     lv_obj_set_grid_cell(label_mux_title, LV_GRID_ALIGN_CENTER, 0, 1, LV_GRID_ALIGN_CENTER, 0, 1);
-    lv_obj_set_style_text_font(label_mux_title, &lv_font_montserrat_40, 0);
+    lv_obj_set_style_text_font(label_mux_title, UI_FONT_40, 0);
     lv_obj_set_style_text_color(label_mux_title, lv_color_hex(0x32c935), 0);
 
     label_status_mux = lv_label_create(grid);
     lv_obj_set_grid_cell(label_status_mux, LV_GRID_ALIGN_CENTER, 1, 1, LV_GRID_ALIGN_CENTER, 0, 1);
-    lv_obj_set_style_text_font(label_status_mux, &lv_font_montserrat_40, 0);
+    lv_obj_set_style_text_font(label_status_mux, UI_FONT_40, 0);
     lv_obj_set_style_text_color(label_status_mux, lv_color_hex(0x32c935), 0);
-    Serial.println("Creating Diagnostics Screen: Mux row created");
+    LOG_I("Creating Diagnostics Screen: Mux row created");
     // Create a row for each aht20 sensor
     for (uint8_t i = 0; i < 3; i++) {
         lv_obj_t *row = lv_label_create(grid);
         lv_label_set_text_fmt(row, "AHT20 #%d:", i + 1);
         lv_obj_set_grid_cell(row, LV_GRID_ALIGN_START, 0, 1, LV_GRID_ALIGN_CENTER, i+1, 1);
-        lv_obj_set_style_text_font(row, &lv_font_montserrat_40, 0);
+        lv_obj_set_style_text_font(row, UI_FONT_40, 0);
         lv_obj_set_style_text_color(row, lv_color_hex(0x32c935), 0);
 
         label_sensor_status[i] = lv_label_create(grid);
         lv_obj_set_grid_cell(label_sensor_status[i], LV_GRID_ALIGN_CENTER, 1, 1, LV_GRID_ALIGN_CENTER, i+1, 1);
-        lv_obj_set_style_text_font(label_sensor_status[i], &lv_font_montserrat_40, 0);
+        lv_obj_set_style_text_font(label_sensor_status[i], UI_FONT_40, 0);
         lv_obj_set_style_text_color(label_sensor_status[i], lv_color_hex(0x32c935), 0);
     }
-    Serial.println("Creating Diagnostics Screen: AHT20 sensor rows created");
+    LOG_I("Creating Diagnostics Screen: AHT20 sensor rows created");
     // Create 02 sensor row
     lv_obj_t *label_o2_title = lv_label_create(grid);
     lv_label_set_text(label_o2_title, "SEN0322:");
     lv_obj_set_grid_cell(label_o2_title, LV_GRID_ALIGN_CENTER, 0, 1, LV_GRID_ALIGN_CENTER, 6, 1);
-    lv_obj_set_style_text_font(label_o2_title, &lv_font_montserrat_40, 0);
+    lv_obj_set_style_text_font(label_o2_title, UI_FONT_40, 0);
     lv_obj_set_style_text_color(label_o2_title, lv_color_hex(0x32c935), 0);
 
     label_status_o2 = lv_label_create(grid);
     lv_obj_set_grid_cell(label_status_o2, LV_GRID_ALIGN_CENTER, 1, 1, LV_GRID_ALIGN_CENTER, 6, 1);
-    lv_obj_set_style_text_font(label_status_o2, &lv_font_montserrat_40, 0);
+    lv_obj_set_style_text_font(label_status_o2, UI_FONT_40, 0);
     lv_obj_set_style_text_color(label_status_o2, lv_color_hex(0x32c935), 0);
-    Serial.println("Creating Diagnostics Screen: O2 sensor row created");
+    LOG_I("Creating Diagnostics Screen: O2 sensor row created");
     // Create VL53L1X sensor rows (ports 4 and 5 on I2C Mux)
     for (uint8_t j = 0; j < 2; j++) {
         lv_obj_t *label_tof_title = lv_label_create(grid);
         lv_label_set_text_fmt(label_tof_title, "VL53L1X #%d:", j + 1);
         lv_obj_set_grid_cell(label_tof_title, LV_GRID_ALIGN_CENTER, 0, 1, LV_GRID_ALIGN_CENTER, 4 + j, 1);
-        lv_obj_set_style_text_font(label_tof_title, &lv_font_montserrat_40, 0);
+        lv_obj_set_style_text_font(label_tof_title, UI_FONT_40, 0);
         lv_obj_set_style_text_color(label_tof_title, lv_color_hex(0x32c935), 0);
 
         label_tof_status[j] = lv_label_create(grid);
         lv_obj_set_grid_cell(label_tof_status[j], LV_GRID_ALIGN_CENTER, 1, 1, LV_GRID_ALIGN_CENTER, 4 + j, 1);
-        lv_obj_set_style_text_font(label_tof_status[j], &lv_font_montserrat_40, 0);
+        lv_obj_set_style_text_font(label_tof_status[j], UI_FONT_40, 0);
         lv_obj_set_style_text_color(label_tof_status[j], lv_color_hex(0x32c935), 0);
     }
-    Serial.println("Creating Diagnostics Screen: VL53L1X sensor rows created");
+    LOG_I("Creating Diagnostics Screen: VL53L1X sensor rows created");
     return diag_screen;
 }
 
@@ -117,7 +122,10 @@ bool is_diagnostics_screen_active(void) {
  */
 void update_diagnostics_screen(void) {
 
-    ConnectionStatus status = sensor_manager_get_connection_status();
+    // From the acquisition snapshot; probing the bus here would stall LVGL
+    SensorSnapshot snap;
+    sensor_manager_get_snapshot(snap);
+    const ConnectionStatus &status = snap.status;
     // Update MUX status
     if (status.mux) {
         lv_label_set_text(label_status_mux, "Connected");
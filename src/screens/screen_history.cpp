@@ -7,34 +7,207 @@
 #include <Arduino.h>
 #include "screens/screen_history.h"
 #include "ui_manager.h"
-#include "screens/screen_warnings.h"
+#include "ui_fonts.h"
+#include "logic/history_log.h"
+
+#define LOG_TAG   "HIST"
+#define LOG_LEVEL LOG_LEVEL_UI
+#include "log.h"
+
+// About one chart point per pixel of width; the query never returns more
+#define HISTORY_CHART_W       760
+#define HISTORY_CHART_POINTS  720
 
 // Screen handle
 static lv_obj_t* history_screen = nullptr;
 
+static lv_obj_t *chart        = nullptr;
+static lv_obj_t *btnm_metric  = nullptr;
+static lv_obj_t *btnm_window  = nullptr;
+static lv_obj_t *label_range  = nullptr;
+static lv_obj_t *label_legend = nullptr;
+static lv_chart_series_t *series[3] = { nullptr };
+
+// Chart data lives here (ext arrays); LVGL reads it directly
+static int32_t points[3][HISTORY_CHART_POINTS];
+
+static HistoryMetric cur_metric = HIST_TEMP;
+static HistoryWindow cur_window = HIST_24H;
+static uint32_t shown_revision  = 0;
+static bool     shown_valid     = false;
+
+static const char *metric_map[] = { "Temp", "Hum", "O2", "Fill", "" };
+static const char *window_map[] = { "1h", "24h", "7d", "30d", "" };
+
+// Fixed-point scale and unit of each metric (see history_log.h)
+static const struct {
+    int32_t     scale;
+    const char *unit;
+} metric_info[HIST_METRIC_COUNT] = {
+    { 10,  "F"  },
+    { 10,  "%"  },
+    { 100, "%"  },
+    { 1,   "%"  },
+};
+
+static const uint32_t series_colors[3] = { 0xc41a1a, 0x42649f, 0x1a8f1f };
+
+/** @brief Query the selected metric/window and redraw the chart. */
+static void refresh_chart() {
+    uint8_t nseries = history_series_count(cur_metric);
+    int32_t vmin = INT32_MAX, vmax = INT32_MIN;
+    size_t n = 0;
+
+    for (uint8_t s = 0; s < 3; s++) {
+        bool used = s < nseries;
+        lv_chart_hide_series(chart, series[s], !used);
+        if (!used) continue;
+
+        n = history_query(cur_window, cur_metric, s, points[s],
+                          HISTORY_CHART_POINTS, LV_CHART_POINT_NONE);
+        for (size_t i = 0; i < n; i++) {
+            if (points[s][i] == LV_CHART_POINT_NONE) continue;
+            if (points[s][i] < vmin) vmin = points[s][i];
+            if (points[s][i] > vmax) vmax = points[s][i];
+        }
+    }
+
+    // Every used series has the same length for a given window
+    lv_chart_set_point_count(chart, n ? n : 1);
+    for (uint8_t s = 0; s < nseries; s++) {
+        lv_chart_set_ext_y_array(chart, series[s], points[s]);
+    }
+
+    const int32_t scale = metric_info[cur_metric].scale;
+    if (vmin > vmax) {
+        lv_chart_set_range(chart, LV_CHART_AXIS_PRIMARY_Y, 0, 100 * scale);
+        lv_label_set_text(label_range, "No data yet");
+    } else {
+        // Pad the range so flat lines don't sit on the frame
+        int32_t pad = (vmax - vmin) / 10 + scale;
+        lv_chart_set_range(chart, LV_CHART_AXIS_PRIMARY_Y, vmin - pad, vmax + pad);
+        if (scale == 1) {
+            lv_label_set_text_fmt(label_range, "Min %ld%s   Max %ld%s",
+                                  (long)vmin, metric_info[cur_metric].unit,
+                                  (long)vmax, metric_info[cur_metric].unit);
+        } else {
+            // LVGL's printf has no %f: print tenths as %d.%d
+            int32_t min10 = vmin * 10 / scale, max10 = vmax * 10 / scale;
+            lv_label_set_text_fmt(label_range, "Min %s%d.%d%s   Max %s%d.%d%s",
+                                  min10 < 0 ? "-" : "", (int)(abs(min10) / 10), (int)(abs(min10) % 10),
+                                  metric_info[cur_metric].unit,
+                                  max10 < 0 ? "-" : "", (int)(abs(max10) / 10), (int)(abs(max10) % 10),
+                                  metric_info[cur_metric].unit);
+        }
+    }
+
+    if (nseries > 1) lv_obj_clear_flag(label_legend, LV_OBJ_FLAG_HIDDEN);
+    else             lv_obj_add_flag(label_legend, LV_OBJ_FLAG_HIDDEN);
+
+    lv_chart_refresh(chart);
+    shown_revision = history_revision();
+    shown_valid    = true;
+}
+
+/** @brief Metric or window selection changed. */
+static void selector_event_cb(lv_event_t *e) {
+    lv_obj_t *btnm = lv_event_get_target_obj(e);
+    uint32_t id = lv_buttonmatrix_get_selected_button(btnm);
+    if (id == LV_BUTTONMATRIX_BUTTON_NONE) return;
+
+    if (btnm == btnm_metric) cur_metric = (HistoryMetric)id;
+    else                     cur_window = (HistoryWindow)id;
+    refresh_chart();
+}
+
+/** @brief Redraw on load in case history was stored while hidden. */
+static void history_load_cb(lv_event_t *e) {
+    LV_UNUSED(e);
+    if (!shown_valid || shown_revision != history_revision()) refresh_chart();
+}
+
+/** @brief Create a one-checked selector button row. */
+static lv_obj_t *create_selector(lv_obj_t *parent, const char **map, uint32_t checked,
+                                 int32_t x, int32_t w) {
+    lv_obj_t *btnm = lv_buttonmatrix_create(parent);
+    lv_buttonmatrix_set_map(btnm, map);
+    lv_buttonmatrix_set_button_ctrl_all(btnm, LV_BUTTONMATRIX_CTRL_CHECKABLE);
+    lv_buttonmatrix_set_one_checked(btnm, true);
+    lv_buttonmatrix_set_button_ctrl(btnm, checked, LV_BUTTONMATRIX_CTRL_CHECKED);
+    lv_obj_set_size(btnm, w, 64);
+    lv_obj_set_pos(btnm, x, 86);
+    lv_obj_set_style_pad_all(btnm, 4, 0);
+    lv_obj_set_style_bg_opa(btnm, LV_OPA_TRANSP, 0);
+    lv_obj_set_style_border_width(btnm, 0, 0);
+    lv_obj_set_style_text_font(btnm, UI_FONT_36, LV_PART_ITEMS);
+    lv_obj_set_style_bg_color(btnm, lv_color_hex(0x42649f), LV_PART_ITEMS | LV_STATE_CHECKED);
+    lv_obj_add_event_cb(btnm, selector_event_cb, LV_EVENT_VALUE_CHANGED, NULL);
+    return btnm;
+}
+
 /** @brief Create the History screen.
  *  @return Pointer to the created history screen object.
  */
 lv_obj_t* create_history_screen(void) {
-    Serial.println("[HS] Loading History Screen..."); // Debug
+    LOG_I("Loading History Screen...");
     history_screen = lv_obj_create(NULL);
     
-    // create header + footer
+    // register with the shared header + footer
     create_header(history_screen, "History");
-    create_footer(history_screen);
-    
 
     // Background color 
     lv_obj_set_style_bg_color(history_screen, lv_color_hex(0xc0c9d9), LV_PART_MAIN);
     lv_obj_set_style_bg_opa(history_screen, LV_OPA_COVER, LV_PART_MAIN);
     lv_obj_clear_flag(history_screen, LV_OBJ_FLAG_SCROLLABLE);
     lv_obj_set_scroll_dir(history_screen, LV_DIR_NONE);
-    
-    lv_obj_t *lbl = lv_label_create(history_screen);
-    lv_label_set_text(lbl, "$100 and i'll finish this screen");
-    lv_obj_set_style_text_font(lbl, &lv_font_montserrat_40, 0);
-    lv_obj_center(lbl);
 
-    Serial.println("[HS] Loading History Screen COMPLETE"); // Debug
+    // Selectors
+    btnm_metric = create_selector(history_screen, metric_map, cur_metric, 20, 440);
+    btnm_window = create_selector(history_screen, window_map, cur_window, 480, 300);
+
+    // Trend chart
+    chart = lv_chart_create(history_screen);
+    lv_obj_set_size(chart, HISTORY_CHART_W, 200);
+    lv_obj_set_pos(chart, 20, 156);
+    lv_chart_set_type(chart, LV_CHART_TYPE_LINE);
+    lv_chart_set_div_line_count(chart, 5, 8);
+    lv_obj_set_style_size(chart, 0, 0, LV_PART_INDICATOR);   // no point markers
+    lv_obj_set_style_line_width(chart, 2, LV_PART_ITEMS);
+    lv_obj_clear_flag(chart, LV_OBJ_FLAG_CLICKABLE);
+    for (uint8_t s = 0; s < 3; s++) {
+        series[s] = lv_chart_add_series(chart, lv_color_hex(series_colors[s]), LV_CHART_AXIS_PRIMARY_Y);
+    }
+
+    // Min/max of the window
+    label_range = lv_label_create(history_screen);
+    lv_obj_set_pos(label_range, 20, 362);
+    lv_obj_set_style_text_font(label_range, UI_FONT_36, 0);
+    lv_label_set_text(label_range, "");
+
+    // Sensor legend (temp/hum only)
+    label_legend = lv_label_create(history_screen);
+    lv_label_set_recolor(label_legend, true);
+    lv_label_set_text_static(label_legend, "#c41a1a S1#  #42649f S2#  #1a8f1f S3#");
+    lv_obj_set_style_text_font(label_legend, UI_FONT_36, 0);
+    lv_obj_align(label_legend, LV_ALIGN_TOP_RIGHT, -20, 362);
+
+    lv_obj_add_event_cb(history_screen, history_load_cb, LV_EVENT_SCREEN_LOAD_START, NULL);
+
+    LOG_I("Loading History Screen COMPLETE");
     return history_screen;
-}
\ No newline at end of file
+}
+
+/** @brief Redraw the chart if a new sample was stored since the last redraw.
+ *  Called from the main loop on each sensor update while the screen is active.
+ */
+void update_history_screen(void) {
+    if (shown_valid && shown_revision == history_revision()) return;
+    refresh_chart();
+}
+
+/** @brief Check if the history screen is currently active.
+ *  @return True if the history screen is active, false otherwise.
+ */
+bool is_history_screen_active(void) {
+    return history_screen && lv_scr_act() == history_screen;
+}
@@ -12,7 +12,9 @@
 #include "GVSU_Logo.h"
 #include "ui_manager.h"
 
-LV_IMG_DECLARE(GVSU_Logo);
+#define LOG_TAG   "HOME"
+#define LOG_LEVEL LOG_LEVEL_UI
+#include "log.h"
 
 extern void global_input_event_cb(lv_event_t * e);
 
@@ -25,9 +27,8 @@ static lv_obj_t* home_screen = nullptr;
  *  @param e Pointer to the event data.
  */
 static void screen_touch_cb(lv_event_t * e) {
-  Serial.println("▶ screen_touch_cb fired");
+  LOG_D("Touch, leaving home");
   handle_screen_selection("Sensor Overview");  // Set the next screen to Sensors
-  Serial.println("◀ screen_touch_cb returned");
 }
 
 /** @brief Create the Home screen.
@@ -42,13 +43,19 @@ lv_obj_t* create_home_screen() {
     lv_obj_set_style_bg_color(home_screen, lv_color_hex(0x0032A0), LV_PART_MAIN);
     lv_obj_set_style_bg_opa(home_screen, LV_OPA_COVER, LV_PART_MAIN);
 
-    // Create logo image object
-    lv_obj_t *logo = lv_img_create(home_screen);
-    lv_img_set_src(logo, &GVSU_Logo);
-    lv_obj_align(logo, LV_ALIGN_CENTER, 0, 0);
+    // Create logo image object (decoded into SDRAM once, drawn like a plain RGB565 image)
+    const lv_image_dsc_t *logo_img = packed_image_decode(&GVSU_Logo_packed);
+    if (logo_img) {
+        lv_obj_t *logo = lv_img_create(home_screen);
+        lv_img_set_src(logo, logo_img);
+        lv_obj_align(logo, LV_ALIGN_CENTER, 0, 0);
+    }
 
-    // Register the global input event callback
-    lv_obj_add_event_cb(home_screen, global_input_event_cb, LV_EVENT_ALL, NULL);
+    // Home is full-screen: hide the shared header/footer while it is shown
+    lv_obj_add_event_cb(home_screen, [](lv_event_t * e) {
+        LV_UNUSED(e);
+        ui_set_chrome_visible(false);
+    }, LV_EVENT_SCREEN_LOAD_START, NULL);
 
     // Add a full-screen transparent object for capturing touch
     lv_obj_t *touch_area = lv_obj_create(home_screen);
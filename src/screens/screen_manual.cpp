@@ -9,15 +9,23 @@
 #include "screens/screen_sensors.h"
 #include "screens/screen_warnings.h"
 #include "ui_manager.h"
+#include "ui_fonts.h"
 #include <string.h>
 #include <Arduino.h>
 #include "screens/screen_settings.h"
+#include "logic/actuator_manager.h"
+
+#define LOG_TAG   "MAN"
+#define LOG_LEVEL LOG_LEVEL_UI
+#include "log.h"
 
 static lv_obj_t* manual_screen = nullptr;
 lv_obj_t *logout_btn = nullptr; // Logout button handle
 
 // LED handles for each motor
 lv_obj_t *led[3];
+// Output each LED shows (same order as the motor rows)
+static const ActuatorOutput LED_OUTPUT[3] = { ACT_OUT_BLOWER1, ACT_OUT_BLOWER2, ACT_OUT_PUMP };
 
 /** @brief Callback for the logout button.
  *  This function is triggered when the user clicks the logout button.
@@ -29,8 +37,7 @@ lv_obj_t* create_manual_control_screen() {
     manual_screen = lv_obj_create(NULL);
     
     // Debug
-    Serial.println("Create manual screen");
-
+    LOG_I("Create manual screen");
     // Background color 
     lv_obj_set_style_bg_color(manual_screen, lv_color_hex(0xc0c9d9), LV_PART_MAIN);
     lv_obj_set_style_bg_opa(manual_screen, LV_OPA_COVER, LV_PART_MAIN);
@@ -38,7 +45,7 @@ lv_obj_t* create_manual_control_screen() {
     lv_obj_set_scroll_dir(manual_screen, LV_DIR_NONE);
     
     // create header
-    create_header(manual_screen, "Manual Override");
+    lv_obj_t *header_actions = create_header(manual_screen, "Manual Override");
     //==================================================================
     // ===== Motor List =====
     // A vertical flex container beneath the header
@@ -75,7 +82,7 @@ lv_obj_t* create_manual_control_screen() {
         // Motor name
         lv_obj_t *lbl = lv_label_create(row);
         lv_label_set_text(lbl, names[i]);
-        lv_obj_set_style_text_font(lbl, &lv_font_montserrat_48, 0);
+        lv_obj_set_style_text_font(lbl, UI_FONT_48, 0);
         lv_obj_set_style_text_color(lbl, lv_color_black(), 0);
     }
 
@@ -90,11 +97,11 @@ lv_obj_t* create_manual_control_screen() {
     lv_label_set_text(act_lbl, "ACTIVATE\nMANUAL\nBUTTON\nCONTROLS");
     lv_obj_set_style_text_align(act_lbl, LV_TEXT_ALIGN_CENTER, 0);
     lv_obj_center(act_lbl);
-    lv_obj_set_style_text_font(act_lbl, &lv_font_montserrat_48, 0);
+    lv_obj_set_style_text_font(act_lbl, UI_FONT_48, 0);
     
 
-    // ===== Logout Button =====
-    logout_btn = lv_btn_create(manual_screen);
+    // ===== Logout Button (in the shared header) =====
+    logout_btn = lv_btn_create(header_actions);
     lv_obj_set_size(logout_btn, 150, 60);
     lv_obj_align(logout_btn, LV_ALIGN_TOP_RIGHT, -20, 10);
     lv_obj_set_style_bg_color(logout_btn, lv_color_hex(0xff4d4d), 0); // red button
@@ -106,34 +113,26 @@ lv_obj_t* create_manual_control_screen() {
     lv_obj_t *logout_lbl = lv_label_create(logout_btn);
     lv_label_set_text(logout_lbl, "Logout");
     lv_obj_center(logout_lbl);
-    lv_obj_set_style_text_font(logout_lbl, &lv_font_montserrat_40, 0);
+    lv_obj_set_style_text_font(logout_lbl, UI_FONT_40, 0);
 
     return manual_screen;
 }
 
 /** @brief Update the manual screen LEDs based on the current state of the motors.
  *  This function updates the LED indicators for the motors and the logout button visibility based on the current state.
- *  @param pumpActive True if the pump is active, false otherwise.
- *  @param blowState The current state of the blowers (1 for blower 1, 2 for blower 2, 0 for both off).
+ *  @param outputs Actuator outputs switched on (actuator_outputs(), bit per ActuatorOutput).
  */
-void updateManualScreenLEDs(bool pumpActive, int blowState) {
+void updateManualScreenLEDs(uint8_t outputs) {
     if (!manual_screen || !lv_obj_is_valid(manual_screen)) return;
     for (int i = 0; i < 3; ++i) {
         if (!led[i] || !lv_obj_is_valid(led[i])) return;
     }
     if (!logout_btn || !lv_obj_is_valid(logout_btn)) return;
 
-    // pump LED
-    if (pumpActive)      lv_led_on(led[2]);
-    else                 lv_led_off(led[2]);
-
-    // blower1 LED
-    if (blowState == 1) lv_led_on(led[0]);
-    else                         lv_led_off(led[0]);
-
-    // blower2 LED
-    if (blowState == 2) lv_led_on(led[1]);
-    else                         lv_led_off(led[1]);
+    for (int i = 0; i < 3; ++i) {
+        if (outputs & (1u << LED_OUTPUT[i])) lv_led_on(led[i]);
+        else                                 lv_led_off(led[i]);
+    }
 
     if (check_pin() && logout_btn) {
       // unlocked → make sure it’s visible
@@ -13,9 +13,15 @@
 #include "screens/screen_manual.h"  
 #include "screens/screen_diagnostics.h" 
 #include "ui_manager.h"
+#include "ui_fonts.h"
 #include "logic/sensor_manager.h"
+#include "logic/telemetry.h"
 #include "screens/screen_settings.h"
 
+#define LOG_TAG   "SENS"
+#define LOG_LEVEL LOG_LEVEL_UI
+#include "log.h"
+
 // ================= extern prototype functions =================
 extern void global_input_event_cb(lv_event_t * e);
 
@@ -28,14 +34,8 @@ static lv_obj_t *label_bar_pct;  // dynamic percentage label
 static lv_obj_t *lbl_tmp117;
 
 static lv_obj_t *bar_level;  // Compost level bar
-// Configuration for TOF buffering
-static const float MAX_DEPTH_CM = 111.0f;         // maximum sensor range
-static const int   BUF_SIZE     = 5;              // number of samples to average
-static const float OUTLIER_THRESH_CM = 20.0f;      // ignore changes >20 cm
 static int bar_val;
-// Maximum measurable compost depth in cm
 
-int8_t o2Channel;
 // Threshold struct
 struct TempThresholds {
     float good_min;
@@ -90,16 +90,18 @@ static void update_sensor_values() {
         o2_whole, o2_decimal
         );
     #else
-        sensor_manager_update();
-        ConnectionStatus status = sensor_manager_get_connection_status();
+        // One consistent copy of the latest acquisition pass
+        SensorSnapshot snap;
+        sensor_manager_get_snapshot(snap);
+        const ConnectionStatus &status = snap.status;
         
         // AHT20 readings
         for (int i = 0; i < 3; i++) {
             if (label_temp[i] && label_hum[i]) {
                 if (status.sensor[i]) {
-                    float tempC = sensor_manager_get_temperature(i);
+                    float tempC = snap.temp_c[i];
                     float tempF = tempC * 9.0f/5.0f + 32.0f;
-                    float hum = sensor_manager_get_humidity(i);
+                    float hum = snap.hum[i];
                     int32_t t10 = roundf(tempF*10);
                     int32_t h10 = roundf(hum*10);
                     lv_label_set_text_fmt(label_temp[i], "%d.%d°F", t10/10, abs(t10%10));
@@ -113,7 +115,7 @@ static void update_sensor_values() {
         // O₂ reading
         if (label_o2) {
             if (status.o2) {
-                float o2 = sensor_manager_get_oxygen();
+                float o2 = snap.o2;
                 int32_t o210 = roundf(o2*10);
                 lv_label_set_text_fmt(label_o2, "%d.%d%%", o210/10, abs(o210%10));
             } else {
@@ -121,45 +123,10 @@ static void update_sensor_values() {
             }
         }
 
-        //Serial.println("VL53L1X sensors:");
-        // Compost-level bar with buffer and outlier logic
-        static float buf[BUF_SIZE];
-        static uint8_t buf_idx = 0, buf_cnt = 0, outlier_count = 0;
-        float raw = status.vl53[0] ? sensor_manager_get_tof_distance(0) : NAN;
-        if (!isnan(raw)) {
-            float avg = 0;
-            if (buf_cnt > 0) {
-                for (uint8_t k = 0; k < buf_cnt; k++) avg += buf[k];
-                avg /= buf_cnt;
-            }
-            if (buf_cnt == 0 || fabs(raw - avg) <= OUTLIER_THRESH_CM) {
-                // valid reading
-                buf[buf_idx] = raw;
-                buf_idx = (buf_idx + 1) % BUF_SIZE;
-                if (buf_cnt < BUF_SIZE) buf_cnt++;
-                outlier_count = 0;
-            } else {
-                // potential outlier
-                outlier_count++;
-                if (outlier_count >= BUF_SIZE) {
-                    // sustained new value: reset buffer
-                    for (uint8_t k = 0; k < BUF_SIZE; k++) buf[k] = raw;
-                    buf_cnt = BUF_SIZE;
-                    buf_idx = 0;
-                    outlier_count = 0;
-                }
-            }
-        }
-        // Compute filtered average
-        float avg_depth = 0;
-        if (buf_cnt > 0) {
-            for (uint8_t k = 0; k < buf_cnt; k++) avg_depth += buf[k];
-            avg_depth /= buf_cnt;
-        }
+        // Compost-level bar (filtered in sensor_manager)
+        float fill = snap.fill_percent;
         if (bar_level && label_bar_pct) {
-            // Map to bar 0..100
-            bar_val = (int)constrain((avg_depth / MAX_DEPTH_CM) * 100.0f, 0, 100);
-            bar_val = 100 - bar_val; // Invert: 0% = full, 100% = empty
+            bar_val = isnan(fill) ? 0 : (int)fill;
             lv_bar_set_value(bar_level, bar_val, LV_ANIM_OFF);
 
             // Update dynamic percentage label next to bar
@@ -181,7 +148,7 @@ static void update_sensor_values() {
         }
         lv_label_set_text(lbl_tmp117, hdr);
 
-        Serial.println("Sensor update completed.");
+        LOG_D("Sensor update completed.");
     #endif
 }
 
@@ -203,7 +170,7 @@ lv_obj_t* create_sensor_screen(void) {
     lv_obj_set_scroll_dir(sensor_screen, LV_DIR_NONE);
 
     // create header
-    create_header(sensor_screen, "Sensor Overview");
+    lv_obj_t *header_actions = create_header(sensor_screen, "Sensor Overview");
 
     // ===== Sensor Data Grid =====
     lv_obj_t *grid = lv_obj_create(sensor_screen);
@@ -231,13 +198,13 @@ lv_obj_t* create_sensor_screen(void) {
     lv_obj_t *label_temp_title = lv_label_create(grid);
     lv_label_set_text(label_temp_title, "Temp");
     lv_obj_set_grid_cell(label_temp_title, LV_GRID_ALIGN_CENTER, 1, 1, LV_GRID_ALIGN_CENTER, 0, 1);
-    lv_obj_set_style_text_font(label_temp_title, &lv_font_montserrat_40, 0);
+    lv_obj_set_style_text_font(label_temp_title, UI_FONT_40, 0);
     lv_obj_set_style_text_color(label_temp_title, lv_color_black(), 0);
 
     lv_obj_t *label_hum_title = lv_label_create(grid);
     lv_label_set_text(label_hum_title, "Hum");
     lv_obj_set_grid_cell(label_hum_title, LV_GRID_ALIGN_CENTER, 2, 1, LV_GRID_ALIGN_CENTER, 0, 1);
-    lv_obj_set_style_text_font(label_hum_title, &lv_font_montserrat_40, 0);
+    lv_obj_set_style_text_font(label_hum_title, UI_FONT_40, 0);
     lv_obj_set_style_text_color(label_hum_title, lv_color_black(), 0);
 
     // ----- Row Labels + Sensor Value Labels -----
@@ -246,19 +213,19 @@ lv_obj_t* create_sensor_screen(void) {
         lv_obj_t *label_sensor = lv_label_create(grid);
         lv_label_set_text_fmt(label_sensor, "Sensor %d", i + 1);
         lv_obj_set_grid_cell(label_sensor, LV_GRID_ALIGN_START, 0, 1, LV_GRID_ALIGN_CENTER, i+1, 1);
-        lv_obj_set_style_text_font(label_sensor, &lv_font_montserrat_48, 0);
+        lv_obj_set_style_text_font(label_sensor, UI_FONT_48, 0);
         lv_obj_set_style_text_color(label_sensor, lv_color_black(), 0);
 
         // Temp
         label_temp[i] = lv_label_create(grid);
         lv_obj_set_grid_cell(label_temp[i], LV_GRID_ALIGN_CENTER, 1, 1, LV_GRID_ALIGN_CENTER, i+1, 1);
-        lv_obj_set_style_text_font(label_temp[i], &lv_font_montserrat_48, 0);
+        lv_obj_set_style_text_font(label_temp[i], UI_FONT_48, 0);
         lv_obj_set_style_text_color(label_temp[i], lv_color_black(), 0);
 
         // Humidity
         label_hum[i] = lv_label_create(grid);
         lv_obj_set_grid_cell(label_hum[i], LV_GRID_ALIGN_CENTER, 2, 1, LV_GRID_ALIGN_CENTER, i+1, 1);
-        lv_obj_set_style_text_font(label_hum[i], &lv_font_montserrat_48, 0);
+        lv_obj_set_style_text_font(label_hum[i], UI_FONT_48, 0);
         lv_obj_set_style_text_color(label_hum[i], lv_color_black(), 0);
     }
     
@@ -274,12 +241,12 @@ lv_obj_t* create_sensor_screen(void) {
     lv_obj_t *label_o2_title = lv_label_create(grid);
     lv_label_set_text(label_o2_title, "O2 %");
     lv_obj_set_grid_cell(label_o2_title, LV_GRID_ALIGN_CENTER, 0, 1, LV_GRID_ALIGN_CENTER, 4, 1);
-    lv_obj_set_style_text_font(label_o2_title, &lv_font_montserrat_48, 0);
+    lv_obj_set_style_text_font(label_o2_title, UI_FONT_48, 0);
     lv_obj_set_style_text_color(label_o2_title, lv_color_black(), 0);
 
     label_o2 = lv_label_create(grid);
     lv_obj_set_grid_cell(label_o2, LV_GRID_ALIGN_CENTER, 1, 1, LV_GRID_ALIGN_CENTER, 4, 1);
-    lv_obj_set_style_text_font(label_o2, &lv_font_montserrat_48, 0);
+    lv_obj_set_style_text_font(label_o2, UI_FONT_48, 0);
     lv_obj_set_style_text_color(label_o2, lv_color_black(), 0);
 
    // Compost level bar on right
@@ -301,7 +268,7 @@ lv_obj_t* create_sensor_screen(void) {
     // Dynamic percentage label
     label_bar_pct = lv_label_create(sensor_screen);
     lv_label_set_text(label_bar_pct, "");
-    lv_obj_set_style_text_font(label_bar_pct, &lv_font_montserrat_40, 0);
+    lv_obj_set_style_text_font(label_bar_pct, UI_FONT_40, 0);
     
     // lbl_tmp117 = lv_label_create(sensor_screen);
 
@@ -310,11 +277,11 @@ lv_obj_t* create_sensor_screen(void) {
 
     // // Set style: white text, medium size font (adjust as needed)
     // lv_obj_set_style_text_color(lbl_tmp117, lv_color_white(), 0);
-    //lv_obj_set_style_text_font(lbl_tmp117, &lv_font_montserrat_36, 0);
+    //lv_obj_set_style_text_font(lbl_tmp117, UI_FONT_36, 0);
 
     
-    // USB “Diagnostics” button at top-left
-    lv_obj_t *btn_diag = lv_btn_create(sensor_screen);
+    // USB “Diagnostics” button at top-right of the shared header
+    lv_obj_t *btn_diag = lv_btn_create(header_actions);
 
    // lv_obj_align_to(lbl_tmp117, btn_diag, LV_ALIGN_OUT_LEFT_MID, -6, 0);
 
@@ -327,24 +294,26 @@ lv_obj_t* create_sensor_screen(void) {
     lv_obj_set_style_bg_opa  (btn_diag, LV_OPA_COVER,           LV_PART_MAIN);
     lv_obj_set_style_border_width(btn_diag, 0,                  LV_PART_MAIN);
     
-    // 3) Load diagnostics on click
+    // 3) Load diagnostics on click (built once, then reused)
     lv_obj_add_event_cb(btn_diag, [](lv_event_t* e) {
         LV_UNUSED(e);
-        lv_scr_load(create_diagnostics_screen());
+        static lv_obj_t *diag = nullptr;
+        if (!diag) diag = create_diagnostics_screen();
+        lv_scr_load(diag);
     }, LV_EVENT_CLICKED, NULL);
 
     // 4) USB symbol label
     lv_obj_t *lbl_diag = lv_label_create(btn_diag);
     lv_label_set_text(lbl_diag, LV_SYMBOL_USB);
     lv_obj_set_style_text_color(lbl_diag, lv_color_white(), 0);
-    lv_obj_set_style_text_font(lbl_diag, &lv_font_montserrat_40, 0);
+    lv_obj_set_style_text_font(lbl_diag, UI_FONT_40, 0);
     lv_obj_center(lbl_diag);
 
     // Now create lbl_tmp117 AFTER btn_diag exists
-    lbl_tmp117 = lv_label_create(sensor_screen);
+    lbl_tmp117 = lv_label_create(header_actions);
     lv_label_set_text(lbl_tmp117, "--F");
     lv_obj_set_style_text_color(lbl_tmp117, lv_color_white(), 0);
-    lv_obj_set_style_text_font(lbl_tmp117, &lv_font_montserrat_36, 0);
+    lv_obj_set_style_text_font(lbl_tmp117, UI_FONT_36, 0);
 
     // Now alignment will work properly
     lv_obj_align_to(lbl_tmp117, btn_diag, LV_ALIGN_OUT_LEFT_MID, -10, 0);
@@ -359,39 +328,17 @@ void update_sensor_screen() {
     update_sensor_values();
 }
 
-/** @brief Send sensor data to Serial for raspberry pi processing.
- * This function formats the sensor data and sends it over Serial.
- */
-void SensorDataToSerial() {
-
-    Serial.print("Data:");
-    for (int i = 0; i < 3; i++) {
-        float tempC = sensor_manager_get_temperature(i);
-        float tempF = tempC * 9.0f / 5.0f + 32.0f;    // convert to °F
-        Serial.print(tempF, 1);                      // print with 1 decimal
-        Serial.print(",");
-        float hum = sensor_manager_get_humidity(i);
-        Serial.print(hum);
-        Serial.print(",");
-    }
-
-    float o2 = sensor_manager_get_oxygen();
-    Serial.print(o2);
-    Serial.print(",");
-    Serial.println(bar_val);
-}
 static int old_camera_delay = -1;
 
-/** @brief Print camera delay through serial to raspberry pi.
- *  This function retrieves the camera delay and prints it to Serial if it has changed.
+/** @brief Send the camera delay to the raspberry pi.
+ *  This function retrieves the camera delay and sends it if it has changed.
  */
 void CameraDelayToSerial() {
-    // Print camera delay to Serial for debugging
+    // Tell the Pi how long to wait before taking a picture
     int camera_delay = getCameraDelay();
     
     if (camera_delay != old_camera_delay) {
         old_camera_delay = camera_delay;
-        Serial.print("Delay:");
-        Serial.println(camera_delay);
+        telemetry_send_camera_delay((uint16_t)camera_delay);
     }
 }
@@ -9,12 +9,17 @@
 #include "screens/screen_warnings.h"
 
 #include "ui_manager.h"
+#include "ui_fonts.h"
 #include <string.h>
 #include <Arduino.h>
 #include <time.h>
 #include "settings_storage.h"
 #include <stdint.h>
 
+#define LOG_TAG   "SET"
+#define LOG_LEVEL LOG_LEVEL_UI
+#include "log.h"
+
 
 // ---- Runtime threshold data ----
 static struct {
@@ -68,11 +73,27 @@ static lv_obj_t *modal_bg = NULL;
 static lv_obj_t *modal_ta = NULL;
 static lv_obj_t *modal_kb = NULL;
 static int        modal_field_id = -1;
-static lv_obj_t * modal_target_btn  = NULL;
+
+// Value labels per setting, so changes made elsewhere (e.g. by the Pi) show up
+static lv_obj_t *value_labels[SETTING_FIELD_COUNT][3] = {};
+
+// Accepted range per setting (minutes stay below 1092 so getters fit in uint16 seconds)
+static const struct { float min, max; } setting_range[SETTING_FIELD_COUNT] = {
+    { -100.0f, 300.0f },   // SETTING_TEMP_LOW
+    { -100.0f, 300.0f },   // SETTING_TEMP_HIGH
+    {    0.0f, 100.0f },   // SETTING_HUM_LOW
+    {    1.0f, 3600.0f },  // SETTING_BLOWER_SEC
+    {    1.0f, 3600.0f },  // SETTING_PUMP_SEC
+    {    1.0f, 1000.0f },  // SETTING_ACTIVATION_MIN
+    {    1.0f, 3600.0f },  // SETTING_CAMERA_DELAY_SEC
+    {    1.0f, 1000.0f },  // SETTING_SEND_INTERVAL_MIN
+};
 
 // Forward declarations
 static void change_pin_btn_cb(lv_event_t *e);
-static void show_modal_keypad(bool for_change);
+static void show_modal_keypad(void);
+static void create_modal_keypad(void);
+static void hide_modal_keypad(void);
 static void params_btn_cb(lv_event_t *e);
 static void modal_kb_event_cb(lv_event_t *e);
 static void config_time_btn_cb(lv_event_t *e);
@@ -91,7 +112,7 @@ void logout_cb(lv_event_t *e) {
  *  @return Pointer to the created settings screen object.
  */
 lv_obj_t* create_settings_screen() {
-    //Serial.println("[UI] Creating Settings screen"); // Debug
+    //DebugSerial.println("[UI] Creating Settings screen"); // Debug
 
     // Constants for layout
     const int HEADER_H   = 80;
@@ -113,7 +134,7 @@ lv_obj_t* create_settings_screen() {
     // Size & position between header & footer
     lv_obj_set_size(tabview, lv_pct(100), TABVIEW_H);
     lv_obj_align   (tabview, LV_ALIGN_TOP_MID, 0, HEADER_H);
-    lv_obj_set_style_text_font(tabview, &lv_font_montserrat_40, 0);
+    lv_obj_set_style_text_font(tabview, UI_FONT_40, 0);
 
     lv_obj_t * tab_buttons = lv_tabview_get_tab_bar(tabview);
     lv_obj_set_style_bg_color(tab_buttons, lv_palette_darken(LV_PALETTE_GREY, 3), 0);
@@ -125,9 +146,9 @@ lv_obj_t* create_settings_screen() {
     tab_3 = lv_tabview_add_tab(tabview, "Config");
     
     // Set font size for each tab
-    lv_obj_set_style_text_font(tab_1, &lv_font_montserrat_40, 0);
-    lv_obj_set_style_text_font(tab_2, &lv_font_montserrat_40, 0);
-    lv_obj_set_style_text_font(tab_3, &lv_font_montserrat_40, 0);
+    lv_obj_set_style_text_font(tab_1, UI_FONT_40, 0);
+    lv_obj_set_style_text_font(tab_2, UI_FONT_40, 0);
+    lv_obj_set_style_text_font(tab_3, UI_FONT_40, 0);
 
     // Set Background Color for each Tab
     lv_obj_set_style_bg_color(tab_1, lv_color_hex(0xc0c9d9), 0);
@@ -138,17 +159,26 @@ lv_obj_t* create_settings_screen() {
     lv_obj_set_style_bg_opa(tab_3, LV_OPA_COVER, 0);
 
     // Tab 1 screen ----------------------------------------------------------------------------------
-    //Serial.println("[UI] Initializing Tab 1");
+    //DebugSerial.println("[UI] Initializing Tab 1");
     setup_ui_tab1();
 
     // Tab 2 screen ----------------------------------------------------------------------------------
-    //Serial.println("[UI] Initializing Tab 2");
+    //DebugSerial.println("[UI] Initializing Tab 2");
     setup_ui_tab2();
     
     // Tab 3 screen ----------------------------------------------------------------------------------
     //
     setup_ui_tab3(); 
-    Serial.println("[UI] Initialized Tab 3");
+    LOG_I("Initialized Tab 3");
+
+    // Pre-build the keypad so opening it is just un-hiding it
+    create_modal_keypad();
+
+    // Don't leave the keypad over another screen (logout, inactivity timeout)
+    lv_obj_add_event_cb(settings_screen, [](lv_event_t *e) {
+        LV_UNUSED(e);
+        hide_modal_keypad();
+    }, LV_EVENT_SCREEN_UNLOAD_START, NULL);
 
     return settings_screen;
 }
@@ -178,7 +208,7 @@ void setup_ui_tab1()
     lv_obj_set_style_bg_opa(grid, LV_OPA_TRANSP, LV_PART_MAIN);
 
     if (pin_protection_enabled && !security_unlocked) {
-        //Serial.println("[UI] Creating lock overlay on Tab 1");
+        //DebugSerial.println("[UI] Creating lock overlay on Tab 1");
         lock_overlay_tab1 = lv_btn_create(tab_1);
         lv_obj_set_size(lock_overlay_tab1, lv_pct(95), lv_pct(95));
         lv_obj_align(lock_overlay_tab1, LV_ALIGN_CENTER, 0, 0);
@@ -205,7 +235,7 @@ void setup_ui_tab1()
         LV_GRID_ALIGN_CENTER, 0, 1);
 
         // styling
-        lv_obj_set_style_text_font(label_col, &lv_font_montserrat_40, 0);
+        lv_obj_set_style_text_font(label_col, UI_FONT_40, 0);
         lv_obj_set_style_text_color(label_col, lv_color_black(), 0);
     }
 
@@ -224,7 +254,7 @@ void setup_ui_tab1()
             LV_GRID_ALIGN_CENTER, row, 1);
 
         // Optionally style it
-        lv_obj_set_style_text_font(label_row, &lv_font_montserrat_40, 0);
+        lv_obj_set_style_text_font(label_row, UI_FONT_40, 0);
         lv_obj_set_style_text_color(label_row, lv_color_black(), 0);
         lv_obj_align(label_row, LV_ALIGN_CENTER, 0, 0);
         }
@@ -256,6 +286,7 @@ void setup_ui_tab1()
         lv_obj_t *lbl = lv_label_create(btn);
         lv_label_set_text(lbl, buf);
         lv_obj_center(lbl);
+        value_labels[SETTING_TEMP_HIGH][r] = lbl;
         intptr_t id = r*3 + 1;
         lv_obj_add_event_cb(btn, params_btn_cb, LV_EVENT_CLICKED, (void*)id);
         }
@@ -269,6 +300,7 @@ void setup_ui_tab1()
         lv_obj_t *lbl = lv_label_create(btn);
         lv_label_set_text(lbl, buf);
         lv_obj_center(lbl);
+        value_labels[SETTING_HUM_LOW][r] = lbl;
         intptr_t id = r*3 + 2;
         lv_obj_add_event_cb(btn, params_btn_cb, LV_EVENT_CLICKED, (void*)id);
         }
@@ -287,7 +319,7 @@ void setup_ui_tab1()
 void setup_ui_tab2() {
     // Change PIN button
     
-    Serial.println("Create Settings screen - Tab2"); // Debug
+    LOG_I("Creating Settings screen - Tab2");
     lv_obj_t *btn_cp = lv_btn_create(tab_2);
     lv_obj_set_size(btn_cp, 300, 100);
     lv_obj_align(btn_cp, LV_ALIGN_TOP_MID, 0, 40);
@@ -301,7 +333,7 @@ void setup_ui_tab2() {
 
     // Overlay
     if (pin_protection_enabled && !security_unlocked) {
-        Serial.println("[UI] Creating lock overlay"); // Debug
+        LOG_D("Creating lock overlay");
         lock_overlay_tab2 = lv_btn_create(tab_2);
         lv_obj_set_size(lock_overlay_tab2, lv_pct(100), lv_pct(100));
         lv_obj_align(lock_overlay_tab2, LV_ALIGN_TOP_LEFT, 0, 0);
@@ -313,7 +345,7 @@ void setup_ui_tab2() {
         lv_obj_t *lbl = lv_label_create(lock_overlay_tab2);
         lv_label_set_text(lbl, "Tap to Unlock");
         lv_obj_center(lbl);
-        Serial.println("[UI] Lock overlay created on Tab 2"); // Debug
+        LOG_D("Lock overlay created on Tab 2");
     }
 }
 
@@ -332,14 +364,14 @@ void setup_ui_tab3()
 
     const char *labels[] = {"Interval", "Blower Duration", "Pump Duration"};
 
-   Serial.println("[UI] Creating Settings screen - Tab3"); // Debug
+    LOG_I("Creating Settings screen - Tab3");
 
     lv_obj_t *grid = lv_obj_create(tab_3);
     lv_obj_set_size(grid, lv_pct(100), lv_pct(100));
     lv_obj_align(grid, LV_ALIGN_TOP_LEFT, 0, 0);
 
     if (pin_protection_enabled && !security_unlocked) {
-        //Serial.println("[UI] Creating lock overlay tab 3"); // Debug
+        //DebugSerial.println("[UI] Creating lock overlay tab 3"); // Debug
         lock_overlay_tab3 = lv_btn_create(tab_3);
         lv_obj_set_size(lock_overlay_tab3, lv_pct(100), lv_pct(100));
         lv_obj_align(lock_overlay_tab3, LV_ALIGN_CENTER, 0, 0);
@@ -389,7 +421,7 @@ void setup_ui_tab3()
     // Title row (Row 0 spanning 2 columns)
     lv_obj_t *title_lbl = lv_label_create(grid);
     lv_label_set_text(title_lbl, "Config On Times");
-    lv_obj_set_style_text_font(title_lbl, &lv_font_montserrat_40, 0);
+    lv_obj_set_style_text_font(title_lbl, UI_FONT_40, 0);
     lv_obj_set_style_text_align(title_lbl, LV_TEXT_ALIGN_LEFT, 0);
 
     // Span both columns: col 0 (start), span 2 columns
@@ -404,7 +436,7 @@ void setup_ui_tab3()
         // Left‐side label
         lv_obj_t *lbl = lv_label_create(grid);
         lv_label_set_text(lbl, labels[i]);
-        lv_obj_set_style_text_font(lbl, &lv_font_montserrat_36, 0);
+        lv_obj_set_style_text_font(lbl, UI_FONT_36, 0);
         lv_obj_set_grid_cell(lbl,
             LV_GRID_ALIGN_START, 0, 1,
             LV_GRID_ALIGN_CENTER, row, 1);
@@ -425,6 +457,7 @@ void setup_ui_tab3()
             snprintf(buf, sizeof(buf), "%d min", activation_interval_min);
             lv_label_set_text(btn_lbl, buf);
             lv_obj_center(btn_lbl);
+            value_labels[SETTING_ACTIVATION_MIN][0] = btn_lbl;
         }
         else {
             // Blower (i==1) or Pump (i==2)
@@ -445,6 +478,7 @@ void setup_ui_tab3()
             snprintf(buf, sizeof(buf), "%d sec", dur);
             lv_label_set_text(btn_lbl, buf);
             lv_obj_center(btn_lbl);
+            value_labels[idx == 0 ? SETTING_BLOWER_SEC : SETTING_PUMP_SEC][0] = btn_lbl;
         }
     }
     // ——— Row 4: separator line ———
@@ -459,7 +493,7 @@ void setup_ui_tab3()
     // ——— Row 5: Data To Server title ———
     lv_obj_t *title2 = lv_label_create(grid);
     lv_label_set_text(title2, "Data To Server");
-    lv_obj_set_style_text_font(title2, &lv_font_montserrat_40, 0);
+    lv_obj_set_style_text_font(title2, UI_FONT_40, 0);
     lv_obj_set_grid_cell(title2,
         LV_GRID_ALIGN_CENTER, 0, 2,
         LV_GRID_ALIGN_CENTER, 5, 1);
@@ -468,7 +502,7 @@ void setup_ui_tab3()
     // Left label
     lv_obj_t *lbl = lv_label_create(grid);
     lv_label_set_text(lbl, "Cam Delay");
-    lv_obj_set_style_text_font(lbl, &lv_font_montserrat_36, 0);
+    lv_obj_set_style_text_font(lbl, UI_FONT_36, 0);
     lv_obj_set_grid_cell(lbl,
         LV_GRID_ALIGN_START, 0, 1,
         LV_GRID_ALIGN_CENTER, 6, 1);
@@ -485,6 +519,7 @@ void setup_ui_tab3()
     snprintf(buf, sizeof(buf), "%d sec", camera_delay_sec);
     lv_label_set_text(btn_lbl, buf);
     lv_obj_center(btn_lbl);
+    value_labels[SETTING_CAMERA_DELAY_SEC][0] = btn_lbl;
     
 
     // ——— Row 7: Data Send Interval ———
@@ -492,7 +527,7 @@ void setup_ui_tab3()
     // Left label
     lv_obj_t *DataLabel = lv_label_create(grid);
     lv_label_set_text(DataLabel, "Send Interval");
-    lv_obj_set_style_text_font(DataLabel, &lv_font_montserrat_36, 0);
+    lv_obj_set_style_text_font(DataLabel, UI_FONT_36, 0);
     lv_obj_set_grid_cell(DataLabel,
         LV_GRID_ALIGN_START, 0, 1,
         LV_GRID_ALIGN_CENTER, 7, 1);
@@ -510,25 +545,24 @@ void setup_ui_tab3()
     snprintf(buf, sizeof(buf), "%d min", send_interval_min);
     lv_label_set_text(DataBtn_lbl, buf);
     lv_obj_center(DataBtn_lbl);
+    value_labels[SETTING_SEND_INTERVAL_MIN][0] = DataBtn_lbl;
 
 }
 
 /** @brief Callback for the camera delay button
  */
 static void config_camera_delay_cb(lv_event_t *e) {
-    lv_obj_t *btn = (lv_obj_t*)lv_event_get_target(e);
+    LV_UNUSED(e);
     modal_mode = MODAL_CAMERA_DELAY;
-    modal_target_btn = btn;
-    show_modal_keypad(false);
+    show_modal_keypad();
 }
 
 /** @brief Callback for the send interval button
  */
 static void config_send_interval_cb(lv_event_t *e) {
-    lv_obj_t *btn = (lv_obj_t*)lv_event_get_target(e);
+    LV_UNUSED(e);
     modal_mode = MODAL_SEND_INTERVAL;
-    modal_target_btn = btn;
-    show_modal_keypad(false);
+    show_modal_keypad();
 }
 
 /** @brief Callback for the keyboard event when the user presses "Enter/OK"
@@ -538,18 +572,16 @@ static void config_time_btn_cb(lv_event_t *e) {
     lv_obj_t *btn = (lv_obj_t *)lv_event_get_target(e);
     int index = (int)(intptr_t)lv_obj_get_user_data(btn); // 0=blower, 1=pump
     modal_mode = (index == 0) ? MODAL_BLOWER_TIME : MODAL_PUMP_TIME;
-    modal_target_btn = btn;
-    show_modal_keypad(false);
+    show_modal_keypad();
 }
 
 /** @brief Callback for the keyboard event when the user presses "Enter/OK"
     * This is where we handle the input from the keypad
     */
 static void config_interval_btn_cb(lv_event_t *e) {
-    lv_obj_t *btn = (lv_obj_t*)lv_event_get_target(e);
+    LV_UNUSED(e);
     modal_mode = MODAL_ACTIVATION_INTERVAL;
-    modal_target_btn = btn;
-    show_modal_keypad(false);
+    show_modal_keypad();
 }
 
 /** @brief Callback for the keyboard event when the user presses "Enter/OK"
@@ -559,10 +591,10 @@ void lock_overlay_cb(lv_event_t *e) {
     lv_obj_t *btn = lv_event_get_target_obj(e);
     // Disable further clicks immediately
     lv_obj_add_flag(btn, LV_OBJ_FLAG_CLICKABLE);
-    //Serial.println("[UI] Lock overlay tapped"); // Debug
+    //DebugSerial.println("[UI] Lock overlay tapped"); // Debug
     modal_mode = MODAL_PIN_UNLOCK;
-    show_modal_keypad(false);
-    Serial.println("[UI] Lock overlay tapped"); // Debug
+    show_modal_keypad();
+    LOG_D("Lock overlay tapped");
 }
 
 /** @brief Callback for the change PIN button
@@ -570,206 +602,111 @@ void lock_overlay_cb(lv_event_t *e) {
     */
 static void change_pin_btn_cb(lv_event_t *e) {
     modal_mode = MODAL_PIN_CHANGE;
-    show_modal_keypad(true);
-    Serial.println("[UI] Change PIN button tapped"); // Debug
+    show_modal_keypad();
+    LOG_D("Change PIN button tapped");
 }
 
 /** @brief Callback for the keyboard event when the user presses "Enter/OK"
     * This is where we handle the input from the keypad
     */
 static void params_btn_cb(lv_event_t * e) {
-    Serial.println("[UI] Params button clicked"); // Debug
+    LOG_D("Params button clicked");
     modal_mode      = MODAL_SENSOR_PARAM;
-    // remember who launched us and what field
-    modal_target_btn = (lv_obj_t *)lv_event_get_target(e);
+    // remember which field we are editing
     modal_field_id   = (int)(intptr_t)lv_event_get_user_data(e);
-
-    // translucent full‐screen bg
-    modal_bg = lv_obj_create(lv_scr_act());
-    lv_obj_set_size(modal_bg, lv_pct(100), lv_pct(100));
-    lv_obj_set_style_bg_color(modal_bg, lv_color_black(), 0);
-    lv_obj_set_style_bg_opa(modal_bg, LV_OPA_50, 0);
-
-    // create close button
-    lv_obj_t * close_btn = lv_btn_create(modal_bg);
-    lv_obj_set_size(close_btn, 100, 100);
-    lv_obj_align(close_btn, LV_ALIGN_TOP_RIGHT, -10, 10);
-
-    lv_obj_t * close_lbl = lv_label_create(close_btn);
-    lv_label_set_text(close_lbl, LV_SYMBOL_CLOSE);
-    lv_obj_center(close_lbl);
-    lv_obj_set_style_text_font(
-    close_lbl,
-    &lv_font_montserrat_48,
-    LV_PART_MAIN | LV_STATE_DEFAULT
-    );
-
-    // Hook its click event to delete the overlay
-    lv_obj_add_event_cb(close_btn, [](lv_event_t * e){
-        LV_UNUSED(e);
-        // Destroy the whole modal (bg → ta, kb, cancel get removed too)
-        if(modal_bg == nullptr) {
-            Serial.println("Error: modal_bg is NULL");
-            return;
-        }
-        lv_obj_del(modal_bg);
-        // Clear your globals
-        modal_bg         = nullptr;
-        modal_ta         = nullptr;
-        modal_kb         = nullptr;
-        modal_target_btn = nullptr;
-        modal_field_id   = -1;
-    }, LV_EVENT_CLICKED, NULL);
-
-    // create textarea for numeric input
-    modal_ta = lv_textarea_create(modal_bg);
-    lv_obj_set_width(modal_ta, 200);
-    lv_obj_align(modal_ta, LV_ALIGN_CENTER, 0, -90);
-    lv_textarea_set_one_line(modal_ta, true);
-    lv_textarea_set_max_length(modal_ta, 6);
-    lv_textarea_set_text(modal_ta, "");
-    lv_obj_set_style_text_font(
-    modal_ta,
-    &lv_font_montserrat_40,
-    LV_PART_MAIN | LV_STATE_DEFAULT
-    );
-    // create keyboard
-    modal_kb = lv_keyboard_create(modal_bg);
-    lv_keyboard_set_mode(modal_kb, LV_KEYBOARD_MODE_NUMBER);
-    lv_obj_set_style_text_font(
-    modal_kb,
-    &lv_font_montserrat_48,         // pick any size you’ve built into LVGL
-    LV_PART_MAIN | LV_STATE_DEFAULT
-    );
-    lv_obj_set_size(modal_kb, lv_pct(100), lv_pct(60));
-    lv_obj_align(modal_kb, LV_ALIGN_BOTTOM_MID, 0, 0);
-    lv_keyboard_set_textarea(modal_kb, modal_ta);
-
-    // when the user presses “Enter/OK”, we’ll get an LV_EVENT_READY
-    lv_obj_add_event_cb(modal_kb, modal_kb_event_cb, LV_EVENT_READY, NULL);
-    Serial.println("[UI] Params button callback executed"); // Debug
+    show_modal_keypad();
+    LOG_D("Params button callback executed");
 }
 
 /**
- * @brief Show a modal keypad for numeric input.
- * @param for_change If true, the keypad is used to change the PIN.
+ * @brief Build the modal keypad once, hidden.
+ * It lives on the top layer so it covers the shared header/footer; every
+ * edit just shows it, and closing hides it again instead of deleting it.
  */
-void show_modal_keypad(bool for_change) {
-    static bool modal_in_progress = false;
-    if (modal_in_progress) return;
-    modal_in_progress = true;
-    // Debug
-    Serial.println("show_modal_keypad");
-    // open kp
-    if (modal_bg) {
-        lv_obj_del(modal_bg);
-        modal_bg = nullptr;
-        modal_kb = nullptr;
-        modal_ta = nullptr;
-        modal_target_btn = nullptr;
-        modal_field_id = -1;
-    }
+static void create_modal_keypad(void) {
+    if (modal_bg) return;
 
-    lv_obj_t *parent = lv_scr_act();
-    if (!parent) {
-        Serial.println("Error: No active screen for modal parent!");
-        modal_in_progress = false;
-        return;
-    }
-
-    // Create a translucent full‐screen background
-    modal_bg = lv_obj_create(parent);
-
-    if (!modal_bg) {
-        Serial.println("Error: modal_bg is NULL");
-        return;
-    }
+    // Translucent full-screen background
+    modal_bg = lv_obj_create(lv_layer_top());
     lv_obj_set_size(modal_bg, lv_pct(100), lv_pct(100));
     lv_obj_set_style_bg_color(modal_bg, lv_color_black(), 0);
     lv_obj_set_style_bg_opa(modal_bg, LV_OPA_50, 0);
+    lv_obj_clear_flag(modal_bg, LV_OBJ_FLAG_SCROLLABLE);
+    lv_obj_add_flag(modal_bg, LV_OBJ_FLAG_HIDDEN);
 
     lv_obj_t *close_btn = lv_btn_create(modal_bg);
     lv_obj_set_size(close_btn, 100, 100);
     lv_obj_align(close_btn, LV_ALIGN_TOP_RIGHT, -10, 10);
 
     lv_obj_t *close_lbl = lv_label_create(close_btn);
-    lv_label_set_text(close_lbl, LV_SYMBOL_CLOSE);
+    lv_label_set_text_static(close_lbl, LV_SYMBOL_CLOSE);
     lv_obj_center(close_lbl);
-    lv_obj_set_style_text_font(close_lbl, &lv_font_montserrat_48, LV_PART_MAIN | LV_STATE_DEFAULT);
+    lv_obj_set_style_text_font(close_lbl, UI_FONT_48, LV_PART_MAIN | LV_STATE_DEFAULT);
 
     lv_obj_add_event_cb(close_btn, [](lv_event_t *e) {
-        if(modal_bg) {
-        lv_obj_del(modal_bg);
-        modal_bg = nullptr;
-        modal_kb = nullptr;
-        modal_ta = nullptr;
-        modal_target_btn = nullptr;
-        modal_field_id = -1;
-    }
+        LV_UNUSED(e);
+        hide_modal_keypad();
     }, LV_EVENT_CLICKED, NULL);
 
-    // create textarea for numeric input
+    // Textarea for numeric input
     modal_ta = lv_textarea_create(modal_bg);
     lv_obj_set_width(modal_ta, 200);
     lv_obj_align(modal_ta, LV_ALIGN_CENTER, 0, -90);
     lv_textarea_set_one_line(modal_ta, true);
     lv_textarea_set_max_length(modal_ta, 6);
-    lv_textarea_set_text(modal_ta, "");
-    lv_obj_set_style_text_font(modal_ta, &lv_font_montserrat_40, LV_PART_MAIN | LV_STATE_DEFAULT);
+    lv_obj_set_style_text_font(modal_ta, UI_FONT_40, LV_PART_MAIN | LV_STATE_DEFAULT);
 
-    // create keyboard
+    // Keyboard
     modal_kb = lv_keyboard_create(modal_bg);
     lv_keyboard_set_mode(modal_kb, LV_KEYBOARD_MODE_NUMBER);
-    lv_obj_set_style_text_font(modal_kb, &lv_font_montserrat_48, LV_PART_MAIN | LV_STATE_DEFAULT);
+    lv_obj_set_style_text_font(modal_kb, UI_FONT_48, LV_PART_MAIN | LV_STATE_DEFAULT);
     lv_obj_set_size(modal_kb, lv_pct(100), lv_pct(60));
     lv_obj_align(modal_kb, LV_ALIGN_BOTTOM_MID, 0, 0);
     lv_keyboard_set_textarea(modal_kb, modal_ta);
 
     lv_obj_add_event_cb(modal_kb, modal_kb_event_cb, LV_EVENT_READY, NULL);
-    Serial.println("[UI] Modal keypad shown"); // Debug
-    modal_in_progress = false;
+    lv_obj_add_event_cb(modal_kb, [](lv_event_t *e) {
+        LV_UNUSED(e);
+        hide_modal_keypad();
+    }, LV_EVENT_CANCEL, NULL);
+}
+
+/**
+ * @brief Show the modal keypad for numeric input.
+ * The caller sets modal_mode (and modal_field_id) first.
+ */
+static void show_modal_keypad(void) {
+    create_modal_keypad();
+
+    lv_textarea_set_text(modal_ta, "");
+    lv_keyboard_set_textarea(modal_kb, modal_ta);
+    lv_obj_move_foreground(modal_bg);
+    lv_obj_clear_flag(modal_bg, LV_OBJ_FLAG_HIDDEN);
+    LOG_D("Modal keypad shown");
+}
+
+/** @brief Hide the modal keypad and forget the field it was editing. */
+static void hide_modal_keypad(void) {
+    if (modal_bg) lv_obj_add_flag(modal_bg, LV_OBJ_FLAG_HIDDEN);
+    modal_field_id   = -1;
+    modal_mode       = MODAL_NONE;
 }
 
 /** @brief Callback for the modal keyboard event when the user presses "Enter/OK"
  * This is where we handle the input from the keypad
  */
 static void modal_kb_event_cb(lv_event_t *e) {
-    Serial.println("[UI] Modal keyboard event callback"); // Debug
-    if (!modal_bg || !modal_ta || !modal_kb) return;
+    LOG_D("Modal keyboard event callback");
+    if (!modal_bg || lv_obj_has_flag(modal_bg, LV_OBJ_FLAG_HIDDEN)) return;
     if (lv_event_get_code(e) != LV_EVENT_READY) return;
     const char *txt = lv_textarea_get_text(modal_ta);
-    Serial.println("[DEBUG] Modal keyboard input");
+    LOG_D("Modal keyboard input");
     switch (modal_mode) {
         case MODAL_SENSOR_PARAM: {
-            float new_val = atof(txt);
-            int sensor = modal_field_id / 3;
-            int field = modal_field_id % 3;
-            switch(field) {
-                case 0:
-                    sensor_thresh[sensor].temp_low  = new_val;
-                    config.temp_low[sensor]         = new_val;
-                    break;
-                case 1:
-                    sensor_thresh[sensor].temp_high = new_val;
-                    config.temp_high[sensor]        = new_val;
-                    break;
-                case 2:
-                    sensor_thresh[sensor].hum_low   = new_val;
-                    config.hum_low[sensor]          = new_val;
-                    break;
-            }
-
-            lv_obj_t * lbl = lv_obj_get_child((lv_obj_t *)modal_target_btn, 0);
-            static char buf[16];
-            if(field < 2) {  // temperature
-                snprintf(buf, sizeof(buf), "%.1f°F", new_val);
-            } else {         // humidity
-                snprintf(buf, sizeof(buf), "%.1f%%", new_val);
-            }
-            lv_label_set_text(lbl, buf);
-            lv_obj_center(lbl);
-            // **Persist the change immediately:**
-            saveConfig();
+            static const SettingField fields[3] = { SETTING_TEMP_LOW, SETTING_TEMP_HIGH, SETTING_HUM_LOW };
+            SettingField field = fields[modal_field_id % 3];
+            float new_val = constrain((float)atof(txt), setting_range[field].min, setting_range[field].max);
+            settings_set_value(field, modal_field_id / 3, new_val);
             break;
         }
         case MODAL_PIN_UNLOCK: {
@@ -799,7 +736,7 @@ static void modal_kb_event_cb(lv_event_t *e) {
                 lv_msgbox_add_title(mbox, "Error");
                 lv_msgbox_add_text(mbox, "Wrong PIN");
                 lv_obj_center(mbox);
-                lv_obj_set_style_text_font(mbox, &lv_font_montserrat_40, LV_PART_MAIN | LV_STATE_DEFAULT);
+                lv_obj_set_style_text_font(mbox, UI_FONT_40, LV_PART_MAIN | LV_STATE_DEFAULT);
                 lv_msgbox_add_close_button(mbox);
             }
             break;
@@ -813,94 +750,26 @@ static void modal_kb_event_cb(lv_event_t *e) {
             break;
         }
         case MODAL_BLOWER_TIME:
-        case MODAL_PUMP_TIME: {
-            int seconds = atoi(txt);
-            if (seconds <= 0) seconds = 1;  // sanity check
-
-            if (modal_mode == MODAL_BLOWER_TIME){
-                blower_duration_sec = seconds;
-                config.blower_duration_sec = seconds; // copy into config
-                saveConfig();
-            }
-            else{
-                pump_duration_sec = seconds;
-                config.pump_duration_sec = seconds;  // copy into config
-                saveConfig();
-            }
-
-            // Update button label
-            lv_obj_t *lbl = lv_obj_get_child(modal_target_btn, 0);
-            char buf[16];
-            snprintf(buf, sizeof(buf), "%d sec", seconds);
-            lv_label_set_text(lbl, buf);
-            lv_obj_center(lbl);
-            break;
-        }
-        case MODAL_ACTIVATION_INTERVAL: {
-            int minutes = atoi(txt);
-            if (minutes < 1) minutes = 1;
-
-            // Update your globals & config
-            activation_interval_min            = minutes;
-            config.activation_interval_min     = minutes;
-            saveConfig();
-
-            // Update the button’s label
-            lv_obj_t *lbl = lv_obj_get_child((lv_obj_t*)modal_target_btn, 0);
-            char buf[16];
-            snprintf(buf, sizeof(buf), "%d min", minutes);
-            lv_label_set_text(lbl, buf);
-            lv_obj_center(lbl);
-            break;
-            }
-        case MODAL_CAMERA_DELAY: {
-            int seconds = atoi(txt);
-            if (seconds < 1) seconds = 1;
-
-            // Update your globals & config
-            camera_delay_sec            = seconds;
-            config.camera_delay_sec     = seconds;
-            saveConfig();
-
-            // Update the button’s label
-            lv_obj_t *lbl = lv_obj_get_child((lv_obj_t*)modal_target_btn, 0);
-            char buf[16];
-            snprintf(buf, sizeof(buf), "%d s", seconds);
-            lv_label_set_text(lbl, buf);
-            lv_obj_center(lbl);
-            break;
-        }
-
+        case MODAL_PUMP_TIME:
+        case MODAL_ACTIVATION_INTERVAL:
+        case MODAL_CAMERA_DELAY:
         case MODAL_SEND_INTERVAL: {
-            int minutes = atoi(txt);
-            if (minutes < 1) minutes = 1;
-
-            // Update your globals & config
-            send_interval_min            = minutes;
-            config.send_interval_min     = minutes;
-            saveConfig();
-
-            // Update the button’s label
-            lv_obj_t *lbl = lv_obj_get_child((lv_obj_t*)modal_target_btn, 0);
-            char buf[16];
-            snprintf(buf, sizeof(buf), "%d min", minutes);
-            lv_label_set_text(lbl, buf);
-            lv_obj_center(lbl);
+            SettingField field =
+                modal_mode == MODAL_BLOWER_TIME         ? SETTING_BLOWER_SEC :
+                modal_mode == MODAL_PUMP_TIME           ? SETTING_PUMP_SEC :
+                modal_mode == MODAL_ACTIVATION_INTERVAL ? SETTING_ACTIVATION_MIN :
+                modal_mode == MODAL_CAMERA_DELAY        ? SETTING_CAMERA_DELAY_SEC :
+                                                          SETTING_SEND_INTERVAL_MIN;
+            // Out-of-range entries are clamped (e.g. 0 becomes 1)
+            float value = constrain((float)atoi(txt), setting_range[field].min, setting_range[field].max);
+            settings_set_value(field, 0, value);
             break;
         }
         default:
             break;
     }
 
-    if (modal_bg) {
-        lv_obj_del(modal_bg); // This deletes modal_bg and all its children (modal_kb, modal_ta, etc.)
-        modal_bg = nullptr;
-        modal_kb = nullptr;
-        modal_ta = nullptr;
-        modal_target_btn = nullptr;
-        modal_field_id = -1;
-    }
-    modal_mode = MODAL_NONE; // Reset modal mode
+    hide_modal_keypad();
 }
 
 /**
@@ -967,6 +836,102 @@ uint16_t getHumLowThreshold(int sensor_id) {
     // returns the current numeric value of the low humidity threshold
     return sensor_thresh[sensor_id].hum_low;
 }
+/** @brief Show a setting's current value on its button label, if the label exists. */
+static void refresh_value_label(SettingField field, uint8_t index) {
+    lv_obj_t *lbl = value_labels[field][index];
+    if (!lbl) return;
+
+    char buf[16];
+    float v = settings_get_value(field, index);
+    switch (field) {
+        case SETTING_TEMP_LOW:
+        case SETTING_TEMP_HIGH:         snprintf(buf, sizeof(buf), "%.1f°F", v); break;
+        case SETTING_HUM_LOW:           snprintf(buf, sizeof(buf), "%.1f%%", v); break;
+        case SETTING_ACTIVATION_MIN:
+        case SETTING_SEND_INTERVAL_MIN: snprintf(buf, sizeof(buf), "%d min", (int)v); break;
+        default:                        snprintf(buf, sizeof(buf), "%d sec", (int)v); break;
+    }
+    lv_label_set_text(lbl, buf);
+    lv_obj_center(lbl);
+}
+
+/**
+ * @brief Change one setting, persist it and update the Settings screen.
+ * @param field Which setting.
+ * @param index Sensor (0-2) for threshold settings, otherwise 0.
+ * @param value New value in the setting's display unit (°F, %, sec or min).
+ * @return False if the field/index is invalid or the value is out of range.
+ */
+bool settings_set_value(SettingField field, uint8_t index, float value) {
+    if (field >= SETTING_FIELD_COUNT || index >= 3) return false;
+    if (field > SETTING_HUM_LOW && index != 0) return false;
+    if (isnan(value) || value < setting_range[field].min || value > setting_range[field].max) return false;
+
+    int whole = (int)value;
+    switch (field) {
+        case SETTING_TEMP_LOW:
+            sensor_thresh[index].temp_low  = value;
+            config.temp_low[index]         = value;
+            break;
+        case SETTING_TEMP_HIGH:
+            sensor_thresh[index].temp_high = value;
+            config.temp_high[index]        = value;
+            break;
+        case SETTING_HUM_LOW:
+            sensor_thresh[index].hum_low   = value;
+            config.hum_low[index]          = value;
+            break;
+        case SETTING_BLOWER_SEC:
+            blower_duration_sec            = whole;
+            config.blower_duration_sec     = whole;
+            break;
+        case SETTING_PUMP_SEC:
+            pump_duration_sec              = whole;
+            config.pump_duration_sec       = whole;
+            break;
+        case SETTING_ACTIVATION_MIN:
+            activation_interval_min        = whole;
+            config.activation_interval_min = whole;
+            break;
+        case SETTING_CAMERA_DELAY_SEC:
+            camera_delay_sec               = whole;
+            config.camera_delay_sec        = whole;
+            break;
+        case SETTING_SEND_INTERVAL_MIN:
+            send_interval_min              = whole;
+            config.send_interval_min       = whole;
+            break;
+        default:
+            return false;
+    }
+
+    // Persist the change immediately
+    saveConfig();
+    refresh_value_label(field, index);
+    return true;
+}
+
+/**
+ * @brief Read one setting.
+ * @param field Which setting.
+ * @param index Sensor (0-2) for threshold settings, otherwise 0.
+ * @return The value in the setting's display unit, or NAN if invalid.
+ */
+float settings_get_value(SettingField field, uint8_t index) {
+    if (index >= 3) return NAN;
+    switch (field) {
+        case SETTING_TEMP_LOW:          return sensor_thresh[index].temp_low;
+        case SETTING_TEMP_HIGH:         return sensor_thresh[index].temp_high;
+        case SETTING_HUM_LOW:           return sensor_thresh[index].hum_low;
+        case SETTING_BLOWER_SEC:        return blower_duration_sec;
+        case SETTING_PUMP_SEC:          return pump_duration_sec;
+        case SETTING_ACTIVATION_MIN:    return activation_interval_min;
+        case SETTING_CAMERA_DELAY_SEC:  return camera_delay_sec;
+        case SETTING_SEND_INTERVAL_MIN: return send_interval_min;
+        default:                        return NAN;
+    }
+}
+
 /**
  * @brief Initialize settings from the configuration.
  * This function copies sensor thresholds, PIN, lock state, and blower/pump times
@@ -6,7 +6,9 @@
  ******************************************************************************/
 
 #include "screens/screen_warnings.h"
+#include "logic/warning_log.h"
 #include "ui_manager.h"
+#include "ui_fonts.h"
 
 #include <time.h>
 #include <lvgl.h>
@@ -14,13 +16,7 @@
 
 static void warnings_table_draw_cb(lv_event_t * e);
 
-// warning screen
-// Max number of warnings we keep in memory
-#define MAX_WARNINGS 20
-
-// Storage for text so table cells point to valid memory
-static char ts_buf    [MAX_WARNINGS+1][32];
-static char desc_buf  [MAX_WARNINGS+1][64];
+// warning screen: rows 1..n show warning_log entries 0..n-1, newest first
 
 // LVGL objects
 static lv_obj_t * warnings_table  = nullptr;
@@ -30,9 +26,6 @@ const int FOOTER_H  = 60;
 const int SCREEN_H  = 480;
 const int TABLE_H   = SCREEN_H - HEADER_H - FOOTER_H;
 
-// How many warnings we’ve added so far
-static int warning_count = 0;
-
 /** @brief Add a warning to the warnings table.
  *  This function adds a new warning to the table, updating the display and managing the warning count.
  *  @param desc The description of the warning.
@@ -118,7 +111,7 @@ lv_obj_t* create_warnings_screen() {
     // Size & position between header and footer
     lv_obj_set_size(warnings_table, lv_pct(100), TABLE_H);
     lv_obj_align   (warnings_table, LV_ALIGN_TOP_MID, 0, HEADER_H);
-    lv_obj_set_style_text_font(warnings_table, &lv_font_montserrat_36, 0);
+    lv_obj_set_style_text_font(warnings_table, UI_FONT_36, 0);
 
     // Style the table
     lv_obj_add_event_cb(warnings_table, warnings_table_draw_cb, LV_EVENT_DRAW_TASK_ADDED, NULL);
@@ -137,22 +130,9 @@ lv_obj_t* create_warnings_screen() {
  *  @param label The label to update with the formatted string.
  * */
 void format_warnings(uint32_t mask, char *buf, size_t buf_sz, lv_obj_t *label) {
-    if(mask == WARN_NONE) {
-        snprintf(buf, buf_sz, "ALL SYSTEMS NOMINAL");
+    if(!warning_text(mask, buf, buf_sz)) {
         lv_obj_set_style_text_color(label, lv_color_hex(0x094211), 0);
-        return;
     }
-    buf[0] = '\0';
-    bool first = true;
-    auto append = [&](const char* msg) {
-        if(!first) strncat(buf, ", ", buf_sz - strlen(buf) - 1);
-        strncat(buf, msg, buf_sz - strlen(buf) - 1);
-        first = false;
-    };
-    if(mask & WARN_FRONT_DOOR)   append("FRONT UNLOADING DOOR OPEN");
-    if(mask & WARN_BACK_DOOR)    append("BACK UNLOADING DOOR OPEN");
-    if(mask & WARN_LOADING_DOOR) append("LOADING DOOR OPEN");
-    if(mask & WARN_HIGH_TEMP)    append("HIGH TEMP");
 }
 
 /** @brief Add a warning to the warnings table.
@@ -162,35 +142,19 @@ void format_warnings(uint32_t mask, char *buf, size_t buf_sz, lv_obj_t *label) {
 void add_warning(const char *description) {
     if(!warnings_table) return;
 
-    // 1) Generate current time “HH:MM:SS” into a temporary buffer
-    char new_ts[16];
-    time_t now = time(NULL);
-    struct tm tm_info;
-    localtime_r(&now, &tm_info);
-    strftime(new_ts, sizeof(new_ts), "%H:%M:%S", &tm_info);
+    // 1) Stamp it and put it at the top of the history
+    warning_log_add(description, time(NULL));
 
     // 2) If not full yet, grow the table by one row
-    if(warning_count < MAX_WARNINGS) {
-        warning_count++;
-        lv_table_set_row_cnt(warnings_table, warning_count + 1); // +1 for header
+    int count = warning_log_count();
+    if((int)lv_table_get_row_cnt(warnings_table) != count + 1) {
+        lv_table_set_row_cnt(warnings_table, count + 1); // +1 for header
     }
 
-    // 3) Shift existing entries down one row (1→2, 2→3, …)
-    //    If at capacity, row MAX_WARNINGS is dropped
-    for(int i = warning_count; i >= 2; --i) {
-        strcpy(ts_buf[i],   ts_buf[i - 1]);
-        strcpy(desc_buf[i], desc_buf[i - 1]);
-    }
-
-    // 4) Insert the new entry at row 1
-    strcpy(ts_buf[1], new_ts);
-    strncpy(desc_buf[1], description, sizeof(desc_buf[0]) - 1);
-    desc_buf[1][sizeof(desc_buf[0]) - 1] = '\0';
-
-    // 5) Refresh the visible rows (rows 1..warning_count)
-    for(int r = 1; r <= warning_count; ++r) {
-        lv_table_set_cell_value(warnings_table, r, 0, ts_buf[r]);
-        lv_table_set_cell_value(warnings_table, r, 1, desc_buf[r]);
+    // 3) Refresh the visible rows (rows 1..count)
+    for(int r = 1; r <= count; ++r) {
+        lv_table_set_cell_value(warnings_table, r, 0, warning_log_time(r - 1));
+        lv_table_set_cell_value(warnings_table, r, 1, warning_log_desc(r - 1));
     }
 }
 
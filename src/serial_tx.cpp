@@ -0,0 +1,164 @@
+/******************************************************************************
+ * @file    serial_tx.cpp
+ * @author  Thomas Zoldowski
+ * @date    October 18, 2026
+ * @brief   TX rings and drain thread for USB serial output.
+ ******************************************************************************/
+
+#include "serial_tx.h"
+#include "config.h"
+#include "log.h"
+#include <mbed.h>
+
+#ifdef CORE_CM4
+  #include <RPC.h>
+  #define TX_PORT RPC      // M4 firmware: the M7 forwards it (core_link.cpp)
+#else
+  #define TX_PORT Serial
+#endif
+
+// Byte ring; one slot is kept free to tell full from empty
+struct TxRing {
+    uint8_t *buf;
+    size_t   size;
+    size_t   head;   // write index
+    size_t   tail;   // read index
+};
+
+static uint8_t tlm_storage[SERIAL_TX_TLM_BUF];
+static uint8_t dbg_storage[SERIAL_TX_DBG_BUF];
+static TxRing  tlm_ring = { tlm_storage, sizeof(tlm_storage), 0, 0 };
+static TxRing  dbg_ring = { dbg_storage, sizeof(dbg_storage), 0, 0 };
+
+static rtos::Mutex     tx_mutex;
+static rtos::Semaphore tx_pending(0, 1);
+static rtos::Thread    tx_thread(osPriorityBelowNormal, 2048, nullptr, "serial_tx");
+static SerialTxStats   stats = { 0, 0, 0, 0, 0 };
+
+SerialTxDebug DebugSerial;
+
+static inline size_t ring_used(const TxRing &r) {
+    return (r.head + r.size - r.tail) % r.size;
+}
+
+static inline size_t ring_free(const TxRing &r) {
+    return r.size - 1 - ring_used(r);
+}
+
+/** @brief Copy bytes into a ring (caller checked the space). */
+static void ring_put(TxRing &r, const uint8_t *data, size_t len) {
+    size_t first = min(len, r.size - r.head);
+    memcpy(&r.buf[r.head], data, first);
+    memcpy(r.buf, data + first, len - first);
+    r.head = (r.head + len) % r.size;
+}
+
+/** @brief Copy up to @p max bytes out of a ring.
+ *  @return Number of bytes copied.
+ */
+static size_t ring_get(TxRing &r, uint8_t *out, size_t max) {
+    size_t len   = min(ring_used(r), max);
+    size_t first = min(len, r.size - r.tail);
+    memcpy(out, &r.buf[r.tail], first);
+    memcpy(out + first, r.buf, len - first);
+    r.tail = (r.tail + len) % r.size;
+    return len;
+}
+
+/** @brief Drop the oldest debug lines until @p need bytes are free. */
+static void dbg_make_room(size_t need) {
+    while (ring_free(dbg_ring) < need && ring_used(dbg_ring) > 0) {
+        // Discard through the end of the oldest line
+        do {
+            uint8_t c = dbg_ring.buf[dbg_ring.tail];
+            dbg_ring.tail = (dbg_ring.tail + 1) % dbg_ring.size;
+            stats.dbg_dropped++;
+            if (c == '\n') break;
+        } while (ring_used(dbg_ring) > 0);
+    }
+}
+
+/** @brief Drain thread: format pending log records, then send telemetry
+ *  first and debug second, in SERIAL_TX_CHUNK pieces.
+ */
+static void tx_drain_thread() {
+    static uint8_t chunk[SERIAL_TX_CHUNK];
+    for (;;) {
+        tx_pending.acquire();
+        log_drain();
+        size_t sent = 0;   // counted under the lock on the next pass
+        for (;;) {
+            size_t n;
+            tx_mutex.lock();
+            stats.written += sent;
+            n = ring_get(tlm_ring, chunk, sizeof(chunk));
+            if (n == 0) n = ring_get(dbg_ring, chunk, sizeof(chunk));
+            tx_mutex.unlock();
+            if (n == 0) break;
+
+            // May block while the host isn't reading; only this thread waits
+            TX_PORT.write(chunk, n);
+            sent = n;
+        }
+    }
+}
+
+/** @brief Start the drain thread. */
+void serial_tx_init() {
+    tx_thread.start(mbed::callback(tx_drain_thread));
+    tx_pending.release();   // flush anything queued before start
+}
+
+/** @brief Queue one telemetry frame, all or nothing.
+ *  @param data Frame bytes.
+ *  @param len  Frame length.
+ *  @return False if the frame was dropped because the ring is full.
+ */
+bool serial_tx_write_telemetry(const uint8_t *data, size_t len) {
+    tx_mutex.lock();
+    bool ok = ring_free(tlm_ring) >= len;
+    if (ok) {
+        ring_put(tlm_ring, data, len);
+        stats.tlm_queued += len;
+    } else {
+        stats.tlm_dropped += len;
+    }
+    tx_mutex.unlock();
+    if (ok) tx_pending.release();
+    return ok;
+}
+
+/** @brief Wake the drain thread (e.g. after a log record was committed). */
+void serial_tx_kick() {
+    tx_pending.release();
+}
+
+/** @brief Get a snapshot of the TX counters. */
+SerialTxStats serial_tx_get_stats() {
+    tx_mutex.lock();
+    SerialTxStats s = stats;
+    tx_mutex.unlock();
+    return s;
+}
+
+/** @brief Queue debug text, discarding the oldest lines if needed. */
+size_t SerialTxDebug::write(const uint8_t *buffer, size_t size) {
+    size_t cap = dbg_ring.size - 1;
+    tx_mutex.lock();
+    if (size > cap) {                    // keep only the tail of huge writes
+        stats.dbg_dropped += size - cap;
+        buffer += size - cap;
+        size    = cap;
+    }
+    dbg_make_room(size);
+    ring_put(dbg_ring, buffer, size);
+    stats.dbg_queued += size;
+    tx_mutex.unlock();
+    tx_pending.release();
+    return size;
+}
+
+/** @brief Queue a single debug character. */
+size_t SerialTxDebug::write(uint8_t c) {
+    return write(&c, 1);
+}
@@ -8,6 +8,12 @@
  ******************************************************************************/
 
 #include "settings_storage.h"
+#include "logic/trace.h"
+#include <cstring>
+
+#define LOG_TAG   "LFS"
+#define LOG_LEVEL LOG_LEVEL_STORAGE
+#include "log.h"
 
 // These must match the extern in settings_storage.h:
 Config config;
@@ -20,19 +26,13 @@ Config config;
 static const char *CONFIG_PATH = "/user/config.bin";
 
 void loadConfig() {
-    // Try opening /config.bin for read
-    FILE *f = fopen(CONFIG_PATH, "rb");
-    if (f) {
-        // File exists → read exactly sizeof(Config) bytes. 
-        size_t n = fread(&config, 1, sizeof(Config), f);
-        fclose(f);
-        if (n == sizeof(Config)) {
-            // Successfully loaded everything
-            return;
-            Serial.println("[LFS]OK: Loaded from config file");
-        }
-        // If we read the wrong size, fall through and rewrite defaults.
+    // Try reading exactly sizeof(Config) bytes
+    if (hal_fs_read(CONFIG_PATH, &config, sizeof(Config))) {
+        // Successfully loaded everything
+        LOG_I("Loaded from config file");
+        return;
     }
+    // If the file is missing or the wrong size, fall through and rewrite defaults.
 
     // If we get here:
     // 1) config.bin didn’t exist, or
@@ -52,7 +52,7 @@ void loadConfig() {
     config.activation_interval_min = 60; // 1 minute
     // ------------------------------------------
 
-    uint32_t now = time(nullptr);
+    uint32_t now = hal_epoch();
     config.lastPumpEpoch    = now;
     config.lastBlowerEpoch  = now;
 
@@ -63,13 +63,12 @@ void loadConfig() {
 }
 
 void saveConfig() {
-    // Open (or create/truncate) /config.bin for write
-    FILE *f = fopen(CONFIG_PATH, "wb");
-    if (!f) {
-        Serial.println("[LFS]ERROR: Could not open config.bin for writing!");
+    trace_config(config);   // a replay applies it at the same point
+
+    // Create or truncate config.bin
+    if (!hal_fs_write(CONFIG_PATH, &config, sizeof(Config))) {
+        LOG_E("Could not open config.bin for writing!");
         return;
     }
-    Serial.println("[LFS]OK: Changed Saved");
-    fwrite(&config, 1, sizeof(Config), f);
-    fclose(f);
-}  
\ No newline at end of file
+    LOG_I("Changed Saved");
+}
@@ -0,0 +1,145 @@
+/******************************************************************************
+ * @file    compost_model.cpp
+ * @author  Thomas Zoldowski
+ * @date    October 18, 2026
+ * @brief   Lumped physical model of a compost batch for host runs (HAL_SIM).
+ ******************************************************************************/
+#include "sim/compost_model.h"
+#include <cmath>
+
+#define CP_WATER      4180.0f    // J/(kg·K)
+#define CP_DRY        1200.0f
+#define CP_AIR        1005.0f
+#define RHO_AIR       1.2f       // kg/m³
+#define LATENT_J_KG   2.43e6f    // evaporation near 40 °C
+#define AIR_O2_PCT    20.9f
+#define MAX_STEP_S    10.0f      // substep bound; air exchange itself is integrated exactly
+#define PI_F          3.14159265f
+
+void compost_default_params(CompostParams &p) {
+    p.k_max_per_day    = 0.20f;
+    p.t_min_c          = 5.0f;
+    p.t_opt_c          = 58.0f;
+    p.t_max_c          = 75.0f;
+    p.o2_half_pct      = 2.0f;
+    p.heat_j_per_kg    = 21e6f;
+    p.o2_m3_per_kg     = 0.9f;      // ~1.2 kg O2 at 1.33 kg/m³
+    p.water_kg_per_kg  = 0.6f;
+    p.ua_w_per_k       = 5.0f;
+    p.gas_m3           = 0.3f;
+    p.passive_m3_s     = 0.0002f;
+    p.blower_m3_s      = 0.010f;
+    p.pump_kg_s        = 0.05f;
+    p.ambient_mean_c   = 15.0f;
+    p.ambient_swing_c  = 5.0f;
+    p.ambient_rh       = 0.6f;
+    p.feed_moisture    = 0.65f;
+    p.feed_vs_fraction = 0.5f;
+    p.feed_temp_c      = 18.0f;
+    p.bin_depth_cm     = 111.0f;
+    p.cm_per_kg        = 0.15f;
+}
+
+void compost_init(CompostState &s, const CompostParams &p, float mass_kg) {
+    s.mass_kg   = 0;
+    s.water_kg  = 0;
+    s.vs_kg     = 0;
+    s.vs_in_kg  = 0;
+    s.temp_c    = p.feed_temp_c;
+    s.o2_pct    = AIR_O2_PCT;
+    s.ambient_c = p.ambient_mean_c;
+    compost_load(s, p, mass_kg);
+}
+
+/** @brief Cardinal temperature model with inflection (Rosso et al.), 0..1. */
+static float f_temp(const CompostParams &p, float t) {
+    if (t <= p.t_min_c || t >= p.t_max_c) return 0;
+    float a = p.t_opt_c - p.t_min_c;
+    float num = (t - p.t_max_c) * (t - p.t_min_c) * (t - p.t_min_c);
+    float den = a * (a * (t - p.t_opt_c) - (p.t_opt_c - p.t_max_c) * (p.t_opt_c + p.t_min_c - 2 * t));
+    float f = num / den;
+    return f < 0 ? 0 : (f > 1 ? 1 : f);
+}
+
+/** @brief Moisture limitation (Haug), wet-basis fraction in. */
+static float f_moisture(float m) {
+    return 1.0f / (std::exp(-17.684f * m + 7.0622f) + 1.0f);
+}
+
+/** @brief Water vapour per kg dry air at saturation, at 101.3 kPa. */
+static float w_sat(float t) {
+    float ps = 0.6108f * std::exp(17.27f * t / (t + 237.3f));   // kPa
+    return 0.622f * ps / (101.325f - ps);
+}
+
+void compost_step(CompostState &s, const CompostParams &p, double t_s, float dt_s,
+                  uint8_t blowers, bool pump) {
+    while (dt_s > 0) {
+        float dt = dt_s < MAX_STEP_S ? dt_s : MAX_STEP_S;
+        dt_s -= dt;
+
+        double day = t_s / 86400.0;
+        s.ambient_c = p.ambient_mean_c +
+                      p.ambient_swing_c * std::sin(2 * PI_F * (float)(day - std::floor(day) - 0.375));
+        t_s += dt;
+
+        float m    = compost_moisture(s);
+        float rate = p.k_max_per_day / 86400.0f * f_temp(p, s.temp_c) * f_moisture(m) *
+                     s.o2_pct / (p.o2_half_pct + s.o2_pct);
+        float dvs  = s.vs_kg * rate * dt;
+        // O2 can't go below zero within the step
+        float o2_avail = s.o2_pct / 100.0f * p.gas_m3;
+        if (dvs * p.o2_m3_per_kg > o2_avail) dvs = o2_avail / p.o2_m3_per_kg;
+
+        float air   = p.passive_m3_s + blowers * p.blower_m3_s;          // m³/s
+        float air_kg = air * RHO_AIR * dt;
+        float evap  = air_kg * (w_sat(s.temp_c) - p.ambient_rh * w_sat(s.ambient_c));
+        if (evap < 0) evap = 0;
+        if (evap > s.water_kg) evap = s.water_kg;
+        float water = pump ? p.pump_kg_s * dt : 0;
+
+        float heat = dvs * p.heat_j_per_kg
+                   - p.ua_w_per_k * (s.temp_c - s.ambient_c) * dt
+                   - air_kg * CP_AIR * (s.temp_c - s.ambient_c)
+                   - evap * LATENT_J_KG
+                   + water * CP_WATER * (s.ambient_c - s.temp_c);
+
+        // Solids leave as CO2, metabolic water stays
+        s.vs_kg    -= dvs;
+        s.water_kg += dvs * p.water_kg_per_kg - evap + water;
+        s.mass_kg  += dvs * (p.water_kg_per_kg - 1.0f) - evap + water;
+
+        float cap = s.water_kg * CP_WATER + (s.mass_kg - s.water_kg) * CP_DRY;
+        if (cap > 0) s.temp_c += heat / cap;
+
+        // Consumption, then exact exchange with the incoming air
+        s.o2_pct -= dvs * p.o2_m3_per_kg / p.gas_m3 * 100.0f;
+        if (s.o2_pct < 0) s.o2_pct = 0;
+        s.o2_pct += (AIR_O2_PCT - s.o2_pct) * (1.0f - std::exp(-air * dt / p.gas_m3));
+    }
+}
+
+void compost_load(CompostState &s, const CompostParams &p, float kg) {
+    if (kg <= 0) return;
+    float water = kg * p.feed_moisture;
+    float vs    = (kg - water) * p.feed_vs_fraction;
+    float cap_pile = s.water_kg * CP_WATER + (s.mass_kg - s.water_kg) * CP_DRY;
+    float cap_feed = water * CP_WATER + (kg - water) * CP_DRY;
+    s.temp_c    = (cap_pile * s.temp_c + cap_feed * p.feed_temp_c) / (cap_pile + cap_feed);
+    s.mass_kg  += kg;
+    s.water_kg += water;
+    s.vs_kg    += vs;
+    s.vs_in_kg += vs;
+    s.o2_pct    = AIR_O2_PCT;    // the open door airs the headspace
+}
+
+float compost_headspace_rh(const CompostState &s) {
+    // Saturated over a wet pile, falling off as it dries below ~60 %
+    float rh = (compost_moisture(s) - 0.25f) / 0.35f * 100.0f;
+    return rh < 0 ? 0 : (rh > 100 ? 100 : rh);
+}
+
+float compost_surface_cm(const CompostState &s, const CompostParams &p) {
+    float d = p.bin_depth_cm - s.mass_kg * p.cm_per_kg;
+    return d < 5.0f ? 5.0f : d;
+}
@@ -0,0 +1,314 @@
+/******************************************************************************
+ * @file    hal_sim.cpp
+ * @author  Thomas Zoldowski
+ * @date    October 18, 2026
+ * @brief   hal.h on a Linux host (HAL_SIM): virtual clock, GPIO and I2C bus.
+ ******************************************************************************/
+#include "hal.h"
+#include "sim/sim_bus.h"
+#include <cstdio>
+#include <cstring>
+
+#define SIM_I2C_TIMEOUT_US  25000   // a hung transfer costs the bus this long
+#define SIM_LAST_READ_MAX   32      // bytes remembered for the stuck fault
+
+typedef struct {
+    SimI2cDevice *dev;
+    uint8_t       addr;
+    int8_t        channel;                     // SIM_MAIN_BUS or mux channel
+    uint8_t       last[SIM_LAST_READ_MAX];
+    size_t        last_len;
+} Attached;
+
+static Attached      devices[SIM_MAX_DEVICES];
+static uint8_t       device_count = 0;
+static SimI2cDevice *mux          = nullptr;
+static uint32_t      bus_hz       = 100000;
+static SimBusStats   bus_stats    = {};
+
+static uint64_t      now_us       = 0;
+static uint32_t      epoch0       = 0;
+static HalTimeout   *pending      = nullptr;   // sorted by due_us
+
+static bool          pin_level[SIM_MAX_PINS];
+static void        (*pin_cb)(uint8_t, bool) = nullptr;
+
+static char          fs_root[128] = ".";
+static uint32_t      rng          = 1;
+static uint32_t      rng_seed     = 1;   // hal_random32(), kept apart from the fault stream
+
+// ========== SETUP ==========
+void sim_reset(uint32_t seed, uint32_t epoch) {
+    device_count = 0;
+    mux          = nullptr;
+    bus_stats    = {};
+    for (HalTimeout *t = pending; t; t = t->next) t->armed = false;
+    pending      = nullptr;
+    now_us       = 0;
+    epoch0       = epoch;
+    memset(pin_level, 0, sizeof(pin_level));
+    pin_cb       = nullptr;
+    rng          = seed ? seed : 1;
+    rng_seed     = rng;
+}
+
+void sim_fs_set_root(const char *dir) {
+    snprintf(fs_root, sizeof(fs_root), "%s", dir);
+}
+
+void sim_i2c_set_hz(uint32_t hz) {
+    if (hz) bus_hz = hz;
+}
+
+bool sim_i2c_attach(SimI2cDevice *dev, uint8_t addr, int8_t channel) {
+    if (device_count >= SIM_MAX_DEVICES || channel >= SIM_MUX_CHANNELS) return false;
+    Attached &a = devices[device_count++];
+    a.dev      = dev;
+    a.addr     = addr;
+    a.channel  = channel;
+    a.last_len = 0;
+    return true;
+}
+
+void sim_i2c_set_mux(SimI2cDevice *m) {
+    mux = m;
+}
+
+SimBusStats sim_i2c_stats() {
+    return bus_stats;
+}
+
+/** @brief xorshift32; the only source of randomness in the simulation. */
+uint32_t sim_rand_ppm() {
+    rng ^= rng << 13;
+    rng ^= rng >> 17;
+    rng ^= rng << 5;
+    return rng % 1000000u;
+}
+
+// ========== TIME ==========
+static void timer_unlink(HalTimeout &t) {
+    for (HalTimeout **p = &pending; *p; p = &(*p)->next) {
+        if (*p == &t) {
+            *p = t.next;
+            break;
+        }
+    }
+    t.armed = false;
+}
+
+void sim_advance_us(uint64_t us) {
+    uint64_t target = now_us + us;
+    while (pending && pending->due_us <= target) {
+        HalTimeout *t = pending;
+        pending  = t->next;
+        t->armed = false;
+        if (t->due_us > now_us) now_us = t->due_us;
+        t->fn(t->arg);                 // may re-arm itself
+    }
+    now_us = target;
+}
+
+uint32_t hal_millis() {
+    return (uint32_t)(now_us / 1000);
+}
+
+uint64_t hal_micros() {
+    return now_us;
+}
+
+uint32_t hal_epoch() {
+    return epoch0 + (uint32_t)(now_us / 1000000);
+}
+
+/** @brief splitmix32 of a counter from the seed, so faults draw the same stream either way. */
+uint32_t hal_random32() {
+    uint32_t z = (rng_seed += 0x9E3779B9u);
+    z = (z ^ (z >> 16)) * 0x85EBCA6Bu;
+    z = (z ^ (z >> 13)) * 0xC2B2AE35u;
+    return z ^ (z >> 16);
+}
+
+void sim_set_epoch(uint32_t epoch) {
+    epoch0 = epoch - (uint32_t)(now_us / 1000000);
+}
+
+void hal_delay_ms(uint32_t ms) {
+    sim_advance_ms(ms);
+}
+
+void hal_timeout_start(HalTimeout &t, void (*fn)(void *), void *arg, uint32_t ms) {
+    if (t.armed) timer_unlink(t);
+    t.fn     = fn;
+    t.arg    = arg;
+    t.due_us = now_us + (uint64_t)ms * 1000;
+    t.armed  = true;
+    HalTimeout **p = &pending;
+    while (*p && (*p)->due_us <= t.due_us) p = &(*p)->next;
+    t.next = *p;
+    *p     = &t;
+}
+
+void hal_timeout_stop(HalTimeout &t) {
+    if (t.armed) timer_unlink(t);
+}
+
+// Timeouts run from sim_advance_us() on the caller's thread, never in
+// the middle of other code
+void hal_critical_enter() {}
+void hal_critical_exit() {}
+
+// ========== GPIO ==========
+void hal_pin_mode(uint8_t pin, HalPinMode mode) {
+    (void)pin;
+    (void)mode;
+}
+
+void hal_pin_write(uint8_t pin, bool high) {
+    if (pin >= SIM_MAX_PINS) return;
+    pin_level[pin] = high;
+    if (pin_cb) pin_cb(pin, high);
+}
+
+bool hal_pin_read(uint8_t pin) {
+    return pin < SIM_MAX_PINS && pin_level[pin];
+}
+
+void sim_pin_set(uint8_t pin, bool high) {
+    if (pin < SIM_MAX_PINS) pin_level[pin] = high;
+}
+
+bool sim_pin_get(uint8_t pin) {
+    return pin < SIM_MAX_PINS && pin_level[pin];
+}
+
+void sim_pin_on_write(void (*cb)(uint8_t pin, bool high)) {
+    pin_cb = cb;
+}
+
+// ========== I2C ==========
+void hal_i2c_begin() {
+}
+
+/** @brief The device answering an address with the mux as it is set now. */
+static Attached *route(uint8_t addr) {
+    Attached *found = nullptr;
+    uint8_t   open  = mux ? mux->channels() : 0;
+    for (uint8_t i = 0; i < device_count; i++) {
+        Attached &a = devices[i];
+        if (a.addr != addr) continue;
+        if (a.channel != SIM_MAIN_BUS && !(open & (1u << a.channel))) continue;
+        if (found) {
+            bus_stats.collisions++;
+            continue;
+        }
+        found = &a;
+    }
+    return found;
+}
+
+/** @brief Charge a transfer of len data bytes (plus address) to the clock. */
+static void spend(Attached *a, size_t len, uint64_t extra_us) {
+    uint64_t us = (uint64_t)(9 * (1 + len) + 2) * 1000000 / bus_hz + extra_us;
+    bus_stats.transfers++;
+    bus_stats.busy_us += us;
+    if (a) a->dev->stats.bus_us += us;
+    sim_advance_us(us);
+}
+
+/** @brief Roll the device's refuse/hang faults. @return HAL_I2C_OK if it answers. */
+static uint8_t roll_faults(Attached *a) {
+    if (!a) return HAL_I2C_ADDR_NACK;
+    const SimFaults &f = a->dev->faults;
+    if (f.offline || (f.nack_ppm && sim_rand_ppm() < f.nack_ppm)) return HAL_I2C_ADDR_NACK;
+    if (f.timeout_ppm && sim_rand_ppm() < f.timeout_ppm) return HAL_I2C_TIMEOUT;
+    return HAL_I2C_OK;
+}
+
+uint8_t hal_i2c_write(uint8_t addr, const uint8_t *data, size_t len, bool stop) {
+    (void)stop;
+    Attached *a  = route(addr);
+    uint8_t   rc = roll_faults(a);
+    if (rc != HAL_I2C_OK) {
+        if (a) a->dev->stats.nacks++;
+        spend(a, 0, rc == HAL_I2C_TIMEOUT ? SIM_I2C_TIMEOUT_US : 0);
+        return rc;
+    }
+    a->dev->stats.writes++;
+    a->dev->stats.bytes += len;
+    bool ok = a->dev->on_write(data, len);
+    spend(a, len, a->dev->latency_us);
+    if (!ok) {
+        a->dev->stats.nacks++;
+        return HAL_I2C_DATA_NACK;
+    }
+    return HAL_I2C_OK;
+}
+
+size_t hal_i2c_read(uint8_t addr, uint8_t *data, size_t len) {
+    Attached *a  = route(addr);
+    uint8_t   rc = roll_faults(a);
+    if (rc != HAL_I2C_OK) {
+        if (a) a->dev->stats.nacks++;
+        spend(a, 0, rc == HAL_I2C_TIMEOUT ? SIM_I2C_TIMEOUT_US : 0);
+        return 0;
+    }
+    const SimFaults &f = a->dev->faults;
+    a->dev->stats.reads++;
+    a->dev->stats.bytes += len;
+
+    memset(data, 0xFF, len);
+    if (f.stuck && a->last_len >= len) {
+        memcpy(data, a->last, len);
+    } else {
+        a->dev->on_read(data, len);
+    }
+    if (len <= SIM_LAST_READ_MAX && !f.stuck) {
+        memcpy(a->last, data, len);
+        a->last_len = len;
+    }
+    if (len && f.corrupt_ppm && sim_rand_ppm() < f.corrupt_ppm) {
+        uint32_t bit = sim_rand_ppm() % (len * 8);
+        data[bit / 8] ^= (uint8_t)(1u << (bit % 8));
+        a->dev->stats.corrupted++;
+    }
+    spend(a, len, a->dev->latency_us);
+    return len;
+}
+
+// ========== FILESYSTEM ==========
+/** @brief Host path for a board path; "/user/x" lands in the root directory. */
+static void host_path(char *out, size_t size, const char *path) {
+    if (strncmp(path, "/user/", 6) == 0) path += 5;
+    snprintf(out, size, "%s%s", fs_root, path);
+}
+
+bool hal_fs_read(const char *path, void *buf, size_t len) {
+    char p[256];
+    host_path(p, sizeof(p), path);
+    FILE *f = fopen(p, "rb");
+    if (!f) return false;
+    size_t n = fread(buf, 1, len, f);
+    fclose(f);
+    return n == len;
+}
+
+bool hal_fs_write(const char *path, const void *buf, size_t len) {
+    char p[256];
+    host_path(p, sizeof(p), path);
+    FILE *f = fopen(p, "wb");
+    if (!f) return false;
+    size_t n = fwrite(buf, 1, len, f);
+    fclose(f);
+    return n == len;
+}
+
+bool hal_fs_append(const char *path, const void *buf, size_t len) {
+    char p[256];
+    host_path(p, sizeof(p), path);
+    FILE *f = fopen(p, "ab");
+    if (!f) return false;
+    size_t n = fwrite(buf, 1, len, f);
+    fclose(f);
+    return n == len;
+}
@@ -0,0 +1,501 @@
+/******************************************************************************
+ * @file    main_sim.cpp
+ * @author  Thomas Zoldowski
+ * @date    October 18, 2026
+ * @brief   Host run of the sensing and control logic on a simulated batch.
+ *
+ * Builds the composter's bus on the simulated I2C (TCA9548 with three
+ * AHT20s, two VL53L1Xs and the SEN0322 behind it, TMP117 on the main bus),
+ * puts a compost batch (sim/compost_model.h) under it, then runs
+ * sensor_manager, the limit switches and actuator_manager on the virtual
+ * clock at their firmware rates. The blower and pump pins aerate and water
+ * the batch; the loading door opens on a schedule to add feed.
+ *
+ *   pio run -e native
+ *   .pio/build/native/program --days 7 --policy frequent
+ *   .pio/build/native/program --days 90 --compare
+ *
+ * --compare runs every aeration policy below on the same batch, one
+ * process each, and tabulates energy against time above --target-c.
+ *
+ * Options:
+ *   --days D / --hours H   simulated time (default 1 day)
+ *   --policy NAME          aeration policy (default: default)
+ *   --compare              run all policies, print the comparison only
+ *   --target-c C           temperature to hold the pile above (default 55)
+ *   --start-kg KG          initial batch (default 300)
+ *   --load-kg KG           feed added at each loading (default 30)
+ *   --load-days D          days between loadings, 0 = never (default 7)
+ *   --seed N               fault and noise generator seed (default 1)
+ *   --i2c-hz HZ            bus speed (default 100000)
+ *   --latency-us US        clock stretching added to every sensor transfer
+ *   --nack-ppm P           random NACKs on every sensor, per million transfers
+ *   --offline NAME         unplug a part: aht0..aht2, tof0, tof1, o2, tmp117
+ *   --fs DIR               host directory standing in for /user (default: fresh temp dir)
+ *   --trace                record a field trace (logic/trace.h) to trace0.bin in --fs DIR,
+ *                          for .pio/build/replay/program
+ *   --log                  print the firmware's log as it runs
+ *   --help                 print these options
+ ******************************************************************************/
+#include "hal.h"
+#include "config.h"
+#include "settings_storage.h"
+#include "sim/sim_bus.h"
+#include "sim/sim_devices.h"
+#include "sim/compost_model.h"
+#include "logic/sensor_manager.h"
+#include "logic/actuator_manager.h"
+#include "logic/trace.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <dirent.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#define SIM_EPOCH         1790000000UL   // arbitrary wall-clock start (2026)
+#define BLOWER_W          45.0           // electrical draw of each blower
+#define PUMP_W            30.0
+#define DOOR_OPEN_S       120            // loading door held open this long
+#define LOADING_DOOR_PIN  HAL_D(4)       // limit switch 4, high = door open
+#define ANAEROBIC_PCT     5.0f           // pore O2 below this counts as anaerobic
+
+// Aeration policies: what a user can set on the settings screen. The
+// blowers run every interval, and every interval / 3 while any zone is at
+// or above the HIGH temperature (see BLOWER_TRIGGERS in actuator_manager).
+typedef struct {
+    const char *name;
+    uint16_t    blower_sec;
+    uint32_t    interval_min;
+    float       temp_high_f;
+    const char *about;
+} Policy;
+
+static const Policy POLICIES[] = {
+    { "default",    10,  60, 160.0f, "firmware defaults" },
+    { "frequent",   10,  15, 160.0f, "short bursts every 15 min" },
+    { "long",       60,  60, 160.0f, "a minute every hour" },
+    { "hot-only",   30, 240, 131.0f, "every 4 h, every 80 min at 55 C" },
+    { "thermostat", 30,  60, 140.0f, "every hour, every 20 min at 60 C" },
+};
+#define POLICY_COUNT (int)(sizeof(POLICIES) / sizeof(POLICIES[0]))
+
+typedef struct {
+    double   days            = 1.0;
+    float    target_c        = 55.0f;
+    float    start_kg        = 300.0f;
+    float    load_kg         = 30.0f;
+    float    load_days       = 7.0f;
+    uint32_t seed            = 1;
+    uint32_t hz              = 100000;
+    uint32_t latency         = 0;
+    uint32_t nack            = 0;
+    const char *fs           = nullptr;
+    bool     verbose         = false;
+    bool     trace           = false;
+    const char *offline[8];
+    int      n_offline       = 0;
+} Options;
+
+typedef struct {
+    double   sim_s, wall_s;
+    uint32_t passes;
+    uint64_t pass_min_us, pass_max_us, pass_sum_us;
+    uint32_t blower_runs, pump_runs, loads;
+    double   blower_on_s, pump_on_s;    // blower: both blowers summed
+    double   above_target_s, anaerobic_s;
+    float    max_temp_c, final_temp_c, final_moisture, vs_done_pct, final_kg;
+} RunResult;
+
+static SimTca9548 mux;
+static SimAht20   aht[3];
+static SimVl53l1x tof[2];
+static SimSen0322 o2;
+static SimTmp117  tmp117;
+
+// Actuator outputs seen on the pins (pump D27, blowers D25 / D23)
+typedef struct {
+    uint8_t     pin;
+    const char *name;
+    bool        high;
+    uint32_t    starts;
+    uint64_t    on_us;
+    uint64_t    since_us;
+} PinLog;
+
+static PinLog outputs[] = {
+    { HAL_D(27), "pump",    false, 0, 0, 0 },
+    { HAL_D(25), "blower1", false, 0, 0, 0 },
+    { HAL_D(23), "blower2", false, 0, 0, 0 },
+};
+
+// The batch, integrated up to world_us
+static CompostParams params;
+static CompostState  batch;
+static uint64_t      world_us = 0;
+static Options       opt;
+static RunResult     res;
+
+/** @brief Bring the batch up to the current time under the present pin levels. */
+static void advance_world() {
+    uint64_t now = hal_micros();
+    if (now <= world_us) return;
+    float   dt      = (now - world_us) / 1e6f;
+    uint8_t blowers = (uint8_t)(outputs[1].high + outputs[2].high);
+    compost_step(batch, params, world_us / 1e6, dt, blowers, outputs[0].high);
+    world_us = now;
+
+    if (batch.temp_c >= opt.target_c)  res.above_target_s += dt;
+    if (batch.o2_pct < ANAEROBIC_PCT)  res.anaerobic_s    += dt;
+    if (batch.temp_c > res.max_temp_c) res.max_temp_c      = batch.temp_c;
+}
+
+/** @brief Show the batch to the sensors. */
+static void world_to_sensors() {
+    static const float ZONE[3] = { 1.0f, 0.97f, 0.92f };   // core to edge
+    float rh = compost_headspace_rh(batch);
+    for (uint8_t i = 0; i < 3; i++) {
+        aht[i].temp_c = batch.ambient_c + (batch.temp_c - batch.ambient_c) * ZONE[i];
+        aht[i].rh     = rh;
+    }
+    for (uint8_t j = 0; j < 2; j++) tof[j].distance_cm = compost_surface_cm(batch, params);
+    o2.o2_percent  = batch.o2_pct;
+    tmp117.temp_c  = batch.ambient_c + 8.0f;                // inside the electronics box
+}
+
+static void on_pin(uint8_t pin, bool high) {
+    for (PinLog &o : outputs) {
+        if (o.pin != pin || o.high == high) continue;
+        advance_world();                                     // up to the edge at the old level
+        if (high) {
+            o.starts++;
+            o.since_us = hal_micros();
+        } else {
+            o.on_us += hal_micros() - o.since_us;
+        }
+        o.high = high;
+    }
+}
+
+/** @brief The composter's bus as wired on the board. */
+static void build_bench() {
+    sim_i2c_attach(&mux, I2C_MUX_ADDR, SIM_MAIN_BUS);
+    sim_i2c_set_mux(&mux);
+    for (uint8_t i = 0; i < 3; i++) {
+        aht[i].noise = 0.3f;
+        sim_i2c_attach(&aht[i], 0x38, i);
+    }
+    for (uint8_t j = 0; j < 2; j++) {
+        tof[j].noise = 1.0f;
+        sim_i2c_attach(&tof[j], 0x29, 3 + j);
+    }
+    o2.noise = 0.1f;
+    sim_i2c_attach(&o2, 0x73, 5);
+    sim_i2c_attach(&tmp117, 0x48, SIM_MAIN_BUS);
+}
+
+static SimI2cDevice *device_by_name(const char *name) {
+    if (!strncmp(name, "aht", 3) && name[3] >= '0' && name[3] <= '2') return &aht[name[3] - '0'];
+    if (!strncmp(name, "tof", 3) && name[3] >= '0' && name[3] <= '1') return &tof[name[3] - '0'];
+    if (!strcmp(name, "o2"))     return &o2;
+    if (!strcmp(name, "tmp117")) return &tmp117;
+    return nullptr;
+}
+
+/** @brief Remove a temporary /user and the files the firmware left in it. */
+static void remove_dir(const char *dir) {
+    DIR *d = opendir(dir);
+    if (!d) return;
+    char path[256];
+    while (struct dirent *e = readdir(d)) {
+        if (!strcmp(e->d_name, ".") || !strcmp(e->d_name, "..")) continue;
+        if (snprintf(path, sizeof(path), "%s/%s", dir, e->d_name) < (int)sizeof(path)) unlink(path);
+    }
+    closedir(d);
+    rmdir(dir);
+}
+
+static const Policy *policy_by_name(const char *name) {
+    for (int i = 0; i < POLICY_COUNT; i++) {
+        if (!strcmp(POLICIES[i].name, name)) return &POLICIES[i];
+    }
+    return nullptr;
+}
+
+/**
+ * @brief One batch under one policy, from power-up.
+ * @param daily Print a line per simulated day to stderr.
+ * @return False if the setup was refused (bad --offline name).
+ */
+static bool run(const Policy &pol, bool daily) {
+    res = {};
+    res.pass_min_us = UINT64_MAX;
+    sim_reset(opt.seed, SIM_EPOCH);
+    sim_i2c_set_hz(opt.hz);
+    sim_pin_on_write(on_pin);
+    build_bench();
+
+    SimI2cDevice *sensors[] = { &aht[0], &aht[1], &aht[2], &tof[0], &tof[1], &o2, &tmp117 };
+    for (SimI2cDevice *d : sensors) {
+        d->latency_us      = opt.latency;
+        d->faults.nack_ppm = opt.nack;
+    }
+    for (int i = 0; i < opt.n_offline; i++) {
+        SimI2cDevice *d = device_by_name(opt.offline[i]);
+        if (!d) { fprintf(stderr, "no part '%s'\n", opt.offline[i]); return false; }
+        d->faults.offline = true;
+    }
+
+    // A fresh /user each run, so no earlier config.bin leaks in
+    char tmp[] = "/tmp/composter-sim-XXXXXX";
+    const char *fs = opt.fs ? opt.fs : mkdtemp(tmp);
+    if (!fs) { perror("mkdtemp"); return false; }
+    sim_fs_set_root(fs);
+
+    compost_default_params(params);
+    compost_init(batch, params, opt.start_kg);
+    world_us = 0;
+    world_to_sensors();
+
+    auto wall0 = std::chrono::steady_clock::now();
+
+    loadConfig();
+    for (int i = 0; i < 3; i++) config.temp_high[i] = pol.temp_high_f;
+    config.blower_duration_sec     = pol.blower_sec;
+    config.activation_interval_min = pol.interval_min;
+    sensor_manager_init();
+    Limit_Switch_Init();
+    if (opt.trace) trace_init();
+    initActuatorScheduler();
+
+    // Same rates as the acquisition and control threads
+    const uint64_t load_every = (uint64_t)(opt.load_days * 86400e6);
+    uint64_t end_us       = (uint64_t)(opt.days * 86400e6);
+    uint64_t next_pass    = hal_micros();
+    uint64_t next_switch  = hal_micros();
+    uint64_t next_control = hal_micros();
+    uint64_t next_door    = load_every ? load_every : UINT64_MAX;
+    uint64_t next_day     = 86400000000ULL;
+    bool     door_open    = false;
+
+    while (hal_micros() < end_us) {
+        uint64_t now = hal_micros();
+        if (now >= next_door) {
+            advance_world();
+            door_open = !door_open;
+            sim_pin_set(LOADING_DOOR_PIN, door_open);
+            if (door_open) {
+                compost_load(batch, params, opt.load_kg);
+                res.loads++;
+                next_door = now + (uint64_t)DOOR_OPEN_S * 1000000;
+            } else {
+                next_door = now - (uint64_t)DOOR_OPEN_S * 1000000 + load_every;
+            }
+        }
+        if (now >= next_pass) {
+            advance_world();
+            world_to_sensors();
+            uint64_t t0 = now;
+            sensor_manager_update();
+            uint64_t spent = hal_micros() - t0;
+            res.passes++;
+            res.pass_sum_us += spent;
+            if (spent < res.pass_min_us) res.pass_min_us = spent;
+            if (spent > res.pass_max_us) res.pass_max_us = spent;
+            next_pass = t0 + (uint64_t)SENSOR_UPDATE_INTERVAL_MS * 1000;
+        }
+        if (now >= next_switch) {
+            Limit_Switch_update();
+            next_switch = now + (uint64_t)LIMIT_SWITCH_INTERVAL_MS * 1000;
+        }
+        if (now >= next_control) {
+            actuator_control_pass();
+            actuator_save_pending();
+            trace_flush(hal_millis());
+            next_control = now + (uint64_t)ACTUATOR_CHECK_MS * 1000;
+        }
+        if (daily && now >= next_day) {
+            advance_world();
+            fprintf(stderr, "day %4u  %5.1f C  moisture %4.1f %%  O2 %4.1f %%  %5.1f kg  VS left %5.1f kg\n",
+                    (unsigned)(now / 86400000000ULL), batch.temp_c, compost_moisture(batch) * 100,
+                    batch.o2_pct, batch.mass_kg, batch.vs_kg);
+            next_day += 86400000000ULL;
+        }
+        uint64_t next = next_pass;
+        if (next_switch  < next) next = next_switch;
+        if (next_control < next) next = next_control;
+        if (next_door    < next) next = next_door;
+        if (next > hal_micros()) sim_advance_us(next - hal_micros());
+    }
+    advance_world();
+    if (opt.trace) trace_flush(hal_millis() + TRACE_FLUSH_MS);   // the rest, due or not
+
+    res.wall_s         = std::chrono::duration<double>(std::chrono::steady_clock::now() - wall0).count();
+    res.sim_s          = hal_micros() / 1e6;
+    res.pump_runs      = outputs[0].starts;
+    res.pump_on_s      = outputs[0].on_us / 1e6;
+    res.blower_runs    = outputs[1].starts;
+    res.blower_on_s    = (outputs[1].on_us + outputs[2].on_us) / 1e6;
+    res.final_temp_c   = batch.temp_c;
+    res.final_moisture = compost_moisture(batch);
+    res.final_kg       = batch.mass_kg;
+    res.vs_done_pct    = batch.vs_in_kg > 0 ? 100.0f * (1.0f - batch.vs_kg / batch.vs_in_kg) : 0;
+    if (!opt.fs) remove_dir(fs);
+    return true;
+}
+
+static double energy_wh(const RunResult &r) {
+    return (r.blower_on_s * BLOWER_W + r.pump_on_s * PUMP_W) / 3600.0;
+}
+
+static void print_report(const Policy &pol) {
+    SimBusStats bus = sim_i2c_stats();
+    printf("Policy %s (%s): blowers %u s every %u min, HIGH %.0f F\n", pol.name, pol.about,
+           (unsigned)pol.blower_sec, (unsigned)pol.interval_min, pol.temp_high_f);
+    printf("Simulated %.1f days in %.2f s wall (%.0fx real time), seed %u, I2C %u Hz\n",
+           res.sim_s / 86400, res.wall_s, res.wall_s > 0 ? res.sim_s / res.wall_s : 0.0,
+           (unsigned)opt.seed, (unsigned)opt.hz);
+    printf("Sensor pass: %u passes, bus+wait time min %.1f / mean %.1f / max %.1f ms (period %u ms)\n",
+           (unsigned)res.passes, res.pass_min_us / 1e3,
+           res.passes ? res.pass_sum_us / 1e3 / res.passes : 0.0, res.pass_max_us / 1e3,
+           (unsigned)SENSOR_UPDATE_INTERVAL_MS);
+    printf("Bus: %u transfers, %.1f%% busy, %u address collisions\n",
+           (unsigned)bus.transfers, 100.0 * bus.busy_us / (res.sim_s * 1e6), (unsigned)bus.collisions);
+    printf("%-10s %10s %10s %10s %8s %10s\n", "part", "writes", "reads", "bytes", "nacks", "bus ms");
+    SimI2cDevice *all[] = { &mux, &aht[0], &aht[1], &aht[2], &tof[0], &tof[1], &o2, &tmp117 };
+    for (SimI2cDevice *d : all) {
+        printf("%-10s %10u %10u %10u %8u %10.1f\n", d->name(), (unsigned)d->stats.writes,
+               (unsigned)d->stats.reads, (unsigned)d->stats.bytes, (unsigned)d->stats.nacks,
+               d->stats.bus_us / 1e3);
+    }
+    for (const PinLog &o : outputs) {
+        printf("%-10s %u starts, %.1f s on\n", o.name, (unsigned)o.starts, o.on_us / 1e6);
+    }
+    printf("Batch: %.1f h at or above %.0f C, %.1f h anaerobic, max %.1f C, final %.1f C\n",
+           res.above_target_s / 3600, opt.target_c, res.anaerobic_s / 3600, res.max_temp_c,
+           res.final_temp_c);
+    printf("       %u loads, %.1f kg, moisture %.1f %%, %.1f %% of VS degraded, %.1f Wh\n",
+           (unsigned)res.loads, res.final_kg, res.final_moisture * 100, res.vs_done_pct, energy_wh(res));
+}
+
+/** @brief Every policy in its own process (the firmware keeps static state), in parallel. */
+static int compare() {
+    RunResult results[POLICY_COUNT];
+    int       fds[POLICY_COUNT];
+    pid_t     pids[POLICY_COUNT];
+    auto      wall0 = std::chrono::steady_clock::now();
+
+    for (int i = 0; i < POLICY_COUNT; i++) {
+        int p[2];
+        if (pipe(p) != 0) { perror("pipe"); return 1; }
+        fflush(stdout);
+        pids[i] = fork();
+        if (pids[i] < 0) { perror("fork"); return 1; }
+        if (pids[i] == 0) {
+            close(p[0]);
+            if (!opt.verbose) freopen("/dev/null", "w", stdout);
+            bool ok = run(POLICIES[i], false);
+            ssize_t n = ok ? write(p[1], &res, sizeof(res)) : 0;
+            _exit(n == (ssize_t)sizeof(res) ? 0 : 1);
+        }
+        close(p[1]);
+        fds[i] = p[0];
+    }
+
+    bool ok = true;
+    for (int i = 0; i < POLICY_COUNT; i++) {
+        ok &= read(fds[i], &results[i], sizeof(results[i])) == (ssize_t)sizeof(results[i]);
+        close(fds[i]);
+        int status;
+        waitpid(pids[i], &status, 0);
+    }
+    if (!ok) { fprintf(stderr, "a policy run failed\n"); return 1; }
+
+    double wall_s = std::chrono::duration<double>(std::chrono::steady_clock::now() - wall0).count();
+    printf("%u policies x %.0f days in %.1f s wall, target %.0f C, %.0f kg + %.0f kg every %.0f days, seed %u\n",
+           (unsigned)POLICY_COUNT, opt.days, wall_s, opt.target_c, opt.start_kg, opt.load_kg,
+           opt.load_days, (unsigned)opt.seed);
+    printf("%-11s %8s %8s %9s %9s %7s %7s %9s %7s\n", "policy", "energy", "blower", "above", "anaer.",
+           "max", "VS", "moisture", "pump");
+    printf("%-11s %8s %8s %9s %9s %7s %7s %9s %7s\n", "", "Wh", "runs", "target h", "h", "C", "% done",
+           "% final", "runs");
+    for (int i = 0; i < POLICY_COUNT; i++) {
+        const RunResult &r = results[i];
+        printf("%-11s %8.1f %8u %9.1f %9.1f %7.1f %7.1f %9.1f %7u\n", POLICIES[i].name, energy_wh(r),
+               (unsigned)r.blower_runs, r.above_target_s / 3600, r.anaerobic_s / 3600, r.max_temp_c,
+               r.vs_done_pct, r.final_moisture * 100, (unsigned)r.pump_runs);
+    }
+    return 0;
+}
+
+static const char USAGE[] =
+    "usage: program [options]\n"
+    "  --days D / --hours H   simulated time (default 1 day)\n"
+    "  --policy NAME          aeration policy (default: default)\n"
+    "  --compare              run all policies, print the comparison only\n"
+    "  --target-c C           temperature to hold the pile above (default 55)\n"
+    "  --start-kg KG          initial batch (default 300)\n"
+    "  --load-kg KG           feed added at each loading (default 30)\n"
+    "  --load-days D          days between loadings, 0 = never (default 7)\n"
+    "  --seed N               fault and noise generator seed (default 1)\n"
+    "  --i2c-hz HZ            bus speed (default 100000)\n"
+    "  --latency-us US        clock stretching added to every sensor transfer\n"
+    "  --nack-ppm P           random NACKs on every sensor, per million transfers\n"
+    "  --offline NAME         unplug a part: aht0..aht2, tof0, tof1, o2, tmp117\n"
+    "  --fs DIR               host directory standing in for /user (default: fresh temp dir)\n"
+    "  --trace                record a field trace to trace0.bin in --fs DIR\n"
+    "  --log                  print the firmware's log as it runs\n";
+
+int main(int argc, char **argv) {
+    const char *policy  = "default";
+    bool        all     = false;
+
+    for (int i = 1; i < argc; i++) {
+        const char *a   = argv[i];
+        const char *val = i + 1 < argc ? argv[i + 1] : nullptr;
+        if      (!strcmp(a, "--help") || !strcmp(a, "-h"))   { fputs(USAGE, stdout); return 0; }
+        else if (!strcmp(a, "--log"))                          opt.verbose = true;
+        else if (!strcmp(a, "--trace"))                        opt.trace   = true;
+        else if (!strcmp(a, "--compare"))                      all = true;
+        else if (!val)                                         { fprintf(stderr, "%s needs a value\n", a); return 2; }
+        else if (!strcmp(a, "--days"))                         opt.days      = atof(argv[++i]);
+        else if (!strcmp(a, "--hours"))                        opt.days      = atof(argv[++i]) / 24;
+        else if (!strcmp(a, "--policy"))                       policy        = argv[++i];
+        else if (!strcmp(a, "--target-c"))                     opt.target_c  = (float)atof(argv[++i]);
+        else if (!strcmp(a, "--start-kg"))                     opt.start_kg  = (float)atof(argv[++i]);
+        else if (!strcmp(a, "--load-kg"))                      opt.load_kg   = (float)atof(argv[++i]);
+        else if (!strcmp(a, "--load-days"))                    opt.load_days = (float)atof(argv[++i]);
+        else if (!strcmp(a, "--seed"))                         opt.seed      = (uint32_t)strtoul(argv[++i], nullptr, 0);
+        else if (!strcmp(a, "--i2c-hz"))                       opt.hz        = (uint32_t)strtoul(argv[++i], nullptr, 0);
+        else if (!strcmp(a, "--latency-us"))                   opt.latency   = (uint32_t)strtoul(argv[++i], nullptr, 0);
+        else if (!strcmp(a, "--nack-ppm"))                     opt.nack      = (uint32_t)strtoul(argv[++i], nullptr, 0);
+        else if (!strcmp(a, "--fs"))                           opt.fs        = argv[++i];
+        else if (!strcmp(a, "--offline") && opt.n_offline < 8) opt.offline[opt.n_offline++] = argv[++i];
+        else { fprintf(stderr, "unknown option %s (see --help)\n", a); return 2; }
+    }
+
+    if (all) return compare();
+    if (opt.trace && !opt.fs) { fprintf(stderr, "--trace needs --fs DIR to keep the file\n"); return 2; }
+
+    const Policy *pol = policy_by_name(policy);
+    if (!pol) {
+        fprintf(stderr, "no policy '%s'; one of:", policy);
+        for (int i = 0; i < POLICY_COUNT; i++) fprintf(stderr, " %s", POLICIES[i].name);
+        fprintf(stderr, "\n");
+        return 2;
+    }
+
+    // The firmware logs to stdout; keep it for the report unless --log
+    fflush(stdout);
+    int report_fd = dup(STDOUT_FILENO);
+    if (!opt.verbose) freopen("/dev/null", "w", stdout);
+    bool ok = run(*pol, true);
+    fflush(stdout);
+    dup2(report_fd, STDOUT_FILENO);
+    close(report_fd);
+    if (!ok) return 2;
+
+    print_report(*pol);
+    return 0;
+}
@@ -0,0 +1,184 @@
+/******************************************************************************
+ * @file    sim_devices.cpp
+ * @author  Thomas Zoldowski
+ * @date    October 18, 2026
+ * @brief   Simulated I2C parts for host runs (HAL_SIM).
+ ******************************************************************************/
+#include "sim/sim_devices.h"
+#include "hal.h"
+#include <cmath>
+
+/** @brief Uniform error in ±amp. */
+static float jitter(float amp) {
+    if (amp <= 0) return 0;
+    return amp * ((float)sim_rand_ppm() / 500000.0f - 1.0f);
+}
+
+// ========== TCA9548 ==========
+bool SimTca9548::on_write(const uint8_t *data, size_t len) {
+    if (len >= 1) control = data[0];
+    return true;
+}
+
+size_t SimTca9548::on_read(uint8_t *data, size_t len) {
+    if (len >= 1) data[0] = control;
+    return len ? 1 : 0;
+}
+
+// ========== AHT20 ==========
+/** @brief CRC-8, polynomial 0x31, init 0xFF (AHT20 datasheet). */
+static uint8_t aht_crc(const uint8_t *data, size_t len) {
+    uint8_t crc = 0xFF;
+    for (size_t i = 0; i < len; i++) {
+        crc ^= data[i];
+        for (uint8_t b = 0; b < 8; b++) crc = (crc & 0x80) ? (uint8_t)((crc << 1) ^ 0x31) : (uint8_t)(crc << 1);
+    }
+    return crc;
+}
+
+bool SimAht20::on_write(const uint8_t *data, size_t len) {
+    if (len == 0) return true;
+    switch (data[0]) {
+        case 0xBA:                              // soft reset
+            ready_us = hal_micros() + 20000;
+            break;
+        case 0xBE:                              // initialize / calibrate
+        case 0xE1:
+            calibrated = true;
+            break;
+        case 0xAC: {                            // trigger; the result is sampled now
+            float h = (rh + jitter(noise)) / 100.0f;
+            float t = (temp_c + jitter(noise) + 50.0f) / 200.0f;
+            h = h < 0 ? 0 : (h > 1 ? 1 : h);
+            t = t < 0 ? 0 : (t > 1 ? 1 : t);
+            raw_h    = (uint32_t)(h * 1048575.0f);
+            raw_t    = (uint32_t)(t * 1048575.0f);
+            ready_us = hal_micros() + (uint64_t)conversion_ms * 1000;
+            break;
+        }
+        default:
+            break;
+    }
+    return true;
+}
+
+size_t SimAht20::on_read(uint8_t *data, size_t len) {
+    uint8_t buf[7];
+    buf[0] = (uint8_t)((hal_micros() < ready_us ? 0x80 : 0) | (calibrated ? 0x08 : 0));
+    buf[1] = (uint8_t)(raw_h >> 12);
+    buf[2] = (uint8_t)(raw_h >> 4);
+    buf[3] = (uint8_t)(((raw_h & 0x0F) << 4) | ((raw_t >> 16) & 0x0F));
+    buf[4] = (uint8_t)(raw_t >> 8);
+    buf[5] = (uint8_t)raw_t;
+    buf[6] = aht_crc(buf, 6);
+    size_t n = len < sizeof(buf) ? len : sizeof(buf);
+    for (size_t i = 0; i < n; i++) data[i] = buf[i];
+    return n;
+}
+
+// ========== VL53L1X ==========
+#define VL_MODEL_ID          0x010F
+#define VL_GPIO_HV_STATUS    0x0031
+#define VL_INTERRUPT_CLEAR   0x0086
+#define VL_MODE_START        0x0087
+#define VL_RESULT_STATUS     0x0089
+#define VL_RESULT_LEN        17
+
+bool SimVl53l1x::data_ready() const {
+    return ranging && hal_micros() >= next_ready_us;
+}
+
+bool SimVl53l1x::on_write(const uint8_t *data, size_t len) {
+    if (len < 2) return len == 0;
+    reg = (uint16_t)((data[0] << 8) | data[1]);
+    if (len < 3) return true;
+    uint64_t period_us = (uint64_t)period_ms * 1000;
+    if (reg == VL_MODE_START) {
+        ranging       = data[2] != 0;
+        next_ready_us = hal_micros() + period_us;
+    } else if (reg == VL_INTERRUPT_CLEAR && data_ready()) {
+        // next result one period after the last, never in the past
+        while (next_ready_us <= hal_micros()) next_ready_us += period_us;
+    }
+    return true;
+}
+
+size_t SimVl53l1x::on_read(uint8_t *data, size_t len) {
+    uint8_t buf[VL_RESULT_LEN] = { 0 };
+    size_t  n = 0;
+    switch (reg) {
+        case VL_MODEL_ID:
+            buf[0] = 0xEA;
+            buf[1] = 0xCC;
+            n = 2;
+            break;
+        case VL_GPIO_HV_STATUS:
+            buf[0] = data_ready() ? 0x00 : 0x01;   // active-low interrupt
+            n = 1;
+            break;
+        case VL_RESULT_STATUS: {
+            float    cm = distance_cm + jitter(noise);
+            uint16_t mm = cm <= 0 ? 0 : (uint16_t)lroundf(cm * 10.0f);
+            buf[0]  = 9;                          // range valid
+            buf[13] = (uint8_t)(mm >> 8);         // final crosstalk-corrected range
+            buf[14] = (uint8_t)mm;
+            n = VL_RESULT_LEN;
+            break;
+        }
+        default:
+            n = 1;
+            break;
+    }
+    if (n > len) n = len;
+    for (size_t i = 0; i < n; i++) data[i] = buf[i];
+    return n;
+}
+
+// ========== SEN0322 ==========
+#define O2_DATA_REG   0x03
+#define O2_KEY_REG    0x0A
+
+bool SimSen0322::on_write(const uint8_t *data, size_t len) {
+    if (len >= 1) reg = data[0];
+    return true;
+}
+
+size_t SimSen0322::on_read(uint8_t *data, size_t len) {
+    if (len == 0) return 0;
+    if (reg == O2_KEY_REG) {
+        data[0] = key;
+        return 1;
+    }
+    if (reg == O2_DATA_REG && len >= 3) {
+        float factor = key ? key / 1000.0f : 20.9f / 120.0f;
+        float raw    = (o2_percent + jitter(noise)) / factor;
+        if (raw < 0) raw = 0;
+        uint32_t centi = (uint32_t)lroundf(raw * 100.0f);
+        data[0] = (uint8_t)(centi / 100 > 255 ? 255 : centi / 100);
+        data[1] = (uint8_t)((centi / 10) % 10);
+        data[2] = (uint8_t)(centi % 10);
+        return 3;
+    }
+    data[0] = 0;
+    return 1;
+}
+
+// ========== TMP117 ==========
+bool SimTmp117::on_write(const uint8_t *data, size_t len) {
+    if (len >= 1) reg = data[0];
+    if (len >= 3 && reg == 0x01) config = (uint16_t)((data[1] << 8) | data[2]);
+    return true;
+}
+
+size_t SimTmp117::on_read(uint8_t *data, size_t len) {
+    uint16_t v;
+    switch (reg) {
+        case 0x00: v = (uint16_t)(int16_t)lroundf((temp_c + jitter(noise)) / 0.0078125f); break;
+        case 0x01: v = config; break;
+        case 0x0F: v = 0x0117; break;
+        default:   v = 0; break;
+    }
+    if (len >= 1) data[0] = (uint8_t)(v >> 8);
+    if (len >= 2) data[1] = (uint8_t)v;
+    return len < 2 ? len : 2;
+}
@@ -0,0 +1,40 @@
+/******************************************************************************
+ * @file    sim_firmware.cpp
+ * @author  Thomas Zoldowski
+ * @date    October 18, 2026
+ * @brief   Firmware pieces a host simulation (HAL_SIM) builds without.
+ *
+ * On the board the settings getters belong to the settings screen; here
+ * they read the loaded Config directly. Host builds that link the
+ * settings screen (env:render) leave this file out.
+ ******************************************************************************/
+#include "settings_storage.h"
+
+// ========== settings_storage.h ==========
+uint16_t getBlowerOnTime() {
+    return config.blower_duration_sec;
+}
+
+uint16_t getPumpOnTime() {
+    return config.pump_duration_sec;
+}
+
+uint16_t getActivationInterval() {
+    return (uint16_t)(config.activation_interval_min * 60);
+}
+
+uint16_t getCameraDelay() {
+    return (uint16_t)config.camera_delay_sec;
+}
+
+uint16_t getSendInterval() {
+    return (uint16_t)config.send_interval_min;
+}
+
+uint16_t getTempHighThreshold(int sensor_id) {
+    return (uint16_t)config.temp_high[sensor_id];
+}
+
+uint16_t getHumLowThreshold(int sensor_id) {
+    return (uint16_t)config.hum_low[sensor_id];
+}
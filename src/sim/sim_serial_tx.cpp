@@ -0,0 +1,26 @@
+/******************************************************************************
+ * @file    sim_serial_tx.cpp
+ * @author  Thomas Zoldowski
+ * @date    October 18, 2026
+ * @brief   Telemetry side of serial_tx.h for host builds (HAL_SIM).
+ *
+ * On the board telemetry frames go to the Pi through the serial TX ring;
+ * here they are only counted.
+ ******************************************************************************/
+#include "serial_tx.h"
+
+static SerialTxStats tx_stats = {};
+
+bool serial_tx_write_telemetry(const uint8_t *data, size_t len) {
+    (void)data;
+    tx_stats.tlm_queued += (uint32_t)len;
+    tx_stats.written    += (uint32_t)len;
+    return true;
+}
+
+void serial_tx_kick() {
+}
+
+SerialTxStats serial_tx_get_stats() {
+    return tx_stats;
+}
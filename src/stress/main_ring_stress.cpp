@@ -0,0 +1,169 @@
+/******************************************************************************
+ * @file    main_ring_stress.cpp
+ * @author  Thomas Zoldowski
+ * @date    October 18, 2026
+ * @brief   Host stress test of SnapshotRing (snapshot_ring.h).
+ *
+ * One producer publishes numbered records in bursts while two
+ * threads read latest() and one consumer walks the ring with pop(). Every
+ * word of a record holds its number, so a copy that mixed two records
+ * shows up as torn. Checked:
+ *
+ *   latest()   never torn, and never older than a record the same reader
+ *              already saw
+ *   pop()      never torn, strictly in order, and got + lost == published
+ *              once the producer stopped and the ring was drained
+ *
+ * The ring is small (4 slots, as SENSOR_SNAPSHOT_SLOTS) and the record is
+ * bigger than a cache line, so the producer laps the readers often. A
+ * producer running flat out laps pop() on nearly every record, though, so
+ * by default it waits for the consumer to catch up every --pace records:
+ * each burst still overruns the ring, and pop() gets enough records to
+ * check. At every wait the ring still holds its last RING_SLOTS records
+ * untouched, so a paced run also fails if pop() got fewer than that per
+ * wait. --pace 0 floods the ring with no waits, which mostly tests
+ * latest(). Exit status is 1 if any check failed.
+ *
+ *   pio run -e ring_stress && .pio/build/ring_stress/program --records 20000000
+ *
+ * Options:
+ *   --records N     records to publish (default 20000000)
+ *   --pace K        wait for pop() every K records; 0 never waits (default 64)
+ ******************************************************************************/
+#include "snapshot_ring.h"
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <thread>
+
+#define RECORD_WORDS  24    // 96 bytes: three cache lines per slot
+#define RING_SLOTS    4
+#define READERS       2
+
+typedef struct {
+    uint32_t word[RECORD_WORDS];
+} Record;
+
+typedef struct {
+    uint64_t reads     = 0;
+    uint64_t empty     = 0;     // latest() gave up or nothing was new
+    uint64_t torn      = 0;
+    uint64_t regressed = 0;
+} ReaderStats;
+
+static SnapshotRing<Record, RING_SLOTS> ring;
+static std::atomic<bool>                done{false};
+static std::atomic<uint32_t>            popped{0};   // records pop() got or skipped
+
+/** @brief Record number, or 0 if the words disagree (a torn copy). */
+static uint32_t check(const Record &r) {
+    for (uint8_t i = 1; i < RECORD_WORDS; i++) {
+        if (r.word[i] != r.word[0]) return 0;
+    }
+    return r.word[0];
+}
+
+static void producer(uint32_t records, uint32_t pace) {
+    // Spinning only helps if the consumer has a core of its own; otherwise
+    // it starves the consumer along with the readers
+    bool   spin = std::thread::hardware_concurrency() >= READERS + 2;
+    Record r;
+    for (uint32_t n = 1; n <= records; n++) {
+        for (uint8_t i = 0; i < RECORD_WORDS; i++) r.word[i] = n;
+        ring.publish(r);
+        if (pace && n % pace == 0) {
+            // The newest record stays in the ring until the next publish,
+            // so pop() always reaches it
+            while (popped.load(std::memory_order_acquire) < n) {
+                if (spin) std::this_thread::yield();
+                else      std::this_thread::sleep_for(std::chrono::microseconds(20));
+            }
+        }
+    }
+    done.store(true, std::memory_order_release);
+}
+
+static void reader(ReaderStats &st) {
+    Record   r;
+    uint32_t last = 0;
+    while (!done.load(std::memory_order_acquire)) {
+        if (!ring.latest(r)) {
+            st.empty++;
+            continue;
+        }
+        st.reads++;
+        uint32_t n = check(r);
+        if (!n)            st.torn++;
+        else if (n < last) st.regressed++;
+        else               last = n;
+    }
+}
+
+static void consumer(uint64_t &got, uint32_t &lost, uint64_t &torn, uint64_t &disorder) {
+    Record   r;
+    uint32_t last = 0;
+    for (;;) {
+        bool finished = done.load(std::memory_order_acquire);   // before the last drain
+        while (ring.pop(r, lost)) {
+            got++;
+            uint32_t n = check(r);
+            if (!n)             torn++;
+            else if (n <= last) disorder++;
+            else                last = n;
+        }
+        popped.store((uint32_t)got + lost, std::memory_order_release);   // even if one was torn
+        if (finished) return;
+    }
+}
+
+int main(int argc, char **argv) {
+    uint32_t records = 20000000;
+    uint32_t pace    = 64;
+    for (int i = 1; i < argc; i++) {
+        if (!strcmp(argv[i], "--records") && i + 1 < argc) {
+            records = (uint32_t)strtoul(argv[++i], nullptr, 10);
+        } else if (!strcmp(argv[i], "--pace") && i + 1 < argc) {
+            pace = (uint32_t)strtoul(argv[++i], nullptr, 10);
+        } else {
+            fprintf(stderr, "usage: program [--records N] [--pace K]\n");
+            return 2;
+        }
+    }
+
+    ReaderStats rs[READERS];
+    uint64_t    got = 0, torn = 0, disorder = 0;
+    uint32_t    lost = 0;
+
+    auto t0 = std::chrono::steady_clock::now();
+    std::thread readers[READERS];
+    for (uint8_t i = 0; i < READERS; i++) readers[i] = std::thread(reader, std::ref(rs[i]));
+    std::thread cons(consumer, std::ref(got), std::ref(lost), std::ref(torn), std::ref(disorder));
+    std::thread prod(producer, records, pace);
+    prod.join();
+    for (auto &t : readers) t.join();
+    cons.join();
+    double secs = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+
+    bool ok = true;
+    for (uint8_t i = 0; i < READERS; i++) {
+        printf("latest() reader %u: %llu reads, %llu empty, %llu torn, %llu regressed\n", i,
+               (unsigned long long)rs[i].reads, (unsigned long long)rs[i].empty,
+               (unsigned long long)rs[i].torn, (unsigned long long)rs[i].regressed);
+        ok = ok && !rs[i].torn && !rs[i].regressed;
+    }
+    bool balanced = got + lost == ring.published();
+    printf("pop(): %llu got + %lu lost = %llu of %lu published, %llu torn, %llu out of order\n",
+           (unsigned long long)got, (unsigned long)lost, (unsigned long long)(got + lost),
+           (unsigned long)ring.published(), (unsigned long long)torn, (unsigned long long)disorder);
+    ok = ok && balanced && !torn && !disorder && ring.published() == records;
+    uint64_t floor = pace ? (uint64_t)(records / pace) * (pace < RING_SLOTS ? pace : RING_SLOTS) : 0;
+    if (got < floor) {
+        printf("pop() got fewer than the %llu records the ring held at the producer's waits\n",
+               (unsigned long long)floor);
+        ok = false;
+    }
+    printf("%lu records in %.2f s: %s\n", (unsigned long)records, secs, ok ? "PASS" : "FAIL");
+    return ok ? 0 : 1;
+}
@@ -9,6 +9,7 @@
  ******************************************************************************/
 
 #include "ui_manager.h"
+#include "ui_fonts.h"
 #include "screens/screen_home.h"
 #include "screens/screen_sensors.h"
 #include "screens/screen_warnings.h"
@@ -18,6 +19,10 @@
 #include <Arduino.h>
 #include <string.h>
 
+#define LOG_TAG   "UI"
+#define LOG_LEVEL LOG_LEVEL_UI
+#include "log.h"
+
 extern void global_input_event_cb(lv_event_t * e);
 
 static lv_style_t dropdown_list_style;
@@ -31,6 +36,7 @@ lv_obj_t *home_screen = nullptr;
 lv_obj_t *sensor_screen = nullptr;
 lv_obj_t *manual_screen = nullptr;
 lv_obj_t *warnings_screen = nullptr;
+lv_obj_t *history_screen = nullptr;
 lv_obj_t *settings_screen = nullptr;
 
 // Footer variables
@@ -39,8 +45,15 @@ static uint32_t last_footer_flash = 0;
 static uint32_t prev_warning_mask = -1;
 static const uint32_t FOOTER_FLASH_INTERVAL = 500;
 
-lv_obj_t *global_footer;
-lv_obj_t *global_footer_label;
+lv_obj_t *global_footer = nullptr;
+lv_obj_t *global_footer_label = nullptr;
+
+// Shared header bar (lives on lv_layer_top(), created once)
+static lv_obj_t *global_header = nullptr;
+static lv_obj_t *global_title  = nullptr;
+static lv_obj_t *active_header_actions = nullptr;  // header buttons of the active screen
+
+static void create_footer();
 
 // Global dropdown menu selection index
 lv_obj_t *dropdown = nullptr;
@@ -55,14 +68,14 @@ static void dropdown_event_handler(lv_event_t * e) {
     // Open drop down menu and Add styling
     if (code == LV_EVENT_CLICKED) {
         lv_dropdown_open(obj);
-        Serial.println("[GDL] opening dropdown"); // Debug
+        LOG_D("Opening dropdown");
         lv_obj_t *list = lv_dropdown_get_list(obj);
         if (list) {
             // Apply custom style only when the list is available
             lv_obj_add_style(list, &dropdown_list_style, LV_PART_MAIN | LV_STATE_DEFAULT);
             lv_obj_set_style_max_height(list, LV_SIZE_CONTENT, 0);
             lv_obj_set_scroll_dir(list, LV_DIR_NONE);
-            lv_obj_set_height(list, 71 * 4);
+            lv_obj_set_height(list, 71 * 5);
         }
     }
 
@@ -71,11 +84,8 @@ static void dropdown_event_handler(lv_event_t * e) {
         char buf[32];
        
         lv_dropdown_get_selected_str(obj, buf, sizeof(buf));
-        Serial.print("[GDL] Selected: ");
-        Serial.println(buf);
+        LOG_D("Dropdown selected: %s", buf);
         handle_screen_selection(buf);
-        lv_obj_set_parent(global_footer, current_screen);
-        lv_obj_set_align(global_footer, LV_ALIGN_BOTTOM_MID);
     }
 }
 
@@ -88,7 +98,7 @@ void create_global_dropdown(lv_obj_t *parent) {
 
     ensure_dropdown_style();
 
-    Serial.println("Create global dropdown"); // Debug
+    LOG_D("Create global dropdown");
 
     dropdown = lv_dropdown_create(parent);
 
@@ -100,6 +110,7 @@ void create_global_dropdown(lv_obj_t *parent) {
     "Sensor Overview\n"
     "Manual Control\n"
     "Warnings\n"
+    "History\n"
     "Settings"
     );
 
@@ -112,7 +123,7 @@ void create_global_dropdown(lv_obj_t *parent) {
     
     lv_dropdown_set_text(dropdown, "");
 
-    lv_obj_set_style_text_font(dropdown, &lv_font_montserrat_48, LV_PART_MAIN | LV_STATE_DEFAULT);
+    lv_obj_set_style_text_font(dropdown, UI_FONT_48, LV_PART_MAIN | LV_STATE_DEFAULT);
     
    
     // Click on menu button handler
@@ -127,22 +138,18 @@ void create_global_dropdown(lv_obj_t *parent) {
  *  @param selected_label The label of the selected screen from the dropdown menu.
  */
 void handle_screen_selection(const char *selected_label) {
-    Serial.println("[Screen Handler] changing Screens..."); // Debug
     int new_index = -1;
 
     if      (!strcmp(selected_label, "Sensor Overview"))   new_index = 0;
     else if (!strcmp(selected_label, "Manual Control"))    new_index = 1;
     else if (!strcmp(selected_label, "Warnings"))          new_index = 2;
-    else if (!strcmp(selected_label, "Settings"))          new_index = 3;
-    else if (!strcmp(selected_label, "Home"))              new_index = 4;
+    else if (!strcmp(selected_label, "History"))           new_index = 3;
+    else if (!strcmp(selected_label, "Settings"))          new_index = 4;
+    else if (!strcmp(selected_label, "Home"))              new_index = 5;
     else new_index = 0;
-    Serial.print("[Screen Handler] ");
-    Serial.println(selected_label);
-    Serial.print("[Screen Handler] new index: ");
-    Serial.println(new_index);
-    Serial.print("[Screen Handler] selected index: ");
-    Serial.println(selected_index);
-    if(new_index == selected_index) return; // no change
+    LOG_D("Screen change: %s (index %d, was %d)", selected_label, new_index, selected_index);
+    // no change (unless a screen outside the menu, e.g. Diagnostics, is showing)
+    if(new_index == selected_index && lv_scr_act() == current_screen) return;
 
     selected_index = new_index;
 
@@ -153,8 +160,9 @@ void handle_screen_selection(const char *selected_label) {
             case 0: current_screen = sensor_screen;         break;
             case 1: current_screen = manual_screen;         break;
             case 2: current_screen = warnings_screen;       break;
-            case 3: current_screen = settings_screen;       break;
-            case 4: current_screen = home_screen;           break;
+            case 3: current_screen = history_screen;        break;
+            case 4: current_screen = settings_screen;       break;
+            case 5: current_screen = home_screen;           break;
             default: current_screen = sensor_screen;        break;
         }
 
@@ -165,21 +173,22 @@ void handle_screen_selection(const char *selected_label) {
             lv_dropdown_set_selected_highlight(dropdown, selected_index);
         }
     }
-    Serial.println("[Screen Handler] Change Complete");
+    LOG_D("Screen change complete");
 }
 
 /** @brief Initialize the user interface
  * This function creates all the screens and sets up the global dropdown menu.
  */
 void ui_init() {
-    
+    // Header/footer first so screens can attach their header buttons
+    create_chrome();
+
     home_screen     = create_home_screen();
     sensor_screen   = create_sensor_screen();
     manual_screen   = create_manual_control_screen();
     warnings_screen = create_warnings_screen();
-    create_footer(warnings_screen);
+    history_screen  = create_history_screen();
     settings_screen = create_settings_screen();
-    create_footer(sensor_screen);
 }
 
 /** @brief Ensure the dropdown style is initialized.
@@ -189,7 +198,7 @@ void ui_init() {
 void ensure_dropdown_style() {
     if (!dropdown_style_initialized) {
         lv_style_init(&dropdown_list_style);
-        lv_style_set_text_font(&dropdown_list_style, &lv_font_montserrat_48);
+        lv_style_set_text_font(&dropdown_list_style, UI_FONT_48);
         lv_style_set_bg_color(&dropdown_list_style, lv_color_hex(0x42649F));
         lv_style_set_bg_grad_color(&dropdown_list_style, lv_color_hex(0xA3B7E4));
         lv_style_set_bg_grad_dir(&dropdown_list_style, LV_GRAD_DIR_HOR);
@@ -197,44 +206,94 @@ void ensure_dropdown_style() {
     }
 }
 
-/** @brief Create the header bar at the top of the screen.
- *  This function creates a header bar with a title and a global dropdown menu.
- *  @param parent Pointer to the parent object where the header will be created.
- *  @param title_txt The title text to display in the header.
- *  This function sets the header's background color, text color, and font.
+/** @brief Create the shared header, dropdown and footer on the top layer.
+ *  These objects are created once and stay alive for every screen, so a
+ *  screen switch only swaps the title text and the screen's header buttons.
  */
-void create_header(lv_obj_t *parent, const char *title_txt) {
-    Serial.println("[gH] creating header"); // Debug
+void create_chrome() {
+    LOG_D("Creating shared header");
+    lv_obj_t *top = lv_layer_top();
+
     // Header Bar
-    lv_obj_t *header = lv_obj_create(parent);
-    lv_obj_set_size(header, lv_pct(100), 80);
-    lv_obj_align(header, LV_ALIGN_TOP_MID, 0, 0);
-    lv_obj_set_style_bg_color(header, lv_color_hex(0x42649f), LV_PART_MAIN);
-    lv_obj_set_style_bg_opa(header, LV_OPA_COVER,    LV_PART_MAIN);
-    lv_obj_clear_flag(header, LV_OBJ_FLAG_SCROLLABLE);
-    lv_obj_set_scroll_dir(header, LV_DIR_NONE);
-
-    // Title Label
-    lv_obj_t *title = lv_label_create(header);
-    lv_label_set_text(title, title_txt);
-    lv_obj_center(title);
-    lv_obj_set_style_text_color(title, lv_color_hex(0xc0c9d9), 0);
-    lv_obj_set_style_text_font(title, &lv_font_montserrat_48,  0);
+    global_header = lv_obj_create(top);
+    lv_obj_set_size(global_header, lv_pct(100), 80);
+    lv_obj_align(global_header, LV_ALIGN_TOP_MID, 0, 0);
+    lv_obj_set_style_bg_color(global_header, lv_color_hex(0x42649f), LV_PART_MAIN);
+    lv_obj_set_style_bg_opa(global_header, LV_OPA_COVER,    LV_PART_MAIN);
+    lv_obj_clear_flag(global_header, LV_OBJ_FLAG_SCROLLABLE);
+    lv_obj_set_scroll_dir(global_header, LV_DIR_NONE);
+
+    // Title Label (text is set when a screen loads)
+    global_title = lv_label_create(global_header);
+    lv_label_set_text_static(global_title, "");
+    lv_obj_center(global_title);
+    lv_obj_set_style_text_color(global_title, lv_color_hex(0xc0c9d9), 0);
+    lv_obj_set_style_text_font(global_title, UI_FONT_48,  0);
 
     // Global navigation dropdown (icon-only)
-    Serial.println("[gH] creating GDL"); // Debug
-    
-    create_global_dropdown(parent);
+    create_global_dropdown(top);
+
+    create_footer();
+
+    // Nothing is shown until the first screen with a header loads
+    ui_set_chrome_visible(false);
 }
 
-/** @brief Create a footer bar at the bottom of the screen.
+/** @brief Screen load handler installed by create_header().
+ *  Swaps the shared title and the screen-specific header buttons.
+ *  @param e Pointer to the event data; user data is the screen's action container.
+ */
+static void header_screen_load_cb(lv_event_t *e) {
+    lv_obj_t *actions = (lv_obj_t *)lv_event_get_user_data(e);
+
+    if (active_header_actions && active_header_actions != actions) {
+        lv_obj_add_flag(active_header_actions, LV_OBJ_FLAG_HIDDEN);
+    }
+    active_header_actions = actions;
+
+    lv_label_set_text_static(global_title, (const char *)lv_obj_get_user_data(actions));
+    ui_set_chrome_visible(true);
+}
+
+/** @brief Register a screen with the shared header bar.
+ *  The header itself lives on the top layer; this only records the title
+ *  for @p parent and creates a container for its own header buttons.
+ *  @param parent Pointer to the screen the title belongs to.
+ *  @param title_txt The title text to display in the header.
+ *  @return Container over the header area for screen-specific buttons.
+ */
+lv_obj_t* create_header(lv_obj_t *parent, const char *title_txt) {
+    lv_obj_t *actions = lv_obj_create(lv_layer_top());
+    lv_obj_remove_style_all(actions);  // transparent, no padding
+    lv_obj_set_size(actions, lv_pct(100), 80);
+    lv_obj_align(actions, LV_ALIGN_TOP_MID, 0, 0);
+    lv_obj_clear_flag(actions, LV_OBJ_FLAG_CLICKABLE);   // let taps reach the header/dropdown
+    lv_obj_clear_flag(actions, LV_OBJ_FLAG_SCROLLABLE);
+    lv_obj_add_flag(actions, LV_OBJ_FLAG_HIDDEN);
+    lv_obj_set_user_data(actions, (void *)title_txt);
+
+    lv_obj_add_event_cb(parent, header_screen_load_cb, LV_EVENT_SCREEN_LOAD_START, actions);
+    return actions;
+}
+
+/** @brief Show or hide the shared header, dropdown and footer.
+ *  @param visible True to show them (normal screens), false for full-screen views like Home.
+ */
+void ui_set_chrome_visible(bool visible) {
+    lv_obj_t *parts[] = { global_header, dropdown, global_footer, active_header_actions };
+    for (lv_obj_t *obj : parts) {
+        if (!obj) continue;
+        if (visible) lv_obj_clear_flag(obj, LV_OBJ_FLAG_HIDDEN);
+        else         lv_obj_add_flag(obj, LV_OBJ_FLAG_HIDDEN);
+    }
+}
+
+/** @brief Create the footer bar at the bottom of the top layer.
  *  This function creates a footer bar with a label to display system status.
- *  @param parent Pointer to the parent object where the footer will be created.
  *  This function sets the footer's background color, text color, and font.
  */
-void create_footer(lv_obj_t *parent) {
-    lv_obj_t *scr = parent ? parent : lv_scr_act();
-    global_footer = lv_obj_create(scr);
+static void create_footer() {
+    global_footer = lv_obj_create(lv_layer_top());
     lv_obj_set_size(global_footer, lv_pct(100), 60);
     lv_obj_align(global_footer, LV_ALIGN_BOTTOM_MID, 0, 0);
     lv_obj_set_style_bg_color(global_footer, lv_color_hex(0x1AC41F), 0);
@@ -247,7 +306,7 @@ void create_footer(lv_obj_t *parent) {
     lv_obj_align(global_footer_label, LV_ALIGN_CENTER, 0, 0);
     lv_label_set_text(global_footer_label, "ALL SYSTEMS NOMINAL");
     lv_obj_set_style_text_color(global_footer_label, lv_color_hex(0x094211), 0);
-    lv_obj_set_style_text_font(global_footer_label, &lv_font_montserrat_48, 0);
+    lv_obj_set_style_text_font(global_footer_label, UI_FONT_48, 0);
     lv_obj_set_style_text_align(global_footer_label, LV_TEXT_ALIGN_CENTER, 0);
 }
 
@@ -259,25 +318,28 @@ void create_footer(lv_obj_t *parent) {
  */
 void update_footer_status(uint32_t warning_mask) {
     if(!global_footer || !global_footer_label) return;
-    // Only update the text when the mask actually changes:
-    char buf[128];
-    format_warnings(warning_mask, buf, sizeof(buf), global_footer_label);
-    if (buf[0] == '\0') {
-        // If the buffer is empty, just return
-        return;
-    }
-    lv_label_set_text(global_footer_label, buf);
-    prev_warning_mask = warning_mask;
-
-    // If no warnings, show green and bail out
-    if (warning_mask == WARN_NONE) {
-        lv_obj_set_style_bg_color(global_footer, lv_color_hex(0x1AC41F), 0);
-        lv_obj_set_style_text_align(global_footer_label, LV_TEXT_ALIGN_CENTER, 0);
-        // reset flash state so it restarts clean next time
-        footer_flash_state = false;
-        last_footer_flash = millis();
-        return;
+    // Only update the text when the mask actually changes; re-setting the
+    // same text/colour would invalidate (and re-render) the footer each call
+    if (warning_mask != prev_warning_mask) {
+        char buf[128];
+        format_warnings(warning_mask, buf, sizeof(buf), global_footer_label);
+        if (buf[0] == '\0') {
+            // If the buffer is empty, just return
+            return;
+        }
+        lv_label_set_text(global_footer_label, buf);
+        prev_warning_mask = warning_mask;
+
+        // If no warnings, show green
+        if (warning_mask == WARN_NONE) {
+            lv_obj_set_style_bg_color(global_footer, lv_color_hex(0x1AC41F), 0);
+            lv_obj_set_style_text_align(global_footer_label, LV_TEXT_ALIGN_CENTER, 0);
+            // reset flash state so it restarts clean next time
+            footer_flash_state = false;
+            last_footer_flash = millis();
+        }
     }
+    if (warning_mask == WARN_NONE) return;
 
     // Otherwise, flash between dark and bright red every interval
     uint32_t t = millis();
@@ -0,0 +1,116 @@
+#!/usr/bin/env python3
+"""
+@file    bench_compare.py
+@author  Thomas Zoldowski
+@date    October 18, 2026
+@brief   Check microbenchmark results against the stored baseline.
+
+Reads the "BENCH: <case> iters=N ns/op=X [cycles/op=Y]" lines that
+src/bench/bench.cpp prints (other output, e.g. the firmware log, is
+skipped) and compares each case with tools/bench_baseline.json. Board
+results are compared in cycles/op, which don't depend on the core clock;
+host results in ns/op. The baseline is kept per build environment, since
+a host and the GIGA have nothing in common.
+
+Exit status is 1 if any case got slower than the tolerance allows, so
+this can gate a build. Host timings vary between machines: record the
+baseline on the machine that runs the comparison.
+
+Usage:
+    .pio/build/bench/program | python tools/bench_compare.py --env bench
+    python tools/bench_compare.py --env bench --run .pio/build/bench/program
+    python tools/bench_compare.py --env giga_r1_m7_bench serial_capture.txt
+    python tools/bench_compare.py --env bench --run .pio/build/bench/program --update
+"""
+
+import argparse
+import json
+import os
+import re
+import subprocess
+import sys
+
+LINE = re.compile(r"BENCH: (\S+) iters=(\d+) ns/op=([\d.]+)(?: cycles/op=([\d.]+))?")
+BASELINE = os.path.join(os.path.dirname(os.path.abspath(__file__)), "bench_baseline.json")
+
+
+def parse(lines):
+    """Return {case: (value, unit)} from bench output."""
+    results = {}
+    for line in lines:
+        m = LINE.search(line)
+        if not m:
+            continue
+        name, _, ns, cycles = m.groups()
+        results[name] = (float(cycles), "cycles/op") if cycles else (float(ns), "ns/op")
+    return results
+
+
+def main():
+    ap = argparse.ArgumentParser(description=__doc__.split("\n\n")[0])
+    ap.add_argument("files", nargs="*", help="bench output (default: stdin)")
+    ap.add_argument("--env", required=True, help="build environment the results came from")
+    ap.add_argument("--run", metavar="CMD", help="run this bench program and read its output")
+    ap.add_argument("--baseline", default=BASELINE)
+    ap.add_argument("--tolerance", type=float, default=25.0,
+                    help="percent slower than the baseline before a case fails (default 25)")
+    ap.add_argument("--update", action="store_true",
+                    help="store these results as the baseline for --env")
+    args = ap.parse_args()
+
+    if args.run:
+        lines = subprocess.run(args.run, shell=True, check=True, capture_output=True,
+                               text=True).stdout.splitlines()
+    elif args.files:
+        lines = []
+        for path in args.files:
+            with open(path, errors="replace") as f:
+                lines += f.read().splitlines()
+    else:
+        lines = sys.stdin.read().splitlines()
+
+    results = parse(lines)
+    if not results:
+        sys.exit("no BENCH lines in the input")
+
+    baseline = {}
+    if os.path.exists(args.baseline):
+        with open(args.baseline) as f:
+            baseline = json.load(f)
+
+    if args.update:
+        baseline[args.env] = {name: {"value": v, "unit": u} for name, (v, u) in sorted(results.items())}
+        with open(args.baseline, "w") as f:
+            json.dump(baseline, f, indent=2, sort_keys=True)
+            f.write("\n")
+        print("%s: stored %d cases for %s" % (args.baseline, len(results), args.env))
+        return
+
+    ref = baseline.get(args.env)
+    if ref is None:
+        sys.exit("no baseline for %s; record one with --update" % args.env)
+
+    failed = 0
+    print("%-18s %12s %12s %8s" % ("case", "baseline", "now", "change"))
+    for name, (value, unit) in results.items():
+        base = ref.get(name)
+        if base is None or base["unit"] != unit:
+            print("%-18s %12s %12.1f %8s  new" % (name, "-", value, ""))
+            continue
+        change = (value / base["value"] - 1.0) * 100.0 if base["value"] else 0.0
+        flag = ""
+        if change > args.tolerance:
+            flag = "  SLOWER"
+            failed += 1
+        print("%-18s %12.1f %12.1f %+7.1f%%%s" % (name, base["value"], value, change, flag))
+    for name in sorted(set(ref) - set(results)):
+        print("%-18s %12.1f %12s %8s  missing" % (name, ref[name]["value"], "-", ""))
+
+    print("%s, %d of %d cases slower than %.0f%% (%s)" %
+          ("FAIL" if failed else "ok", failed, len(results), args.tolerance,
+           next(iter(results.values()))[1]))
+    sys.exit(1 if failed else 0)
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,182 @@
+"""
+@file    gen_fonts.py
+@author  Thomas Zoldowski
+@date    October 18, 2026
+@brief   Generate subset Montserrat 36/40/48 fonts from the UI's own strings.
+
+PlatformIO pre-script (see extra_scripts in platformio.ini). It collects every
+character used in string literals under src/screens and src/ui_manager.cpp,
+and in the logic modules they include (those hand them text to show, e.g.
+the footer warnings of warning_log.cpp), plus the LV_SYMBOLs referenced
+there and the ones LVGL widgets draw by themselves (WIDGET_SYMBOLS). It
+then runs lv_font_conv to build src/fonts/ui_font_<size>.c with only those
+glyphs. On success it defines UI_SUBSET_FONTS so ui_fonts.h picks the
+subset fonts; otherwise the build falls back to LVGL's built-in
+lv_font_montserrat_* fonts.
+
+Space, punctuation and the digits (0x20-0x3F) are always emitted as one
+contiguous range. lv_font_conv stores a contiguous range as a direct-index
+cmap, so looking up a digit is a subtraction instead of a search; this is
+what the large numeric readouts draw.
+
+Needs lv_font_conv (npm i -g lv_font_conv) and the fonts LVGL uses for its
+built-ins: Montserrat-Medium.ttf and FontAwesome5-Solid+Brands+Regular.woff,
+either in tools/fonts/ or in the LVGL package's scripts/built_in_font/.
+
+Can also be run by hand: python tools/gen_fonts.py
+"""
+
+import glob
+import hashlib
+import os
+import re
+import shutil
+import subprocess
+
+SIZES = (36, 40, 48)
+BPP = 4
+
+# Codepoints of the LV_SYMBOLs the UI may use (lvgl/src/font/lv_symbol_def.h)
+SYMBOLS = {
+    "LV_SYMBOL_LIST": 0xF00B,
+    "LV_SYMBOL_OK": 0xF00C,
+    "LV_SYMBOL_CLOSE": 0xF00D,
+    "LV_SYMBOL_POWER": 0xF011,
+    "LV_SYMBOL_SETTINGS": 0xF013,
+    "LV_SYMBOL_HOME": 0xF015,
+    "LV_SYMBOL_REFRESH": 0xF021,
+    "LV_SYMBOL_LEFT": 0xF053,
+    "LV_SYMBOL_RIGHT": 0xF054,
+    "LV_SYMBOL_PLUS": 0xF067,
+    "LV_SYMBOL_MINUS": 0xF068,
+    "LV_SYMBOL_WARNING": 0xF071,
+    "LV_SYMBOL_UP": 0xF077,
+    "LV_SYMBOL_DOWN": 0xF078,
+    "LV_SYMBOL_KEYBOARD": 0xF11C,
+    "LV_SYMBOL_WIFI": 0xF1EB,
+    "LV_SYMBOL_USB": 0xF287,
+    "LV_SYMBOL_BACKSPACE": 0xF55A,
+}
+
+# Symbols LVGL draws itself, keyed by what in the sources brings them in
+WIDGET_SYMBOLS = {
+    # lv_keyboard's number map (lv_keyboard.c); its text is in DENSE_BLOCK
+    "LV_KEYBOARD_MODE_NUMBER": ("LV_SYMBOL_KEYBOARD", "LV_SYMBOL_OK", "LV_SYMBOL_BACKSPACE",
+                                "LV_SYMBOL_LEFT", "LV_SYMBOL_RIGHT"),
+    "lv_msgbox_add_close_button": ("LV_SYMBOL_CLOSE",),
+    "lv_dropdown_create": ("LV_SYMBOL_DOWN",),   # until lv_dropdown_set_symbol()
+}
+
+DENSE_BLOCK = range(0x20, 0x40)   # space, punctuation, digits
+EXTRA_CHARS = ""                  # text only built at runtime (not in a literal)
+GAP_FILL = 2                      # merge ranges separated by <= 2 unused chars
+
+
+def project_dir():
+    try:
+        return env.subst("$PROJECT_DIR")  # noqa: F821 (SCons)
+    except NameError:
+        return os.path.dirname(os.path.dirname(os.path.abspath(__file__)))
+
+
+def ui_sources(root):
+    """The screens, ui_manager.cpp and every logic module they include."""
+    files = glob.glob(os.path.join(root, "src", "screens", "*.cpp"))
+    files.append(os.path.join(root, "src", "ui_manager.cpp"))
+    files = [f for f in files if os.path.exists(f)]
+    for path in list(files):
+        for mod in re.findall(r'#include\s+"logic/(\w+)\.h"', open(path, encoding="utf-8").read()):
+            files.append(os.path.join(root, "src", "logic", mod + ".cpp"))
+    return sorted(set(f for f in files if os.path.exists(f)))
+
+
+def collect(root):
+    """Return (text codepoints, symbol codepoints) used by the UI sources."""
+    chars, symbols = set(DENSE_BLOCK) | set(map(ord, EXTRA_CHARS)), set()
+    for path in ui_sources(root):
+        src = open(path, encoding="utf-8").read()
+        src = re.sub(r"//[^\n]*|/\*.*?\*/", "", src, flags=re.S)  # ignore comments
+        src = re.sub(r"^\s*#.*$", "", src, flags=re.M)           # preprocessor lines
+        src = re.sub(r"\b(?:Serial\.print\w*|LOG_[EWID]|static_assert|supervisor_register)"
+                     r"\s*\([^;]*;", "", src)                      # debug and internal text
+        src = re.sub(r"\bThread\s+\w+\s*\([^;]*;", "", src)       # thread names
+        for lit in re.findall(r'"((?:[^"\\\n]|\\.)*)"', src):
+            lit = re.sub(r"\\[nrt\\\"']", "", lit)
+            lit = re.sub(r"%[-+ 0#]*\d*(?:\.\d+)?[a-zA-Z]+", "", lit)  # printf specifiers
+            chars.update(ord(c) for c in lit if c.isprintable() and ord(c) <= 0xFF)
+        names = re.findall(r"LV_SYMBOL_[A-Z_]+", src)
+        for key, implied in WIDGET_SYMBOLS.items():
+            if re.search(r"\b%s\b" % key, src):
+                names += implied
+        for name in names:
+            if name in SYMBOLS:
+                symbols.add(SYMBOLS[name])
+    return chars, symbols
+
+
+def ranges(codepoints, gap=GAP_FILL):
+    """Turn codepoints into lv_font_conv ranges, bridging small gaps."""
+    out = []
+    for cp in sorted(codepoints):
+        if out and cp - out[-1][1] <= gap + 1:
+            out[-1][1] = cp
+        else:
+            out.append([cp, cp])
+    return ",".join("0x%X" % a if a == b else "0x%X-0x%X" % (a, b) for a, b in out)
+
+
+def find_font(root, name):
+    candidates = [os.path.join(root, "tools", "fonts", name)]
+    candidates += glob.glob(os.path.join(root, ".pio", "libdeps", "*", "lvgl",
+                                         "scripts", "built_in_font", name))
+    return next((c for c in candidates if os.path.exists(c)), None)
+
+
+def converter():
+    exe = shutil.which("lv_font_conv")
+    return [exe] if exe else None
+
+
+def generate(root):
+    """Build the subset fonts. Returns True if they are present and current."""
+    text, symbols = collect(root)
+    text_r, sym_r = ranges(text), ranges(symbols, gap=0)
+    out_dir = os.path.join(root, "src", "fonts")
+    stamp = os.path.join(out_dir, ".ui_fonts.stamp")
+    key = hashlib.sha1(("%s|%s|%s|%d" % (text_r, sym_r, SIZES, BPP)).encode()).hexdigest()
+
+    outputs = [os.path.join(out_dir, "ui_font_%d.c" % s) for s in SIZES]
+    if os.path.exists(stamp) and open(stamp).read() == key and all(map(os.path.exists, outputs)):
+        return True
+
+    conv = converter()
+    text_font = find_font(root, "Montserrat-Medium.ttf")
+    sym_font = find_font(root, "FontAwesome5-Solid+Brands+Regular.woff")
+    if not conv or not text_font or (symbols and not sym_font):
+        print("[fonts] lv_font_conv or font files not found; using built-in Montserrat fonts")
+        return False
+
+    os.makedirs(out_dir, exist_ok=True)
+    print("[fonts] glyphs: %s  symbols: %s" % (text_r, sym_r or "-"))
+    for size, out in zip(SIZES, outputs):
+        cmd = conv + ["--bpp", str(BPP), "--size", str(size), "--no-compress",
+                      "--format", "lvgl", "--lv-include", "lvgl.h",
+                      "--lv-font-name", "ui_font_%d" % size,
+                      "--font", text_font, "-r", text_r]
+        if symbols:
+            cmd += ["--font", sym_font, "-r", sym_r]
+        cmd += ["-o", out]
+        if subprocess.call(cmd) != 0:
+            print("[fonts] lv_font_conv failed for size %d; using built-in fonts" % size)
+            return False
+    with open(stamp, "w") as f:
+        f.write(key)
+    return True
+
+
+if __name__ == "__main__":
+    print("subset fonts ready" if generate(project_dir()) else "using built-in fonts")
+else:
+    Import("env")  # noqa: F821 (SCons)
+    if generate(project_dir()):
+        env.Append(CPPDEFINES=["UI_SUBSET_FONTS"])  # noqa: F821
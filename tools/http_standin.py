@@ -0,0 +1,149 @@
+#!/usr/bin/env python3
+"""
+@file    http_standin.py
+@author  Thomas Zoldowski
+@date    October 18, 2026
+@brief   Local HTTP/1.1 keep-alive stand-in for the readings API.
+
+Lets the GIGA's Wi-Fi uploader (network_manager.cpp) be exercised on the
+bench without the cloud endpoint. Every POST body is checked as JSON and
+logged with the connection it arrived on, so connection reuse is visible
+at a glance: "conn 3 req 12" means twelve uploads shared one connection.
+
+The failure options reproduce what the uploader has to survive: servers
+that close after a few requests, idle timeouts shorter than the upload
+interval, 5xx errors, slow replies and chunked responses.
+
+Build the firmware for plain HTTP against this machine, e.g.
+    -DNET_UPLOAD_ENABLED=1 -DNET_USE_TLS=0 -DAPI_HOST=\\"192.168.1.20\\" -DAPI_PORT=8080
+
+Usage:
+    python tools/http_standin.py --port 8080
+    python tools/http_standin.py --port 8080 --idle-timeout 20 --close-every 5
+    python tools/http_standin.py --port 8080 --fail-every 4 --delay-ms 800 --chunked
+"""
+
+import argparse
+import itertools
+import json
+import threading
+import time
+from http.server import BaseHTTPRequestHandler, ThreadingHTTPServer
+
+stats_lock = threading.Lock()
+stats = {"connections": 0, "requests": 0, "bad_json": 0}
+conn_ids = itertools.count(1)
+
+
+def make_handler(args):
+    class StandinHandler(BaseHTTPRequestHandler):
+        protocol_version = "HTTP/1.1"   # keep-alive unless a side says close
+        timeout = args.idle_timeout     # idle connections are closed after this
+
+        def setup(self):
+            super().setup()
+            self.conn_id = next(conn_ids)
+            self.conn_requests = 0
+            with stats_lock:
+                stats["connections"] += 1
+            print(f"conn {self.conn_id} open from {self.client_address[0]}")
+
+        def finish(self):
+            super().finish()
+            print(f"conn {self.conn_id} closed after {self.conn_requests} request(s)")
+
+        def log_message(self, fmt, *fargs):
+            pass   # one line per request is printed by do_POST instead
+
+        def reply(self, status, body, close=False):
+            data = json.dumps(body).encode()
+            self.send_response(status)
+            self.send_header("Content-Type", "application/json")
+            if close:
+                self.send_header("Connection", "close")
+                self.close_connection = True
+            else:
+                self.send_header("Keep-Alive", f"timeout={args.idle_timeout}")
+            if args.chunked:
+                self.send_header("Transfer-Encoding", "chunked")
+                self.end_headers()
+                half = len(data) // 2
+                for part in (data[:half], data[half:]):
+                    if part:
+                        self.wfile.write(f"{len(part):x}\r\n".encode() + part + b"\r\n")
+                self.wfile.write(b"0\r\n\r\n")
+            else:
+                self.send_header("Content-Length", str(len(data)))
+                self.end_headers()
+                self.wfile.write(data)
+
+        def do_POST(self):
+            started = time.monotonic()
+            self.conn_requests += 1
+            with stats_lock:
+                stats["requests"] += 1
+                n = stats["requests"]
+
+            length = int(self.headers.get("Content-Length", 0))
+            raw = self.rfile.read(length)
+            try:
+                reading = json.loads(raw)
+                summary = (f"ts={reading.get('timestamp')} "
+                           f"temps={[s.get('temp') for s in reading.get('sensor', [])]} "
+                           f"o2={reading.get('o2')}")
+            except ValueError:
+                with stats_lock:
+                    stats["bad_json"] += 1
+                print(f"conn {self.conn_id} req {self.conn_requests}: bad JSON {raw[:80]!r}")
+                self.reply(400, {"error": "bad json"})
+                return
+
+            if args.delay_ms:
+                time.sleep(args.delay_ms / 1000.0)
+
+            fail = args.fail_every and n % args.fail_every == 0
+            close = args.close_every and self.conn_requests % args.close_every == 0
+            status = 503 if fail else 200
+            self.reply(status, {"ok": not fail, "n": n}, close=bool(close))
+
+            took = (time.monotonic() - started) * 1000.0
+            flags = (" [503]" if fail else "") + (" [close]" if close else "")
+            print(f"conn {self.conn_id} req {self.conn_requests} ({took:.0f} ms): "
+                  f"{self.path} {summary}{flags}")
+
+    return StandinHandler
+
+
+def main():
+    ap = argparse.ArgumentParser(description=__doc__.split("\n\n")[0])
+    ap.add_argument("--host", default="0.0.0.0")
+    ap.add_argument("--port", type=int, default=8080)
+    ap.add_argument("--idle-timeout", type=int, default=120,
+                    help="seconds before an idle connection is closed (sent as Keep-Alive)")
+    ap.add_argument("--close-every", type=int, default=0,
+                    help="answer every Nth request on a connection with Connection: close")
+    ap.add_argument("--fail-every", type=int, default=0,
+                    help="answer every Nth request overall with 503")
+    ap.add_argument("--delay-ms", type=int, default=0,
+                    help="wait this long before answering")
+    ap.add_argument("--chunked", action="store_true",
+                    help="send responses with Transfer-Encoding: chunked")
+    args = ap.parse_args()
+
+    server = ThreadingHTTPServer((args.host, args.port), make_handler(args))
+    server.daemon_threads = True
+    print(f"Listening on {args.host}:{args.port}")
+    try:
+        server.serve_forever()
+    except KeyboardInterrupt:
+        pass
+    finally:
+        server.server_close()
+        with stats_lock:
+            c, r = stats["connections"], stats["requests"]
+        print(f"\n{r} request(s) over {c} connection(s), "
+              f"{r / c if c else 0:.1f} per connection, {stats['bad_json']} bad JSON")
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,180 @@
+#!/usr/bin/env python3
+"""
+@file    mqtt_standin.py
+@author  Thomas Zoldowski
+@date    October 18, 2026
+@brief   Local MQTT 3.1.1 stand-in broker for the GIGA's publisher.
+
+Speaks just enough MQTT for network_manager.cpp: CONNECT/CONNACK,
+PUBLISH (QoS 0/1) with PUBACK, PINGREQ/PINGRESP and DISCONNECT. Nothing
+is forwarded; every PUBLISH is decoded and counted so throughput, batch
+sizes and duplicates after a reconnect can be read off the summary.
+
+A real mosquitto works just as well for plain delivery; this stand-in adds
+the failure modes the spool has to cope with: a broker that is down for a
+while, one that drops connections with PUBACKs outstanding, and slow acks.
+
+Usage:
+    python tools/mqtt_standin.py --port 1883
+    python tools/mqtt_standin.py --down-for 120          # refuse connections for 2 min
+    python tools/mqtt_standin.py --drop-every 25 --ack-delay-ms 50
+"""
+
+import argparse
+import json
+import socket
+import threading
+import time
+
+lock = threading.Lock()
+stats = {"connections": 0, "publishes": 0, "readings": 0, "bytes": 0,
+         "duplicates": 0, "dropped_conns": 0}
+seen = set()
+started = time.monotonic()
+first_pub = None
+last_pub = None
+
+
+def recv_exact(sock, n):
+    buf = b""
+    while len(buf) < n:
+        chunk = sock.recv(n - len(buf))
+        if not chunk:
+            raise ConnectionError("closed")
+        buf += chunk
+    return buf
+
+
+def read_packet(sock):
+    """Return (type, flags, body) for one control packet."""
+    h = recv_exact(sock, 1)[0]
+    length, shift = 0, 0
+    while True:
+        b = recv_exact(sock, 1)[0]
+        length |= (b & 0x7F) << shift
+        if not b & 0x80:
+            break
+        shift += 7
+    return h >> 4, h & 0x0F, recv_exact(sock, length) if length else b""
+
+
+def count_readings(payload):
+    """Count readings in a batch and note ones already delivered."""
+    global first_pub, last_pub
+    try:
+        doc = json.loads(payload)
+    except ValueError:
+        print(f"  bad JSON: {payload[:80]!r}")
+        return 0
+    readings = doc.get("readings", [doc])
+    now = time.monotonic()
+    with lock:
+        first_pub = first_pub or now
+        last_pub = now
+        for r in readings:
+            key = json.dumps(r, sort_keys=True)
+            if key in seen:
+                stats["duplicates"] += 1
+            seen.add(key)
+    return len(readings)
+
+
+def serve(conn, addr, args, conn_id):
+    pubs = 0
+    try:
+        ptype, _, _ = read_packet(conn)
+        if ptype != 1:
+            return
+        conn.sendall(bytes([0x20, 2, 0, 0]))          # CONNACK, accepted
+        print(f"conn {conn_id} from {addr[0]} connected")
+        while True:
+            ptype, flags, body = read_packet(conn)
+            if ptype == 3:                             # PUBLISH
+                tlen = (body[0] << 8) | body[1]
+                topic = body[2:2 + tlen].decode(errors="replace")
+                pos = 2 + tlen
+                qos = (flags >> 1) & 3
+                pid = None
+                if qos:
+                    pid = (body[pos] << 8) | body[pos + 1]
+                    pos += 2
+                payload = body[pos:]
+                n = count_readings(payload)
+                pubs += 1
+                with lock:
+                    stats["publishes"] += 1
+                    stats["readings"] += n
+                    stats["bytes"] += len(body) + 2
+                if args.verbose:
+                    print(f"conn {conn_id} pid {pid} {topic}: {n} reading(s), {len(payload)} B")
+                if args.drop_every and pubs % args.drop_every == 0:
+                    with lock:
+                        stats["dropped_conns"] += 1
+                    print(f"conn {conn_id}: dropping with pid {pid} unacknowledged")
+                    return
+                if qos:
+                    if args.ack_delay_ms:
+                        time.sleep(args.ack_delay_ms / 1000.0)
+                    conn.sendall(bytes([0x40, 2, pid >> 8, pid & 0xFF]))
+            elif ptype == 12:                          # PINGREQ
+                conn.sendall(bytes([0xD0, 0]))
+            elif ptype == 14:                          # DISCONNECT
+                return
+    except (ConnectionError, OSError):
+        pass
+    finally:
+        conn.close()
+        print(f"conn {conn_id} closed after {pubs} publish(es)")
+
+
+def summary():
+    with lock:
+        s = dict(stats)
+        span = (last_pub - first_pub) if first_pub and last_pub else 0
+    print(f"\n{s['publishes']} publish(es), {s['readings']} reading(s) "
+          f"({s['readings'] - s['duplicates']} unique, {s['duplicates']} duplicate), "
+          f"{s['bytes']} B over {s['connections']} connection(s), "
+          f"{s['dropped_conns']} dropped on purpose")
+    if span > 0:
+        print(f"{s['readings'] / span:.1f} readings/s, {s['bytes'] / span / 1024:.1f} KiB/s "
+              f"between first and last publish")
+
+
+def main():
+    ap = argparse.ArgumentParser(description=__doc__.split("\n\n")[0])
+    ap.add_argument("--host", default="0.0.0.0")
+    ap.add_argument("--port", type=int, default=1883)
+    ap.add_argument("--down-for", type=float, default=0,
+                    help="seconds after start during which connections are closed at once")
+    ap.add_argument("--drop-every", type=int, default=0,
+                    help="close the connection instead of acking every Nth publish on it")
+    ap.add_argument("--ack-delay-ms", type=int, default=0,
+                    help="wait this long before each PUBACK")
+    ap.add_argument("-v", "--verbose", action="store_true", help="print every publish")
+    args = ap.parse_args()
+
+    srv = socket.socket(socket.AF_INET, socket.SOCK_STREAM)
+    srv.setsockopt(socket.SOL_SOCKET, socket.SO_REUSEADDR, 1)
+    srv.bind((args.host, args.port))
+    srv.listen()
+    print(f"Listening on {args.host}:{args.port}")
+    conn_id = 0
+    try:
+        while True:
+            conn, addr = srv.accept()
+            if time.monotonic() - started < args.down_for:
+                conn.close()                           # looks like an unreachable broker
+                continue
+            conn_id += 1
+            with lock:
+                stats["connections"] += 1
+            threading.Thread(target=serve, args=(conn, addr, args, conn_id), daemon=True).start()
+    except KeyboardInterrupt:
+        pass
+    finally:
+        srv.close()
+        summary()
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,125 @@
+#!/usr/bin/env python3
+"""
+@file    pack_image.py
+@author  Thomas Zoldowski
+@date    October 18, 2026
+@brief   Convert an RGB565 image into a palette + PackBits C asset.
+
+The firmware decodes the asset once into SDRAM (see packed_image.h), so the
+image costs a few KB of flash instead of w*h*2 bytes.
+
+Input is either an LVGL RGB565 C array (as written by the LVGL image
+converter) or any image Pillow can open.
+
+Usage:
+    python tools/pack_image.py GVSU_Logo.png  GVSU_Logo src/GVSU_Logo.c
+    python tools/pack_image.py old_GVSU_Logo.c GVSU_Logo src/GVSU_Logo.c
+"""
+
+import re
+import sys
+
+MAX_COLORS = 256
+
+
+def load_lvgl_c(path):
+    """Read pixels, width and height from an LVGL RGB565 C array."""
+    src = open(path).read()
+    body = src[src.index("[] = {") + 6:src.index("};")]
+    raw = bytes(int(x, 16) for x in re.findall(r"0x[0-9a-fA-F]{2}", body))
+    w = int(re.search(r"\.header\.w\s*=\s*(\d+)", src).group(1))
+    h = int(re.search(r"\.header\.h\s*=\s*(\d+)", src).group(1))
+    px = [raw[i] | (raw[i + 1] << 8) for i in range(0, len(raw), 2)]
+    return px, w, h
+
+
+def load_image(path):
+    """Read pixels from a regular image file and convert them to RGB565."""
+    from PIL import Image
+    img = Image.open(path).convert("RGB")
+    w, h = img.size
+    px = [((r >> 3) << 11) | ((g >> 2) << 5) | (b >> 3) for r, g, b in img.getdata()]
+    return px, w, h
+
+
+def packbits(data):
+    """PackBits: n<128 -> n+1 literal bytes follow; n>128 -> next byte repeats 257-n times."""
+    out = bytearray()
+    i = 0
+    while i < len(data):
+        run = 1
+        while i + run < len(data) and run < 128 and data[i + run] == data[i]:
+            run += 1
+        if run >= 3:
+            out += bytes((257 - run, data[i]))
+            i += run
+            continue
+        # Literal block up to the next run of 3
+        j = i
+        while j < len(data) and j - i < 128:
+            if j + 2 < len(data) and data[j] == data[j + 1] == data[j + 2]:
+                break
+            j += 1
+        out.append(j - i - 1)
+        out += data[i:j]
+        i = j
+    return bytes(out)
+
+
+def c_bytes(data, per_line=24):
+    lines = []
+    for i in range(0, len(data), per_line):
+        lines.append("  " + ", ".join("0x%02x" % b for b in data[i:i + per_line]) + ",")
+    return "\n".join(lines)
+
+
+def main():
+    if len(sys.argv) != 4:
+        print(__doc__)
+        sys.exit(1)
+    src, name, dst = sys.argv[1:]
+    px, w, h = load_lvgl_c(src) if src.endswith(".c") else load_image(src)
+
+    palette = sorted(set(px))
+    if len(palette) > MAX_COLORS:
+        sys.exit("%d colors; at most %d are supported" % (len(palette), MAX_COLORS))
+    index = {c: i for i, c in enumerate(palette)}
+    packed = packbits(bytes(index[c] for c in px))
+
+    pal = "\n".join("  " + ", ".join("0x%04x" % c for c in palette[i:i + 12]) + ","
+                    for i in range(0, len(palette), 12))
+    with open(dst, "w") as f:
+        f.write(f"""/******************************************************************************
+ * @file    {dst.split('/')[-1]}
+ * @author  Thomas Zoldowski
+ * @date    October 18, 2026
+ * @brief   {name} image, palette + PackBits compressed.
+ *
+ * Generated by tools/pack_image.py - do not edit by hand.
+ * {w}x{h} RGB565, {len(palette)} colors, {len(packed)} bytes packed
+ * ({w * h * 2} bytes unpacked). Decoded at runtime by packed_image_decode().
+ ******************************************************************************/
+
+#include "packed_image.h"
+
+static const uint16_t {name}_palette[{len(palette)}] = {{
+{pal}
+}};
+
+static const uint8_t {name}_data[{len(packed)}] = {{
+{c_bytes(packed)}
+}};
+
+const packed_image_t {name}_packed = {{
+  {w}, {h},
+  {len(palette)},
+  {name}_palette,
+  {name}_data,
+  sizeof({name}_data),
+}};
+""")
+    print("%s: %dx%d, %d colors, %d -> %d bytes" % (name, w, h, len(palette), w * h * 2, len(packed)))
+
+
+if __name__ == "__main__":
+    main()
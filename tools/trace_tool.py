@@ -0,0 +1,237 @@
+#!/usr/bin/env python3
+"""
+@file    trace_tool.py
+@author  Thomas Zoldowski
+@date    October 18, 2026
+@brief   Print field traces and rebuild them from TLM_TRACE frames.
+
+dump     Prints the records of trace files (/user/trace0.bin and
+         /user/trace1.bin, see include/logic/trace.h) one per line, with the
+         raw sensor passes decoded.
+
+capture  Pulls the TLM_TRACE frames out of a raw capture of the GIGA's USB
+         serial port (the Pi sink, TRACE_SINKS & TRACE_SINK_PI) and writes
+         them as a trace file that dump and the replay read. Frames lost on
+         the way show up as a jump in the stream offset; a TRACE_GAP record
+         goes in their place, so the replay waits for the next sync point.
+         A GIGA reset starts the offset at 0 again, which starts a new file
+         (name.bin, name.1.bin, ...).
+
+Replay itself is the host program of env:replay:
+    .pio/build/replay/program trace1.bin trace0.bin
+
+Usage:
+    python tools/trace_tool.py dump trace0.bin
+    python tools/trace_tool.py capture serial_capture.bin -o pi_trace.bin
+"""
+
+import argparse
+import os
+import struct
+import sys
+
+MAGIC = b"CTRC"
+VERSION = 1
+HEADER_LEN = 12
+CONFIG_LEN = 68
+STATE_FIXED_LEN = 37
+TLM_TRACE = 0x07
+
+CONFIG, STATE, PASS, SWITCH, OUTPUT, CONTROL, TRIGGER, GAP = range(1, 9)
+NAMES = {CONFIG: "CONFIG", STATE: "STATE", PASS: "PASS", SWITCH: "SWITCH",
+         OUTPUT: "OUTPUT", CONTROL: "CONTROL", TRIGGER: "TRIGGER", GAP: "GAP"}
+FLOATS = ("t0", "t1", "t2", "h0", "h1", "h2", "o2", "tof0", "tof1", "board_f")
+
+
+def varint(buf, pos):
+    """Return (value, next position) of the LEB128 varint at pos."""
+    value = shift = 0
+    while True:
+        if pos >= len(buf) or shift > 63:
+            raise ValueError("truncated varint")
+        b = buf[pos]
+        pos += 1
+        value |= (b & 0x7F) << shift
+        shift += 7
+        if not b & 0x80:
+            return value, pos
+
+
+def unzigzag(v):
+    return (v >> 1) ^ -(v & 1)
+
+
+def records(buf, pos=0):
+    """Yield (offset, type, t_us, text) per record; stops at a malformed one."""
+    t_us = 0
+    prev = [0] * len(FLOATS)
+    status = 0
+    epoch = 0
+    while pos < len(buf):
+        start = pos
+        try:
+            kind = buf[pos]
+            dt, pos = varint(buf, pos + 1)
+            if kind == CONFIG:
+                if pos + CONFIG_LEN > len(buf):
+                    raise ValueError("truncated")
+                pos += CONFIG_LEN
+                text = "%d bytes" % CONFIG_LEN
+            elif kind == STATE:
+                n, pos = varint(buf, pos)
+                if pos + STATE_FIXED_LEN > len(buf):
+                    raise ValueError("truncated")
+                epoch, sw, out, pump, blower = struct.unpack_from("<IBBII", buf, pos)
+                pos += STATE_FIXED_LEN
+                prev = [0] * len(FLOATS)
+                status = 0
+                text = "pass=%d epoch=%d switches=%02x outputs=%02x pump=%d blower=%d" % (
+                    n, epoch, sw, out, pump, blower)
+            elif kind == PASS:
+                changed, pos = varint(buf, pos)
+                if changed & 1:
+                    status = buf[pos]
+                    pos += 1
+                for i in range(len(FLOATS)):
+                    if changed & (2 << i):
+                        x, pos = varint(buf, pos)
+                        prev[i] ^= x & 0xFFFFFFFF
+                vals = struct.unpack("<%df" % len(FLOATS), struct.pack("<%dI" % len(FLOATS), *prev))
+                text = "status=%02x " % status + " ".join(
+                    "%s=%.2f" % (name, v) for name, v in zip(FLOATS, vals))
+            elif kind in (SWITCH, OUTPUT):
+                text = "%02x" % buf[pos]
+                pos += 1
+            elif kind == CONTROL:
+                n, pos = varint(buf, pos)
+                d, pos = varint(buf, pos)
+                epoch = (epoch + unzigzag(d)) & 0xFFFFFFFF
+                text = "pass=%d epoch=%d" % (n, epoch)
+            elif kind == TRIGGER:
+                program = buf[pos]
+                d, pos = varint(buf, pos + 1)
+                epoch = (epoch + unzigzag(d)) & 0xFFFFFFFF
+                text = "program=%d epoch=%d" % (program, epoch)
+            elif kind == GAP:
+                n, pos = varint(buf, pos)
+                text = "%d records lost" % n
+            else:
+                raise ValueError("unknown type %d" % kind)
+        except (ValueError, IndexError, struct.error) as e:
+            yield start, None, t_us, str(e)
+            return
+        t_us += dt
+        yield start, kind, t_us, text
+
+
+def dump(path):
+    with open(path, "rb") as f:
+        buf = f.read()
+    if len(buf) < HEADER_LEN or buf[:4] != MAGIC or buf[4] != VERSION:
+        print("%s: not a version %d trace file" % (path, VERSION), file=sys.stderr)
+        return False
+    seq = struct.unpack_from("<I", buf, 8)[0]
+    print("# %s: seq %d, %d bytes" % (path, seq, len(buf)))
+    ok = True
+    for off, kind, t_us, text in records(buf, HEADER_LEN):
+        if kind is None:
+            print("# damaged at offset %d (%s), %d bytes skipped" % (off, text, len(buf) - off))
+            ok = False
+            break
+        print("%12.6f %-8s %s" % (t_us / 1e6, NAMES[kind], text))
+    return ok
+
+
+# ========== SERIAL CAPTURE ==========
+
+def crc16(data):
+    """CRC-16/CCITT-FALSE, as crc16_ccitt() in src/logic/telemetry.cpp."""
+    crc = 0xFFFF
+    for b in data:
+        crc ^= b << 8
+        for _ in range(8):
+            crc = ((crc << 1) ^ 0x1021) if crc & 0x8000 else crc << 1
+            crc &= 0xFFFF
+    return crc
+
+
+def cobs_decode(chunk):
+    out = bytearray()
+    pos = 0
+    while pos < len(chunk):
+        code = chunk[pos]
+        if code == 0 or pos + code > len(chunk) + 1:
+            return None
+        out += chunk[pos + 1:pos + code]
+        pos += code
+        if code < 0xFF and pos < len(chunk):
+            out.append(0)
+    return bytes(out)
+
+
+def trace_frames(data):
+    """Yield (offset, records) of every valid TLM_TRACE frame; text and damage are skipped."""
+    for chunk in data.split(b"\x00"):
+        frame = cobs_decode(chunk) if chunk else None
+        if not frame or len(frame) < 6 + 4:
+            continue
+        if crc16(frame[:-2]) != struct.unpack_from("<H", frame, len(frame) - 2)[0]:
+            continue
+        if frame[1] != TLM_TRACE:
+            continue
+        yield struct.unpack_from("<I", frame, 4)[0], frame[8:-2]
+
+
+def capture(path, out):
+    with open(path, "rb") as f:
+        data = f.read()
+    base, ext = os.path.splitext(out)
+    files = []
+    stream = None
+    expect = 0
+    gaps = 0
+    for offset, payload in trace_frames(data):
+        if stream is None or offset < expect:
+            # First frame, or the GIGA restarted its stream: new file
+            stream = bytearray(MAGIC + bytes([VERSION, 0, 0, 0]) + struct.pack("<I", len(files) + 1))
+            files.append(stream)
+            if offset:
+                stream += bytes([GAP, 0, 0])
+                gaps += 1
+        elif offset > expect:
+            stream += bytes([GAP, 0, 0])
+            gaps += 1
+        stream += payload
+        expect = offset + len(payload)
+    if not files:
+        print("%s: no TLM_TRACE frames" % path, file=sys.stderr)
+        return False
+    for i, buf in enumerate(files):
+        name = out if i == 0 else "%s.%d%s" % (base, i, ext)
+        with open(name, "wb") as f:
+            f.write(buf)
+        print("%s: %d bytes" % (name, len(buf)))
+    if gaps:
+        print("%d gaps in the stream (frames lost)" % gaps)
+    return True
+
+
+def main():
+    ap = argparse.ArgumentParser(description="Print field traces and rebuild them from TLM_TRACE frames.")
+    sub = ap.add_subparsers(dest="cmd", required=True)
+    d = sub.add_parser("dump", help="print the records of trace files")
+    d.add_argument("files", nargs="+")
+    c = sub.add_parser("capture", help="rebuild a trace file from a raw serial capture")
+    c.add_argument("capture")
+    c.add_argument("-o", "--output", default="pi_trace.bin")
+    args = ap.parse_args()
+
+    if args.cmd == "dump":
+        ok = all([dump(p) for p in args.files])
+    else:
+        ok = capture(args.capture, args.output)
+    sys.exit(0 if ok else 1)
+
+
+if __name__ == "__main__":
+    main()